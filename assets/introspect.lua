@@ -9,158 +9,467 @@ import("core.project.project")
 import("core.tool.compiler")
 import("core.tool.linker")
 import("core.base.json")
+import("core.base.option")
+import("core.base.task")
 import("private.action.run.make_runenvs")
 
-function parse_cxflags(argument, arguments)
-    if argument:startswith("/isystem") or
-       argument:startswith("/ifcSearchDir") or
-       argument:startswith("/stdIfcDir") then
-        return  argument .. " ".. arguments[i + 1], true
+-- marker printed after each answer in server mode
+local SERVER_END_MARKER = "@@XMAKE_INTROSPECT_END@@"
+
+-- prefix of the target lines printed in stream mode
+local TARGET_MARKER = "@@XMAKE_INTROSPECT_TARGET@@"
+
+-- prefix of the "<done> <total>" progress lines printed on stderr
+local PROGRESS_MARKER = "@@XMAKE_INTROSPECT_PROGRESS@@"
+
+-- when set, the flags of the files configured on their own are only computed on request
+local lazy_flags = false
+
+-- CBOR (RFC 8949) item head for a major type and an unsigned argument
+function _cbor_head(major, value)
+    local prefix = major * 32
+    if value < 24 then
+        return string.char(prefix + value)
+    end
+
+    local bytes = {}
+    local size = value < 0x100 and 1 or value < 0x10000 and 2 or value < 0x100000000 and 4 or 8
+    for i = size, 1, -1 do
+        bytes[i] = value % 0x100
+        value = math.floor(value / 0x100)
     end
 
-    return argument, false
+    local additional = ({ [1] = 24, [2] = 25, [4] = 26, [8] = 27 })[size]
+    return string.char(prefix + additional, table.unpack(bytes))
 end
 
--- main entry
-function main ()
-    local output = {}
+-- true when the table only has the 1..n keys, empty tables are encoded as arrays
+function _is_array(value)
+    local count = 0
+    for _ in pairs(value) do
+        count = count + 1
+    end
 
-    -- load config
-    config.load()
-    -- add version info
-    output.version = format("%s", xmake.version())
-    -- add package infos
+    return count == #value
+end
 
-    -- add targets data
-    local targets = {}
-    local qml_import_path = {}
-    for name, target in pairs((project:targets())) do
-        local header_files = target:headerfiles()
-        table.sort(header_files)
-
-        local cxx_source_batch = target:sourcebatches()["c++.build"]
-        local cxx_module_batch = target:sourcebatches()["c++.build.modules"]
-        local cxx_source_files
-        local cxx_arguments
-        if cxx_source_batch then
-            for _, sourcefile in ipairs(cxx_source_batch.sourcefiles) do
-                local arguments = compiler.compflags(sourcefile, {target = target})
-
-                local ignore_next_arg = false
-                for i, argument in ipairs(arguments) do
-                        if ignore_next_arg then
-                                ignore_next_arg = false
-                                goto continue2
-                        end
-
-                        cxx_arguments = cxx_arguments or {}
-                        cxx_argument, ignore_next_arg = parse_cxflags(argument, arguments)
-                        table.append(cxx_arguments, cxx_argument)
-
-                        ::continue2::
-                 end
+-- append the CBOR encoding of value to buffer, map keys are sorted so the output is stable
+function _cbor_encode(value, buffer)
+    local kind = type(value)
+    if kind == "string" then
+        table.insert(buffer, _cbor_head(3, #value))
+        table.insert(buffer, value)
+    elseif kind == "boolean" then
+        table.insert(buffer, string.char(value and 0xf5 or 0xf4))
+    elseif kind == "number" and value == math.floor(value) and math.abs(value) < 2^53 then
+        if value < 0 then
+            table.insert(buffer, _cbor_head(1, -1 - value))
+        else
+            table.insert(buffer, _cbor_head(0, value))
+        end
+    elseif kind == "number" then
+        _cbor_encode(tostring(value), buffer)
+    elseif kind == "table" and _is_array(value) then
+        table.insert(buffer, _cbor_head(4, #value))
+        for _, item in ipairs(value) do
+            _cbor_encode(item, buffer)
+        end
+    elseif kind == "table" then
+        local keys = {}
+        for key, _ in pairs(value) do
+            table.insert(keys, tostring(key))
+        end
+        table.sort(keys)
+
+        table.insert(buffer, _cbor_head(5, #keys))
+        for _, key in ipairs(keys) do
+            _cbor_encode(key, buffer)
+            local item = value[key]
+            if item == nil then
+                item = value[tonumber(key)]
             end
+            _cbor_encode(item, buffer)
+        end
+    else
+        table.insert(buffer, string.char(0xf6))
+    end
+end
 
-            cxx_source_files = cxx_source_files or {}
-            table.join2(cxx_source_files, cxx_source_batch.sourcefiles, header_files, cxx_module_batch and cxx_module_batch.sourcefiles or {})
+-- write the output as a self-described CBOR document, print it as JSON when the file can't be written
+function _write_output(output, cbor_file)
+    if cbor_file then
+        local file = io.open(cbor_file, "wb")
+        if file then
+            local buffer = { string.char(0xd9, 0xd9, 0xf7) }
+            _cbor_encode(output, buffer)
+
+            file:write(table.concat(buffer))
+            file:close()
+            return
         end
+    end
 
-        local c_source_batch = target:sourcebatches()["c.build"]
-        local c_source_files
-        local c_arguments
-        if c_source_batch then
-            for _, sourcefile in ipairs(c_source_batch.sourcefiles) do
-                local args = compiler.compflags(sourcefile, {target = target})
+    print(json.encode(output))
+end
 
-                local ignore_next_arg = false
-                for i, argument in ipairs(arguments) do
-                        if ignore_next_arg then
-                                ignore_next_arg = false
-                                goto continue2
-                        end
+-- merge the flags taking their value as a separate argument
+function _split_compflags(flags)
+    local arguments = {}
+
+    local i = 1
+    while i <= #flags do
+        local flag = flags[i]
+        if (flag:startswith("/isystem") or
+            flag:startswith("/ifcSearchDir") or
+            flag:startswith("/stdIfcDir")) and flags[i + 1] then
+            flag = flag .. " " .. flags[i + 1]
+            i = i + 1
+        end
 
-                        c_arguments = c_arguments or {}
-                        c_argument, ignore_next_arg = parse_cxflags(argument, arguments)
-                        table.append(c_arguments, c_argument)
+        table.insert(arguments, flag)
+        i = i + 1
+    end
+
+    return arguments
+end
 
-                        ::continue2::
-                 end
+-- the flags of a file as the ones it appends to the flags of its batch, or all of them when
+-- it changes or reorders those, "-isystem", "dir" and the -D/-U order can't be split
+function _flags_delta(base, flags)
+    if #flags > #base then
+        local appended = true
+        for i, flag in ipairs(base) do
+            if flags[i] ~= flag then
+                appended = false
+                break
             end
+        end
 
-            c_source_files = c_source_files or {}
-            table.join2(c_source_files, c_source_batch.sourcefiles, header_files, c_module_batch and c_module_batch.sourcefiles or {})
+        if appended then
+            return { added = table.slice(flags, #base + 1) }
         end
+    end
 
-        local source_batches = {}
+    return { arguments = flags }
+end
 
-        if cxx_source_files then
-            table.append(source_batches, { kind = cxx_source_batch.sourcekind, source_files = cxx_source_files, arguments = cxx_arguments or {}})
+-- compute the flags of a source batch once, files configured with their own flags get a delta
+-- or, in lazy mode, are listed to be asked for with a "fileflags" request
+function _batch_arguments(target, sourcebatch)
+    local base_file
+    local configured_files = {}
+    for _, sourcefile in ipairs(sourcebatch.sourcefiles) do
+        if target.fileconfig and target:fileconfig(sourcefile) then
+            table.insert(configured_files, sourcefile)
+        elseif not base_file then
+            base_file = sourcefile
         end
-        if c_source_files then
-            table.append(source_batches, { kind = c_source_batch.sourcekind, source_files = c_source_files, arguments = c_arguments or {}})
+    end
+
+    local arguments = {}
+    base_file = base_file or sourcebatch.sourcefiles[1]
+    if base_file then
+        arguments = _split_compflags(compiler.compflags(base_file, {target = target}))
+    end
+
+    if lazy_flags then
+        return arguments, {}, configured_files
+    end
+
+    local file_flags = {}
+    local base_key = table.concat(arguments, "\n")
+    for _, sourcefile in ipairs(configured_files) do
+        local flags = _split_compflags(compiler.compflags(sourcefile, {target = target}))
+        if table.concat(flags, "\n") ~= base_key then
+            file_flags[sourcefile] = _flags_delta(arguments, flags)
         end
+    end
 
-        local target_file = target:targetfile() or ""
+    return arguments, file_flags, {}
+end
 
-        local defined_in = path.absolute("xmake.lua", target:scriptdir())
+-- split a "|" separated list of xmake.lua files into a lookup table
+function _parse_filter(str)
+    if not str or #str == 0 then
+        return nil
+    end
 
-        local use_qt = false
-        local frameworks = target:get("frameworks")
-        for _, framework in ipairs(frameworks) do
-            if framework:startswith("Qt") then
-                use_qt = true
-            end
+    local filter = {}
+    for _, file in ipairs(str:split("|", {plain = true})) do
+        filter[path.translate(file)] = true
+    end
+
+    return filter
+end
+
+function _add_target_pkgenvs(target, pkgenvs, targets_added)
+    if targets_added[target:name()] then
+        return
+    end
+
+    targets_added[target:name()] = true
+
+    table.join2(pkgenvs, target:pkgenvs())
 
+    for _, dep in ipairs(target:orderdeps()) do
+        _add_target_pkgenvs(dep, pkgenvs, targets_added)
+    end
+end
+
+-- collect the packages required by the project and whether "xmake f" could install them
+function _introspect_packages()
+    local packages = {}
+
+    local ok, required = pcall(project.required_packages)
+    if not ok or not required then
+        return packages
+    end
+
+    for name, pkg in pairs(required) do
+        local has_version, version = pcall(pkg.version_str, pkg)
+        local has_state, enabled = pcall(pkg.enabled, pkg)
+        table.insert(packages, { name = name,
+                                 version = has_version and version or "",
+                                 installed = has_state and enabled or false })
+    end
+
+    table.sort(packages, function(first, second) return first.name < second.name end)
+
+    return packages
+end
 
+-- the compiled interface of a module, once the target was built
+function _module_bmi(target, name)
+    local cachedir = path.join(target:autogendir(), "rules", "modules", "cache")
+    local filename = name:gsub(":", "-")
+
+    for _, bmi in ipairs({ path.join(cachedir, filename .. ".pcm"),
+                           path.join(cachedir, filename .. ".ifc"),
+                           path.join(cachedir, "gcm.cache", filename .. ".gcm") }) do
+        if os.isfile(bmi) then
+            return bmi
         end
-        ::continue3::
+    end
 
-        if use_qt and target:get("runenv") and target:get("runenv")["QML2_IMPORT_PATH"] then
-            for _, p in ipairs(target:get("runenv")["QML2_IMPORT_PATH"]) do
-                p = project:directory()
-                table.append(qml_import_path, p)
+    return ""
+end
+
+-- read the module declaration and the imports of each module unit, header units are left out
+function _introspect_module_units(target, module_files)
+    local units = {}
+
+    for _, file in ipairs(module_files) do
+        local unit = { file = file, name = "", interface = false, imports = {} }
+
+        local source = io.readfile(file) or ""
+        for line in source:gmatch("[^\n]*") do
+            local name = line:match("^%s*export%s+module%s+([%w_.:]+)%s*;")
+            if name then
+                unit.name = name
+                unit.interface = true
+            else
+                name = line:match("^%s*module%s+([%w_.:]+)%s*;")
+                if name then
+                    -- an implementation unit implicitly imports its primary interface
+                    unit.name = name
+                    table.insert(unit.imports, name)
+                end
             end
-        end
 
-        function _add_target_pkgenvs(target, pkgenvs, targets_added)
-            if targets_added[target:name()] then
-                return
+            local imported = line:match("^%s*import%s+([%w_.:]+)%s*;") or
+                             line:match("^%s*export%s+import%s+([%w_.:]+)%s*;")
+            if imported then
+                -- a partition is imported by its name in the primary module
+                if imported:startswith(":") then
+                    imported = unit.name:split(":", {plain = true})[1] .. imported
+                end
+                table.insert(unit.imports, imported)
             end
+        end
+
+        if #unit.name > 0 then
+            unit.bmi = unit.interface and _module_bmi(target, unit.name) or ""
+            table.insert(units, unit)
+        end
+    end
+
+    return units
+end
+
+-- collect the description of one target, the time spent in its slow parts is added to profile
+function _introspect_target(name, target, qml_import_path, profile)
+    local start = os.mclock()
+
+    local header_files = target:headerfiles()
+    table.sort(header_files)
+
+    local batches_start = os.mclock()
+    local cxx_source_batch = target:sourcebatches()["c++.build"]
+    local cxx_module_batch = target:sourcebatches()["c++.build.modules"]
+    local c_source_batch = target:sourcebatches()["c.build"]
+    local batches_time = os.mclock() - batches_start
+
+    local source_batches = {}
 
-            targets_added[target:name()] = true
+    local flags_start = os.mclock()
+    if cxx_source_batch then
+        local arguments, file_flags, lazy_files = _batch_arguments(target, cxx_source_batch)
+        local source_files = table.join(cxx_source_batch.sourcefiles, cxx_module_batch and cxx_module_batch.sourcefiles or {})
+
+        table.append(source_batches, { kind = cxx_source_batch.sourcekind, source_files = source_files, arguments = arguments, file_flags = file_flags, lazy_files = lazy_files })
+    end
+
+    if c_source_batch then
+        local arguments, file_flags, lazy_files = _batch_arguments(target, c_source_batch)
+        local source_files = c_source_batch.sourcefiles
+
+        table.append(source_batches, { kind = c_source_batch.sourcekind, source_files = source_files, arguments = arguments, file_flags = file_flags, lazy_files = lazy_files })
+    end
 
-            table.join2(pkgenvs, target:pkgenvs())
+    local module_units = cxx_module_batch and _introspect_module_units(target, cxx_module_batch.sourcefiles) or {}
 
-            for _, dep in ipairs(target:orderdeps()) do
-                _add_target_pkgenvs(dep, pkgenvs, targets_added)
+    -- the uic headers exist once the target is built, the IDE generates them in memory until then
+    local generated_files = {}
+    local ui_batch = target:sourcebatches()["qt.ui"]
+    if ui_batch then
+        local ui_dir = path.join(target:autogendir(), "rules", "qt", "ui")
+        for _, file in ipairs(ui_batch.sourcefiles) do
+            table.insert(generated_files, { kind = "ui", source = file, outputs = { path.absolute(path.join(ui_dir, "ui_" .. path.basename(file) .. ".h")) } })
+        end
+    end
+    local flags_time = os.mclock() - flags_start
+
+    local target_file = target:targetfile() or ""
+
+    -- -1 when the unity build rule isn't applied, 0 for the default batch size
+    local unity_batch_size = -1
+    if target:rule("c++.unity_build") then
+        unity_batch_size = target:extraconf("rules", "c++.unity_build", "batchsize") or 0
+    end
+    local precompiled_header = target:pcxxheaderfile() or target:pcheaderfile()
+
+    local defined_in = path.absolute("xmake.lua", target:scriptdir())
+
+    local use_qt = false
+    local frameworks = target:get("frameworks")
+    for _, framework in ipairs(frameworks) do
+        if framework:startswith("Qt") then
+            use_qt = true
+        end
+    end
+
+    -- kept per target too, a partial introspection is merged with the paths of the others
+    local target_qml_import_path = {}
+    if use_qt and target:get("runenv") and target:get("runenv")["QML2_IMPORT_PATH"] then
+        for _, p in ipairs(table.wrap(target:get("runenv")["QML2_IMPORT_PATH"])) do
+            -- relative entries are relative to the xmake.lua declaring the target
+            local import_path = path.absolute(p, target:scriptdir())
+            table.append(target_qml_import_path, import_path)
+            table.append(qml_import_path, import_path)
+        end
+    end
+
+    local runenvs_start = os.mclock()
+    local pkgenvs = {}
+    _add_target_pkgenvs(target, pkgenvs, {})
+
+    local addrunenvs, setrunenvs = make_runenvs(target)
+    local runenvs = { add = addrunenvs, set = setrunenvs }
+
+    for name, env in pairs(pkgenvs) do
+        runenvs.add[name] = runenvs.add[name] or {}
+        table.append(runenvs.add[name], env)
+    end
+    local runenvs_time = os.mclock() - runenvs_start
+
+    table.insert(profile, { name = name,
+                            total = os.mclock() - start,
+                            sourcebatches = batches_time,
+                            compflags = flags_time,
+                            runenvs = runenvs_time })
+
+    return { name = name,
+             kind = target:targetkind(),
+             run_envs = runenvs,
+             defined_in = defined_in,
+             source_batches = source_batches or {},
+             header_files = header_files or {},
+             module_files = cxx_module_batch and cxx_module_batch.sourcefiles or {},
+             module_units = module_units,
+             generated_files = generated_files,
+             target_file = target_file,
+             object_dir = target:objectdir(),
+             unity_batch_size = unity_batch_size,
+             precompiled_header = precompiled_header and path.absolute(precompiled_header) or "",
+             install_dir = target:installdir() or "",
+             tests = table.wrap(target:get("tests")),
+             packages = target:get("packages") or {},
+             frameworks = target:get("frameworks") or {},
+             use_qt = use_qt,
+             qml_import_path = target_qml_import_path,
+             group = target:get("group") or "",
+             deps = table.wrap(target:get("deps")),
+             autogendir = target:autogendir() }
+end
+
+-- files the last build of a target was compiled from, read from the dependency files xmake
+-- wrote for its objects, nil when an object has none yet
+function _target_build_inputs(target, depend)
+    local files = {}
+    for _, sourcebatch in pairs(target:sourcebatches()) do
+        for _, objectfile in ipairs(sourcebatch.objectfiles or {}) do
+            local dependinfo = depend.load(target:dependfile(objectfile))
+            if not dependinfo then
+                return nil
+            end
+
+            for _, file in ipairs(dependinfo.files or {}) do
+                table.insert(files, path.absolute(file, project:directory()))
             end
         end
+    end
 
+    return table.unique(files)
+end
 
-        local pkgenvs = {}
-        _add_target_pkgenvs(target, pkgenvs, {})
+-- collect the project description, restricted to the targets defined in the filter files if any
+-- in stream mode each target is printed on its own line as soon as it is ready
+function _introspect(filter, stream)
+    local output = {}
 
-        local addrunenvs, setrunenvs = make_runenvs(target)
-        local runenvs = { add = addrunenvs, set = setrunenvs }
+    -- load config
+    config.load()
+    -- add version info
+    output.version = format("%s", xmake.version())
+    -- add package infos
+    output.packages = _introspect_packages()
 
-        for name, env in pairs(pkgenvs) do
-            runenvs.add[name] = runenvs.add[name] or {}
-            table.append(runenvs.add[name], env)
+    -- add targets data
+    local targets = {}
+    local qml_import_path = {}
+    local profile = {}
+    local total = #table.keys(project:targets())
+    local done = 0
+    local reported = -1
+    for name, target in pairs((project:targets())) do
+        -- at most a hundred steps, whatever the number of targets
+        done = done + 1
+        local percent = math.floor(done * 100 / total)
+        if percent ~= reported then
+            reported = percent
+            io.stderr:print(PROGRESS_MARKER .. " " .. done .. " " .. total)
         end
 
-        table.insert(targets, { name = name,
-                                kind = target:targetkind(),
-                                run_envs = runenvs,
-                                defined_in = defined_in,
-                                source_batches = source_batches or {},
-                                header_files = header_files or {},
-                                module_files = cxx_module_batch and cxx_module_batch.sourcefiles or {},
-                                target_file = target_file,
-                                packages = target:get("packages") or {},
-                                frameworks = target:get("frameworks") or {},
-                                use_qt = use_qt,
-                                group = target:get("group") or "",
-                                autogendir = target:autogendir() } )
+        local defined_in = path.absolute("xmake.lua", target:scriptdir())
+        if not filter or filter[path.translate(defined_in)] then
+            local info = _introspect_target(name, target, qml_import_path, profile)
+            if stream then
+                print(TARGET_MARKER .. json.encode(info))
+                io.flush()
+            else
+                table.insert(targets, info)
+            end
+        end
     end
 
     table.sort(targets, function(first, second) return first.name > second.name end)
@@ -216,9 +525,231 @@ function main ()
     output.options = options
 
     output.project_dir = project:directory()
-    output.qml_import_path = qml_import_path
+    output.qml_import_path = table.unique(qml_import_path)
     output.project_files = project:allfiles()
 
+    -- milliseconds spent on each target, slowest first
+    table.sort(profile, function(first, second) return first.total > second.total end)
+    output.profile = profile
 
-    print(json.encode(output))
+    if filter then
+        output.partial_files = table.keys(filter)
+    end
+
+    return output
+end
+
+-- drop the project state cached by xmake so that edited xmake.lua files are interpreted again
+function _reset_project()
+    local memcache = import("core.cache.memcache")
+    memcache.cache("core.project.project"):clear()
+    memcache.cache("core.project.config"):clear()
+end
+
+-- run "xmake f" in this process so that the project is only loaded once for both steps
+function _configure(argv)
+    local menu = task.task("config"):menu()
+    local options = option.parse(argv, menu.options, {populate_defaults = false})
+    if not options then
+        raise("invalid configuration arguments: %s", table.concat(argv, " "))
+    end
+
+    task.run("config", options)
+    _reset_project()
+end
+
+-- answer introspection requests read on stdin until "quit" or end of input
+function _serve(cbor_file, stream)
+    while true do
+        local request = io.read()
+        if not request then
+            break
+        end
+
+        request = request:trim()
+        local command, argument = request:match("^(%S+)%s*(.*)$")
+        if command == "quit" then
+            break
+        elseif command == "introspect" then
+            local status = 0
+            try {
+                function ()
+                    _reset_project()
+                    _write_output(_introspect(_parse_filter(argument), stream), cbor_file)
+                end,
+                catch {
+                    function (errors)
+                        io.stderr:print(tostring(errors))
+                        status = 1
+                    end
+                }
+            }
+            print(SERVER_END_MARKER .. " " .. status)
+        elseif command == "fileflags" then
+            -- "<target>|<file>", answered with the flags of the file as a JSON document
+            local status = 0
+            try {
+                function ()
+                    config.load()
+
+                    local name, file = argument:match("^(.-)|(.+)$")
+                    local target = name and project.target(name)
+                    if not target then
+                        raise("unknown target: %s", tostring(name))
+                    end
+
+                    local arguments = _split_compflags(compiler.compflags(file, {target = target}))
+                    print(json.encode({ file = file, arguments = arguments }))
+                end,
+                catch {
+                    function (errors)
+                        io.stderr:print(tostring(errors))
+                        status = 1
+                    end
+                }
+            }
+            print(SERVER_END_MARKER .. " " .. status)
+        elseif command == "buildinputs" then
+            -- answered with the recorded inputs of each target as a JSON document
+            local status = 0
+            try {
+                function ()
+                    config.load()
+
+                    local depend = import("core.project.depend")
+                    local inputs = {}
+                    for name, target in pairs(project:targets()) do
+                        inputs[name] = _target_build_inputs(target, depend)
+                    end
+                    print(json.encode({ targets = inputs }))
+                end,
+                catch {
+                    function (errors)
+                        io.stderr:print(tostring(errors))
+                        status = 1
+                    end
+                }
+            }
+            print(SERVER_END_MARKER .. " " .. status)
+        elseif command then
+            io.stderr:print("unknown request: " .. request)
+            print(SERVER_END_MARKER .. " 1")
+        end
+
+        io.flush()
+    end
+end
+
+-- run probe and tell whether it succeeded and returned a true value
+function _probe(probe)
+    return try { probe } and true or false
+end
+
+-- print the modes this xmake runtime can serve, probed once per executable by the plugin
+-- each mode is listed only when the APIs it relies on answer as the script uses them
+function _capabilities()
+    local capabilities = {}
+
+    -- "xmake f" run by the script itself, parsing its arguments without the defaults
+    if _probe(function ()
+        local menu = task.task("config"):menu()
+        return menu and option.parse({}, menu.options, {populate_defaults = false})
+    end) then
+        table.insert(capabilities, "configure")
+    end
+
+    -- the document is written byte for byte, without any transcoding
+    if _probe(function ()
+        local file_path = os.tmpfile() .. ".cbor"
+        local bytes = string.char(0xd9, 0xd9, 0xf7, 0x00, 0xff, 0x0a, 0x0d)
+
+        local file = io.open(file_path, "wb")
+        file:write(bytes)
+        file:close()
+
+        local read = io.readfile(file_path, {encoding = "binary"})
+        os.tryrm(file_path)
+
+        return read == bytes
+    end) then
+        table.insert(capabilities, "cbor")
+    end
+
+    -- the server drops the project cached by xmake before each answer
+    if _probe(function ()
+        local cache = import("core.cache.memcache").cache("core.project.project")
+        return cache and cache.clear
+    end) then
+        table.insert(capabilities, "server")
+    end
+
+    -- each streamed target is one JSON line
+    if _probe(function ()
+        local line = json.encode({ name = "probe", files = { "a.c", "b.c" } })
+        return line and not line:find("\n", 1, true) and io.flush
+    end) then
+        table.insert(capabilities, "stream")
+    end
+
+    -- the files configured on their own are listed and asked for with a target
+    if _probe(function ()
+        local scopeinfo = import("core.base.scopeinfo")
+        local target = import("core.project.target").new("probe", scopeinfo.new("target", {}))
+        if not target.fileconfig then
+            return false
+        end
+
+        local file_path = os.tmpfile() .. ".c"
+        io.writefile(file_path, "int main(void) { return 0; }\n")
+
+        local flags = compiler.compflags(file_path, {target = target})
+        os.tryrm(file_path)
+
+        return flags ~= nil
+    end) then
+        table.insert(capabilities, "fileflags")
+    end
+
+    print(table.concat(capabilities, " "))
+end
+
+-- main entry
+function main(...)
+    local mode
+    local filter
+    local cbor_file
+    local stream = false
+    local config_argv
+    for _, arg in ipairs({...}) do
+        if config_argv then
+            table.insert(config_argv, arg)
+        elseif arg == "--configure" then
+            -- everything after is given to the config task
+            config_argv = {}
+        elseif arg:startswith("--cbor=") then
+            cbor_file = arg:sub(#"--cbor=" + 1)
+        elseif arg == "--stream" then
+            stream = true
+        elseif arg == "--lazy-flags" then
+            lazy_flags = true
+        elseif arg == "--capabilities" then
+            _capabilities()
+            return
+        elseif arg == "server" then
+            mode = arg
+        else
+            filter = arg
+        end
+    end
+
+    if mode == "server" then
+        _serve(cbor_file, stream)
+        return
+    end
+
+    if config_argv then
+        _configure(config_argv)
+    end
+
+    _write_output(_introspect(_parse_filter(filter), stream), cbor_file)
 end
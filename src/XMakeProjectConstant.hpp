@@ -24,6 +24,37 @@ namespace XMakeProjectManager::Constants {
         static constexpr auto CATEGORY   = "Z.XMake";
     } // namespace SettingsPage
 
+    namespace GeneralSettings {
+        static constexpr auto INTROSPECTION_SERVER_KEY = "XMakeProjectManager.IntrospectionServer";
+        static constexpr auto INTROSPECTION_SERVER_IDLE_TIMEOUT_KEY =
+            "XMakeProjectManager.IntrospectionServer.IdleTimeout";
+        static constexpr auto INTROSPECTION_CACHE_KEY = "XMakeProjectManager.IntrospectionCache";
+        static constexpr auto SHARED_INTROSPECTION_KEY =
+            "XMakeProjectManager.SharedIntrospection";
+        static constexpr auto INTROSPECTION_STREAMING_KEY =
+            "XMakeProjectManager.IntrospectionStreaming";
+        static constexpr auto LAZY_FILE_FLAGS_KEY    = "XMakeProjectManager.LazyFileFlags";
+        static constexpr auto COMBINED_CONFIGURE_KEY = "XMakeProjectManager.CombinedConfigure";
+        static constexpr auto MAX_XMAKE_PROCESSES_KEY = "XMakeProjectManager.MaxXMakeProcesses";
+        static constexpr auto BACKGROUND_LOW_PRIORITY_KEY =
+            "XMakeProjectManager.BackgroundLowPriority";
+        static constexpr auto BACKGROUND_CONFIGURE_LOW_PRIORITY_KEY =
+            "XMakeProjectManager.BackgroundLowPriority.Configure";
+        static constexpr auto COMPILE_COMMANDS_KEY   = "XMakeProjectManager.CompileCommands";
+        static constexpr auto LAZY_PROJECT_TREE_KEY  = "XMakeProjectManager.LazyProjectTree";
+        static constexpr auto PACKAGE_PREFETCH_KEY   = "XMakeProjectManager.PackagePrefetch";
+        static constexpr auto BACKGROUND_CONFIGURE_KEY =
+            "XMakeProjectManager.BackgroundConfigure";
+        static constexpr auto BACKGROUND_CONFIGURE_JOBS_KEY =
+            "XMakeProjectManager.BackgroundConfigureJobs";
+        static constexpr auto PARSE_TIMINGS_HISTORY_KEY =
+            "XMakeProjectManager.ParseTimingsHistory";
+        static constexpr auto COMPILE_ON_SAVE_KEY = "XMakeProjectManager.CompileOnSave";
+        static constexpr auto TRACE_EXPORT_KEY    = "XMakeProjectManager.TraceExport";
+        static constexpr auto SHARED_DETECTION_KEY = "XMakeProjectManager.SharedDetection";
+        static constexpr auto RECORD_FIXTURES_KEY  = "XMakeProjectManager.RecordFixtures";
+    } // namespace GeneralSettings
+
     namespace ToolsSettings {
         static constexpr auto FILENAME         = "xmaketool.xml";
         static constexpr auto ENTRY_KEY        = "XMakeProjectManager.Tool.";
@@ -36,6 +67,10 @@ namespace XMakeProjectManager::Constants {
         static constexpr auto TOOL_TYPE_XREPO  = "xrepo"; /* for the future */
         static constexpr auto TOOL_TYPE_KEY    = "XMakeProjectManager.Tool.Type";
         static constexpr auto AUTORUN_KEY      = "XMakeProjectManager.Tool.Autorun";
+        static constexpr auto VERSION_KEY      = "XMakeProjectManager.Tool.Version";
+        // renamed when the script probes differently, the old probes are run again
+        static constexpr auto CAPABILITIES_KEY = "XMakeProjectManager.Tool.ProbedCapabilities";
+        static constexpr auto EXE_MODIFIED_KEY = "XMakeProjectManager.Tool.ExeModified";
         static constexpr auto AUTO_ACCEPT_REQUESTS_KEY =
             "XMakeProjectManager.Tool.AutoAcceptRequests";
     } // namespace ToolsSettings
@@ -43,20 +78,92 @@ namespace XMakeProjectManager::Constants {
     namespace BuildConfiguration {
         static constexpr auto BUILD_TYPE_KEY = "XMakeProjectManager.BuildConfig.Type";
         static constexpr auto PARAMETERS_KEY = "XMakeProjectManager.BuildConfig.Parameters";
+        static constexpr auto IMPORT_PARAMETERS_KEY =
+            "XMakeProjectManager.BuildConfig.ImportParameters";
+        static constexpr auto TARGET_OPTIONS_KEY =
+            "XMakeProjectManager.BuildConfig.TargetOptions";
+        static constexpr auto UNITY_BATCH_SIZE_KEY   = "UnityBatchSize";
+        static constexpr auto PRECOMPILED_HEADER_KEY = "PrecompiledHeader";
+        static constexpr auto OUTPUT_DIRECTORY_KEY =
+            "XMakeProjectManager.BuildConfig.OutputDirectory";
     } // namespace BuildConfiguration
 
     namespace BuildStep {
         static constexpr auto TARGETS_KEY = "XMakeProjectManager.BuildStep.BuildTargets";
         static constexpr auto TOOL_ARGUMENTS_KEY =
             "XMakeProjectManager.BuildStep.AdditionalArguments";
+        static constexpr auto JOBS_KEY   = "XMakeProjectManager.BuildStep.Jobs";
+        static constexpr auto CCACHE_KEY = "XMakeProjectManager.BuildStep.CompilerCache";
+        static constexpr auto AFFECTED_ONLY_KEY =
+            "XMakeProjectManager.BuildStep.AffectedTargetsOnly";
+        static constexpr auto LAST_BUILD_KEY = "XMakeProjectManager.BuildStep.LastFullBuild";
+        static constexpr auto SKIP_UP_TO_DATE_KEY =
+            "XMakeProjectManager.BuildStep.SkipUpToDate";
+        static constexpr auto STRUCTURED_DIAGNOSTICS_KEY =
+            "XMakeProjectManager.BuildStep.StructuredDiagnostics";
+        static constexpr auto TIME_TRACE_KEY = "XMakeProjectManager.BuildStep.TimeTrace";
+        static constexpr auto QUIET_OUTPUT_KEY = "XMakeProjectManager.BuildStep.QuietOutput";
+        static constexpr auto RUN_TARGET_MODE_KEY =
+            "XMakeProjectManager.BuildStep.RunTargetMode";
+        static constexpr auto WATCH_KEY = "XMakeProjectManager.BuildStep.Watch";
     } // namespace BuildStep
 
+    namespace TestStep {
+        static constexpr auto TESTS_KEY = "XMakeProjectManager.TestStep.Tests";
+        static constexpr auto JOBS_KEY  = "XMakeProjectManager.TestStep.Jobs";
+    } // namespace TestStep
+
     namespace Targets {
         static constexpr auto ALL   = "all";
         static constexpr auto CLEAN = "clean";
     } // namespace Targets
 
-    static constexpr auto XMAKE_INFO_DIR = ".xmake";
+    namespace Locator {
+        static constexpr auto BUILD_TARGET_FILTER_ID = "XMakeProjectManager.Locator.BuildTarget";
+        static constexpr auto RUN_TARGET_FILTER_ID   = "XMakeProjectManager.Locator.RunTarget";
+    } // namespace Locator
+
+    namespace Introspection {
+        static constexpr auto SERVER_ARG          = "server";
+        static constexpr auto SERVER_REQUEST      = "introspect";
+        static constexpr auto FILTER_SEPARATOR    = '|';
+        static constexpr auto SERVER_QUIT         = "quit\n";
+        static constexpr auto SERVER_END_MARKER   = "@@XMAKE_INTROSPECT_END@@";
+        static constexpr auto CBOR_ARG            = "--cbor=";
+        static constexpr auto CBOR_OUTPUT         = ".xmake-qtc-introspection.cbor";
+        static constexpr auto STREAM_ARG          = "--stream";
+        static constexpr auto LAZY_FLAGS_ARG      = "--lazy-flags";
+        static constexpr auto SERVER_FILE_FLAGS   = "fileflags";
+        static constexpr auto SERVER_BUILD_INPUTS = "buildinputs";
+        static constexpr auto TARGET_MARKER       = "@@XMAKE_INTROSPECT_TARGET@@";
+        static constexpr auto PROGRESS_MARKER     = "@@XMAKE_INTROSPECT_PROGRESS@@";
+        static constexpr auto CONFIGURE_ARG       = "--configure";
+        static constexpr auto CAPABILITIES_ARG    = "--capabilities";
+    } // namespace Introspection
+
+    static constexpr auto XMAKE_INFO_DIR            = ".xmake";
+    static constexpr auto XMAKE_INTROSPECTION_CACHE = ".xmake-qtc-introspection.cache";
+    static constexpr auto COMPILE_COMMANDS          = "compile_commands.json";
+    static constexpr auto CCACHE_STATS_LOG          = ".xmake-qtc-ccache-stats.log";
+    static constexpr auto SARIF_LOG_DIR             = ".xmake-qtc-sarif";
+    static constexpr auto PHASE_HISTORY             = ".xmake-qtc-durations.json";
+    static constexpr auto BUILD_DURATIONS           = ".xmake-qtc-build-durations.json";
+    static constexpr auto BUILD_LOG                 = ".xmake-qtc-build.log";
+    static constexpr auto PARSE_TRACE               = ".xmake-qtc-parse-trace.json";
+    static constexpr auto BUILD_TRACE               = ".xmake-qtc-build-trace.json";
+    // xmake rc file applying the per target options of a build configuration
+    static constexpr auto TARGET_OPTIONS_FILE = ".xmake-qtc-targets.lua";
+    static constexpr auto OUTPUT_MARKER       = ".xmake-qtc-output";
+
+    // records the introspection documents there even with the setting off, the replay test
+    // reads them back from it
+    static constexpr auto FIXTURES_DIR_VARIABLE = "XMAKE_QTC_FIXTURES_DIR";
+    // the oldest recorded documents are removed past that count
+    static constexpr auto MAX_FIXTURES = 50;
+
+    static constexpr auto TASK_CATEGORY_COMPILE_TIMES = "XMakeProjectManager.CompileTimes";
+    // where xmake install puts the targets without an install directory on unix
+    static constexpr auto DEFAULT_INSTALL_PREFIX = "/usr/local";
 
 #if defined(Q_OS_WINDOWS)
     #if INTPTR_MAX == INT64_MAX
@@ -83,5 +190,7 @@ namespace XMakeProjectManager::Constants {
 
     static constexpr auto XMAKE_TOOL_MANAGER    = "XMakeProjectManager.Tools";
     static constexpr auto XMAKE_BUILD_STEP_ID   = "XMakeProjectManager.BuildStep";
+    static constexpr auto XMAKE_TEST_STEP_ID    = "XMakeProjectManager.TestStep";
     static constexpr auto XMAKE_BUILD_CONFIG_ID = "XMakeProjectManager.BuildConfiguration";
+    static constexpr auto XMAKE_RUN_CONFIG_ID   = "XMakeProjectManager.XMakeRunConfiguration";
 } // namespace XMakeProjectManager::Constants
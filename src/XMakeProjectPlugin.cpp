@@ -6,12 +6,19 @@
 
 #include <XMakeProjectConstant.hpp>
 
+#include <exewrappers/XMakeWrapper.hpp>
+
+#include <project/XMakeBackgroundConfigurator.hpp>
 #include <project/XMakeBuildConfiguration.hpp>
 #include <project/XMakeBuildStep.hpp>
+#include <project/XMakeIntrospectionServer.hpp>
 #include <project/XMakeProject.hpp>
 #include <project/XMakeRunConfiguration.hpp>
+#include <project/XMakeTestStep.hpp>
+#include <project/projecttree/ProjectTree.hpp>
 
 #include <xmakeactionsmanager/XMakeActionsManager.hpp>
+#include <xmakeactionsmanager/XMakeTargetLocatorFilter.hpp>
 
 #include <settings/general/Settings.hpp>
 #include <settings/tools/ToolsSettingsAccessor.hpp>
@@ -25,6 +32,12 @@
 #include <projectexplorer/projectmanager.h>
 #include <projectexplorer/runconfiguration.h>
 #include <projectexplorer/runcontrol.h>
+#include <projectexplorer/taskhub.h>
+
+#ifdef WITH_TESTS
+#include <XMakeFixtureReplayTest.hpp>
+#include <XMakeParseBenchmarks.hpp>
+#endif
 
 namespace XMakeProjectManager::Internal {
     class XMakeProjectPlugin::XMakeProjectPluginPrivate final: public QObject {
@@ -37,14 +50,20 @@ namespace XMakeProjectManager::Internal {
                   { ProjectExplorer::Constants::NORMAL_RUN_MODE },
                   { m_run_configuration_factory.runConfigurationId() }
               } {
-            XMakeTools::setTools(m_tools_settings.loadXMakeTools(Core::ICore::dialogParent()));
+            // most sessions don't open an xmake project, the tools are restored on first use
+            XMakeTools::setLoader(
+                [this] { return m_tools_settings.loadXMakeTools(Core::ICore::dialogParent()); });
             connect(Core::ICore::instance(),
                     &Core::ICore::saveSettingsRequested,
                     this,
                     &XMakeProjectPluginPrivate::saveAll);
         }
 
-        ~XMakeProjectPluginPrivate() override = default;
+        ~XMakeProjectPluginPrivate() override {
+            XMakeTools::setLoader({});
+            XMakeBackgroundConfigurator::shutdown();
+            XMakeIntrospectionServer::shutdownAll();
+        }
 
         XMakeProjectPluginPrivate(XMakeProjectPluginPrivate &&)      = delete;
         XMakeProjectPluginPrivate(const XMakeProjectPluginPrivate &) = delete;
@@ -54,6 +73,9 @@ namespace XMakeProjectManager::Internal {
 
       private:
         void saveAll() {
+            // nothing changed since the tools weren't restored
+            if (!XMakeTools::isLoaded()) return;
+
             m_tools_settings.saveXMakeTools(XMakeTools::tools(), Core::ICore::dialogParent());
         }
 
@@ -63,11 +85,14 @@ namespace XMakeProjectManager::Internal {
         XMakeToolKitAspect m_kit_aspect;
 
         XMakeBuildStepFactory m_build_step_factory;
+        XMakeTestStepFactory m_test_step_factory;
 
         XMakeBuildConfigurationFactory m_build_configuration_factory;
         XMakeRunConfigurationFactory m_run_configuration_factory;
 
         XMakeActionsManager m_actions_manager;
+        XMakeBuildTargetLocatorFilter m_build_target_locator_filter;
+        XMakeRunTargetLocatorFilter m_run_target_locator_filter;
 
         ProjectExplorer::RunWorkerFactory m_xmake_run_worker_factory;
     };
@@ -93,9 +118,26 @@ namespace XMakeProjectManager::Internal {
             QLatin1String { Constants::Icons::XMAKE_FILE_OVERLAY },
             "xmake.lua");
 
+        // extract the introspection script now rather than before the first parse
+        XMakeWrapper::introspectScript();
+
+        ProjectTree::initializeIcons();
+
+        ProjectExplorer::TaskHub::addCategory(Constants::TASK_CATEGORY_COMPILE_TIMES,
+                                              tr("Compile Times"),
+                                              false);
+
         return true;
     }
 
+#ifdef WITH_TESTS
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectPlugin::createTestObjects() const -> QVector<QObject *> {
+        return { new XMakeParseBenchmarks, new XMakeFixtureReplayTest };
+    }
+#endif
+
     auto XMakeProjectPlugin::XMakeProjectPluginPrivateDeleter::operator()(
         XMakeProjectPluginPrivate *p) -> void {
         delete p;
@@ -24,6 +24,10 @@ namespace XMakeProjectManager::Internal {
 
         bool initialize(const QStringList &arguments, QString *error_message) override;
 
+#ifdef WITH_TESTS
+        QVector<QObject *> createTestObjects() const override;
+#endif
+
         std::unique_ptr<XMakeProjectPluginPrivate, XMakeProjectPluginPrivateDeleter> m_pimpl;
     };
 } // namespace XMakeProjectManager::Internal
@@ -8,11 +8,22 @@
 
 #include <exewrappers/XMakeWrapper.hpp>
 
+#include <projectexplorer/projectexplorer.h>
+
 #include <utils/algorithm.h>
 #include <utils/filepath.h>
 #include <utils/qtcassert.h>
+#include <utils/runextensions.h>
+
+#include <utility>
 
 namespace XMakeProjectManager::Internal {
+    struct XMakeTools::ToolDetection {
+        Utils::FilePaths candidates;
+        std::vector<Utils::optional<XMakeWrapper::Probe>> probes;
+        std::size_t pending;
+    };
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     XMakeTools::XMakeTools() = default;
@@ -38,9 +49,13 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeTools::addTool(XMakeWrapperPtr &&xmake) -> void {
+        ensureLoaded();
+
         auto &self = instance();
         self.m_tools.emplace_back(std::move(xmake));
 
+        probe(*self.m_tools.back());
+
         Q_EMIT self.toolAdded(*self.m_tools.back());
     }
 
@@ -49,16 +64,108 @@ namespace XMakeProjectManager::Internal {
     auto XMakeTools::setTools(std::vector<XMakeWrapperPtr> &&tools) -> void {
         auto &self = instance();
 
-        self.m_tools = std::move(tools);
+        self.m_loaded = true;
+        self.m_loader = {};
+        self.m_tools  = std::move(tools);
+
+        for (const auto &tool : self.m_tools) probe(*tool);
+
+        // the detected tool is saved with the others, later startups only check it still exists
+        const auto *detected = xmakeWrapper();
+        if (!detected || !detected->exe().exists()) detectTool();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTools::setLoader(Loader loader) -> void {
+        auto &self = instance();
+        if (self.m_loaded) return;
+
+        self.m_loader = std::move(loader);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTools::ensureLoaded() -> void {
+        auto &self = instance();
+        if (self.m_loaded) return;
+
+        // set first, restoring the tools looks them up
+        self.m_loaded = true;
+
+        if (auto loader = std::exchange(self.m_loader, {}); loader) setTools(loader());
+
+        Q_EMIT self.toolsLoaded();
+    }
 
-        auto wrapper = xmakeWrapper();
-        if (wrapper) return;
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTools::detectTool() -> void {
+        // looking through the PATH and the install directories hits the disk
+        auto future = Utils::runAsync(ProjectExplorer::ProjectExplorerPlugin::sharedThreadPool(),
+                                      &XMakeWrapper::toolCandidates);
 
-        auto path = XMakeWrapper::findTool();
-        if (path)
-            self.m_tools.emplace_back(std::make_unique<XMakeWrapper>(QStringLiteral("System XMake"),
-                                                                     std::move(path.value()),
-                                                                     true));
+        Utils::onResultReady(future, &instance(), &XMakeTools::probeCandidates);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTools::probeCandidates(Utils::FilePaths candidates) -> void {
+        if (candidates.isEmpty()) return;
+
+        const auto count = static_cast<std::size_t>(candidates.size());
+        auto detection   = std::make_shared<ToolDetection>(
+            ToolDetection { std::move(candidates),
+                            std::vector<Utils::optional<XMakeWrapper::Probe>>(count),
+                            count });
+
+        // every candidate is probed on the pool, the first one of the list that runs is kept
+        for (auto i = std::size_t { 0 }; i < count; ++i) {
+            auto future =
+                Utils::runAsync(ProjectExplorer::ProjectExplorerPlugin::sharedThreadPool(),
+                                &XMakeWrapper::probe,
+                                detection->candidates.at(static_cast<int>(i)));
+
+            Utils::onFinished(future,
+                              &instance(),
+                              [detection, i](const QFuture<XMakeWrapper::Probe> &f) {
+                                  detection->probes[i] = f.result();
+
+                                  if (--detection->pending == 0) addDetectedTool(*detection);
+                              });
+        }
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTools::addDetectedTool(const ToolDetection &detection) -> void {
+        // a tool was detected while the candidates were probed
+        const auto *previous = xmakeWrapper();
+        if (previous && previous->exe().exists()) return;
+
+        for (auto i = std::size_t { 0 }; i < std::size(detection.probes); ++i) {
+            const auto &probe = detection.probes[i];
+            if (!probe || !probe->version.valid()) continue;
+
+            const auto &exe = detection.candidates.at(static_cast<int>(i));
+
+            // a moved executable keeps the id the kits refer to
+            auto tool = previous ? std::make_unique<XMakeWrapper>(previous->name(),
+                                                                  exe,
+                                                                  previous->id(),
+                                                                  true,
+                                                                  previous->autorun(),
+                                                                  previous->autoAcceptRequests())
+                                 : std::make_unique<XMakeWrapper>(QStringLiteral("System XMake"),
+                                                                  exe,
+                                                                  true);
+            // the tool is probed again once added when the capabilities weren't answered
+            if (probe->complete) tool->setProbe(*probe);
+
+            if (previous) removeTool(previous->id());
+            addTool(std::move(tool));
+            return;
+        }
     }
 
     ////////////////////////////////////////////////////
@@ -68,6 +175,8 @@ namespace XMakeProjectManager::Internal {
                                 Utils::FilePath exe,
                                 bool autorun,
                                 bool auto_accept_requests) -> void {
+        ensureLoaded();
+
         auto &self = instance();
 
         auto item = std::find_if(std::begin(self.m_tools),
@@ -79,6 +188,8 @@ namespace XMakeProjectManager::Internal {
             (*item)->setName(std::move(name));
             (*item)->setAutorun(autorun);
             (*item)->setAutoAcceptRequests(auto_accept_requests);
+
+            probe(**item);
         } else
             addTool(std::move(id), std::move(name), std::move(exe), autorun, auto_accept_requests);
     }
@@ -86,6 +197,8 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeTools::removeTool(Utils::Id id) -> void {
+        ensureLoaded();
+
         auto &self = instance();
 
         auto item = Utils::take(self.m_tools, [&id](const auto &tool) { return tool->id() == id; });
@@ -98,6 +211,8 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeTools::xmakeWrapper() -> XMakeWrapper * {
+        ensureLoaded();
+
         auto &self = instance();
 
         auto item = std::find_if(std::begin(self.m_tools),
@@ -112,6 +227,8 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeTools::xmakeWrapper(Utils::Id id) -> XMakeWrapper * {
+        ensureLoaded();
+
         auto &self = instance();
 
         auto item = std::find_if(std::begin(self.m_tools),
@@ -122,4 +239,33 @@ namespace XMakeProjectManager::Internal {
 
         return item->get();
     }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTools::probe(const XMakeWrapper &tool) -> void {
+        // a probe saved with the tool settings stays valid until the executable changes
+        if (!tool.isValid() || !tool.needsProbe()) return;
+
+        auto future = Utils::runAsync(ProjectExplorer::ProjectExplorerPlugin::sharedThreadPool(),
+                                      &XMakeWrapper::probe,
+                                      tool.exe());
+
+        Utils::onFinished(future,
+                          &instance(),
+                          [id = tool.id(), exe = tool.exe()](const QFuture<XMakeWrapper::Probe> &f) {
+                              auto wrapper = xmakeWrapper(id);
+
+                              // the tool was removed or pointed elsewhere in the meantime
+                              if (!wrapper || wrapper->exe() != exe) return;
+
+                              // an empty capability set would turn every mode off until the
+                              // executable changes, the next load probes it again
+                              const auto probe = f.result();
+                              if (!probe.complete) return;
+
+                              wrapper->setProbe(probe);
+
+                              Q_EMIT instance().toolProbed(*wrapper);
+                          });
+    }
 } // namespace XMakeProjectManager::Internal
@@ -10,6 +10,7 @@
 #include <utils/fileutils.h>
 #include <utils/id.h>
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -20,6 +21,7 @@ namespace XMakeProjectManager::Internal {
 
       public:
         using XMakeWrapperPtr = std::unique_ptr<XMakeWrapper>;
+        using Loader          = std::function<std::vector<XMakeWrapperPtr>()>;
 
         ~XMakeTools() override;
 
@@ -30,6 +32,11 @@ namespace XMakeProjectManager::Internal {
                             bool auto_accept_requests);
         static void addTool(XMakeWrapperPtr &&xmake);
         static void setTools(std::vector<XMakeWrapperPtr> &&tools);
+
+        // the saved tools are restored and the system one is detected the first time a tool is
+        // needed, by a project or a settings page, rather than when the plugin starts
+        static void setLoader(Loader loader);
+        static bool isLoaded() noexcept;
         static void updateTool(Utils::Id id,
                                QString name,
                                Utils::FilePath exe,
@@ -37,7 +44,7 @@ namespace XMakeProjectManager::Internal {
                                bool auto_accept_requests);
         static void removeTool(Utils::Id id);
 
-        static const std::vector<XMakeWrapperPtr> &tools() noexcept;
+        static const std::vector<XMakeWrapperPtr> &tools();
 
         static XMakeWrapper *xmakeWrapper();
         static XMakeWrapper *xmakeWrapper(Utils::Id id);
@@ -46,11 +53,24 @@ namespace XMakeProjectManager::Internal {
       Q_SIGNALS:
         void toolAdded(const XMakeProjectManager::Internal::XMakeWrapper &tool);
         void toolRemoved(const XMakeProjectManager::Internal::XMakeWrapper &tool);
+        void toolProbed(const XMakeProjectManager::Internal::XMakeWrapper &tool);
+        void toolsLoaded();
 
       private:
         XMakeTools();
 
+        static void ensureLoaded();
+        static void probe(const XMakeWrapper &tool);
+        struct ToolDetection;
+
+        static void detectTool();
+        static void probeCandidates(Utils::FilePaths candidates);
+        static void addDetectedTool(const ToolDetection &detection);
+
         std::vector<XMakeWrapperPtr> m_tools;
+
+        Loader m_loader;
+        bool m_loaded = false;
     };
 } // namespace XMakeProjectManager::Internal
 
@@ -7,10 +7,16 @@
 namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    inline auto XMakeTools::tools() noexcept -> const std::vector<XMakeWrapperPtr> & {
+    inline auto XMakeTools::tools() -> const std::vector<XMakeWrapperPtr> & {
+        ensureLoaded();
+
         return instance().m_tools;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeTools::isLoaded() noexcept -> bool { return instance().m_loaded; }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     inline auto XMakeTools::instance() -> XMakeTools & {
@@ -9,17 +9,34 @@
 #include <settings/general/Settings.hpp>
 
 #include <coreplugin/icore.h>
+#include <utils/environment.h>
+#include <utils/hostosinfo.h>
 #include <utils/qtcprocess.h>
 
 #include <QCryptographicHash>
+#include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QHash>
+#include <QRegularExpression>
 #include <QStandardPaths>
 #include <QUuid>
 
+#include <array>
+
 namespace XMakeProjectManager::Internal {
     static Q_LOGGING_CATEGORY(xmake_xmake_wrapper_log, "qtc.xmake.xmakewrapper", QtDebugMsg);
 
+    static constexpr auto INTROSPECT_SCRIPT_RESOURCE = ":/xmakeproject/assets/introspect.lua";
+    static constexpr auto DEVICE_SCRIPT_DIR          = "/tmp/xmake-qtc-introspect";
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto commandPath(const Utils::FilePath &path) -> QString {
+        // xmake runs on the device of its executable, it only knows the paths of that device
+        return path.needsDevice() ? path.path() : path.nativePath();
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     template<typename... T>
@@ -81,20 +98,119 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeWrapper::setExe(Utils::FilePath new_exe) -> void {
+        if (new_exe != m_exe) m_probe.reset();
+
         m_exe = std::move(new_exe);
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeWrapper::needsProbe() const -> bool {
+        return !m_probe || m_probe->exe_modified != m_exe.lastModified();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeWrapper::probe(const Utils::FilePath &exe) -> Probe {
+        static constexpr auto PROBE_TIMEOUT_S = 30;
+
+        static const auto capability_names = std::array {
+            std::make_pair(QStringLiteral("configure"), Capability::CombinedConfigure),
+            std::make_pair(QStringLiteral("cbor"), Capability::Cbor),
+            std::make_pair(QStringLiteral("server"), Capability::Server),
+            std::make_pair(QStringLiteral("stream"), Capability::Stream),
+            std::make_pair(QStringLiteral("fileflags"), Capability::FileFlags),
+        };
+
+        auto result = Probe { {}, {}, exe.lastModified() };
+
+        const auto work_dir =
+            exe.withNewPath(exe.needsDevice() ? QString { "/tmp" } : QDir::tempPath());
+
+        auto run = [&](QStringList args) -> Utils::optional<QString> {
+            auto process = Utils::QtcProcess {};
+            process.setWorkingDirectory(work_dir);
+            process.setCommand({ exe, args });
+            process.setTimeoutS(PROBE_TIMEOUT_S);
+            process.runBlocking();
+
+            if (process.result() != Utils::ProcessResult::FinishedWithSuccess) {
+                qCWarning(xmake_xmake_wrapper_log)
+                    << "Failed to probe" << exe.toUserOutput() << args << process.stdErr();
+                return Utils::nullopt;
+            }
+
+            return process.stdOut();
+        };
+
+        if (const auto output = run({ "--version" })) result.version = Version::fromString(*output);
+        else
+            result.complete = false;
+
+        // the script reports the modes the xmake runtime it runs in can serve
+        if (const auto output =
+                run({ "lua",
+                      deviceIntrospectScript(exe),
+                      Constants::Introspection::CAPABILITIES_ARG })) {
+            const auto names =
+                output->split(QRegularExpression { QStringLiteral("\\s+") }, Qt::SkipEmptyParts);
+
+            for (const auto &[name, capability] : capability_names)
+                if (names.contains(name)) result.capabilities |= capability;
+        } else
+            result.complete = false;
+
+        qCDebug(xmake_xmake_wrapper_log)
+            << "Probed" << exe.toUserOutput() << result.version.toQString()
+            << static_cast<int>(result.capabilities);
+
+        return result;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeWrapper::findTool() -> Utils::optional<Utils::FilePath> {
+        const auto candidates = toolCandidates();
+        if (candidates.isEmpty()) return Utils::nullopt;
+
+        return candidates.front();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeWrapper::toolCandidates() -> Utils::FilePaths {
         using namespace Utils;
 
-        auto env = Environment::systemEnvironment();
+        const auto env      = Environment::systemEnvironment();
+        const auto exe_name =
+            HostOsInfo::withExecutableSuffix(QLatin1String { Constants::TOOL_NAME });
+        const auto home     = FilePath::fromString(QDir::homePath());
+
+        auto directories = FilePaths { home / ".local/bin",
+                                       FilePath::fromString("/usr/local/bin"),
+                                       FilePath::fromString("/opt/homebrew/bin"),
+                                       FilePath::fromString("/home/linuxbrew/.linuxbrew/bin"),
+                                       home / ".linuxbrew/bin" };
+
+        if (HostOsInfo::isWindowsHost()) {
+            // scoop shims, then the directories of the xmake installer and install script
+            if (const auto scoop = env.expandedValueForKey("SCOOP"); !scoop.isEmpty())
+                directories.append(FilePath::fromUserInput(scoop) / "shims");
+            directories.append(home / "scoop/shims");
+
+            const auto program_files = env.expandedValueForKey("ProgramFiles");
+            if (!program_files.isEmpty())
+                directories.append(FilePath::fromUserInput(program_files) / "xmake");
+            directories.append(home / "xmake");
+        }
 
-        const auto exe_path = env.searchInPath(QLatin1String { Constants::TOOL_NAME });
-        if (exe_path.exists()) return exe_path;
+        auto candidates = env.findAllInPath(exe_name);
+        for (const auto &directory : std::as_const(directories)) {
+            const auto exe = directory / exe_name;
+            if (!candidates.contains(exe) && exe.isExecutableFile()) candidates.append(exe);
+        }
 
-        return Utils::nullopt;
+        return candidates;
     }
 
     ////////////////////////////////////////////////////
@@ -103,72 +219,192 @@ namespace XMakeProjectManager::Internal {
                                  const Utils::FilePath &build_directory,
                                  const QStringList &options,
                                  bool wipe) const -> Command {
+        return { m_exe,
+                 build_directory,
+                 options_cat("f",
+                             "-P",
+                             commandPath(source_directory),
+                             configureOptions(build_directory, options, wipe)) };
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeWrapper::require(const Utils::FilePath &source_directory,
+                               const Utils::FilePath &build_directory) const -> Command {
+        return { m_exe,
+                 build_directory,
+                 options_cat("require", "-P", commandPath(source_directory), "--yes") };
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeWrapper::configureOptions(const Utils::FilePath &build_directory,
+                                        const QStringList &options,
+                                        bool wipe) const -> QStringList {
         QStringList _options = options;
         if (wipe) _options.emplace_back("-c");
         if (m_auto_accept_requests) _options.emplace_back("--yes");
+
+        return options_cat(_options, "-o", commandPath(build_directory));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeWrapper::introspect(const Utils::FilePath &source_directory,
+                                  const Utils::FilePath &cbor_output,
+                                  bool stream,
+                                  const QStringList &project_files) -> Command {
+        const auto path = deviceIntrospectScript(m_exe);
+
+        auto filter = QStringList {};
+        if (!project_files.isEmpty())
+            filter.append(project_files.join(Constants::Introspection::FILTER_SEPARATOR));
+
         return { m_exe,
-                 build_directory,
-                 options_cat("f",
-                             _options,
+                 m_exe.withNewPath(m_exe.needsDevice() ? QString { "/" } : QDir::rootPath()),
+                 options_cat("lua",
                              "-P",
-                             source_directory.nativePath(),
-                             "-o",
-                             build_directory.nativePath()) };
+                             commandPath(source_directory),
+                             path,
+                             filter,
+                             outputArgs(cbor_output, stream)) };
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeWrapper::introspect(const Utils::FilePath &source_directory) -> Command {
-        auto path = decompressIntrospectLuaIfNot();
+    auto XMakeWrapper::introspectServer(const Utils::FilePath &source_directory,
+                                        const Utils::FilePath &cbor_output,
+                                        bool stream,
+                                        bool lazy_flags) -> Command {
+        const auto path = deviceIntrospectScript(m_exe);
+
+        auto args = outputArgs(cbor_output, stream);
+        if (lazy_flags) args.append(Constants::Introspection::LAZY_FLAGS_ARG);
 
         return { m_exe,
-                 Utils::FilePath::fromString(QDir::rootPath()),
-                 options_cat("lua", "-P", source_directory.nativePath(), path) };
+                 m_exe.withNewPath(m_exe.needsDevice() ? QString { "/" } : QDir::rootPath()),
+                 options_cat("lua",
+                             "-P",
+                             commandPath(source_directory),
+                             path,
+                             Constants::Introspection::SERVER_ARG,
+                             args) };
     }
 
-    auto fileChecksum(const QString &fileName, QCryptographicHash::Algorithm hashAlgorithm)
-        -> QByteArray {
-        auto file = QFile { fileName };
-        if (file.open(QFile::ReadOnly)) {
-            auto hash = QCryptographicHash { hashAlgorithm };
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeWrapper::configureAndIntrospect(const Utils::FilePath &source_directory,
+                                              const Utils::FilePath &build_directory,
+                                              const QStringList &options,
+                                              bool wipe,
+                                              const Utils::FilePath &cbor_output,
+                                              bool stream) -> Command {
+        const auto path = deviceIntrospectScript(m_exe);
+
+        // the configuration arguments come last, the script gives them all to the config task
+        return { m_exe,
+                 build_directory,
+                 options_cat("lua",
+                             "-P",
+                             commandPath(source_directory),
+                             path,
+                             outputArgs(cbor_output, stream),
+                             Constants::Introspection::CONFIGURE_ARG,
+                             configureOptions(build_directory, options, wipe)) };
+    }
 
-            if (hash.addData(&file)) { return hash.result(); }
-        }
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeWrapper::outputArgs(const Utils::FilePath &cbor_output, bool stream)
+        -> QStringList {
+        auto args = QStringList {};
+
+        // without an output file the script prints the JSON document on stdout
+        if (!cbor_output.isEmpty())
+            args.append(QString { Constants::Introspection::CBOR_ARG } + commandPath(cbor_output));
+        if (stream) args.append(Constants::Introspection::STREAM_ARG);
+
+        return args;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeWrapper::introspectScriptHash() -> const QByteArray & {
+        static const auto hash = [] {
+            auto file = QFile { INTROSPECT_SCRIPT_RESOURCE };
+            if (!file.open(QIODevice::ReadOnly)) return QByteArray {};
+
+            return QCryptographicHash::hash(file.readAll(), QCryptographicHash::Sha256);
+        }();
 
-        return {};
+        return hash;
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto extractQrcFileTo(const Utils::FilePath &input, const Utils::FilePath &output) -> void {
-        if (!output.exists() || fileChecksum(input.toString(), QCryptographicHash::Sha256) !=
-                                    fileChecksum(output.toString(), QCryptographicHash::Sha256)) {
+    auto XMakeWrapper::deviceIntrospectScript(const Utils::FilePath &exe) -> QString {
+        if (!exe.needsDevice()) return introspectScript();
+
+        // copied once per device and script version, the name carries the hash
+        static auto deployed = QHash<Utils::FilePath, QString> {};
+
+        const auto device_root = exe.withNewPath("/");
+        if (const auto it = deployed.constFind(device_root); it != std::cend(deployed))
+            return *it;
+
+        const auto dir    = exe.withNewPath(DEVICE_SCRIPT_DIR);
+        const auto script = dir.pathAppended(
+            QString { "introspect-%1.lua" }.arg(QString::fromLatin1(
+                introspectScriptHash().toHex().left(16))));
+
+        if (!script.exists()) {
             qCDebug(xmake_xmake_wrapper_log)
-                << QString { "Extracting %1 to %2" }.arg(input.toUserOutput(),
-                                                         output.toUserOutput());
-
-            if (output.exists()) {
-                if (!output.removeFile()) {
-                    qCWarning(xmake_xmake_wrapper_log())
-                        << QString { "Failed to remove %1" }.arg(output.toUserOutput());
-                }
+                << QString { "Copying the introspection script to %1" }.arg(script.toUserOutput());
+
+            if (!dir.exists()) dir.createDir();
+            if (!Utils::FilePath::fromString(introspectScript()).copyFile(script)) {
+                qCWarning(xmake_xmake_wrapper_log)
+                    << QString { "Failed to copy the introspection script to %1" }.arg(
+                           script.toUserOutput());
+                return script.path();
             }
-
-            if (input.copyFile(output))
-                qCDebug(xmake_xmake_wrapper_log)
-                    << QString { "Failed to extract %1" }.arg(input.toUserOutput());
         }
+
+        return *deployed.insert(device_root, script.path());
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeWrapper::decompressIntrospectLuaIfNot() -> QString {
-        auto dir = Core::ICore::cacheResourcePath("xmake-introspect-files");
-        if (!dir.exists()) dir.createDir();
+    auto XMakeWrapper::introspectScript() -> const QString & {
+        // checked once per session, the hash of the extracted resource is kept next to it so
+        // the file on disk never has to be read back
+        static const auto path = [] {
+            auto dir = Core::ICore::cacheResourcePath("xmake-introspect-files");
+            if (!dir.exists()) dir.createDir();
+
+            const auto introspect_path = dir.pathAppended("introspect.lua");
+            const auto hash_path       = dir.pathAppended("introspect.lua.sha256");
+
+            const auto hash = introspectScriptHash().toHex();
+            if (introspect_path.exists() && hash_path.fileContents() == hash)
+                return introspect_path.toString();
+
+            qCDebug(xmake_xmake_wrapper_log)
+                << QString { "Extracting %1 to %2" }.arg(INTROSPECT_SCRIPT_RESOURCE,
+                                                         introspect_path.toUserOutput());
+
+            if (introspect_path.exists() && !introspect_path.removeFile())
+                qCWarning(xmake_xmake_wrapper_log)
+                    << QString { "Failed to remove %1" }.arg(introspect_path.toUserOutput());
+
+            if (!Utils::FilePath::fromString(INTROSPECT_SCRIPT_RESOURCE).copyFile(introspect_path) ||
+                !hash_path.writeFileContents(hash))
+                qCWarning(xmake_xmake_wrapper_log)
+                    << QString { "Failed to extract %1" }.arg(INTROSPECT_SCRIPT_RESOURCE);
 
-        auto introspect_path = dir.pathAppended("introspect.lua");
-        extractQrcFileTo(":/xmakeproject/assets/introspect.lua", introspect_path);
+            return introspect_path.toString();
+        }();
 
-        return introspect_path.toString();
+        return path;
     }
 } // namespace XMakeProjectManager::Internal
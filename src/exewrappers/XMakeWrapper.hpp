@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <VersionHelper.hpp>
 #include <XMakeProjectConstant.hpp>
 #include <XMakeProjectPlugin.hpp>
 
@@ -14,8 +15,10 @@
 #include <utils/optional.h>
 #include <utils/qtcprocess.h>
 
+#include <QDateTime>
 #include <QFile>
 #include <QFileInfo>
+#include <QFlags>
 #include <QTemporaryFile>
 
 #include <tuple>
@@ -60,6 +63,23 @@ namespace XMakeProjectManager::Internal {
 
     class XMakeWrapper {
       public:
+        enum class Capability {
+            CombinedConfigure = 0x1,
+            Cbor              = 0x2,
+            Server            = 0x4,
+            Stream            = 0x8,
+            FileFlags         = 0x10,
+        };
+        Q_DECLARE_FLAGS(Capabilities, Capability)
+
+        struct Probe {
+            Version version;
+            Capabilities capabilities;
+            QDateTime exe_modified;
+            // false when a run failed or timed out, such a probe is neither kept nor saved
+            bool complete = true;
+        };
+
         XMakeWrapper() = delete;
         XMakeWrapper(QString name,
                      Utils::FilePath path,
@@ -88,24 +108,60 @@ namespace XMakeProjectManager::Internal {
         bool autorun() const noexcept;
         bool autoAcceptRequests() const noexcept;
 
+        const Version &version() const noexcept;
+        bool hasCapability(Capability capability) const noexcept;
+        bool needsProbe() const;
+        const Utils::optional<Probe> &lastProbe() const noexcept;
+
         void setName(QString value) noexcept;
         void setExe(Utils::FilePath value);
         void setAutorun(bool value) noexcept;
         void setAutoAcceptRequests(bool value) noexcept;
+        void setProbe(Probe probe);
 
         static Utils::optional<Utils::FilePath> findTool();
+        // executables found in PATH first, then in the usual install directories
+        static Utils::FilePaths toolCandidates();
+
+        static Probe probe(const Utils::FilePath &exe);
 
         Command configure(const Utils::FilePath &source_directory,
                           const Utils::FilePath &build_directory,
                           const QStringList &options = {},
                           bool wipe                  = false) const;
 
-        Command introspect(const Utils::FilePath &source_directory);
+        Command require(const Utils::FilePath &source_directory,
+                        const Utils::FilePath &build_directory) const;
+
+        Command introspect(const Utils::FilePath &source_directory,
+                           const Utils::FilePath &cbor_output,
+                           bool stream,
+                           const QStringList &project_files = {});
+        Command introspectServer(const Utils::FilePath &source_directory,
+                                 const Utils::FilePath &cbor_output,
+                                 bool stream,
+                                 bool lazy_flags = false);
+        Command configureAndIntrospect(const Utils::FilePath &source_directory,
+                                       const Utils::FilePath &build_directory,
+                                       const QStringList &options,
+                                       bool wipe,
+                                       const Utils::FilePath &cbor_output,
+                                       bool stream);
 
         static QString toolName();
 
+        static const QString &introspectScript();
+        static const QByteArray &introspectScriptHash();
+
       private:
-        QString decompressIntrospectLuaIfNot();
+        QStringList configureOptions(const Utils::FilePath &build_directory,
+                                     const QStringList &options,
+                                     bool wipe) const;
+
+        static QStringList outputArgs(const Utils::FilePath &cbor_output, bool stream);
+
+        // the script as seen by the executable, copied to its device when it isn't local
+        static QString deviceIntrospectScript(const Utils::FilePath &exe);
 
         bool m_is_valid;
         bool m_autodetected;
@@ -115,8 +171,12 @@ namespace XMakeProjectManager::Internal {
 
         bool m_autorun;
         bool m_auto_accept_requests;
+
+        Utils::optional<Probe> m_probe;
     };
 
+    Q_DECLARE_OPERATORS_FOR_FLAGS(XMakeWrapper::Capabilities)
+
     QVariantMap toVariantMap(const XMakeWrapper &xmake);
     XMakeWrapper *fromVariantMap(const QVariantMap &data);
 } // namespace XMakeProjectManager::Internal
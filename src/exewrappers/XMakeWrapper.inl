@@ -117,6 +117,31 @@ namespace XMakeProjectManager::Internal {
         return m_auto_accept_requests;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeWrapper::version() const noexcept -> const Version & {
+        static const auto unknown = Version {};
+
+        return m_probe ? m_probe->version : unknown;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeWrapper::hasCapability(Capability capability) const noexcept -> bool {
+        // until the probe answers every mode is allowed, a failing one falls back on its own
+        return !m_probe || m_probe->capabilities.testFlag(capability);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeWrapper::lastProbe() const noexcept -> const Utils::optional<Probe> & {
+        return m_probe;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeWrapper::setProbe(Probe probe) -> void { m_probe = std::move(probe); }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     inline auto XMakeWrapper::setName(QString value) noexcept -> void { m_name = std::move(value); }
@@ -150,18 +175,42 @@ namespace XMakeProjectManager::Internal {
         data.insert(QLatin1String { Constants::ToolsSettings::AUTO_ACCEPT_REQUESTS_KEY },
                     xmake.autoAcceptRequests());
 
+        // the probe is only trusted again while the executable keeps its modification time
+        if (const auto &probe = xmake.lastProbe()) {
+            data.insert(QLatin1String { Constants::ToolsSettings::VERSION_KEY },
+                        probe->version.toQString());
+            data.insert(QLatin1String { Constants::ToolsSettings::CAPABILITIES_KEY },
+                        static_cast<int>(probe->capabilities));
+            data.insert(QLatin1String { Constants::ToolsSettings::EXE_MODIFIED_KEY },
+                        probe->exe_modified);
+        }
+
         return data;
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     inline auto fromVariantMap(const QVariantMap &data) -> XMakeWrapper * {
-        return new XMakeWrapper(
+        auto xmake = new XMakeWrapper(
             data[QLatin1String { Constants::ToolsSettings::NAME_KEY }].toString(),
             Utils::FilePath::fromVariant(data[QLatin1String { Constants::ToolsSettings::EXE_KEY }]),
             Utils::Id::fromSetting(data[QLatin1String { Constants::ToolsSettings::UUID_KEY }]),
             data[QLatin1String { Constants::ToolsSettings::AUTODETECTED_KEY }].toBool(),
             data[QLatin1String { Constants::ToolsSettings::AUTORUN_KEY }].toBool(),
             data[QLatin1String { Constants::ToolsSettings::AUTO_ACCEPT_REQUESTS_KEY }].toBool());
+
+        const auto exe_modified =
+            data.value(QLatin1String { Constants::ToolsSettings::EXE_MODIFIED_KEY }).toDateTime();
+        if (exe_modified.isValid() &&
+            data.contains(QLatin1String { Constants::ToolsSettings::CAPABILITIES_KEY }))
+            xmake->setProbe({ Version::fromString(
+                                  data[QLatin1String { Constants::ToolsSettings::VERSION_KEY }]
+                                      .toString()),
+                              XMakeWrapper::Capabilities::fromInt(
+                                  data[QLatin1String { Constants::ToolsSettings::CAPABILITIES_KEY }]
+                                      .toInt()),
+                              exe_modified });
+
+        return xmake;
     }
 } // namespace XMakeProjectManager::Internal
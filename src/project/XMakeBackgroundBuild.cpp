@@ -0,0 +1,232 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeBackgroundBuild.hpp"
+
+#include <project/XMakeBuildSystem.hpp>
+#include <project/XMakeMimeTypeCache.hpp>
+#include <project/parsers/XMakeBuildParser.hpp>
+
+#include <settings/general/Settings.hpp>
+
+#include <settings/tools/kitaspect/XMakeToolKitAspect.hpp>
+
+#include <coreplugin/editormanager/editormanager.h>
+#include <coreplugin/idocument.h>
+
+#include <projectexplorer/buildconfiguration.h>
+#include <projectexplorer/buildmanager.h>
+#include <projectexplorer/kit.h>
+#include <projectexplorer/project.h>
+#include <projectexplorer/projectexplorerconstants.h>
+#include <projectexplorer/taskhub.h>
+
+#include <utils/outputformatter.h>
+#include <utils/qtcprocess.h>
+
+#include <QLoggingCategory>
+
+#include <utility>
+
+namespace XMakeProjectManager::Internal {
+    static Q_LOGGING_CATEGORY(xmake_background_build_log, "qtc.xmake.backgroundbuild", QtDebugMsg);
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeBackgroundBuild::XMakeBackgroundBuild(XMakeBuildSystem *build_system)
+        : m_build_system { build_system } {
+        connect(Core::EditorManager::instance(),
+                &Core::EditorManager::saved,
+                this,
+                &XMakeBackgroundBuild::documentSaved);
+
+        // the parsers submit the tasks to the hub, the ones of the running compilation are kept
+        // to be replaced by the next compilation of the file
+        connect(ProjectExplorer::TaskHub::instance(),
+                &ProjectExplorer::TaskHub::taskAdded,
+                this,
+                [this](const ProjectExplorer::Task &task) {
+                    if (m_collecting &&
+                        task.category == ProjectExplorer::Constants::TASK_CATEGORY_COMPILE)
+                        m_tasks[m_file].append(task);
+                });
+
+        // a build compiles the file too and clears the compile tasks when it starts
+        connect(ProjectExplorer::BuildManager::instance(),
+                &ProjectExplorer::BuildManager::buildStateChanged,
+                this,
+                [this](ProjectExplorer::Project *project) {
+                    if (project != m_build_system->project() ||
+                        !ProjectExplorer::BuildManager::isBuilding(project))
+                        return;
+
+                    stop();
+                    m_tasks.clear();
+                });
+
+        connect(ProjectExplorer::BuildManager::instance(),
+                &ProjectExplorer::BuildManager::buildQueueFinished,
+                this,
+                [this](bool success) {
+                    if (!m_pending_build) return;
+
+                    const auto target_names = std::exchange(m_pending_build, Utils::nullopt);
+                    if (success) start(QStringList { "b" } + *target_names, {});
+                });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeBackgroundBuild::~XMakeBackgroundBuild() { stop(); }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundBuild::compile(const Utils::FilePath &file, const QString &target_name)
+        -> void {
+        // xmake compiles only the objects of the given files, nothing is linked
+        start({ "b", "--files=" + file.path(), target_name }, file);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundBuild::build(const QStringList &target_names) -> void {
+        // the launched target runs first, the queue is still busy with its build
+        if (ProjectExplorer::BuildManager::isBuilding(m_build_system->project())) {
+            m_pending_build = target_names;
+            return;
+        }
+
+        start(QStringList { "b" } + target_names, {});
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundBuild::start(const QStringList &args, const Utils::FilePath &file)
+        -> void {
+        stop();
+
+        const auto *build_configuration = m_build_system->buildConfiguration();
+        auto *kit                       = build_configuration->kit();
+
+        const auto tool = XMakeToolKitAspect::xmakeTool(kit);
+        if (!tool) return;
+
+        removeTasks(file);
+
+        const auto project_dir = m_build_system->project()->projectDirectory();
+        const auto command     = Utils::CommandLine { tool->exe(), args };
+
+        auto env = build_configuration->environment();
+        env.setupEnglishOutput();
+        env.appendOrSet("XMAKE_CONFIGDIR", build_configuration->buildDirectory().nativePath());
+        env.appendOrSet("XMAKE_THEME", "plain");
+
+        auto *xmake_parser = new XMakeBuildParser { XMakeBuildParser::typeForKit(kit) };
+        xmake_parser->setSourceDirectory(project_dir);
+
+        auto parsers = QList<Utils::OutputLineParser *> { xmake_parser };
+        for (auto *parser : kit->createOutputParsers()) {
+            parser->setRedirectionDetector(xmake_parser);
+            parsers.append(parser);
+        }
+
+        for (auto *parser : parsers)
+            if (auto *task_parser = qobject_cast<ProjectExplorer::OutputTaskParser *>(parser))
+                connect(task_parser,
+                        &ProjectExplorer::OutputTaskParser::newTask,
+                        this,
+                        [](const ProjectExplorer::Task &task) {
+                            ProjectExplorer::TaskHub::addTask(task);
+                        });
+
+        m_formatter = std::make_unique<Utils::OutputFormatter>();
+        m_formatter->setLineParsers(parsers);
+        m_formatter->addSearchDir(project_dir);
+
+        m_file       = file;
+        m_collecting = true;
+
+        qCDebug(xmake_background_build_log) << "Running" << command.toUserOutput();
+
+        m_process = std::make_unique<Utils::QtcProcess>();
+        m_process->setLowPriority();
+        m_process->setWorkingDirectory(m_build_system->project()->rootProjectDirectory());
+        m_process->setEnvironment(env);
+        m_process->setCommand(command);
+        m_process->setStdOutLineCallback([this](const QString &line) {
+            m_formatter->appendMessage(line, Utils::StdOutFormat);
+        });
+        m_process->setStdErrLineCallback([this](const QString &line) {
+            m_formatter->appendMessage(line, Utils::StdErrFormat);
+        });
+
+        connect(m_process.get(),
+                &Utils::QtcProcess::done,
+                this,
+                &XMakeBackgroundBuild::handleProcessDone);
+
+        m_process->start();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundBuild::stop() -> void {
+        if (!m_process) return;
+
+        qCDebug(xmake_background_build_log) << "Stopping the background build" << m_file;
+
+        m_process->disconnect();
+        m_process->close();
+        m_process.reset();
+
+        m_formatter.reset();
+        m_collecting = false;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundBuild::documentSaved(Core::IDocument *document) -> void {
+        if (!Settings::instance()->compile_on_save.value()) return;
+
+        const auto *build_configuration = m_build_system->buildConfiguration();
+        if (!build_configuration || !build_configuration->isActive()) return;
+
+        // the build has the file in its queue, a parse may change its target
+        if (m_build_system->isParsing() ||
+            ProjectExplorer::BuildManager::isBuilding(m_build_system->project()))
+            return;
+
+        // a save doesn't interrupt the build of the remaining targets
+        if (isRunning() && m_file.isEmpty()) return;
+
+        const auto file = document->filePath();
+        if (XMakeMimeTypeCache::isHeaderOrModule(file.path())) return;
+
+        const auto target_name = m_build_system->targetForSource(file);
+        if (target_name.isEmpty()) return;
+
+        compile(file, target_name);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundBuild::handleProcessDone() -> void {
+        qCDebug(xmake_background_build_log)
+            << "Background build of" << m_file << "exited with" << m_process->exitCode();
+
+        m_process.release()->deleteLater();
+
+        // the batched tasks are submitted before the formatter goes away
+        m_formatter->flush();
+        m_formatter.reset();
+
+        m_collecting = false;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundBuild::removeTasks(const Utils::FilePath &file) -> void {
+        for (const auto &task : m_tasks.take(file)) ProjectExplorer::TaskHub::removeTask(task);
+    }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,76 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <projectexplorer/task.h>
+
+#include <utils/filepath.h>
+#include <utils/optional.h>
+
+#include <QHash>
+#include <QObject>
+
+#include <memory>
+
+namespace Core {
+    class IDocument;
+} // namespace Core
+
+namespace Utils {
+    class OutputFormatter;
+    class QtcProcess;
+} // namespace Utils
+
+namespace XMakeProjectManager::Internal {
+    class XMakeBuildSystem;
+
+    // runs the low priority builds started outside of the build queue: the object file of each
+    // saved source and the targets left once the launched one is built, their diagnostics are
+    // listed in the issues
+    class XMakeBackgroundBuild final: public QObject {
+        Q_OBJECT
+
+      public:
+        explicit XMakeBackgroundBuild(XMakeBuildSystem *build_system);
+        ~XMakeBackgroundBuild() override;
+
+        XMakeBackgroundBuild(XMakeBackgroundBuild &&)      = delete;
+        XMakeBackgroundBuild(const XMakeBackgroundBuild &) = delete;
+
+        XMakeBackgroundBuild &operator=(XMakeBackgroundBuild &&)      = delete;
+        XMakeBackgroundBuild &operator=(const XMakeBackgroundBuild &) = delete;
+
+        // a compilation still running is replaced, the file is older than what was saved
+        void compile(const Utils::FilePath &file, const QString &target_name);
+        // empty builds every target, started once the build queue is over
+        void build(const QStringList &target_names);
+        void stop();
+
+        [[nodiscard]] bool isRunning() const noexcept;
+
+      private:
+        void start(const QStringList &args, const Utils::FilePath &file);
+        void documentSaved(Core::IDocument *document);
+        void handleProcessDone();
+        void removeTasks(const Utils::FilePath &file);
+
+        XMakeBuildSystem *m_build_system;
+
+        std::unique_ptr<Utils::QtcProcess> m_process;
+        std::unique_ptr<Utils::OutputFormatter> m_formatter;
+
+        // empty for a build of targets
+        Utils::FilePath m_file;
+        bool m_collecting = false;
+
+        Utils::optional<QStringList> m_pending_build;
+
+        // tasks of the last compilation of each file, removed when it is compiled again, the
+        // ones of the last build of targets have no file
+        QHash<Utils::FilePath, ProjectExplorer::Tasks> m_tasks;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakeBackgroundBuild.inl"
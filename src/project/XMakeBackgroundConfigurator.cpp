@@ -0,0 +1,266 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeBackgroundConfigurator.hpp"
+
+#include <XMakeProjectConstant.hpp>
+
+#include <exewrappers/XMakeTools.hpp>
+
+#include <project/XMakeDetectionCache.hpp>
+#include <project/XMakeIntrospectionCache.hpp>
+#include <project/XMakeProcessQueue.hpp>
+
+#include <settings/general/Settings.hpp>
+
+#include <xmakeinfoparser/XMakeInfoParser.hpp>
+
+#include <projectexplorer/projectexplorer.h>
+
+#include <utils/qtcprocess.h>
+#include <utils/runextensions.h>
+
+#include <QFile>
+#include <QLoggingCategory>
+#include <QThread>
+
+#include <algorithm>
+
+namespace XMakeProjectManager::Internal {
+    static Q_LOGGING_CATEGORY(xmake_background_configurator_log,
+                              "qtc.xmake.backgroundconfigurator",
+                              QtDebugMsg);
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto configurator() -> std::unique_ptr<XMakeBackgroundConfigurator> & {
+        static auto configurator = std::unique_ptr<XMakeBackgroundConfigurator> {};
+
+        return configurator;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeBackgroundConfigurator::XMakeBackgroundConfigurator() = default;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeBackgroundConfigurator::~XMakeBackgroundConfigurator() {
+        for (auto &run : m_running) {
+            XMakeProcessQueue::instance().release(run->process.get());
+
+            run->process->disconnect();
+            run->process->close();
+        }
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundConfigurator::instance() -> XMakeBackgroundConfigurator & {
+        auto &instance = configurator();
+        if (!instance) instance = std::make_unique<XMakeBackgroundConfigurator>();
+
+        return *instance;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundConfigurator::shutdown() -> void { configurator().reset(); }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundConfigurator::schedule(Job job) -> void {
+        const auto same_dir = [&job](const auto &other) {
+            return other.build_dir == job.build_dir;
+        };
+
+        if (std::any_of(std::cbegin(m_queue), std::cend(m_queue), same_dir)) return;
+        if (std::any_of(std::cbegin(m_running), std::cend(m_running), [&](const auto &run) {
+                return same_dir(run->job);
+            }))
+            return;
+
+        qCDebug(xmake_background_configurator_log)
+            << "Scheduling background configuration of" << job.build_dir;
+
+        m_queue.push_back(std::move(job));
+
+        startNext();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundConfigurator::cancel(const Utils::FilePath &build_dir) -> void {
+        m_queue.erase(std::remove_if(std::begin(m_queue),
+                                     std::end(m_queue),
+                                     [&](const auto &job) { return job.build_dir == build_dir; }),
+                      std::end(m_queue));
+
+        // the build configuration is being loaded in the foreground, both runs would write to the
+        // same xmake config directory
+        auto it = std::find_if(std::begin(m_running), std::end(m_running), [&](const auto &run) {
+            return run->job.build_dir == build_dir;
+        });
+        if (it == std::end(m_running)) return;
+
+        qCDebug(xmake_background_configurator_log)
+            << "Cancelling background configuration of" << build_dir;
+
+        XMakeProcessQueue::instance().release((*it)->process.get());
+
+        (*it)->process->disconnect();
+        (*it)->process->close();
+
+        m_running.erase(it);
+
+        startNext();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundConfigurator::startNext() -> void {
+        const auto max_processes =
+            static_cast<std::size_t>(Settings::instance()->background_configure_jobs.value());
+
+        while (!m_queue.empty() && std::size(m_running) < max_processes) {
+            auto run = std::make_unique<Run>();
+            run->job = std::move(m_queue.front());
+            m_queue.pop_front();
+
+            auto *xmake = XMakeTools::xmakeWrapper(run->job.xmake);
+            if (!xmake || !xmake->isValid()) continue;
+
+            if (const auto output = cborOutput(run->job); output.exists()) output.removeFile();
+
+            auto &job = run->job;
+
+            if (!job.detection_dir.isEmpty())
+                XMakeDetectionCache::seed(job.detection_dir, job.build_dir);
+
+            if (xmake->hasCapability(XMakeWrapper::Capability::CombinedConfigure)) {
+                run->introspecting = true;
+                start(*run,
+                      xmake->configureAndIntrospect(job.source_dir,
+                                                    job.build_dir,
+                                                    job.config_args,
+                                                    false,
+                                                    cborOutput(job),
+                                                    false));
+            } else
+                start(*run, xmake->configure(job.source_dir, job.build_dir, job.config_args));
+
+            m_running.push_back(std::move(run));
+        }
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundConfigurator::start(Run &run, const Command &command) -> void {
+        qCDebug(xmake_background_configurator_log) << "Running" << command.toUserOutput();
+
+        run.process = std::make_unique<Utils::QtcProcess>();
+        run.process->setLowPriority();
+        run.process->setWorkingDirectory(command.workDir());
+        run.process->setEnvironment(run.job.env);
+        run.process->setCommand(command.cmdLine());
+
+        connect(run.process.get(), &Utils::QtcProcess::done, this, [this, run = &run] {
+            processDone(run);
+        });
+
+        // counted with the foreground xmake processes, which go first
+        XMakeProcessQueue::instance().enqueue(run.process.get(),
+                                              run.job.source_dir,
+                                              [process = run.process.get()] { process->start(); });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundConfigurator::processDone(Run *run) -> void {
+        const auto success = run->process->result() == Utils::ProcessResult::FinishedWithSuccess;
+
+        XMakeProcessQueue::instance().release(run->process.get());
+
+        if (!success) {
+            qCDebug(xmake_background_configurator_log)
+                << "Background configuration of" << run->job.build_dir << "failed"
+                << run->process->cleanedStdErr();
+
+            finish(run);
+            return;
+        }
+
+        if (!run->introspecting) {
+            auto *xmake = XMakeTools::xmakeWrapper(run->job.xmake);
+            if (!xmake) {
+                finish(run);
+                return;
+            }
+
+            run->introspecting = true;
+            run->process.release()->deleteLater();
+
+            start(*run, xmake->introspect(run->job.source_dir, cborOutput(run->job), false));
+            return;
+        }
+
+        // the script falls back to JSON on stdout when it can't write the CBOR document
+        auto data = run->process->readAllStandardOutput();
+
+        auto file = QFile { cborOutput(run->job).toString() };
+        if (file.open(QIODevice::ReadOnly)) {
+            data = file.readAll();
+            file.close();
+            file.remove();
+        }
+
+        store(run->job, std::move(data));
+
+        if (!run->job.detection_dir.isEmpty())
+            XMakeDetectionCache::store(run->job.detection_dir, run->job.build_dir);
+
+        finish(run);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundConfigurator::finish(Run *run) -> void {
+        auto it = std::find_if(std::begin(m_running),
+                               std::end(m_running),
+                               [run](const auto &other) { return other.get() == run; });
+
+        if (it != std::end(m_running)) {
+            (*it)->process.release()->deleteLater();
+            m_running.erase(it);
+        }
+
+        startNext();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundConfigurator::store(const Job &job, QByteArray data) -> void {
+        if (!Settings::instance()->introspection_cache.value()) return;
+
+        const auto *xmake = XMakeTools::xmakeWrapper(job.xmake);
+        if (!xmake) return;
+
+        Utils::runAsync(ProjectExplorer::ProjectExplorerPlugin::sharedThreadPool(),
+                        QThread::IdlePriority,
+                        [data      = std::move(data),
+                         cache     = XMakeIntrospectionCache { job.build_dir },
+                         cache_key = XMakeIntrospectionCache::key(xmake->exe(), job.config_args)] {
+                            const auto result = XMakeInfoParser::parse(data);
+                            if (std::empty(result.targets)) return;
+
+                            cache.store(cache_key, data, result.build_system_files);
+                        });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBackgroundConfigurator::cborOutput(const Job &job) -> Utils::FilePath {
+        return job.build_dir.pathAppended(Constants::Introspection::CBOR_OUTPUT);
+    }
+} // namespace XMakeProjectManager::Internal
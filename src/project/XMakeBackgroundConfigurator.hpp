@@ -0,0 +1,73 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <exewrappers/XMakeWrapper.hpp>
+
+#include <utils/environment.h>
+#include <utils/filepath.h>
+#include <utils/id.h>
+
+#include <QObject>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace Utils {
+    class QtcProcess;
+} // namespace Utils
+
+namespace XMakeProjectManager::Internal {
+    // configures and introspects the inactive build configurations at idle priority, the result
+    // is only stored in their introspection snapshot and loaded when they become active
+    class XMakeBackgroundConfigurator final: public QObject {
+        Q_OBJECT
+
+      public:
+        struct Job {
+            Utils::Id xmake;
+            Utils::FilePath source_dir;
+            Utils::FilePath build_dir;
+            QStringList config_args;
+            Utils::Environment env;
+            // empty when the detection results aren't shared
+            Utils::FilePath detection_dir;
+        };
+
+        XMakeBackgroundConfigurator();
+        ~XMakeBackgroundConfigurator() override;
+
+        XMakeBackgroundConfigurator(XMakeBackgroundConfigurator &&)      = delete;
+        XMakeBackgroundConfigurator(const XMakeBackgroundConfigurator &) = delete;
+
+        XMakeBackgroundConfigurator &operator=(XMakeBackgroundConfigurator &&)      = delete;
+        XMakeBackgroundConfigurator &operator=(const XMakeBackgroundConfigurator &) = delete;
+
+        static XMakeBackgroundConfigurator &instance();
+        static void shutdown();
+
+        void schedule(Job job);
+        void cancel(const Utils::FilePath &build_dir);
+
+      private:
+        struct Run {
+            Job job;
+            std::unique_ptr<Utils::QtcProcess> process;
+            bool introspecting = false;
+        };
+
+        void startNext();
+        void start(Run &run, const Command &command);
+        void processDone(Run *run);
+        void finish(Run *run);
+        void store(const Job &job, QByteArray data);
+
+        static Utils::FilePath cborOutput(const Job &job);
+
+        std::deque<Job> m_queue;
+        std::vector<std::unique_ptr<Run>> m_running;
+    };
+} // namespace XMakeProjectManager::Internal
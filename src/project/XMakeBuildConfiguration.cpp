@@ -22,6 +22,9 @@
 #include <projectexplorer/project.h>
 #include <projectexplorer/target.h>
 
+#include <QCryptographicHash>
+#include <QDir>
+
 namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
@@ -30,6 +33,20 @@ namespace XMakeProjectManager::Internal {
         appendInitialBuildStep(Constants::XMAKE_BUILD_STEP_ID);
         appendInitialCleanStep(Constants::XMAKE_BUILD_STEP_ID);
 
+        m_output_dir_aspect = addAspect<Utils::StringAspect>();
+        m_output_dir_aspect->setSettingsKey(Constants::BuildConfiguration::OUTPUT_DIRECTORY_KEY);
+        m_output_dir_aspect->setDisplayStyle(Utils::StringAspect::PathChooserDisplay);
+        m_output_dir_aspect->setExpectedKind(Utils::PathChooser::Directory);
+        m_output_dir_aspect->setLabelText(tr("Build output directory:"));
+        m_output_dir_aspect->setPlaceHolderText(tr("The build directory"));
+        m_output_dir_aspect->setToolTip(
+            tr("A directory on fast storage, such as a tmpfs or a RAM disk, where xmake writes "
+               "the objects and the targets. The configuration stays in the build directory and "
+               "everything is built again when the directory was emptied."));
+        connect(m_output_dir_aspect, &Utils::BaseAspect::changed, this, [this] {
+            if (m_build_system) m_build_system->configure();
+        });
+
         setInitializer([this, target](const auto &info) {
             m_build_type = xmakeBuildType(info.typeName);
 
@@ -44,6 +61,14 @@ namespace XMakeProjectManager::Internal {
                     QString { " --qt=\"%1\"" }.arg(kit_info.qtVersion->prefix().nativePath());
             }
 
+            // set by the project importer for a directory configured outside of Qt Creator
+            const auto import_parameters =
+                info.extraInfo.toMap()
+                    .value(QString::fromLatin1(
+                        Constants::BuildConfiguration::IMPORT_PARAMETERS_KEY))
+                    .toString();
+            if (!import_parameters.isEmpty()) m_parameters += ' ' + import_parameters;
+
             if (info.buildDirectory.isEmpty())
                 setBuildDirectory(shadowBuildDirectory(target->project()->projectFilePath(),
                                                        kit,
@@ -51,6 +76,7 @@ namespace XMakeProjectManager::Internal {
                                                        info.buildType));
 
             m_build_system = std::make_unique<XMakeBuildSystem>(this);
+            if (!import_parameters.isEmpty()) m_build_system->adoptConfiguration();
         });
     }
 
@@ -83,29 +109,44 @@ namespace XMakeProjectManager::Internal {
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeBuildConfiguration::build(const QString &target) -> void {
-        const auto &build_steps = *buildSteps();
-
+    auto XMakeBuildConfiguration::build(const QStringList &targets, const QStringList &files)
+        -> void {
         auto *xmake_build_step = qobject_cast<XMakeBuildStep *>(
             Utils::findOrDefault(buildSteps()->steps(), [](const auto *bs) {
                 return bs->id() == Constants::XMAKE_BUILD_STEP_ID;
             }));
 
-        auto original_build_target = QString {};
+        auto original_build_targets = QStringList {};
         if (xmake_build_step) {
-            original_build_target = xmake_build_step->targetName();
-            xmake_build_step->setBuildTarget(target);
+            original_build_targets = xmake_build_step->targetNames();
+            xmake_build_step->setBuildTargets(targets);
+            xmake_build_step->setBuildFiles(files);
         }
 
+        // the command line is computed when the steps are queued
         ProjectExplorer::BuildManager::buildList(buildSteps());
 
-        if (xmake_build_step) xmake_build_step->setBuildTarget(target);
+        if (xmake_build_step) {
+            xmake_build_step->setBuildTargets(original_build_targets);
+            xmake_build_step->setBuildFiles({});
+        }
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeBuildConfiguration::xmakeConfigArgs() -> QStringList {
-        return Utils::ProcessArgs::splitArgs(m_parameters);
+        auto args = Utils::ProcessArgs::splitArgs(m_parameters);
+
+        const auto *xmake_build_step = qobject_cast<XMakeBuildStep *>(
+            Utils::findOrDefault(buildSteps()->steps(), [](const auto *bs) {
+                return bs->id() == Constants::XMAKE_BUILD_STEP_ID;
+            }));
+        if (xmake_build_step) args += xmake_build_step->configArgs();
+
+        if (const auto output_dir = outputDirectory(); !output_dir.isEmpty())
+            args << "-o" << output_dir.nativePath();
+
+        return args;
     }
 
     ////////////////////////////////////////////////////
@@ -116,6 +157,18 @@ namespace XMakeProjectManager::Internal {
             xmakeBuildTypeName(m_build_type);
         data[QString::fromLatin1(Constants::BuildConfiguration::PARAMETERS_KEY)] = m_parameters;
 
+        auto target_options = QVariantMap {};
+        for (auto it = std::cbegin(m_target_options); it != std::cend(m_target_options); ++it)
+            target_options.insert(
+                it.key(),
+                QVariantMap {
+                    { QString::fromLatin1(Constants::BuildConfiguration::UNITY_BATCH_SIZE_KEY),
+                      it->unity_batch_size },
+                    { QString::fromLatin1(Constants::BuildConfiguration::PRECOMPILED_HEADER_KEY),
+                      it->precompiled_header.toVariant() } });
+        data[QString::fromLatin1(Constants::BuildConfiguration::TARGET_OPTIONS_KEY)] =
+            target_options;
+
         return data;
     }
 
@@ -131,9 +184,124 @@ namespace XMakeProjectManager::Internal {
         m_parameters = map.value(QString::fromLatin1(Constants::BuildConfiguration::PARAMETERS_KEY))
                            .toString();
 
+        const auto target_options =
+            map.value(QString::fromLatin1(Constants::BuildConfiguration::TARGET_OPTIONS_KEY))
+                .toMap();
+        const auto unity_key =
+            QString::fromLatin1(Constants::BuildConfiguration::UNITY_BATCH_SIZE_KEY);
+        const auto pch_key =
+            QString::fromLatin1(Constants::BuildConfiguration::PRECOMPILED_HEADER_KEY);
+
+        for (auto it = std::cbegin(target_options); it != std::cend(target_options); ++it) {
+            const auto values = it->toMap();
+
+            auto options               = XMakeTargetOptions {};
+            options.unity_batch_size   = values.value(unity_key, -1).toInt();
+            options.precompiled_header = Utils::FilePath::fromVariant(values.value(pch_key));
+
+            if (!options.isEmpty()) m_target_options.insert(it.key(), std::move(options));
+        }
+
+        // the build directory may have been wiped since the project was saved
+        writeTargetOptionsFile();
+
         return result;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildConfiguration::setTargetOptions(const QString &target,
+                                                   const XMakeTargetOptions &options) -> void {
+        if (options.isEmpty()) m_target_options.remove(target);
+        else
+            m_target_options.insert(target, options);
+
+        writeTargetOptionsFile();
+        updateCacheAndEmitEnvironmentChanged();
+
+        m_build_system->configure();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildConfiguration::addToEnvironment(Utils::Environment &env) const -> void {
+        if (m_target_options.isEmpty()) return;
+
+        // xmake loads the rc files before the xmake.lua of the project
+        env.appendOrSet("XMAKE_RCFILES",
+                        targetOptionsFile().nativePath(),
+                        QString { QDir::listSeparator() });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildConfiguration::outputDirectory() const -> Utils::FilePath {
+        const auto root = m_output_dir_aspect->filePath();
+        if (root.isEmpty()) return {};
+
+        // the build configurations of every project can share the same fast storage
+        const auto hash = QCryptographicHash::hash(buildDirectory().toString().toUtf8(),
+                                                   QCryptographicHash::Sha1)
+                              .toHex()
+                              .left(8);
+
+        return root.pathAppended(
+            QString { "%1-%2" }.arg(project()->displayName(), QString::fromLatin1(hash)));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildConfiguration::prepareOutputDirectory() const -> bool {
+        const auto output_dir = outputDirectory();
+        if (output_dir.isEmpty()) return false;
+
+        // written once the directory is known to hold the outputs of this build configuration
+        const auto marker = output_dir.pathAppended(QString::fromLatin1(Constants::OUTPUT_MARKER));
+        if (marker.exists()) return false;
+
+        output_dir.ensureWritableDir();
+        marker.writeFileContents(buildDirectory().toString().toUtf8());
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildConfiguration::targetOptionsFile() const -> Utils::FilePath {
+        return buildDirectory().pathAppended(QString::fromLatin1(Constants::TARGET_OPTIONS_FILE));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildConfiguration::writeTargetOptionsFile() const -> void {
+        const auto file = targetOptionsFile();
+
+        if (m_target_options.isEmpty()) {
+            if (file.exists()) file.removeFile();
+            return;
+        }
+
+        // reopening a target scope adds to it, the rest of the target comes from xmake.lua
+        auto script = QStringList { "-- generated by Qt Creator from the build configuration" };
+        for (auto it = std::cbegin(m_target_options); it != std::cend(m_target_options); ++it) {
+            script << QString { "target(\"%1\")" }.arg(it.key());
+
+            if (it->unity_batch_size == 0) script << "    add_rules(\"c++.unity_build\")";
+            else if (it->unity_batch_size > 0)
+                script << QString { "    add_rules(\"c++.unity_build\", {batchsize = %1})" }.arg(
+                    it->unity_batch_size);
+
+            if (!it->precompiled_header.isEmpty())
+                script << QString { "    set_pcxxheader(\"%1\")" }.arg(
+                    it->precompiled_header.toString());
+
+            script << "target_end()";
+        }
+
+        file.parentDir().ensureWritableDir();
+        file.writeFileContents(script.join('\n').toUtf8() + '\n');
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeBuildConfiguration::createConfigWidget() -> ProjectExplorer::NamedWidget * {
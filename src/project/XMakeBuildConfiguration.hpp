@@ -6,6 +6,9 @@
 
 #include <projectexplorer/buildconfiguration.h>
 
+#include <utils/aspects.h>
+
+#include <QMap>
 #include <QString>
 #include <QStringView>
 
@@ -33,6 +36,15 @@ namespace XMakeProjectManager::Internal {
 
     ProjectExplorer::BuildConfiguration::BuildType buildType(XMakeBuildType type);
 
+    // build options of a target kept with the build configuration rather than in xmake.lua
+    struct XMakeTargetOptions {
+        // -1 leaves the unity build as the project sets it, 0 lets xmake pick the batch size
+        int unity_batch_size = -1;
+        Utils::FilePath precompiled_header;
+
+        bool isEmpty() const noexcept;
+    };
+
     class XMakeBuildSystem;
     class XMakeTools;
     class XMakeBuildConfiguration final: public ProjectExplorer::BuildConfiguration {
@@ -48,15 +60,31 @@ namespace XMakeProjectManager::Internal {
 
         ProjectExplorer::BuildSystem *buildSystem() const override;
 
-        void build(const QString &target);
+        void build(const QStringList &targets, const QStringList &files = {});
 
         QStringList xmakeConfigArgs();
 
         QStringView parameters() const noexcept;
 
+        XMakeBuildType xmakeType() const noexcept;
+
         void setParameters(const QString &params);
         void addParameters(const QString &params);
 
+        XMakeTargetOptions targetOptions(const QString &target) const;
+        // reconfigures the project with the new options
+        void setTargetOptions(const QString &target, const XMakeTargetOptions &options);
+
+        void addToEnvironment(Utils::Environment &env) const override;
+
+        // xmake writes the objects, the dependency files and the targets there rather than in
+        // the build directory, which keeps the configuration, empty when not set
+        Utils::FilePath outputDirectory() const;
+        Utils::StringAspect *outputDirectoryAspect() const noexcept;
+        // true when the output directory was emptied since the last build, a tmpfs or a RAM
+        // disk doesn't survive a reboot
+        bool prepareOutputDirectory() const;
+
       Q_SIGNALS:
         void parametersChanged();
 
@@ -69,9 +97,16 @@ namespace XMakeProjectManager::Internal {
 
         ProjectExplorer::NamedWidget *createConfigWidget() override;
 
+        Utils::FilePath targetOptionsFile() const;
+        void writeTargetOptionsFile() const;
+
         std::unique_ptr<XMakeBuildSystem> m_build_system;
 
         QString m_parameters;
+
+        Utils::StringAspect *m_output_dir_aspect;
+
+        QMap<QString, XMakeTargetOptions> m_target_options;
     };
 
     class XMakeBuildConfigurationFactory final: public ProjectExplorer::BuildConfigurationFactory {
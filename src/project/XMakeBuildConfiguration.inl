@@ -64,12 +64,38 @@ namespace XMakeProjectManager::Internal {
         }
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeTargetOptions::isEmpty() const noexcept -> bool {
+        return unity_batch_size < 0 && precompiled_header.isEmpty();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildConfiguration::targetOptions(const QString &target) const
+        -> XMakeTargetOptions {
+        return m_target_options.value(target);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildConfiguration::xmakeType() const noexcept -> XMakeBuildType {
+        return m_build_type;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     inline auto XMakeBuildConfiguration::parameters() const noexcept -> QStringView {
         return m_parameters;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildConfiguration::outputDirectoryAspect() const noexcept
+        -> Utils::StringAspect * {
+        return m_output_dir_aspect;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     inline auto XMakeBuildConfiguration::setParameters(const QString &params) -> void {
@@ -0,0 +1,224 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeBuildMatrix.hpp"
+
+#include <XMakeProjectConstant.hpp>
+
+#include <project/XMakeBuildConfiguration.hpp>
+#include <project/XMakeProcessQueue.hpp>
+
+#include <settings/tools/kitaspect/XMakeToolKitAspect.hpp>
+
+#include <coreplugin/progressmanager/progressmanager.h>
+
+#include <projectexplorer/buildsystem.h>
+#include <projectexplorer/project.h>
+
+#include <utils/qtcprocess.h>
+#include <utils/stringutils.h>
+
+#include <QLoggingCategory>
+#include <QThread>
+
+#include <algorithm>
+
+namespace XMakeProjectManager::Internal {
+    static Q_LOGGING_CATEGORY(xmake_build_matrix_log, "qtc.xmake.buildmatrix", QtDebugMsg);
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeBuildMatrix::XMakeBuildMatrix() = default;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeBuildMatrix::~XMakeBuildMatrix() { cancel(); }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildMatrix::start(const QList<XMakeBuildConfiguration *> &configurations, int jobs)
+        -> void {
+        QTC_ASSERT(!isRunning(), return );
+        if (configurations.isEmpty()) return;
+
+        m_runs.clear();
+
+        const auto budget = (jobs > 0) ? jobs : QThread::idealThreadCount();
+        const auto count  = static_cast<int>(configurations.size());
+
+        ProjectExplorer::BuildSystem::startNewBuildSystemOutput(
+            tr("Building %1 configurations with %2 jobs.").arg(count).arg(budget));
+
+        for (auto i = 0; i < count; ++i) {
+            auto *configuration = configurations[i];
+
+            const auto *xmake = XMakeToolKitAspect::xmakeTool(configuration->kit());
+            if (!xmake || !xmake->isValid()) {
+                ProjectExplorer::BuildSystem::appendBuildSystemOutput(
+                    tr("[%1] No valid xmake tool in the kit, skipped.")
+                        .arg(configuration->displayName()));
+                continue;
+            }
+
+            // the remainder of the budget goes to the first configurations
+            const auto run_jobs = std::max(1, budget / count + ((i < budget % count) ? 1 : 0));
+
+            const auto source_dir = configuration->project()->projectDirectory();
+            const auto build_dir  = configuration->buildDirectory();
+
+            auto run  = std::make_unique<Run>();
+            run->name = configuration->displayName();
+
+            run->env = configuration->environment();
+            run->env.setupEnglishOutput();
+            run->env.appendOrSet("XMAKE_PROJECTDIR", source_dir.nativePath());
+            run->env.appendOrSet("XMAKE_CONFIGDIR", build_dir.nativePath());
+            run->env.appendOrSet("XMAKE_THEME", "plain");
+
+            // the configurations never loaded in the foreground aren't configured yet
+            if (!isSetup(build_dir))
+                run->commands.push_back(
+                    xmake->configure(source_dir, build_dir, configuration->xmakeConfigArgs()));
+
+            run->commands.push_back(
+                { xmake->exe(), source_dir, { "b", "-j", QString::number(run_jobs) } });
+
+            std::reverse(std::begin(run->commands), std::end(run->commands));
+
+            m_runs.push_back(std::move(run));
+        }
+
+        if (m_runs.empty()) {
+            Q_EMIT finished(false);
+            return;
+        }
+
+        m_future_interface = QFutureInterface<void>();
+        m_future_interface.setProgressRange(0, static_cast<int>(std::size(m_runs)));
+        m_future_interface.reportStarted();
+
+        Core::ProgressManager::addTask(m_future_interface.future(),
+                                       tr("Building the build matrix"),
+                                       "XMake.BuildMatrix");
+
+        m_future_watcher = std::make_unique<QFutureWatcher<void>>();
+        connect(m_future_watcher.get(),
+                &QFutureWatcher<void>::canceled,
+                this,
+                &XMakeBuildMatrix::cancel);
+        m_future_watcher->setFuture(m_future_interface.future());
+
+        m_running = static_cast<int>(std::size(m_runs));
+        for (auto &run : m_runs) {
+            run->elapsed.start();
+            startNext(*run);
+        }
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildMatrix::cancel() -> void {
+        if (!isRunning()) return;
+
+        for (auto &run : m_runs) {
+            if (!run->process) continue;
+
+            XMakeProcessQueue::instance().release(run->process.get());
+
+            run->process->disconnect();
+            run->process->close();
+            run->process.reset();
+
+            ProjectExplorer::BuildSystem::appendBuildSystemOutput(
+                tr("[%1] Canceled.").arg(run->name));
+        }
+
+        m_running = 0;
+
+        m_future_watcher.reset();
+        m_future_interface.reportCanceled();
+        m_future_interface.reportFinished();
+
+        Q_EMIT finished(false);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildMatrix::startNext(Run &run) -> void {
+        const auto command = std::move(run.commands.back());
+        run.commands.pop_back();
+
+        qCDebug(xmake_build_matrix_log) << run.name << "running" << command.toUserOutput();
+
+        ProjectExplorer::BuildSystem::appendBuildSystemOutput(
+            tr("[%1] Running %2").arg(run.name, command.toUserOutput()));
+
+        run.process = std::make_unique<Utils::QtcProcess>();
+        run.process->setLowPriority();
+        run.process->setWorkingDirectory(command.workDir());
+        run.process->setEnvironment(run.env);
+        run.process->setCommand(command.cmdLine());
+
+        // every line is labelled, the outputs of the configurations are interleaved
+        const auto label = [name = run.name](const QString &line) {
+            ProjectExplorer::BuildSystem::appendBuildSystemOutput(
+                QString { "[%1] %2" }.arg(name, line.trimmed()));
+        };
+        run.process->setStdOutLineCallback(label);
+        run.process->setStdErrLineCallback(label);
+
+        connect(run.process.get(), &Utils::QtcProcess::done, this, [this, run = &run] {
+            processDone(*run);
+        });
+
+        XMakeProcessQueue::instance().enqueue(run.process.get(),
+                                              command.workDir(),
+                                              [process = run.process.get()] { process->start(); });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildMatrix::processDone(Run &run) -> void {
+        run.success = run.process->result() == Utils::ProcessResult::FinishedWithSuccess;
+
+        XMakeProcessQueue::instance().release(run.process.get());
+        run.process.release()->deleteLater();
+
+        if (run.success && !run.commands.empty()) {
+            startNext(run);
+            return;
+        }
+
+        ProjectExplorer::BuildSystem::appendBuildSystemOutput(
+            (run.success ? tr("[%1] Succeeded, %2.") : tr("[%1] Failed, %2."))
+                .arg(run.name, Utils::formatElapsedTime(run.elapsed.elapsed()).trimmed()));
+
+        m_future_interface.setProgressValue(m_future_interface.progressValue() + 1);
+
+        if (--m_running == 0) finish();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildMatrix::finish() -> void {
+        const auto success = std::all_of(std::cbegin(m_runs),
+                                         std::cend(m_runs),
+                                         [](const auto &run) { return run->success; });
+
+        auto summary = QStringList {};
+        for (const auto &run : m_runs)
+            summary.append(QString { "%1: %2" }.arg(run->name,
+                                                    run->success ? tr("succeeded")
+                                                                 : tr("failed")));
+
+        ProjectExplorer::BuildSystem::appendBuildSystemOutput(
+            tr("Build matrix finished, %1.").arg(summary.join(", ")));
+
+        m_future_watcher.reset();
+        if (!success) m_future_interface.reportCanceled();
+        m_future_interface.reportFinished();
+
+        Q_EMIT finished(success);
+    }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,72 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <exewrappers/XMakeWrapper.hpp>
+
+#include <utils/environment.h>
+
+#include <QElapsedTimer>
+#include <QFutureInterface>
+#include <QFutureWatcher>
+#include <QObject>
+
+#include <memory>
+#include <vector>
+
+namespace Utils {
+    class QtcProcess;
+} // namespace Utils
+
+namespace XMakeProjectManager::Internal {
+    class XMakeBuildConfiguration;
+
+    // builds several build configurations of a project at the same time, each one in its own
+    // xmake config directory, the jobs budget is shared between them
+    class XMakeBuildMatrix final: public QObject {
+        Q_OBJECT
+
+      public:
+        XMakeBuildMatrix();
+        ~XMakeBuildMatrix() override;
+
+        XMakeBuildMatrix(XMakeBuildMatrix &&)      = delete;
+        XMakeBuildMatrix(const XMakeBuildMatrix &) = delete;
+
+        XMakeBuildMatrix &operator=(XMakeBuildMatrix &&)      = delete;
+        XMakeBuildMatrix &operator=(const XMakeBuildMatrix &) = delete;
+
+        // 0 jobs uses the number of cores
+        void start(const QList<XMakeBuildConfiguration *> &configurations, int jobs = 0);
+        void cancel();
+
+        bool isRunning() const noexcept;
+
+      Q_SIGNALS:
+        void finished(bool success);
+
+      private:
+        struct Run {
+            QString name;
+            Utils::Environment env;
+            std::vector<Command> commands;
+            std::unique_ptr<Utils::QtcProcess> process;
+            QElapsedTimer elapsed;
+            bool success = false;
+        };
+
+        void startNext(Run &run);
+        void processDone(Run &run);
+        void finish();
+
+        std::vector<std::unique_ptr<Run>> m_runs;
+        int m_running = 0;
+
+        QFutureInterface<void> m_future_interface;
+        std::unique_ptr<QFutureWatcher<void>> m_future_watcher;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakeBuildMatrix.inl"
@@ -0,0 +1,11 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildMatrix::isRunning() const noexcept -> bool { return m_running > 0; }
+} // namespace XMakeProjectManager::Internal
@@ -9,42 +9,101 @@
 #include <project/XMakeBuildSystem.hpp>
 #include <project/XMakeProject.hpp>
 #include <project/parsers/XMakeBuildParser.hpp>
+#include <project/parsers/XMakeTimeTraces.hpp>
 
 #include <coreplugin/find/itemviewfind.h>
+#include <coreplugin/messagemanager.h>
 
+#include <settings/general/Settings.hpp>
 #include <settings/tools/kitaspect/XMakeToolKitAspect.hpp>
 
 #include <qtsupport/qtcppkitinfo.h>
 
 #include <projectexplorer/buildsteplist.h>
 #include <projectexplorer/processparameters.h>
+#include <projectexplorer/runconfiguration.h>
+#include <projectexplorer/projectexplorer.h>
 #include <projectexplorer/projectexplorerconstants.h>
 #include <projectexplorer/target.h>
+#include <projectexplorer/taskhub.h>
 
 #include <utils/commandline.h>
+#include <utils/runextensions.h>
 
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDir>
 #include <QFormLayout>
 #include <QListWidget>
-#include <QRadioButton>
+#include <QSignalBlocker>
+#include <QSpinBox>
+#include <QThread>
+
+#include <algorithm>
+#include <utility>
 
 namespace XMakeProjectManager::Internal {
+    static constexpr auto TIME_TRACE_REPORT_SIZE = 20;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto isSpecialTarget(const QString &target) -> bool {
+        return target == QString::fromLatin1(Constants::Targets::ALL) ||
+               target == QString::fromLatin1(Constants::Targets::CLEAN);
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     XMakeBuildStep::XMakeBuildStep(ProjectExplorer::BuildStepList *bsl, Utils::Id id)
         : ProjectExplorer::AbstractProcessStep { bsl, id } {
-        if (m_target_name.isEmpty()) setBuildTarget(defaultBuildTarget());
+        if (m_target_names.isEmpty()) setBuildTarget(defaultBuildTarget());
 
         setLowPriority();
 
-        setCommandLineProvider([this] { return command(); });
+        setCommandLineProvider([this] { return command(m_run_target_names, m_run_files); });
         setEnvironmentModifier([this](Utils::Environment &env) {
             env.setupEnglishOutput();
             env.appendOrSet("XMAKE_CONFIGDIR", buildDirectory().nativePath());
             env.appendOrSet("XMAKE_THEME", "plain");
+
+            // ccache logs the result of every compilation, read back for the cache statistics
+            if (m_ccache) env.set("CCACHE_STATSLOG", ccacheStatsLog().nativePath());
         });
         setWorkingDirectoryProvider([this] { return project()->rootProjectDirectory(); });
 
         connect(target(), &ProjectExplorer::Target::parsingFinished, this, &XMakeBuildStep::update);
+
+        connect(this, &ProjectExplorer::BuildStep::finished, this, [this](auto success) {
+            // a failed build leaves targets to rebuild, keep comparing with the last good one
+            if (success && m_run_started.isValid()) {
+                m_last_full_build = m_run_started;
+
+                if (auto *build_system = qobject_cast<XMakeBuildSystem *>(buildSystem()))
+                    build_system->recordBuildInputs(m_last_full_build);
+            }
+
+            m_run_started = {};
+
+            m_diagnostics.finish();
+
+            if (success && !m_run_target.isEmpty() && m_run_target_mode == RunTargetMode::First) {
+                const auto builds_all =
+                    m_run_target_names.contains(QString::fromLatin1(Constants::Targets::ALL));
+                const auto remaining = remainingTargets();
+                auto *build_system   = qobject_cast<XMakeBuildSystem *>(buildSystem());
+
+                if (build_system && (builds_all || !remaining.isEmpty()))
+                    build_system->buildInBackground(remaining);
+            }
+            m_run_target.clear();
+
+            if (success && std::exchange(m_start_watch, false))
+                if (auto *build_system = qobject_cast<XMakeBuildSystem *>(buildSystem()))
+                    build_system->watch().start(watchedTargets());
+
+            if (success && m_time_trace) reportCompileTimes();
+            m_affected_targets.clear();
+        });
     }
 
     ////////////////////////////////////////////////////
@@ -61,6 +120,70 @@ namespace XMakeProjectManager::Internal {
         auto tool_arguments = new QLineEdit { widget };
         tool_arguments->setText(m_command_args);
 
+        auto jobs = new QSpinBox { widget };
+        jobs->setRange(0, 1024);
+        jobs->setSpecialValueText(tr("Default"));
+        jobs->setValue(m_jobs);
+
+        auto affected_only =
+            new QCheckBox { tr("Only build the targets affected by changed files"), widget };
+        affected_only->setToolTip(
+            tr("When building all targets, only pass to xmake the targets with files modified "
+               "since the last successful build, and the targets depending on them."));
+        affected_only->setChecked(m_affected_only);
+
+        auto skip_up_to_date =
+            new QCheckBox { tr("Skip the build when the targets are up to date"), widget };
+        skip_up_to_date->setToolTip(
+            tr("Don't run xmake when the outputs of the targets are newer than their inputs and "
+               "nothing changed since the last successful build."));
+        skip_up_to_date->setChecked(m_skip_up_to_date);
+
+        auto quiet_output = new QCheckBox { tr("Collapse the progress lines"), widget };
+        quiet_output->setToolTip(
+            tr("Only shows the diagnostics in the compile output, the job xmake runs is shown "
+               "in the progress details and the complete output is written to %1 in the build "
+               "directory.")
+                .arg(QString::fromLatin1(Constants::BUILD_LOG)));
+        quiet_output->setChecked(m_quiet_output);
+
+        auto watch = new QCheckBox { tr("Keep the targets built with xmake watch"), widget };
+        watch->setToolTip(
+            tr("After a successful build, xmake watch rebuilds the targets each time a file "
+               "changes and reports its diagnostics in the issues. The next builds don't start "
+               "xmake, they wait for the running rebuild and report its result."));
+        watch->setChecked(m_watch);
+
+        auto run_target_mode = new QComboBox { widget };
+        run_target_mode->addItem(tr("Build the selected targets"),
+                                 static_cast<int>(RunTargetMode::Off));
+        run_target_mode->addItem(tr("Build it first, the others in the background"),
+                                 static_cast<int>(RunTargetMode::First));
+        run_target_mode->addItem(tr("Only build it"), static_cast<int>(RunTargetMode::Only));
+        run_target_mode->setToolTip(
+            tr("Builds the target of the active run configuration and its dependencies, so that "
+               "it starts without waiting for the unrelated targets."));
+        run_target_mode->setCurrentIndex(
+            run_target_mode->findData(static_cast<int>(m_run_target_mode)));
+
+        auto compiler_cache = new QCheckBox { tr("Use the compiler cache"), widget };
+        compiler_cache->setToolTip(tr("Applied the next time the project is configured."));
+        compiler_cache->setChecked(m_ccache);
+
+        auto structured_diagnostics =
+            new QCheckBox { tr("Read structured compiler diagnostics"), widget };
+        structured_diagnostics->setToolTip(
+            tr("Has the compiler write its diagnostics as JSON or SARIF documents. Needs GCC 10, "
+               "Clang 15 or MSVC 17.8, applied the next time the project is configured."));
+        structured_diagnostics->setChecked(m_structured_diagnostics);
+
+        auto time_trace = new QCheckBox { tr("Trace compile times"), widget };
+        time_trace->setToolTip(
+            tr("Reports the headers and the template instantiations taking the most time to "
+               "compile after each build. Needs Clang, applied the next time the project is "
+               "configured."));
+        time_trace->setChecked(m_time_trace);
+
         auto wrapper =
             Core::ItemViewFind::createSearchableWrapper(build_targets_list,
                                                         Core::ItemViewFind::LightColored);
@@ -69,37 +192,49 @@ namespace XMakeProjectManager::Internal {
         form_layout->setFieldGrowthPolicy(QFormLayout::ExpandingFieldsGrow);
         form_layout->setContentsMargins(0, 0, 0, 0);
         form_layout->addRow(tr("Tool arguments:"), tool_arguments);
+        form_layout->addRow(tr("Parallel jobs:"), jobs);
+        form_layout->addRow(tr("Launched target:"), run_target_mode);
+        form_layout->addRow(QString {}, compiler_cache);
+        form_layout->addRow(QString {}, structured_diagnostics);
+        form_layout->addRow(QString {}, time_trace);
+        form_layout->addRow(QString {}, affected_only);
+        form_layout->addRow(QString {}, skip_up_to_date);
+        form_layout->addRow(QString {}, quiet_output);
+        form_layout->addRow(QString {}, watch);
         form_layout->addRow(tr("Targets:"), wrapper);
 
         auto update_details = [this] {
             auto param = ProjectExplorer::ProcessParameters {};
             setupProcessParameters(&param);
+            // the provider gives the command of the queued build
+            param.setCommandLine(command());
             setSummaryText(param.summary(displayName()));
         };
 
-        auto update_target_list = [this, build_targets_list, update_details] {
-            build_targets_list->clear();
+        auto update_checked_targets = [this, build_targets_list] {
+            const auto blocker = QSignalBlocker { build_targets_list };
 
-            for (const auto &target : projectTargets()) {
-                auto item   = new QListWidgetItem { build_targets_list };
-                auto button = new QRadioButton { target };
+            for (auto i = 0; i < build_targets_list->count(); ++i) {
+                auto *item         = build_targets_list->item(i);
+                const auto checked = targetNames().contains(item->data(Qt::UserRole).toString());
 
-                connect(button,
-                        &QRadioButton::toggled,
-                        this,
-                        [this, target, update_details](auto toggled) {
-                            if (!toggled) return;
+                item->setCheckState(checked ? Qt::Checked : Qt::Unchecked);
+            }
+        };
 
-                            setBuildTarget(target);
-                            update_details();
-                        });
+        auto update_target_list = [this, build_targets_list, update_checked_targets] {
+            const auto blocker = QSignalBlocker { build_targets_list };
 
-                button->setChecked(targetName() == target);
+            build_targets_list->clear();
 
-                build_targets_list->setItemWidget(item, button);
+            for (const auto &target : projectTargets()) {
+                auto item = new QListWidgetItem { target, build_targets_list };
 
+                item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
                 item->setData(Qt::UserRole, target);
             }
+
+            update_checked_targets();
         };
 
         update_details();
@@ -117,13 +252,60 @@ namespace XMakeProjectManager::Internal {
                     update_details();
                 });
 
+        connect(jobs,
+                QOverload<int>::of(&QSpinBox::valueChanged),
+                this,
+                [this, update_details](auto value) {
+                    setJobs(value);
+                    update_details();
+                });
+
+        connect(compiler_cache, &QCheckBox::toggled, this, &XMakeBuildStep::setUseCompilerCache);
+        connect(structured_diagnostics,
+                &QCheckBox::toggled,
+                this,
+                &XMakeBuildStep::setStructuredDiagnostics);
+        connect(time_trace, &QCheckBox::toggled, this, &XMakeBuildStep::setTraceCompileTimes);
+        connect(affected_only, &QCheckBox::toggled, this, &XMakeBuildStep::setAffectedTargetsOnly);
+        connect(skip_up_to_date, &QCheckBox::toggled, this, &XMakeBuildStep::setSkipUpToDate);
+        connect(quiet_output, &QCheckBox::toggled, this, &XMakeBuildStep::setQuietOutput);
+        connect(watch, &QCheckBox::toggled, this, [this](auto checked) {
+            setWatchChanges(checked);
+
+            if (auto *build_system = qobject_cast<XMakeBuildSystem *>(buildSystem());
+                build_system && !checked)
+                build_system->watch().stop();
+        });
+        connect(run_target_mode,
+                QOverload<int>::of(&QComboBox::currentIndexChanged),
+                this,
+                [this, run_target_mode](auto index) {
+                    setRunTargetMode(
+                        static_cast<RunTargetMode>(run_target_mode->itemData(index).toInt()));
+                });
+
         connect(build_targets_list,
                 &QListWidget::itemChanged,
                 this,
-                [this, update_details](auto *item) {
-                    if (item->checkState() != Qt::Checked) return;
-
-                    setBuildTarget(item->data(Qt::UserRole).toString());
+                [this, update_details, update_checked_targets](auto *item) {
+                    const auto target = item->data(Qt::UserRole).toString();
+
+                    auto targets = targetNames();
+                    if (item->checkState() == Qt::Checked) {
+                        // all and clean can't be combined with other targets
+                        if (isSpecialTarget(target)) targets.clear();
+                        else
+                            targets.erase(std::remove_if(std::begin(targets),
+                                                         std::end(targets),
+                                                         isSpecialTarget),
+                                          std::end(targets));
+
+                        targets.append(target);
+                    } else
+                        targets.removeAll(target);
+
+                    setBuildTargets(targets);
+                    update_checked_targets();
                     update_details();
                 });
 
@@ -133,6 +315,13 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeBuildStep::command() -> Utils::CommandLine {
+        return command(m_target_names, m_build_files);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildStep::command(const QStringList &target_names, const QStringList &files)
+        -> Utils::CommandLine {
         auto cmd = [this] {
             auto tool = XMakeToolKitAspect::xmakeTool(kit());
             if (tool) return Utils::CommandLine { tool->exe() };
@@ -140,22 +329,30 @@ namespace XMakeProjectManager::Internal {
             return Utils::CommandLine {};
         }();
 
-        qDebug() << m_target_name;
-
-        if (!m_target_name.isEmpty() &&
-            m_target_name == QString::fromLatin1(Constants::Targets::CLEAN)) {
+        if (target_names.contains(QString::fromLatin1(Constants::Targets::CLEAN))) {
             cmd.addArg("c");
         } else {
             cmd.addArg("b");
 
+            if (m_jobs > 0) cmd.addArgs({ "-j", QString::number(m_jobs) });
+
+            if (!files.isEmpty()) cmd.addArg("--files=" + files.join(QDir::listSeparator()));
+
             if (!m_command_args.isEmpty())
                 cmd.addArgs(m_command_args, Utils::CommandLine::RawType::Raw);
-        }
 
-        if (!m_target_name.isEmpty() &&
-            m_target_name != QString::fromLatin1(Constants::Targets::ALL) &&
-            m_target_name != QString::fromLatin1(Constants::Targets::CLEAN))
-            cmd.addArg(m_target_name);
+            // xmake builds the dependencies of the launched target with it
+            if (!m_run_target.isEmpty()) {
+                cmd.addArg(m_run_target);
+                return cmd;
+            }
+
+            // a single invocation lets xmake schedule all the selected targets together
+            for (const auto &target : target_names)
+                if (!isSpecialTarget(target)) cmd.addArg(target);
+
+            for (const auto &target : m_affected_targets) cmd.addArg(target);
+        }
 
         return cmd;
     }
@@ -168,8 +365,69 @@ namespace XMakeProjectManager::Internal {
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeBuildStep::setBuildTarget(const QString &target_name) -> void {
-        m_target_name = target_name;
+    auto XMakeBuildStep::setBuildTargets(const QStringList &target_names) -> void {
+        m_target_names = target_names;
+        m_target_names.removeDuplicates();
+
+        if (m_target_names.isEmpty()) m_target_names.append(defaultBuildTarget());
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildStep::configArgs() const -> QStringList {
+        auto args = QStringList {};
+        if (!m_ccache) args.append("--ccache=n");
+
+        auto flags = QStringList {};
+
+        const auto diagnostics_flags =
+            XMakeStructuredDiagnostics::compilerFlags(diagnosticsFormat(), diagnosticsLogDir());
+        if (!diagnostics_flags.isEmpty()) flags.append(diagnostics_flags);
+
+        // msvc only prints its /d1reportTime timings, there is no trace to collect
+        const auto *toolchain = QtSupport::CppKitInfo { kit() }.cxxToolChain;
+        if (m_time_trace && toolchain) {
+            if (toolchain->typeId() == ProjectExplorer::Constants::CLANG_TOOLCHAIN_TYPEID)
+                flags.append("-ftime-trace");
+            else if (toolchain->typeId() == ProjectExplorer::Constants::CLANG_CL_TOOLCHAIN_TYPEID)
+                flags.append("/clang:-ftime-trace");
+        }
+
+        if (!flags.isEmpty()) args.append("--cxflags=" + flags.join(' '));
+
+        return args;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildStep::diagnosticsFormat() const -> XMakeStructuredDiagnostics::Format {
+        using Format = XMakeStructuredDiagnostics::Format;
+
+        const auto *toolchain = QtSupport::CppKitInfo { kit() }.cxxToolChain;
+        if (!m_structured_diagnostics || !toolchain) return Format::None;
+
+        const auto type_id = toolchain->typeId();
+        if (type_id == ProjectExplorer::Constants::MSVC_TOOLCHAIN_TYPEID ||
+            type_id == ProjectExplorer::Constants::CLANG_TOOLCHAIN_TYPEID)
+            return Format::Sarif;
+        if (type_id == ProjectExplorer::Constants::GCC_TOOLCHAIN_TYPEID ||
+            type_id == ProjectExplorer::Constants::MINGW_TOOLCHAIN_TYPEID)
+            return Format::GCCJson;
+
+        // clang-cl has neither the msvc logs nor the clang driver flags
+        return Format::None;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildStep::diagnosticsLogDir() const -> Utils::FilePath {
+        // only msvc writes its logs to files
+        if (diagnosticsFormat() != XMakeStructuredDiagnostics::Format::Sarif) return {};
+
+        const auto *toolchain = QtSupport::CppKitInfo { kit() }.cxxToolChain;
+        if (toolchain->typeId() != ProjectExplorer::Constants::MSVC_TOOLCHAIN_TYPEID) return {};
+
+        return buildDirectory().pathAppended(QString::fromLatin1(Constants::SARIF_LOG_DIR));
     }
 
     ////////////////////////////////////////////////////
@@ -177,8 +435,20 @@ namespace XMakeProjectManager::Internal {
     auto XMakeBuildStep::toMap() const -> QVariantMap {
         auto map = AbstractProcessStep::toMap();
 
-        map[QString::fromLatin1(Constants::BuildStep::TARGETS_KEY)]        = m_target_name;
-        map[QString::fromLatin1(Constants::BuildStep::TOOL_ARGUMENTS_KEY)] = m_command_args;
+        map[QString::fromLatin1(Constants::BuildStep::TARGETS_KEY)]         = m_target_names;
+        map[QString::fromLatin1(Constants::BuildStep::TOOL_ARGUMENTS_KEY)]  = m_command_args;
+        map[QString::fromLatin1(Constants::BuildStep::JOBS_KEY)]            = m_jobs;
+        map[QString::fromLatin1(Constants::BuildStep::CCACHE_KEY)]          = m_ccache;
+        map[QString::fromLatin1(Constants::BuildStep::AFFECTED_ONLY_KEY)]   = m_affected_only;
+        map[QString::fromLatin1(Constants::BuildStep::LAST_BUILD_KEY)]      = m_last_full_build;
+        map[QString::fromLatin1(Constants::BuildStep::SKIP_UP_TO_DATE_KEY)] = m_skip_up_to_date;
+        map[QString::fromLatin1(Constants::BuildStep::STRUCTURED_DIAGNOSTICS_KEY)] =
+            m_structured_diagnostics;
+        map[QString::fromLatin1(Constants::BuildStep::TIME_TRACE_KEY)]   = m_time_trace;
+        map[QString::fromLatin1(Constants::BuildStep::QUIET_OUTPUT_KEY)] = m_quiet_output;
+        map[QString::fromLatin1(Constants::BuildStep::RUN_TARGET_MODE_KEY)] =
+            static_cast<int>(m_run_target_mode);
+        map[QString::fromLatin1(Constants::BuildStep::WATCH_KEY)] = m_watch;
 
         return map;
     }
@@ -186,10 +456,33 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeBuildStep::fromMap(const QVariantMap &map) -> bool {
-        m_target_name =
-            map.value(QString::fromLatin1(Constants::BuildStep::TARGETS_KEY)).toString();
+        // older versions stored a single target name
+        setBuildTargets(
+            map.value(QString::fromLatin1(Constants::BuildStep::TARGETS_KEY)).toStringList());
         m_command_args =
             map.value(QString::fromLatin1(Constants::BuildStep::TOOL_ARGUMENTS_KEY)).toString();
+        setJobs(map.value(QString::fromLatin1(Constants::BuildStep::JOBS_KEY), 0).toInt());
+        m_ccache = map.value(QString::fromLatin1(Constants::BuildStep::CCACHE_KEY), true).toBool();
+        m_affected_only =
+            map.value(QString::fromLatin1(Constants::BuildStep::AFFECTED_ONLY_KEY)).toBool();
+        m_last_full_build =
+            map.value(QString::fromLatin1(Constants::BuildStep::LAST_BUILD_KEY)).toDateTime();
+        m_skip_up_to_date =
+            map.value(QString::fromLatin1(Constants::BuildStep::SKIP_UP_TO_DATE_KEY), true)
+                .toBool();
+        m_structured_diagnostics =
+            map.value(QString::fromLatin1(Constants::BuildStep::STRUCTURED_DIAGNOSTICS_KEY))
+                .toBool();
+        m_time_trace =
+            map.value(QString::fromLatin1(Constants::BuildStep::TIME_TRACE_KEY)).toBool();
+        m_quiet_output =
+            map.value(QString::fromLatin1(Constants::BuildStep::QUIET_OUTPUT_KEY)).toBool();
+        m_run_target_mode = static_cast<RunTargetMode>(
+            std::clamp(map.value(QString::fromLatin1(Constants::BuildStep::RUN_TARGET_MODE_KEY))
+                           .toInt(),
+                       static_cast<int>(RunTargetMode::Off),
+                       static_cast<int>(RunTargetMode::Only)));
+        m_watch = map.value(QString::fromLatin1(Constants::BuildStep::WATCH_KEY)).toBool();
 
         return AbstractProcessStep::fromMap(map);
     }
@@ -198,26 +491,258 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     auto XMakeBuildStep::update(bool parsing_successful) -> void {
         if (parsing_successful) {
-            if (!projectTargets().contains(m_target_name)) setBuildTarget(defaultBuildTarget());
+            const auto targets = projectTargets();
+
+            auto target_names = m_target_names;
+            target_names.erase(std::remove_if(std::begin(target_names),
+                                              std::end(target_names),
+                                              [&targets](const auto &target) {
+                                                  return !targets.contains(target);
+                                              }),
+                               std::end(target_names));
+
+            setBuildTargets(target_names);
 
             Q_EMIT targetListChanged();
         }
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildStep::init() -> bool {
+        m_run_target_names = m_target_names;
+        m_run_files        = m_build_files;
+        m_run_target.clear();
+
+        return AbstractProcessStep::init();
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeBuildStep::doRun() -> void {
+        // the outputs the last build left are gone, the targets and the files changed since
+        // can't be told apart
+        const auto *build_configuration =
+            qobject_cast<XMakeBuildConfiguration *>(buildConfiguration());
+        if (build_configuration && build_configuration->prepareOutputDirectory() &&
+            m_last_full_build.isValid()) {
+            Q_EMIT addOutput(tr("The build output directory %1 was emptied, building everything.")
+                                 .arg(build_configuration->outputDirectory().toUserOutput()),
+                             OutputFormat::NormalMessage);
+            m_last_full_build = {};
+        }
+
+        m_run_target = runTarget();
+        if (!m_run_target.isEmpty()) {
+            Q_EMIT addOutput(tr("Building the launched target %1 first.").arg(m_run_target),
+                             OutputFormat::NormalMessage);
+            setupProcessParameters(processParameters());
+        }
+
+        auto *build_system = qobject_cast<XMakeBuildSystem *>(buildSystem());
+
+        m_start_watch = false;
+        if (build_system) {
+            auto &watch = build_system->watch();
+
+            // a restricted build or a clean would race with the rebuilds of the watch
+            const auto watches =
+                m_watch && m_run_target.isEmpty() && m_run_files.isEmpty() &&
+                !m_run_target_names.contains(QString::fromLatin1(Constants::Targets::CLEAN));
+
+            if (!watches) watch.stop();
+            else if (watch.isWatching(watchedTargets())) {
+                if (watch.isBuilding()) {
+                    Q_EMIT addOutput(tr("Waiting for the rebuild of xmake watch."),
+                                     OutputFormat::NormalMessage);
+
+                    m_watch_rebuild =
+                        connect(&watch, &XMakeWatch::buildFinished, this, [this](auto success) {
+                            disconnect(m_watch_rebuild);
+                            Q_EMIT finished(success);
+                        });
+                    return;
+                }
+
+                Q_EMIT addOutput(tr("xmake watch keeps the targets built."),
+                                 OutputFormat::NormalMessage);
+
+                // the build queue cleared the diagnostics of the last rebuild
+                watch.restoreTasks();
+                Q_EMIT finished(watch.lastBuildSucceeded());
+                return;
+            } else
+                m_start_watch = true;
+        }
+
+        const auto builds_all =
+            m_run_target.isEmpty() &&
+            m_run_target_names == QStringList { QString::fromLatin1(Constants::Targets::ALL) };
+
+        // only a build of every target tells which files the next one can skip
+        m_run_started = builds_all ? QDateTime::currentDateTime() : QDateTime {};
+        m_trace_since = QDateTime::currentDateTime();
+        m_affected_targets.clear();
+
+        if (m_run_target_names.contains(QString::fromLatin1(Constants::Targets::CLEAN)))
+            m_diagnostics.clear();
+        else
+            m_diagnostics.start();
+
+        if (m_skip_up_to_date && build_system && m_run_files.isEmpty() &&
+            !m_run_target_names.contains(QString::fromLatin1(Constants::Targets::CLEAN))) {
+            m_checking_up_to_date = true;
+
+            const auto up_to_date =
+                build_system->isUpToDate(m_run_target.isEmpty() ? m_run_target_names
+                                                                : QStringList { m_run_target },
+                                         m_last_full_build);
+            const auto check = ++m_up_to_date_check;
+            Utils::onFinished(up_to_date, this, [this, check](const QFuture<bool> &future) {
+                // canceled while the files were looked at
+                if (check != m_up_to_date_check || !std::exchange(m_checking_up_to_date, false))
+                    return;
+
+                if (!future.result()) {
+                    runBuild();
+                    return;
+                }
+
+                // nothing was built, the inputs recorded at the last build still hold
+                m_run_started = {};
+
+                Q_EMIT addOutput(tr("The targets are up to date."), OutputFormat::NormalMessage);
+                Q_EMIT finished(true);
+            });
+            return;
+        }
+
+        runBuild();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildStep::runBuild() -> void {
+        const auto builds_all =
+            m_run_target.isEmpty() &&
+            m_run_target_names == QStringList { QString::fromLatin1(Constants::Targets::ALL) };
+
+        if (builds_all && m_affected_only) {
+            if (auto affected = affectedTargets(); affected) {
+                if (affected->isEmpty()) {
+                    Q_EMIT addOutput(tr("No file changed since the last build."),
+                                     OutputFormat::NormalMessage);
+                    Q_EMIT finished(true);
+                    return;
+                }
+
+                Q_EMIT addOutput(tr("Building the affected targets: %1").arg(affected->join(", ")),
+                                 OutputFormat::NormalMessage);
+
+                m_affected_targets = std::move(*affected);
+                setupProcessParameters(processParameters());
+            }
+        }
+
+        // msvc doesn't create the directory of its diagnostics logs
+        if (const auto log_dir = diagnosticsLogDir(); !log_dir.isEmpty())
+            log_dir.ensureWritableDir();
+
         AbstractProcessStep::doRun();
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildStep::doCancel() -> void {
+        // nothing runs yet while the targets are checked
+        if (std::exchange(m_checking_up_to_date, false)) {
+            Q_EMIT finished(false);
+            return;
+        }
+
+        // nothing runs while waiting for xmake watch
+        if (m_watch_rebuild) {
+            disconnect(m_watch_rebuild);
+            Q_EMIT finished(false);
+            return;
+        }
+
+        AbstractProcessStep::doCancel();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildStep::affectedTargets() const -> Utils::optional<QStringList> {
+        const auto *build_system = qobject_cast<XMakeBuildSystem *>(buildSystem());
+        if (!build_system || !m_last_full_build.isValid()) return Utils::nullopt;
+
+        const auto &targets = build_system->targets();
+        if (targets.empty()) return Utils::nullopt;
+
+        const auto project_dir = project()->projectDirectory();
+        const auto changed     = [&project_dir, this](const QString &file) {
+            return project_dir.resolvePath(file).lastModified() > m_last_full_build;
+        };
+        const auto any_changed = [&changed](const QStringList &files) {
+            return std::any_of(std::cbegin(files), std::cend(files), changed);
+        };
+
+        auto affected   = std::vector<bool>(std::size(targets), false);
+        auto dependents = std::vector<std::vector<std::size_t>>(std::size(targets));
+        auto pending    = std::vector<std::size_t> {};
+
+        for (auto i = 0u; i < std::size(targets); ++i) {
+            const auto &target = targets[i];
+
+            for (auto dep : target.dependencies) dependents[dep].push_back(i);
+
+            affected[i] = changed(target.defined_in) || any_changed(target.headers) ||
+                          any_changed(target.modules) ||
+                          std::any_of(std::cbegin(target.sources),
+                                      std::cend(target.sources),
+                                      [&any_changed](const auto &group) {
+                                          return any_changed(group.sources);
+                                      });
+            if (affected[i]) pending.push_back(i);
+        }
+
+        // the targets depending on a changed one have to relink
+        while (!pending.empty()) {
+            const auto index = pending.back();
+            pending.pop_back();
+
+            for (auto dependent : dependents[index]) {
+                if (affected[dependent]) continue;
+
+                affected[dependent] = true;
+                pending.push_back(dependent);
+            }
+        }
+
+        auto names = QStringList {};
+        for (auto i = 0u; i < std::size(targets); ++i)
+            if (affected[i]) names.append(targets[i].name);
+
+        return names;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeBuildStep::setupOutputFormatter(Utils::OutputFormatter *formatter) -> void {
-        const auto toolchain = QtSupport::CppKitInfo { kit() }.cxxToolChain;
-        m_xmake_parser       = new XMakeBuildParser { (toolchain->displayName().contains("visual")
-                                                           ? XMakeBuildParser::Type::MSVC
-                                                           : XMakeBuildParser::Type::GCC_Clang) };
+        m_xmake_parser = new XMakeBuildParser { XMakeBuildParser::typeForKit(kit()) };
         m_xmake_parser->setSourceDirectory(project()->projectDirectory());
+        m_xmake_parser->setStructuredDiagnostics(diagnosticsFormat(), diagnosticsLogDir());
+        m_xmake_parser->setTimingOwners(timingOwners());
+        m_xmake_parser->setDurationsHistory(
+            buildDirectory().pathAppended(QString::fromLatin1(Constants::BUILD_DURATIONS)));
+        if (Settings::instance()->trace_export.value())
+            m_xmake_parser->setTraceFile(
+                buildDirectory().pathAppended(QString::fromLatin1(Constants::BUILD_TRACE)));
+        if (m_quiet_output)
+            m_xmake_parser->setFullLog(
+                buildDirectory().pathAppended(QString::fromLatin1(Constants::BUILD_LOG)));
+        if (m_ccache)
+            m_xmake_parser->setCacheStatsLog(ccacheStatsLog(), processParameters()->environment());
 
         formatter->addLineParser(m_xmake_parser);
 
@@ -230,11 +755,96 @@ namespace XMakeProjectManager::Internal {
 
         AbstractProcessStep::setupOutputFormatter(formatter);
 
-        connect(m_xmake_parser, &XMakeBuildParser::reportProgress, this, [this](auto percent) {
-            Q_EMIT progress(percent, QString {});
+        connect(m_xmake_parser,
+                &XMakeBuildParser::reportProgress,
+                this,
+                [this](auto percent, const auto &text) { Q_EMIT progress(percent, text); });
+        connect(m_xmake_parser,
+                &XMakeBuildParser::sourceCompiled,
+                &m_diagnostics,
+                &XMakeBuildDiagnostics::compiled);
+        connect(m_xmake_parser, &XMakeBuildParser::reportFullLog, this, [this](const auto &log) {
+            Q_EMIT addOutput(tr("The complete output is in %1.").arg(log.toUserOutput()),
+                             OutputFormat::NormalMessage);
+        });
+        connect(m_xmake_parser, &XMakeBuildParser::reportTrace, this, [this](const auto &trace) {
+            Q_EMIT addOutput(tr("The build trace is in %1.").arg(trace.toUserOutput()),
+                             OutputFormat::NormalMessage);
+        });
+        connect(m_xmake_parser, &XMakeBuildParser::reportTimings, this, [this](const auto &report) {
+            Q_EMIT addOutput(report, OutputFormat::NormalMessage);
+        });
+        connect(m_xmake_parser,
+                &XMakeBuildParser::reportCacheStatistics,
+                this,
+                [this](const auto &report) {
+                    Q_EMIT addOutput(tr("Compiler cache:"), OutputFormat::NormalMessage);
+                    Q_EMIT addOutput(report, OutputFormat::NormalMessage);
+                });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildStep::reportCompileTimes() -> void {
+        const auto *build_system = qobject_cast<XMakeBuildSystem *>(buildSystem());
+        if (!build_system || !m_trace_since.isValid()) return;
+
+        const auto project_dir = project()->projectDirectory();
+
+        auto object_dirs = Utils::FilePaths {};
+        for (const auto &target : build_system->targets())
+            if (!target.object_dir.isEmpty())
+                object_dirs.append(project_dir.resolvePath(target.object_dir));
+
+        // the traces of a large build weigh hundreds of megabytes, the build queue doesn't wait
+        // for them and the report goes to the general messages
+        auto future = Utils::runAsync(ProjectExplorer::ProjectExplorerPlugin::sharedThreadPool(),
+                                      QThread::LowPriority,
+                                      XMakeTimeTraces::collect,
+                                      std::move(object_dirs),
+                                      m_trace_since);
+
+        Utils::onResultReady(future, this, [](const XMakeTimeTraces &traces) {
+            if (traces.isEmpty()) return;
+
+            ProjectExplorer::TaskHub::clearTasks(Constants::TASK_CATEGORY_COMPILE_TIMES);
+            for (const auto &task : traces.tasks(TIME_TRACE_REPORT_SIZE))
+                ProjectExplorer::TaskHub::addTask(task);
+
+            Core::MessageManager::writeSilently(traces.report(TIME_TRACE_REPORT_SIZE));
         });
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildStep::ccacheStatsLog() const -> Utils::FilePath {
+        return buildDirectory().pathAppended(QString::fromLatin1(Constants::CCACHE_STATS_LOG));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildStep::timingOwners() const -> QHash<QString, QString> {
+        const auto *build_system = qobject_cast<XMakeBuildSystem *>(buildSystem());
+        if (!build_system) return {};
+
+        const auto project_dir = project()->projectDirectory();
+
+        auto owners = QHash<QString, QString> {};
+        for (const auto &target : build_system->targets()) {
+            for (const auto &group : target.sources)
+                for (const auto &source : group.sources)
+                    owners.insert(project_dir.resolvePath(source).cleanPath().toString(),
+                                  target.name);
+
+            // xmake prints the file name of the linked or archived target
+            if (!target.target_file.isEmpty())
+                owners.insert(Utils::FilePath::fromString(target.target_file).fileName(),
+                              target.name);
+        }
+
+        return owners;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeBuildStep::defaultBuildTarget() const -> QString {
@@ -249,6 +859,50 @@ namespace XMakeProjectManager::Internal {
         return QString::fromLatin1(Constants::Targets::ALL);
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildStep::runTarget() const -> QString {
+        if (m_run_target_mode == RunTargetMode::Off || !m_run_files.isEmpty() ||
+            m_run_target_names.contains(QString::fromLatin1(Constants::Targets::CLEAN)))
+            return {};
+
+        const auto *run_configuration = target()->activeRunConfiguration();
+        if (!run_configuration) return {};
+
+        // the build target info is named after the xmake target
+        const auto name = run_configuration->buildTargetInfo().displayName;
+        if (!projectTargets().contains(name)) return {};
+
+        // the launched target isn't among the selected ones, the build is left as configured
+        if (!m_run_target_names.contains(QString::fromLatin1(Constants::Targets::ALL)) &&
+            !m_run_target_names.contains(name))
+            return {};
+
+        return name;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildStep::remainingTargets() const -> QStringList {
+        // "all" leaves the choice of the default targets to xmake
+        if (m_run_target_names.contains(QString::fromLatin1(Constants::Targets::ALL))) return {};
+
+        auto targets = m_run_target_names;
+        targets.removeAll(m_run_target);
+
+        return targets;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildStep::watchedTargets() const -> QStringList {
+        auto targets = m_run_target_names;
+        targets.erase(std::remove_if(std::begin(targets), std::end(targets), isSpecialTarget),
+                      std::end(targets));
+
+        return targets;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     XMakeBuildStepFactory::XMakeBuildStepFactory() {
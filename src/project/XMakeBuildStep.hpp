@@ -4,14 +4,24 @@
 
 #pragma once
 
+#include <project/parsers/XMakeBuildDiagnostics.hpp>
+#include <project/parsers/XMakeStructuredDiagnostics.hpp>
+
 #include <projectexplorer/abstractprocessstep.h>
 #include <projectexplorer/buildstep.h>
 
+#include <utils/optional.h>
+
+#include <QDateTime>
+
 namespace XMakeProjectManager::Internal {
     class XMakeBuildParser;
     class XMakeBuildStep final: public ProjectExplorer::AbstractProcessStep {
         Q_OBJECT
       public:
+        // what is built when the active run configuration launches one of the targets
+        enum class RunTargetMode { Off, First, Only };
+
         XMakeBuildStep(ProjectExplorer::BuildStepList *bsl, Utils::Id id);
 
         QWidget *createConfigWidget() override;
@@ -21,10 +31,57 @@ namespace XMakeProjectManager::Internal {
         QStringList projectTargets();
 
         void setBuildTarget(const QString &target_name);
+        void setBuildTargets(const QStringList &target_names);
+
+        // restricts the build to these sources of the targets, not saved with the step
+        void setBuildFiles(const QStringList &files);
+        const QStringList &buildFiles() const noexcept;
 
         void setCommandArgs(const QString &args);
 
-        const QString &targetName() const;
+        // 0 lets xmake pick the job count
+        int jobs() const noexcept;
+        void setJobs(int jobs) noexcept;
+
+        // applied when the project is configured, xmake build has no switch for it
+        bool useCompilerCache() const noexcept;
+        void setUseCompilerCache(bool use) noexcept;
+        QStringList configArgs() const;
+
+        // applied when the project is configured, the compilers write machine readable
+        // diagnostics instead of the text ones
+        bool structuredDiagnostics() const noexcept;
+        void setStructuredDiagnostics(bool structured) noexcept;
+
+        // applied when the project is configured, clang writes a trace per translation unit
+        // merged in a report of the most expensive headers and templates after the build
+        bool traceCompileTimes() const noexcept;
+        void setTraceCompileTimes(bool trace) noexcept;
+
+        // when building all targets, only pass the ones with files changed since the last build
+        bool affectedTargetsOnly() const noexcept;
+        void setAffectedTargetsOnly(bool affected_only) noexcept;
+
+        // don't start xmake when the build system reports the targets as up to date
+        bool skipUpToDate() const noexcept;
+        void setSkipUpToDate(bool skip) noexcept;
+
+        // the progress lines only update the progress text, the complete output is written to a
+        // log in the build directory
+        bool quietOutput() const noexcept;
+        void setQuietOutput(bool quiet) noexcept;
+
+        // First builds the launched target and its dependencies, the other targets are built
+        // at low priority while it runs, Only doesn't build them
+        RunTargetMode runTargetMode() const noexcept;
+        void setRunTargetMode(RunTargetMode mode) noexcept;
+
+        // once built, an xmake watch process rebuilds the targets on every change and the next
+        // builds only report its last result
+        bool watchChanges() const noexcept;
+        void setWatchChanges(bool watch) noexcept;
+
+        const QStringList &targetNames() const;
 
         QVariantMap toMap() const override;
         bool fromMap(const QVariantMap &map) override;
@@ -34,14 +91,60 @@ namespace XMakeProjectManager::Internal {
         void commandChanged();
 
       private:
+        Utils::CommandLine command(const QStringList &target_names,
+                                   const QStringList &files);
         void update(bool parsing_successful);
+        bool init() override;
         void doRun() override;
+        void runBuild();
+        void doCancel() override;
         void setupOutputFormatter(Utils::OutputFormatter *formatter) override;
         QString defaultBuildTarget() const;
+        QString runTarget() const;
+        QStringList remainingTargets() const;
+        QStringList watchedTargets() const;
+        QHash<QString, QString> timingOwners() const;
+        Utils::FilePath ccacheStatsLog() const;
+        XMakeStructuredDiagnostics::Format diagnosticsFormat() const;
+        Utils::FilePath diagnosticsLogDir() const;
+        void reportCompileTimes();
+        Utils::optional<QStringList> affectedTargets() const;
 
         QString m_command_args;
-        QString m_target_name;
+        QStringList m_target_names;
+        QStringList m_build_files;
+        // what the queued build was asked for, the build configuration restores the targets and
+        // drops the files once the build list is queued
+        QStringList m_run_target_names;
+        QStringList m_run_files;
+        int m_jobs                    = 0;
+        bool m_ccache                 = true;
+        bool m_structured_diagnostics = false;
+        bool m_time_trace             = false;
+
+        bool m_affected_only   = false;
+        bool m_skip_up_to_date = true;
+        bool m_quiet_output    = false;
+
+        RunTargetMode m_run_target_mode = RunTargetMode::Off;
+
+        bool m_watch       = false;
+        bool m_start_watch = false;
+        // the build waits for the rebuild xmake watch is running
+        QMetaObject::Connection m_watch_rebuild;
+        // the up to date check runs on a worker thread, the build starts once it answered
+        bool m_checking_up_to_date = false;
+        quint64 m_up_to_date_check = 0;
+        // the target of the active run configuration when this build is restricted to it
+        QString m_run_target;
+        QStringList m_affected_targets;
+        QDateTime m_last_full_build;
+        QDateTime m_run_started;
+        QDateTime m_trace_since;
         XMakeBuildParser *m_xmake_parser;
+
+        // the tasks of the files the incremental builds don't recompile
+        XMakeBuildDiagnostics m_diagnostics;
     };
 
     class XMakeBuildStepFactory final: public ProjectExplorer::BuildStepFactory {
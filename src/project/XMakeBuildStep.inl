@@ -13,5 +13,117 @@ namespace XMakeProjectManager::Internal {
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    inline auto XMakeBuildStep::targetName() const -> const QString & { return m_target_name; }
+    inline auto XMakeBuildStep::setBuildFiles(const QStringList &files) -> void {
+        m_build_files = files;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::buildFiles() const noexcept -> const QStringList & {
+        return m_build_files;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::jobs() const noexcept -> int { return m_jobs; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::setJobs(int jobs) noexcept -> void {
+        m_jobs = (jobs > 0) ? jobs : 0;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::useCompilerCache() const noexcept -> bool { return m_ccache; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::setUseCompilerCache(bool use) noexcept -> void { m_ccache = use; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::structuredDiagnostics() const noexcept -> bool {
+        return m_structured_diagnostics;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::setStructuredDiagnostics(bool structured) noexcept -> void {
+        m_structured_diagnostics = structured;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::traceCompileTimes() const noexcept -> bool { return m_time_trace; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::setTraceCompileTimes(bool trace) noexcept -> void {
+        m_time_trace = trace;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::affectedTargetsOnly() const noexcept -> bool {
+        return m_affected_only;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::setAffectedTargetsOnly(bool affected_only) noexcept -> void {
+        m_affected_only = affected_only;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::skipUpToDate() const noexcept -> bool { return m_skip_up_to_date; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::quietOutput() const noexcept -> bool { return m_quiet_output; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::setQuietOutput(bool quiet) noexcept -> void {
+        m_quiet_output = quiet;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::runTargetMode() const noexcept -> RunTargetMode {
+        return m_run_target_mode;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::setRunTargetMode(RunTargetMode mode) noexcept -> void {
+        m_run_target_mode = mode;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::watchChanges() const noexcept -> bool { return m_watch; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::setWatchChanges(bool watch) noexcept -> void { m_watch = watch; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::setSkipUpToDate(bool skip) noexcept -> void {
+        m_skip_up_to_date = skip;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::targetNames() const -> const QStringList & {
+        return m_target_names;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildStep::setBuildTarget(const QString &target_name) -> void {
+        setBuildTargets({ target_name });
+    }
 } // namespace XMakeProjectManager::Internal
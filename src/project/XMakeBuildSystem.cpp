@@ -4,15 +4,34 @@
 
 #include "XMakeBuildSystem.hpp"
 
+#include <project/XMakeBackgroundConfigurator.hpp>
 #include <project/XMakeBuildConfiguration.hpp>
+#include <project/XMakeDetectionCache.hpp>
+#include <project/XMakeIntrospectionCache.hpp>
+#include <project/projecttree/ProjectTree.hpp>
 
 #include <settings/general/Settings.hpp>
 
 #include <settings/tools/kitaspect/XMakeToolKitAspect.hpp>
 
 #include <utils/qtcassert.h>
+#include <utils/runextensions.h>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include <coreplugin/editormanager/documentmodel.h>
+#include <coreplugin/editormanager/editormanager.h>
+#include <coreplugin/idocument.h>
 
 #include <projectexplorer/buildconfiguration.h>
+#include <projectexplorer/deploymentdata.h>
+#include <projectexplorer/kitinformation.h>
+#include <projectexplorer/projectexplorer.h>
+#include <projectexplorer/toolchain.h>
+#include <projectexplorer/project.h>
+#include <projectexplorer/projecttree.h>
 #include <projectexplorer/projectexplorerconstants.h>
 #include <projectexplorer/target.h>
 #include <projectexplorer/taskhub.h>
@@ -20,9 +39,15 @@
 #include <qtsupport/qtcppkitinfo.h>
 #include <qtsupport/qtkitinformation.h>
 
+#include <cppeditor/cppmodelmanager.h>
+
 #include <qmljs/qmljsdialect.h>
 #include <qmljs/qmljsmodelmanagerinterface.h>
 
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QSet>
+
 #define LEAVE_IF_BUSY()                                  \
     {                                                    \
         if (m_parse_guard.guardsProject()) return false; \
@@ -40,6 +65,12 @@
 namespace XMakeProjectManager::Internal {
     static Q_LOGGING_CATEGORY(xmake_build_system_log, "qtc.xmake.buildsystem", QtDebugMsg);
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto contentHash(const Utils::FilePath &file) -> QByteArray {
+        return QCryptographicHash::hash(file.fileContents(), QCryptographicHash::Sha1);
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     XMakeBuildSystem::XMakeBuildSystem(XMakeBuildConfiguration *build_conf)
@@ -47,51 +78,103 @@ namespace XMakeProjectManager::Internal {
                                                                       build_conf->kit()),
                                                                   build_conf->environment(),
                                                                   project() },
-          m_kit_info { nullptr } {
+          m_background_build { this }, m_watch { this }, m_kit_info { nullptr } {
         init();
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeBuildSystem::~XMakeBuildSystem() { qDeleteAll(m_extra_compilers); }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeBuildSystem::triggerParsing() -> void {
         qCDebug(xmake_build_system_log) << "Trigger parsing";
 
-        parseProject();
+        m_scheduler.schedule(XMakeParseScheduler::Action::Introspect);
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeBuildSystem::configure() -> bool {
+        m_scheduler.schedule(XMakeParseScheduler::Action::Configure);
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::wipe() -> bool {
+        m_scheduler.schedule(XMakeParseScheduler::Action::Wipe);
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::run(XMakeParseScheduler::Action action,
+                               const Utils::FilePaths &changed_files) -> void {
+        auto started = false;
+
+        // the project parts are built by the parser worker, it needs the kit up front
+        if (buildConfiguration() && kit()) m_parser.setKitInfo(QtSupport::CppKitInfo { kit() });
+
+        // only the reparses following a project file change are started without the user
+        m_parser.setBackground(action == XMakeParseScheduler::Action::Introspect &&
+                               !changed_files.isEmpty());
+
+        switch (action) {
+            case XMakeParseScheduler::Action::Introspect:
+                started = parseProject(changed_files);
+                break;
+            case XMakeParseScheduler::Action::Configure: started = runConfigure(); break;
+            case XMakeParseScheduler::Action::Wipe: started = runWipe(); break;
+        }
+
+        if (!started) m_scheduler.finished();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::runConfigure() -> bool {
         LEAVE_IF_BUSY();
 
         LOCK();
         qCDebug(xmake_build_system_log) << "Configure";
 
-        if (m_parser.configure(projectDirectory(),
-                               buildConfiguration()->buildDirectory(),
-                               configArgs(false))) {
-            return true;
-        }
-        UNLOCK(false);
+        m_last_configure = QDateTime::currentDateTime();
 
-        Q_EMIT errorOccurred();
-
-        return false;
+        return prefetchPackages(false) || startConfigure(false);
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeBuildSystem::wipe() -> bool {
+    auto XMakeBuildSystem::runWipe() -> bool {
         LEAVE_IF_BUSY();
 
         LOCK();
         qCDebug(xmake_build_system_log) << "Wipe";
 
-        if (m_parser.wipe(projectDirectory(),
-                          buildConfiguration()->buildDirectory(),
-                          configArgs(true))) {
-            return true;
-        }
+        m_last_configure = QDateTime::currentDateTime();
+
+        return prefetchPackages(true) || startConfigure(true);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::startConfigure(bool wipe) -> bool {
+        // a wipe asks for a fresh detection, its results replace the shared ones
+        m_detection_dir = XMakeDetectionCache::directory(kit());
+        if (!m_detection_dir.isEmpty() && !wipe)
+            XMakeDetectionCache::seed(m_detection_dir, buildConfiguration()->buildDirectory());
+
+        const auto started = wipe ? m_parser.wipe(projectDirectory(),
+                                                  buildConfiguration()->buildDirectory(),
+                                                  configArgs(true))
+                                  : m_parser.configure(projectDirectory(),
+                                                       buildConfiguration()->buildDirectory(),
+                                                       configArgs(false));
+        if (started) return true;
 
         UNLOCK(false);
 
@@ -100,6 +183,53 @@ namespace XMakeProjectManager::Internal {
         return false;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::prefetchPackages(bool wipe) -> bool {
+        if (!Settings::instance()->package_prefetch.value()) return false;
+
+        // without auto accept, xmake would wait for its install confirmation
+        auto *xmake = XMakeToolKitAspect::xmakeTool(kit());
+        if (!xmake || !xmake->autoAcceptRequests()) return false;
+
+        // once the packages are known, only a missing one is worth an extra xmake run
+        const auto &packages = m_parser.packages();
+        if (m_packages_introspected &&
+            std::all_of(std::cbegin(packages), std::cend(packages), [](const auto &package) {
+                return package.installed;
+            }))
+            return false;
+
+        qCDebug(xmake_build_system_log) << "Prefetching packages";
+
+        const auto build_dir = buildConfiguration()->buildDirectory();
+
+        auto env = buildConfiguration()->environment();
+        env.setupEnglishOutput();
+        env.appendOrSet("XMAKE_PROJECTDIR", projectDirectory().nativePath());
+        env.appendOrSet("XMAKE_CONFIGDIR", build_dir.nativePath());
+
+        m_prefetch_wipe = wipe;
+        m_package_prefetcher.run(xmake->require(projectDirectory(), build_dir),
+                                 env,
+                                 project()->displayName());
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::updatePackageStatus(const QString &name, Package::Status status)
+        -> void {
+        m_package_status[name] = status;
+
+        if (!buildConfiguration()->isActive()) return;
+
+        auto *root = project()->rootProjectNode();
+        if (ProjectTree::updatePackageStatus(root, m_package_status))
+            ProjectExplorer::ProjectTree::emitSubtreeChanged(root);
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeBuildSystem::xmakeBuildConfiguration() -> XMakeBuildConfiguration * {
@@ -108,11 +238,264 @@ namespace XMakeProjectManager::Internal {
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeBuildSystem::makeInstallCommand([[maybe_unused]] const Utils::FilePath &install_root)
-        const -> ProjectExplorer::MakeInstallCommand {
+    auto XMakeBuildSystem::targetForSource(const Utils::FilePath &source) const -> QString {
+        for (const auto &owner : fileIndex().owners(source.cleanPath()))
+            if (owner.group >= 0) return targets()[owner.target].name;
+
         return {};
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::isUpToDate(const QStringList &target_names,
+                                      const QDateTime &last_build) const -> QFuture<bool> {
+        const auto &targets = this->targets();
+        if (!last_build.isValid() || targets.empty() || isParsing() ||
+            m_build_inputs_time != last_build)
+            return QtFuture::makeReadyFuture(false);
+        if (m_last_configure.isValid() && m_last_configure > last_build)
+            return QtFuture::makeReadyFuture(false);
+
+        const auto project_dir = projectDirectory();
+        const auto all = target_names.contains(QString::fromLatin1(Constants::Targets::ALL));
+
+        auto selected = std::vector<bool>(std::size(targets), all);
+        auto pending  = std::vector<std::size_t> {};
+        for (auto i = 0u; i < std::size(targets); ++i)
+            if (all || target_names.contains(targets[i].name)) {
+                selected[i] = true;
+                pending.push_back(i);
+            }
+
+        if (pending.empty()) return QtFuture::makeReadyFuture(false);
+
+        // a target relinks when one of its dependencies was rebuilt
+        for (auto index = 0u; index < std::size(pending); ++index)
+            for (auto dep : targets[pending[index]].dependencies) {
+                if (selected[dep]) continue;
+
+                selected[dep] = true;
+                pending.push_back(dep);
+            }
+
+        struct Check {
+            Utils::FilePath output;
+            Utils::FilePaths inputs;
+            Utils::FilePaths dependency_outputs;
+        };
+
+        const auto output_path = [&project_dir, &targets](std::size_t index) {
+            const auto &target_file = targets[index].target_file;
+            return target_file.isEmpty() ? Utils::FilePath {}
+                                         : project_dir.resolvePath(target_file);
+        };
+
+        auto checks = std::vector<Check> {};
+        checks.reserve(std::size(pending));
+        for (auto index : pending) {
+            const auto &target = targets[index];
+
+            // the declared files miss the headers included on the way, only the files xmake saw
+            // while compiling tell
+            const auto inputs = m_build_inputs.constFind(target.name);
+            if (inputs == std::cend(m_build_inputs)) return QtFuture::makeReadyFuture(false);
+
+            // a source added since was never compiled
+            const auto recorded =
+                QSet<Utils::FilePath> { std::cbegin(*inputs), std::cend(*inputs) };
+            for (const auto &group : target.sources)
+                for (const auto &source : group.sources)
+                    if (!recorded.contains(project_dir.resolvePath(source).cleanPath()))
+                        return QtFuture::makeReadyFuture(false);
+
+            auto &check  = checks.emplace_back();
+            check.output = output_path(index);
+            check.inputs = *inputs;
+            if (!target.defined_in.isEmpty())
+                check.inputs.append(project_dir.resolvePath(target.defined_in));
+
+            for (auto dep : target.dependencies)
+                if (const auto dep_output = output_path(dep); !dep_output.isEmpty())
+                    check.dependency_outputs.append(dep_output);
+        }
+
+        return Utils::runAsync(ProjectExplorer::ProjectExplorerPlugin::sharedThreadPool(),
+                               [checks = std::move(checks),
+                                files  = m_parser.buildSystemFiles(),
+                                last_build]() {
+            if (std::any_of(std::cbegin(files), std::cend(files), [&last_build](const auto &file) {
+                    return file.lastModified() > last_build;
+                }))
+                return false;
+
+            for (const auto &check : checks) {
+                // headeronly and phony targets have no output, their inputs are still checked
+                const auto has_output = !check.output.isEmpty();
+                const auto output     = has_output ? check.output.lastModified() : QDateTime {};
+                if (has_output && !output.isValid()) return false;
+
+                for (const auto &input : check.inputs) {
+                    // a removed input, the build fails or takes another file
+                    const auto modified = input.lastModified();
+                    if (!modified.isValid() || modified > last_build ||
+                        (has_output && modified > output))
+                        return false;
+                }
+
+                if (!has_output) continue;
+
+                for (const auto &dep_output : check.dependency_outputs)
+                    if (dep_output.lastModified() > output) return false;
+            }
+
+            return true;
+        });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::recordBuildInputs(const QDateTime &build_started) -> void {
+        // nothing is trusted until xmake answers for this build
+        m_build_inputs.clear();
+        m_build_inputs_time = {};
+
+        m_parser.queryBuildInputs(this, [this, build_started](auto inputs) {
+            if (!inputs) return;
+
+            m_build_inputs      = std::move(*inputs);
+            m_build_inputs_time = build_started;
+        });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::makeInstallCommand(const Utils::FilePath &install_root) const
+        -> ProjectExplorer::MakeInstallCommand {
+        auto command = ProjectExplorer::MakeInstallCommand {};
+
+        const auto *xmake = XMakeToolKitAspect::xmakeTool(buildConfiguration()->kit());
+        if (!xmake) return command;
+
+        // the upload steps only send the files whose timestamp changed since the last deploy
+        command.command = Utils::CommandLine { xmake->exe(),
+                                               { "install",
+                                                 "-y",
+                                                 "-P",
+                                                 projectDirectory().path(),
+                                                 "-o",
+                                                 install_root.path() } };
+
+        command.environment = buildConfiguration()->environment();
+        command.environment.setupEnglishOutput();
+        command.environment.appendOrSet("XMAKE_CONFIGDIR",
+                                        buildConfiguration()->buildDirectory().nativePath());
+        command.environment.appendOrSet("XMAKE_THEME", "plain");
+
+        return command;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::testcasesInfo() const -> QList<ProjectExplorer::TestCaseInfo> {
+        const auto project_dir = projectDirectory();
+
+        auto tests = QList<ProjectExplorer::TestCaseInfo> {};
+
+        for (const auto &target : targets())
+            for (const auto &test : target.tests) {
+                auto &info = tests.emplace_back();
+                info.name  = target.name + '/' + test;
+                info.path  = project_dir.resolvePath(target.defined_in);
+            }
+
+        return tests;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::commandLineForTests(const QList<QString> &tests,
+                                               const QStringList &options) const
+        -> Utils::CommandLine {
+        const auto *xmake = XMakeToolKitAspect::xmakeTool(buildConfiguration()->kit());
+        if (!xmake) return {};
+
+        return { xmake->exe(),
+                 QStringList { "test", "-P", projectDirectory().path() } + options + tests };
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::updateExtraCompilers() -> void {
+        auto sources = QStringList {};
+        for (const auto &target : targets())
+            for (const auto &generated : target.generated_files)
+                sources << generated.kind + ':' + generated.source + ':' +
+                               generated.outputs.join(':');
+
+        // the compilers follow the source edits by themselves, only a new file list needs new ones
+        if (sources == m_extra_compiler_sources) return;
+
+        qDeleteAll(m_extra_compilers);
+        m_extra_compilers.clear();
+        m_extra_compiler_sources = std::move(sources);
+
+        const auto factories = ProjectExplorer::ExtraCompilerFactory::extraCompilerFactories();
+
+        for (const auto &target : targets()) {
+            for (const auto &generated : target.generated_files) {
+                const auto it = std::find_if(std::cbegin(factories),
+                                             std::cend(factories),
+                                             [&generated](const auto *factory) {
+                                                 return factory->sourceTag() == generated.kind;
+                                             });
+                if (it == std::cend(factories)) continue;
+
+                auto outputs = Utils::FilePaths {};
+                std::transform(std::cbegin(generated.outputs),
+                               std::cend(generated.outputs),
+                               std::back_inserter(outputs),
+                               &Utils::FilePath::fromString);
+
+                const auto source = Utils::FilePath::fromString(generated.source);
+                m_extra_compilers.append((*it)->create(project(), source, outputs));
+            }
+        }
+
+        qCDebug(xmake_build_system_log) << "Created" << m_extra_compilers.size()
+                                        << "extra compilers";
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::updateDeploymentData() -> void {
+        const auto *toolchain = ProjectExplorer::ToolChainKitAspect::cxxToolChain(kit());
+        const auto is_windows =
+            toolchain && toolchain->targetAbi().os() == ProjectExplorer::Abi::WindowsOS;
+
+        auto deployment_data = ProjectExplorer::DeploymentData {};
+
+        for (const auto &target : targets()) {
+            if (target.target_file.isEmpty() ||
+                (target.kind != Target::Kind::BINARY && target.kind != Target::Kind::SHARED))
+                continue;
+
+            const auto prefix = target.install_dir.isEmpty()
+                                    ? QString::fromLatin1(Constants::DEFAULT_INSTALL_PREFIX)
+                                    : target.install_dir;
+
+            // same layout as xmake install, the dlls go next to the executables
+            const auto binary = target.kind == Target::Kind::BINARY;
+            const auto dir    = (binary || is_windows) ? QString { "bin" } : QString { "lib" };
+
+            deployment_data.addFile(Utils::FilePath::fromString(target.target_file),
+                                    prefix + '/' + dir,
+                                    binary ? ProjectExplorer::DeployableFile::TypeExecutable
+                                           : ProjectExplorer::DeployableFile::TypeNormal);
+        }
+
+        setDeploymentData(deployment_data);
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeBuildSystem::init() -> void {
@@ -122,6 +505,31 @@ namespace XMakeProjectManager::Internal {
             updateKit(kit());
         });
 
+        // each build configuration keeps its own xmake config and introspection snapshot, switching
+        // back to one loads its snapshot instead of configuring it again
+        connect(buildConfiguration()->target(),
+                &ProjectExplorer::Target::activeBuildConfigurationChanged,
+                this,
+                [this](auto *build_configuration) {
+                    if (build_configuration != buildConfiguration()) return;
+
+                    m_cache_checked = false;
+                    XMakeBackgroundConfigurator::instance().cancel(
+                        buildConfiguration()->buildDirectory());
+                });
+
+        // the build configurations of the other kits are prepared in the background too
+        connect(project(),
+                &ProjectExplorer::Project::activeTargetChanged,
+                this,
+                [this](auto *active_target) {
+                    if (active_target != target() || !buildConfiguration()->isActive()) return;
+
+                    m_cache_checked = false;
+                    XMakeBackgroundConfigurator::instance().cancel(
+                        buildConfiguration()->buildDirectory());
+                });
+
         connect(xmakeBuildConfiguration(),
                 &XMakeBuildConfiguration::buildDirectoryChanged,
                 this,
@@ -135,7 +543,9 @@ namespace XMakeProjectManager::Internal {
                 this,
                 [this] {
                     updateKit(kit());
-                    wipe();
+
+                    // xmake keeps the cached values of the options not given, wiping is explicit
+                    configure();
                 });
 
         connect(xmakeBuildConfiguration(),
@@ -143,45 +553,161 @@ namespace XMakeProjectManager::Internal {
                 this,
                 [this] { m_parser.setEnvironment(buildConfiguration()->environment()); });
 
-        connect(project(), &ProjectExplorer::Project::projectFileIsDirty, this, [this]() {
-            if (buildConfiguration()->isActive()) parseProject();
-        });
+        connect(project(),
+                &ProjectExplorer::Project::projectFileIsDirty,
+                this,
+                &XMakeBuildSystem::projectFileChanged);
 
         connect(&m_parser,
                 &XMakeProjectParser::parsingCompleted,
                 this,
                 &XMakeBuildSystem::parsingCompleted);
 
-        connect(&m_intro_watcher, &Utils::FileSystemWatcher::fileChanged, this, [this] {
-            if (buildConfiguration()->isActive()) parseProject();
+        connect(&m_parser,
+                &XMakeProjectParser::projectTreePopulated,
+                this,
+                &XMakeBuildSystem::updateProjectTree);
+
+        // the flags of the files configured on their own are asked for once they are opened
+        connect(Core::EditorManager::instance(),
+                &Core::EditorManager::documentOpened,
+                this,
+                [this](Core::IDocument *document) {
+                    if (!isParsing() && buildConfiguration()->isActive())
+                        m_parser.queryFileArguments(document->filePath());
+                });
+
+        // the model knows the parts of the opened files, the editors are usable
+        connect(CppEditor::CppModelManager::instance(),
+                &CppEditor::CppModelManager::projectPartsUpdated,
+                this,
+                [this](ProjectExplorer::Project *updated) {
+                    if (updated != project() || !std::exchange(m_code_model_pending, false))
+                        return;
+                    if (!kit() || !buildConfiguration()) return;
+
+                    qCDebug(xmake_build_system_log) << "Updating the code model with every part";
+
+                    m_cpp_code_model_updater.update({ project(),
+                                                      QtSupport::CppKitInfo { kit() },
+                                                      buildConfiguration()->environment(),
+                                                      m_parser.projectParts() },
+                                                    m_extra_compilers);
+                });
+
+        connect(&m_parser, &XMakeProjectParser::projectPartsUpdated, this, [this] {
+            if (!kit() || !buildConfiguration()) return;
+
+            m_code_model_pending = false;
+
+            qCDebug(xmake_build_system_log) << "Updating the code model with the file flags";
+
+            m_cpp_code_model_updater.update({ project(),
+                                              QtSupport::CppKitInfo { kit() },
+                                              buildConfiguration()->environment(),
+                                              m_parser.projectParts() },
+                                            m_extra_compilers);
+        });
+
+        connect(&m_parser, &XMakeProjectParser::cacheMissed, this, [this] {
+            UNLOCK(false);
+
+            if (!parseProject()) m_scheduler.finished();
         });
 
+        connect(&m_scheduler, &XMakeParseScheduler::runRequested, this, &XMakeBuildSystem::run);
+
+        // the configuration runs once the packages are installed, it reports the failures
+        connect(&m_package_prefetcher, &XMakePackagePrefetcher::finished, this, [this] {
+            if (!startConfigure(m_prefetch_wipe)) m_scheduler.finished();
+        });
+
+        connect(&m_package_prefetcher,
+                &XMakePackagePrefetcher::statusChanged,
+                this,
+                &XMakeBuildSystem::updatePackageStatus);
+
+        // catches the changes made outside of Qt Creator to the files not opened in an editor
+        connect(&m_project_files_watcher,
+                &Utils::FileSystemWatcher::fileChanged,
+                this,
+                [this](const QString &file) {
+                    projectFileChanged(Utils::FilePath::fromString(file));
+                });
+
         updateKit(kit());
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::projectFileChanged(const Utils::FilePath &file) -> void {
+        if (!buildConfiguration()->isActive()) return;
+
+        // saving a file unchanged or touching it doesn't change what xmake would report
+        auto hash = contentHash(file);
+        if (auto it = m_project_file_hashes.find(file);
+            it != std::end(m_project_file_hashes) && *it == hash) {
+            qCDebug(xmake_build_system_log) << "Project file unchanged" << file.toUserOutput();
+            return;
+        }
 
-        m_intro_watcher.addDirectory(buildConfiguration()
-                                         ->buildDirectory()
-                                         .pathAppended(
-                                             QString::fromLatin1(Constants::XMAKE_INFO_DIR))
-                                         .toString(),
-                                     Utils::FileSystemWatcher::WatchModifiedDate);
+        m_project_file_hashes.insert(file, std::move(hash));
+
+        m_scheduler.schedule(XMakeParseScheduler::Action::Introspect, { file });
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeBuildSystem::parseProject() -> bool {
+    auto XMakeBuildSystem::watchProjectFiles() -> void {
+        const auto &files = m_parser.buildSystemFiles();
+
+        // only the files xmake read, its own writes in the build directory are not watched
+        auto hashes = QHash<Utils::FilePath, QByteArray> {};
+        auto paths  = QStringList {};
+        for (const auto &file : files) {
+            hashes.insert(file, contentHash(file));
+            paths.append(file.toString());
+        }
+
+        m_project_file_hashes = std::move(hashes);
+
+        m_project_files_watcher.clear();
+        m_project_files_watcher.addFiles(paths, Utils::FileSystemWatcher::WatchModifiedDate);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::parseProject(const Utils::FilePaths &changed_files) -> bool {
         QTC_ASSERT(buildConfiguration(), return false);
 
+        m_parser.setConfigArgs(configArgs(false));
+
+        // on project open or activation, the previous introspection result is enough if nothing
+        // changed, the cache is validated against the project files by the parser worker
+        if (!std::exchange(m_cache_checked, true) && changed_files.isEmpty()) {
+            LEAVE_IF_BUSY();
+            LOCK();
+
+            qCDebug(xmake_build_system_log) << "Loading cached introspection";
+
+            if (m_parser.parseCached(projectDirectory(), buildConfiguration()->buildDirectory()))
+                return true;
+
+            UNLOCK(false);
+        }
+
         const auto xmake = XMakeToolKitAspect::xmakeTool(xmakeBuildConfiguration()->kit());
 
-        if (xmake && xmake->autorun()) return configure();
+        if (xmake && xmake->autorun() && !std::exchange(m_adopted, false)) return runConfigure();
 
         LEAVE_IF_BUSY();
         LOCK();
 
         qCDebug(xmake_build_system_log) << "Starting parser";
 
-        const auto result =
-            m_parser.parse(projectDirectory(), buildConfiguration()->buildDirectory());
+        const auto result = m_parser.parse(projectDirectory(),
+                                           buildConfiguration()->buildDirectory(),
+                                           changed_files);
         if (result) return true;
 
         UNLOCK(false);
@@ -199,38 +725,222 @@ namespace XMakeProjectManager::Internal {
         m_kit_info = QtSupport::CppKitInfo { kit };
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::updateProjectTree() -> void {
+        auto root_node = m_parser.takeProjectNode();
+        if (!root_node) return;
+
+        // a new root resets the whole project model, keep the current one when nothing changed
+        if (ProjectTree::isUpToDate(project()->rootProjectNode(), *root_node)) {
+            qCDebug(xmake_build_system_log) << "Project tree unchanged";
+
+            auto *root = project()->rootProjectNode();
+            if (ProjectTree::updatePackageStatus(root, m_package_status))
+                ProjectExplorer::ProjectTree::emitSubtreeChanged(root);
+
+            return;
+        }
+
+        ProjectTree::updatePackageStatus(root_node.get(), m_package_status);
+
+        setRootProjectNode(std::move(root_node));
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeBuildSystem::parsingCompleted(bool success) -> void {
+        if (const auto detection_dir = std::exchange(m_detection_dir, {});
+            success && !detection_dir.isEmpty())
+            XMakeDetectionCache::store(detection_dir, buildConfiguration()->buildDirectory());
+
         if (!success) {
             ProjectExplorer::TaskHub::addTask(
                 ProjectExplorer::BuildSystemTask { ProjectExplorer::Task::Error,
                                                    tr("XMake introspection: Parsing failed") });
             UNLOCK(false);
+            m_scheduler.finished();
 
             emitBuildSystemUpdated();
 
             return;
         }
 
-        setRootProjectNode(m_parser.takeProjectNode());
+        // packages built by the prefetch keep that status until the next session
+        m_packages_introspected = true;
+        for (const auto &package : m_parser.packages()) {
+            auto &status = m_package_status[package.name];
+
+            if (!package.installed) status = Package::Status::Missing;
+            else if (status != Package::Status::Built)
+                status = Package::Status::Cached;
+        }
+
+        updateProjectTree();
+
+        const auto &build_system_files = m_parser.buildSystemFiles();
+        project()->setExtraProjectFiles(
+            QSet<Utils::FilePath> { std::cbegin(build_system_files), std::cend(build_system_files) });
+        watchProjectFiles();
 
         if (kit() && buildConfiguration()) {
-            auto kit_info = QtSupport::CppKitInfo { kit() };
+            auto env = buildConfiguration()->environment();
 
-            m_cpp_code_model_updater.update({ project(),
-                                              QtSupport::CppKitInfo { kit() },
-                                              buildConfiguration()->environment(),
-                                              m_parser.buildProjectParts(kit_info) });
+            const auto extra_compiler_sources = m_extra_compiler_sources;
+            updateExtraCompilers();
+
+            // unchanged targets keep their parts, re-indexing only pays off when one changed
+            if (!m_parser.changedTargets().isEmpty() || m_code_model_env != env ||
+                m_extra_compiler_sources != extra_compiler_sources) {
+                qCDebug(xmake_build_system_log)
+                    << "Updating the code model for" << m_parser.changedTargets();
+
+                auto timer = QElapsedTimer {};
+                timer.start();
+
+                updateCodeModel(env);
+                m_code_model_env = std::move(env);
+
+                m_parser.setCodeModelTime(timer.elapsed());
+            }
 
             updateQMLCodeModel();
         }
 
         setApplicationTargets(m_parser.appTargets());
+        updateDeploymentData();
+        Q_EMIT testInformationUpdated();
+
+        if (buildConfiguration()->isActive())
+            for (const auto *document : Core::DocumentModel::openedDocuments())
+                m_parser.queryFileArguments(document->filePath());
 
         UNLOCK(true);
+        m_scheduler.finished();
 
         emitBuildSystemUpdated();
+
+        // the stale snapshot keeps the tree and the code model usable while the project is
+        // introspected again, the unchanged targets keep their nodes and project parts
+        if (m_parser.isStale()) {
+            qCDebug(xmake_build_system_log) << "Revalidating the cached introspection";
+
+            m_scheduler.schedule(XMakeParseScheduler::Action::Introspect);
+            return;
+        }
+
+        if (buildConfiguration()->isActive()) preconfigureOtherBuildConfigurations();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::updateCodeModel(const Utils::Environment &env) -> void {
+        const auto &parts = m_parser.projectParts();
+
+        // generating the project info of every part delays the opened editors, their parts are
+        // submitted on their own first. The update replaces the whole project info, once the
+        // model holds parts of the project the other targets would lose theirs meanwhile
+        const auto project_info = CppEditor::CppModelManager::instance()->projectInfo(project());
+        const auto first_parts  = !project_info || project_info->projectParts().isEmpty();
+
+        auto opened_parts =
+            first_parts ? openedProjectParts() : ProjectExplorer::RawProjectParts {};
+        m_code_model_pending = !opened_parts.isEmpty() && opened_parts.size() < parts.size();
+
+        m_cpp_code_model_updater.update({ project(),
+                                          QtSupport::CppKitInfo { kit() },
+                                          env,
+                                          m_code_model_pending ? std::move(opened_parts) : parts },
+                                        m_extra_compilers);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::openedProjectParts() const -> ProjectExplorer::RawProjectParts {
+        if (!buildConfiguration()->isActive()) return {};
+
+        auto opened_files = QSet<QString> {};
+        for (const auto *document : Core::DocumentModel::openedDocuments())
+            opened_files.insert(document->filePath().cleanPath().toString());
+        if (opened_files.isEmpty()) return {};
+
+        const auto &parts      = m_parser.projectParts();
+        const auto project_dir = projectDirectory();
+
+        // xmake lists the sources relative to the project directory
+        auto names = QSet<QString> {};
+        for (const auto &part : parts)
+            if (std::any_of(std::cbegin(part.files),
+                            std::cend(part.files),
+                            [&opened_files, &project_dir](const auto &file) {
+                                return opened_files.contains(
+                                    project_dir.resolvePath(file).cleanPath().toString());
+                            }))
+                names.insert(part.buildSystemTarget);
+        if (names.isEmpty()) return {};
+
+        // the headers of the direct dependencies are the first ones navigated to
+        const auto opened_targets = names;
+        const auto &targets       = m_parser.targets();
+        for (const auto &target : targets) {
+            if (!opened_targets.contains(target.name)) continue;
+
+            for (auto dependency : target.dependencies) names.insert(targets[dependency].name);
+        }
+
+        auto opened_parts = ProjectExplorer::RawProjectParts {};
+        for (const auto &part : parts)
+            if (names.contains(part.buildSystemTarget)) opened_parts.append(part);
+
+        return opened_parts;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildSystem::preconfigureOtherBuildConfigurations() -> void {
+        if (!Settings::instance()->background_configure.value()) return;
+
+        const auto schedule = [this](ProjectExplorer::BuildConfiguration *build_configuration) {
+            auto *xmake_build_configuration =
+                qobject_cast<XMakeBuildConfiguration *>(build_configuration);
+            if (!xmake_build_configuration || build_configuration == buildConfiguration())
+                return;
+
+            const auto build_dir = build_configuration->buildDirectory();
+
+            // a stored snapshot is validated when the build configuration becomes active
+            if (XMakeIntrospectionCache { build_dir }.path().exists()) return;
+
+            auto env = build_configuration->environment();
+            env.setupEnglishOutput();
+            env.appendOrSet("XMAKE_PROJECTDIR", projectDirectory().nativePath());
+            env.appendOrSet("XMAKE_CONFIGDIR", build_dir.nativePath());
+
+            XMakeBackgroundConfigurator::instance().schedule(
+                { XMakeToolKitAspect::xmakeToolId(build_configuration->kit()),
+                  projectDirectory(),
+                  build_dir,
+                  xmake_build_configuration->xmakeConfigArgs(),
+                  std::move(env),
+                  XMakeDetectionCache::directory(build_configuration->kit()) });
+        };
+
+        // the other kits usually target the other platforms developed for, their active build
+        // configuration comes first and the jobs run side by side within the background budget
+        const auto targets = project()->targets();
+        for (auto *other_target : targets)
+            if (other_target != target()) schedule(other_target->activeBuildConfiguration());
+
+        for (auto *build_configuration : target()->buildConfigurations())
+            schedule(build_configuration);
+
+        for (auto *other_target : targets) {
+            if (other_target == target()) continue;
+
+            for (auto *build_configuration : other_target->buildConfigurations())
+                if (build_configuration != other_target->activeBuildConfiguration())
+                    schedule(build_configuration);
+        }
     }
 
     ////////////////////////////////////////////////////
@@ -255,9 +965,21 @@ namespace XMakeProjectManager::Internal {
         auto project = this->project();
 
         auto project_info = model_manager->defaultProjectInfoForProject(project);
+
+        auto import_paths = m_parser.qmlImportPaths();
+        import_paths.removeDuplicates();
+        import_paths.sort();
+
+        // updating the project info makes the code model rescan the import paths
+        if (import_paths == m_qml_import_paths &&
+            project_info.sourceFiles == m_qml_source_files) {
+            qCDebug(xmake_build_system_log) << "QML code model unchanged";
+            return;
+        }
+
         project_info.importPaths.clear();
 
-        for (const auto &import : m_parser.qmlImportPaths()) {
+        for (const auto &import : import_paths) {
             qCDebug(xmake_build_system_log) << "QML IMPORT PATH: " << import;
             project_info.importPaths.maybeInsert(Utils::FilePath::fromString(import),
                                                  QmlJS::Dialect::Qml);
@@ -266,6 +988,9 @@ namespace XMakeProjectManager::Internal {
         project->setProjectLanguage(ProjectExplorer::Constants::QMLJS_LANGUAGE_ID,
                                     !project_info.sourceFiles.empty());
 
+        m_qml_import_paths = std::move(import_paths);
+        m_qml_source_files = project_info.sourceFiles;
+
         model_manager->updateProjectInfo(project_info, project);
     }
 } // namespace XMakeProjectManager::Internal
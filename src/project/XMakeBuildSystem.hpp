@@ -5,22 +5,33 @@
 #pragma once
 
 #include <projectexplorer/buildsystem.h>
+#include <projectexplorer/extracompiler.h>
 
 #include <cppeditor/cppprojectupdater.h>
+#include <utils/environment.h>
 #include <utils/filesystemwatcher.h>
+#include <utils/optional.h>
 
+#include <project/XMakeBackgroundBuild.hpp>
+#include <project/XMakePackagePrefetcher.hpp>
+#include <project/XMakeParseScheduler.hpp>
 #include <project/XMakeProjectParser.hpp>
+#include <project/XMakeWatch.hpp>
 
 #include <xmakeinfoparser/XMakeBuildOptionsParser.hpp>
 
 #include <qtsupport/qtcppkitinfo.h>
 
+#include <QDateTime>
+#include <QFuture>
+
 namespace XMakeProjectManager::Internal {
     class XMakeBuildConfiguration;
     class XMakeBuildSystem final: public ProjectExplorer::BuildSystem {
         Q_OBJECT
       public:
         explicit XMakeBuildSystem(XMakeBuildConfiguration *build_conf);
+        ~XMakeBuildSystem() override;
 
         void triggerParsing() override;
 
@@ -29,49 +40,125 @@ namespace XMakeProjectManager::Internal {
         bool configure();
         bool wipe();
 
+        // the build directory is already configured, the first parse introspects it even when
+        // the tool configures automatically
+        void adoptConfiguration() noexcept;
+
         XMakeBuildConfiguration *xmakeBuildConfiguration();
 
         const BuildOptionsList &buildOptionsList() const noexcept;
 
         const TargetsList &targets() const noexcept;
         const QStringList &targetList() const noexcept;
+        const XMakeFileIndex &fileIndex() const noexcept;
+
+        // name of the target compiling source, empty when no target does
+        QString targetForSource(const Utils::FilePath &source) const;
+
+        // whether the outputs of the targets and of their dependencies are newer than the inputs
+        // xmake recorded for the build started at last_build and nothing was reconfigured since,
+        // "all" checks every target. The files are looked at on a worker thread, a target
+        // without recorded inputs is never up to date
+        QFuture<bool> isUpToDate(const QStringList &target_names,
+                                 const QDateTime &last_build) const;
+
+        // the build started at build_started succeeded, asks xmake for the files it read
+        void recordBuildInputs(const QDateTime &build_started);
 
         void setXMakeConfigArgs(QStringList args);
 
+        // builds the targets at low priority outside of the build queue, empty builds them all
+        void buildInBackground(const QStringList &target_names);
+
+        // the xmake watch process of this build configuration
+        XMakeWatch &watch() noexcept;
+
         const XMakeProjectParser &parser() const noexcept;
 
         ProjectExplorer::MakeInstallCommand
             makeInstallCommand(const Utils::FilePath &install_root) const override;
 
+        // the tests declared with add_tests, named <target>/<test> as xmake test expects them
+        QList<ProjectExplorer::TestCaseInfo> testcasesInfo() const override;
+        Utils::CommandLine commandLineForTests(const QList<QString> &tests,
+                                               const QStringList &options) const override;
+
       Q_SIGNALS:
         void errorOccurred();
 
       private:
         void init();
 
-        bool parseProject();
+        void run(XMakeParseScheduler::Action action, const Utils::FilePaths &changed_files);
+        bool runConfigure();
+        bool runWipe();
+        bool startConfigure(bool wipe);
+        bool prefetchPackages(bool wipe);
+        void updatePackageStatus(const QString &name, Package::Status status);
+        bool parseProject(const Utils::FilePaths &changed_files = {});
 
         void updateKit(ProjectExplorer::Kit *kit);
 
         void parsingCompleted(bool success);
+        void projectFileChanged(const Utils::FilePath &file);
+        void watchProjectFiles();
+        void updateProjectTree();
+        void preconfigureOtherBuildConfigurations();
+        void updateCodeModel(const Utils::Environment &env);
+        ProjectExplorer::RawProjectParts openedProjectParts() const;
 
         ProjectExplorer::Kit *kit();
 
         QStringList configArgs(bool is_setup);
 
         void updateQMLCodeModel();
+        void updateExtraCompilers();
+        void updateDeploymentData();
 
         ProjectExplorer::BuildSystem::ParseGuard m_parse_guard;
 
         XMakeProjectParser m_parser;
+        XMakeParseScheduler m_scheduler;
+
+        XMakePackagePrefetcher m_package_prefetcher;
+        PackageStatusMap m_package_status;
+        bool m_packages_introspected = false;
+        bool m_prefetch_wipe         = false;
 
         CppEditor::CppProjectUpdater m_cpp_code_model_updater;
+        Utils::optional<Utils::Environment> m_code_model_env;
+        // the parts of the opened files went first, the others follow once they are known
+        bool m_code_model_pending = false;
+
+        // generate the uic headers in memory for the code model, recreated when the generated
+        // files listed by the targets change
+        QList<ProjectExplorer::ExtraCompiler *> m_extra_compilers;
+        QStringList m_extra_compiler_sources;
+
+        XMakeBackgroundBuild m_background_build;
+        XMakeWatch m_watch;
 
         QStringList m_pending_config_args;
 
-        Utils::FileSystemWatcher m_intro_watcher;
+        bool m_cache_checked = false;
+        bool m_adopted       = false;
+
+        QDateTime m_last_configure;
+
+        // the inputs of every target at the last successful build, with the time it started
+        XMakeProjectParser::BuildInputs m_build_inputs;
+        QDateTime m_build_inputs_time;
+        // the detection results of the running configuration go to the shared cache
+        Utils::FilePath m_detection_dir;
+
+        Utils::FileSystemWatcher m_project_files_watcher;
+        QHash<Utils::FilePath, QByteArray> m_project_file_hashes;
 
         QtSupport::CppKitInfo m_kit_info;
+
+        // what the QML code model was last given
+        QStringList m_qml_import_paths;
+        Utils::FilePaths m_qml_source_files;
     };
 } // namespace XMakeProjectManager::Internal
 
@@ -9,6 +9,10 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     inline auto XMakeBuildSystem::name() const -> QString { return QStringLiteral("XMake"); }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildSystem::adoptConfiguration() noexcept -> void { m_adopted = true; }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     inline auto XMakeBuildSystem::buildOptionsList() const noexcept -> const BuildOptionsList & {
@@ -21,6 +25,12 @@ namespace XMakeProjectManager::Internal {
         return m_parser.targets();
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildSystem::fileIndex() const noexcept -> const XMakeFileIndex & {
+        return m_parser.fileIndex();
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     inline auto XMakeBuildSystem::targetList() const noexcept -> const QStringList & {
@@ -33,6 +43,16 @@ namespace XMakeProjectManager::Internal {
         m_pending_config_args = args;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildSystem::buildInBackground(const QStringList &target_names) -> void {
+        m_background_build.build(target_names);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildSystem::watch() noexcept -> XMakeWatch & { return m_watch; }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     inline auto XMakeBuildSystem::parser() const noexcept -> const XMakeProjectParser & {
@@ -0,0 +1,102 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeCompilationDatabase.hpp"
+
+#include <projectexplorer/projectexplorerconstants.h>
+#include <projectexplorer/toolchain.h>
+
+#include <qtsupport/qtcppkitinfo.h>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
+#include <QSaveFile>
+
+namespace XMakeProjectManager::Internal {
+    static Q_LOGGING_CATEGORY(xmake_compilation_database_log,
+                              "qtc.xmake.compilationdatabase",
+                              QtDebugMsg);
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto toolChainFor(const QString &kind, const QtSupport::CppKitInfo &kit_info)
+        -> ProjectExplorer::ToolChain * {
+        if (kind == "cxx" || kind == "cxxmodules") return kit_info.cxxToolChain;
+        if (kind == "cc") return kit_info.cToolChain;
+
+        return nullptr;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeCompilationDatabase::targetEntries(const Target &target,
+                                                 const Utils::FilePath &source_dir,
+                                                 const QtSupport::CppKitInfo &kit_info)
+        -> QJsonArray {
+        auto entries = QJsonArray {};
+
+        // xmake compiles from the project directory, relative paths are resolved from there
+        const auto directory = source_dir.toString();
+
+        for (const auto &group : target.sources) {
+            const auto *tool_chain = toolChainFor(group.kind, kit_info);
+            if (!tool_chain) continue;
+
+            const auto msvc_like =
+                tool_chain->typeId() == ProjectExplorer::Constants::MSVC_TOOLCHAIN_TYPEID ||
+                tool_chain->typeId() == ProjectExplorer::Constants::CLANG_CL_TOOLCHAIN_TYPEID;
+
+            const auto compiler_arguments = [&](const QStringList &flags) {
+                auto arguments = QJsonArray { tool_chain->compilerCommand().toString() };
+                for (const auto &arg : flags) arguments.append(arg);
+                arguments.append(msvc_like ? "/c" : "-c");
+
+                return arguments;
+            };
+
+            const auto arguments = compiler_arguments(group.arguments);
+
+            for (const auto &source : group.sources) {
+                const auto file = source_dir.resolvePath(source).toString();
+
+                const auto delta = group.file_flags.value(source);
+
+                auto file_arguments = delta.isEmpty()
+                                          ? arguments
+                                          : compiler_arguments(delta.applyTo(group.arguments));
+                file_arguments.append(file);
+
+                entries.append(QJsonObject { { "directory", directory },
+                                             { "arguments", file_arguments },
+                                             { "file", file } });
+            }
+        }
+
+        return entries;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeCompilationDatabase::write(const Utils::FilePath &path, const QJsonArray &entries)
+        -> bool {
+        const auto data = QJsonDocument { entries }.toJson(QJsonDocument::Indented);
+
+        // clangd reloads the database when it is touched, an identical one is left alone
+        if (path.exists() && path.fileContents() == data) return true;
+
+        auto file = QSaveFile { path.toString() };
+        if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() ||
+            !file.commit()) {
+            qCWarning(xmake_compilation_database_log)
+                << "Failed to write" << path.toUserOutput() << file.errorString();
+            return false;
+        }
+
+        qCDebug(xmake_compilation_database_log)
+            << "Wrote" << entries.size() << "entries to" << path.toUserOutput();
+
+        return true;
+    }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,26 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <xmakeinfoparser/XMakeTargetParser.hpp>
+
+#include <utils/filepath.h>
+
+#include <QJsonArray>
+
+namespace QtSupport {
+    class CppKitInfo;
+}
+
+namespace XMakeProjectManager::Internal {
+    class XMakeCompilationDatabase {
+      public:
+        static QJsonArray targetEntries(const Target &target,
+                                        const Utils::FilePath &source_dir,
+                                        const QtSupport::CppKitInfo &kit_info);
+
+        static bool write(const Utils::FilePath &path, const QJsonArray &entries);
+    };
+} // namespace XMakeProjectManager::Internal
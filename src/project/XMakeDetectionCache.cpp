@@ -0,0 +1,99 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeDetectionCache.hpp"
+
+#include <XMakeProjectConstant.hpp>
+
+#include <settings/general/Settings.hpp>
+#include <settings/tools/kitaspect/XMakeToolKitAspect.hpp>
+
+#include <coreplugin/icore.h>
+
+#include <projectexplorer/kit.h>
+
+#include <QCryptographicHash>
+#include <QDirIterator>
+#include <QLoggingCategory>
+
+namespace XMakeProjectManager::Internal {
+    static Q_LOGGING_CATEGORY(xmake_detection_cache_log, "qtc.xmake.detectioncache", QtDebugMsg);
+
+    // written by xmake in <config dir>/.xmake/<host>/<arch>/cache, the other caches belong to
+    // the project
+    static const auto DETECTION_CACHES = QStringList { "detect", "toolchain" };
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto detectionFiles(const Utils::FilePath &root) -> Utils::FilePaths {
+        if (root.needsDevice() || !root.isDir()) return {};
+
+        auto files = Utils::FilePaths {};
+
+        auto it = QDirIterator { root.toString(),
+                                 DETECTION_CACHES,
+                                 QDir::Files,
+                                 QDirIterator::Subdirectories };
+        while (it.hasNext()) {
+            const auto file = Utils::FilePath::fromString(it.next());
+            if (file.parentDir().fileName() == QLatin1String { "cache" }) files.append(file);
+        }
+
+        return files;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto copyFiles(const Utils::FilePath &from, const Utils::FilePath &to) -> void {
+        for (const auto &file : detectionFiles(from)) {
+            const auto target = to.resolvePath(file.relativeChildPath(from).path());
+
+            if (!target.parentDir().ensureWritableDir() ||
+                !target.writeFileContents(file.fileContents()))
+                qCDebug(xmake_detection_cache_log) << "Failed to copy" << file << "to" << target;
+        }
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeDetectionCache::directory(const ProjectExplorer::Kit *kit) -> Utils::FilePath {
+        if (!kit || !Settings::instance()->shared_detection.value()) return {};
+
+        const auto *tool = XMakeToolKitAspect::xmakeTool(kit);
+        if (!tool) return {};
+
+        // the toolchains and the environment of the kit decide what xmake detects
+        auto hash = QCryptographicHash { QCryptographicHash::Sha1 };
+        hash.addData(tool->exe().toString().toUtf8());
+        hash.addData(kit->id().toString().toUtf8());
+
+        return Core::ICore::cacheResourcePath("xmake-detection")
+            .pathAppended(QString::fromLatin1(hash.result().toHex()));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeDetectionCache::seed(const Utils::FilePath &shared_dir,
+                                   const Utils::FilePath &build_dir) -> void {
+        const auto info_dir =
+            build_dir.pathAppended(QString::fromLatin1(Constants::XMAKE_INFO_DIR));
+        if (!detectionFiles(info_dir).isEmpty()) return;
+
+        qCDebug(xmake_detection_cache_log) << "Seeding" << build_dir << "from" << shared_dir;
+
+        copyFiles(shared_dir, info_dir);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeDetectionCache::store(const Utils::FilePath &shared_dir,
+                                    const Utils::FilePath &build_dir) -> void {
+        const auto info_dir =
+            build_dir.pathAppended(QString::fromLatin1(Constants::XMAKE_INFO_DIR));
+
+        qCDebug(xmake_detection_cache_log) << "Storing" << build_dir << "in" << shared_dir;
+
+        copyFiles(info_dir, shared_dir);
+    }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,28 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <utils/filepath.h>
+
+namespace ProjectExplorer {
+    class Kit;
+} // namespace ProjectExplorer
+
+namespace XMakeProjectManager::Internal {
+    // the toolchain and program detection results of xmake, shared by every build directory
+    // configured with the same xmake executable and kit so that the probes run once per machine
+    class XMakeDetectionCache {
+      public:
+        XMakeDetectionCache() = delete;
+
+        // empty when the cache is disabled or the kit has no xmake tool
+        static Utils::FilePath directory(const ProjectExplorer::Kit *kit);
+
+        // a build directory which already has detection results keeps them
+        static void seed(const Utils::FilePath &shared_dir, const Utils::FilePath &build_dir);
+        // called once a configuration succeeded, its results replace the shared ones
+        static void store(const Utils::FilePath &shared_dir, const Utils::FilePath &build_dir);
+    };
+} // namespace XMakeProjectManager::Internal
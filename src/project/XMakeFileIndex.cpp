@@ -0,0 +1,32 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeFileIndex.hpp"
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeFileIndex::XMakeFileIndex(const Utils::FilePath &src_dir, const TargetsList &targets) {
+        const auto add = [this, &src_dir](const QStringList &files, std::size_t target, int group) {
+            for (const auto &file : files) {
+                auto &owners = m_owners[src_dir.resolvePath(file).cleanPath()];
+
+                // a file listed twice in the same group is owned once
+                if (owners.isEmpty() || owners.last().target != target ||
+                    owners.last().group != group)
+                    owners.append({ target, group });
+            }
+        };
+
+        for (auto i = 0u; i < std::size(targets); ++i) {
+            const auto &target = targets[i];
+
+            for (auto group = 0u; group < std::size(target.sources); ++group)
+                add(target.sources[group].sources, i, static_cast<int>(group));
+
+            add(target.headers, i, HEADERS);
+            add(target.modules, i, MODULES);
+        }
+    }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,43 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+
+#include <utils/filepath.h>
+
+#include <xmakeinfoparser/XMakeTargetParser.hpp>
+
+namespace XMakeProjectManager::Internal {
+    // indices in the targets list and in the source groups of the target
+    struct FileOwner {
+        std::size_t target;
+        int group;
+    };
+    using FileOwnerList = QList<FileOwner>;
+
+    // file to owning targets, built with the targets it indexes and replaced with them
+    class XMakeFileIndex {
+      public:
+        // group of the files which are not in one of the source groups of the target
+        static constexpr auto HEADERS = -1;
+        static constexpr auto MODULES = -2;
+
+        XMakeFileIndex() = default;
+        XMakeFileIndex(const Utils::FilePath &src_dir, const TargetsList &targets);
+
+        // file must be absolute and clean, as the paths resolved against the source directory
+        FileOwnerList owners(const Utils::FilePath &file) const;
+        bool contains(const Utils::FilePath &file) const;
+
+        qsizetype size() const noexcept;
+
+      private:
+        QHash<Utils::FilePath, FileOwnerList> m_owners;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakeFileIndex.inl"
@@ -0,0 +1,23 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeFileIndex::owners(const Utils::FilePath &file) const -> FileOwnerList {
+        return m_owners.value(file);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeFileIndex::contains(const Utils::FilePath &file) const -> bool {
+        return m_owners.contains(file);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeFileIndex::size() const noexcept -> qsizetype { return m_owners.size(); }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,211 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeFixtureRecorder.hpp"
+
+#include <XMakeProjectConstant.hpp>
+
+#include <settings/general/Settings.hpp>
+
+#include <coreplugin/icore.h>
+
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValue>
+#include <QDateTime>
+#include <QDir>
+#include <QJsonDocument>
+#include <QLoggingCategory>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace XMakeProjectManager::Internal {
+    static Q_LOGGING_CATEGORY(xmake_fixture_recorder_log, "qtc.xmake.fixtures", QtDebugMsg);
+
+    using Replacements = std::vector<std::pair<QString, QString>>;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto isSeparator(QChar c) -> bool { return c == '/' || c == '\\'; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto isNameChar(QChar c) -> bool {
+        return c.isLetterOrNumber() || c == '_' || c == '-' || c == '.' || c == '+' || c == '~';
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto isWholePath(const QString &string, qsizetype begin, qsizetype end) -> bool {
+        // /home/user matches neither /home/username nor /mnt/home/user, but does -I/home/user
+        if (end < std::size(string) && isNameChar(string[end])) return false;
+
+        auto first = begin;
+        while (first > 0 && isNameChar(string[first - 1])) --first;
+
+        return first == 0 || !isSeparator(string[first - 1]);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto substitute(QString string, const Replacements &replacements) -> QString {
+        for (const auto &[path, placeholder] : replacements) {
+            auto begin = string.indexOf(path);
+            while (begin != -1) {
+                const auto end = begin + std::size(path);
+                if (!isWholePath(string, begin, end)) {
+                    begin = string.indexOf(path, end);
+                    continue;
+                }
+
+                string.replace(begin, std::size(path), placeholder);
+                begin = string.indexOf(path, begin + std::size(placeholder));
+            }
+        }
+
+        return string;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto removeOldFixtures(const Utils::FilePath &directory) -> void {
+        // newest first
+        const auto fixtures =
+            directory.dirEntries({ { "*.json", "*.cbor" }, QDir::Files }, QDir::Time);
+
+        for (auto i = Constants::MAX_FIXTURES; i < std::size(fixtures); ++i) {
+            if (!fixtures[i].removeFile())
+                qCDebug(xmake_fixture_recorder_log) << "Failed to remove" << fixtures[i];
+        }
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto substitute(const QCborValue &value, const Replacements &replacements)
+        -> QCborValue {
+        if (value.isString()) return substitute(value.toString(), replacements);
+
+        if (value.isArray()) {
+            auto array = QCborArray {};
+            for (const auto &element : value.toArray())
+                array.append(substitute(element, replacements));
+
+            return array;
+        }
+
+        // the CBOR documents of the script are tagged as self-described
+        if (value.isTag())
+            return QCborValue { value.tag(), substitute(value.taggedValue(), replacements) };
+
+        // the files of a target are also used as keys
+        if (value.isMap()) {
+            const auto source = value.toMap();
+
+            auto map = QCborMap {};
+            for (auto it = std::cbegin(source); it != std::cend(source); ++it)
+                map.insert(substitute(it.key(), replacements),
+                           substitute(QCborValue { it.value() }, replacements));
+
+            return map;
+        }
+
+        return value;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto replacePaths(XMakeInfoParser::Format format,
+                             const QByteArray &data,
+                             Replacements replacements) -> QByteArray {
+        // the longest paths go first, the build directory is usually inside the project and
+        // the project inside the home directory
+        std::stable_sort(std::begin(replacements),
+                         std::end(replacements),
+                         [](const auto &lhs, const auto &rhs) {
+                             return std::size(lhs.first) > std::size(rhs.first);
+                         });
+
+        // the JSON output may start with diagnostics and have the targets on separate lines
+        if (format == XMakeInfoParser::Format::Json) {
+            const auto json = QJsonDocument::fromJson(XMakeInfoParser::jsonDocument(data));
+            const auto document =
+                substitute(QCborValue::fromJsonValue(json.object()), replacements);
+
+            return QJsonDocument { document.toJsonValue().toObject() }.toJson(
+                QJsonDocument::Compact);
+        }
+
+        return substitute(QCborValue::fromCbor(data), replacements).toCbor();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto placeholders(const Utils::FilePath &src_dir, const Utils::FilePath &build_dir)
+        -> std::vector<std::pair<Utils::FilePath, QString>> {
+        return { { build_dir, QStringLiteral("$(buildir)") },
+                 { src_dir, QStringLiteral("$(projectdir)") },
+                 { Utils::FilePath::fromString(QDir::homePath()), QStringLiteral("$(home)") } };
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeFixtureRecorder::directory() -> Utils::FilePath {
+        const auto variable = qEnvironmentVariable(Constants::FIXTURES_DIR_VARIABLE);
+        if (!variable.isEmpty()) return Utils::FilePath::fromUserInput(variable);
+
+        if (!Settings::instance()->record_fixtures.value()) return {};
+
+        return Core::ICore::userResourcePath("xmake-fixtures");
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeFixtureRecorder::record(const Utils::FilePath &directory,
+                                      XMakeInfoParser::Format format,
+                                      const QByteArray &payload,
+                                      const Utils::FilePath &src_dir,
+                                      const Utils::FilePath &build_dir) -> void {
+        auto replacements = Replacements {};
+        for (const auto &[path, placeholder] : placeholders(src_dir, build_dir)) {
+            if (path.isEmpty()) continue;
+
+            replacements.emplace_back(path.toString(), placeholder);
+            if (path.nativePath() != path.toString())
+                replacements.emplace_back(path.nativePath(), placeholder);
+        }
+
+        const auto data = replacePaths(format, payload, std::move(replacements));
+
+        const auto name = QString { "%1-%2.%3" }.arg(
+            src_dir.fileName(),
+            QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss"),
+            format == XMakeInfoParser::Format::Json ? QStringLiteral("json")
+                                                    : QStringLiteral("cbor"));
+        const auto fixture = directory.pathAppended(name);
+
+        if (!directory.ensureWritableDir() || !fixture.writeFileContents(data)) {
+            qCDebug(xmake_fixture_recorder_log) << "Failed to write" << fixture;
+            return;
+        }
+
+        qCDebug(xmake_fixture_recorder_log) << "Recorded" << fixture;
+
+        removeOldFixtures(directory);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeFixtureRecorder::restore(const QByteArray &fixture,
+                                       XMakeInfoParser::Format format,
+                                       const Utils::FilePath &src_dir,
+                                       const Utils::FilePath &build_dir) -> QByteArray {
+        auto replacements = Replacements {};
+        for (const auto &[path, placeholder] : placeholders(src_dir, build_dir))
+            replacements.emplace_back(placeholder, path.toString());
+
+        return replacePaths(format, fixture, std::move(replacements));
+    }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,37 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <xmakeinfoparser/XMakeInfoParser.hpp>
+
+#include <utils/filepath.h>
+
+#include <QByteArray>
+
+namespace XMakeProjectManager::Internal {
+    // keeps the introspection documents of real projects to replay them through the decoding,
+    // the project tree and the project parts, the paths of the machine are replaced
+    class XMakeFixtureRecorder {
+      public:
+        XMakeFixtureRecorder() = delete;
+
+        // empty when neither the setting nor the environment variable enable the recording
+        static Utils::FilePath directory();
+
+        // called from the parser worker with the complete output, format is the one it was
+        // decoded from, only the last MAX_FIXTURES documents are kept
+        static void record(const Utils::FilePath &directory,
+                           XMakeInfoParser::Format format,
+                           const QByteArray &payload,
+                           const Utils::FilePath &src_dir,
+                           const Utils::FilePath &build_dir);
+
+        // the document of a fixture with its placeholders replaced by these directories
+        static QByteArray restore(const QByteArray &fixture,
+                                  XMakeInfoParser::Format format,
+                                  const Utils::FilePath &src_dir,
+                                  const Utils::FilePath &build_dir);
+    };
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,186 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeIntrospectionCache.hpp"
+
+#include <XMakeProjectConstant.hpp>
+
+#include <exewrappers/XMakeWrapper.hpp>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDirIterator>
+#include <QFile>
+#include <QLoggingCategory>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <utility>
+
+namespace XMakeProjectManager::Internal {
+    static Q_LOGGING_CATEGORY(xmake_introspection_cache_log,
+                              "qtc.xmake.introspectioncache",
+                              QtDebugMsg);
+
+    static constexpr auto CACHE_MAGIC   = quint32 { 0x584d4943 };
+    static constexpr auto CACHE_VERSION = quint32 { 3 };
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeIntrospectionCache::XMakeIntrospectionCache(const Utils::FilePath &build_dir)
+        : m_build_dir { build_dir },
+          m_path { build_dir.pathAppended(Constants::XMAKE_INTROSPECTION_CACHE) } {}
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionCache::key(const Utils::FilePath &xmake, const QStringList &config_args)
+        -> QByteArray {
+        auto hash = QCryptographicHash { QCryptographicHash::Sha1 };
+
+        // the introspection script ships with the plugin, a new version invalidates every cache
+        hash.addData(XMakeWrapper::introspectScriptHash());
+        hash.addData(xmake.toString().toUtf8());
+        hash.addData(QByteArray::number(xmake.lastModified().toMSecsSinceEpoch()));
+        for (const auto &arg : config_args) {
+            hash.addData(arg.toUtf8());
+            hash.addData("\0", 1);
+        }
+
+        return hash.result();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionCache::load(const QByteArray &key) const -> Utils::optional<Entry> {
+        auto file = QFile { m_path.toString() };
+        if (!file.open(QIODevice::ReadOnly)) return Utils::nullopt;
+
+        auto stream = QDataStream { &file };
+
+        auto magic   = quint32 {};
+        auto version = quint32 {};
+        stream >> magic >> version;
+        if (magic != CACHE_MAGIC || version != CACHE_VERSION) return Utils::nullopt;
+
+        auto stored_key = QByteArray {};
+        stream >> stored_key;
+        if (stored_key != key) {
+            qCDebug(xmake_introspection_cache_log) << "Cache key changed" << m_path.toUserOutput();
+            return Utils::nullopt;
+        }
+
+        auto stale = false;
+
+        auto count = quint32 {};
+        stream >> count;
+        for (auto i = quint32 { 0 }; i < count; ++i) {
+            auto file_path = QString {};
+            auto hash      = QByteArray {};
+            stream >> file_path >> hash;
+
+            if (stream.status() != QDataStream::Ok) return Utils::nullopt;
+
+            if (!stale && fileHash(Utils::FilePath::fromString(file_path)) != hash) {
+                qCDebug(xmake_introspection_cache_log) << file_path << "changed since last parse";
+                stale = true;
+            }
+        }
+
+        auto payload = QByteArray {};
+        stream >> payload;
+        if (stream.status() != QDataStream::Ok) return Utils::nullopt;
+
+        qCDebug(xmake_introspection_cache_log) << "Using cached introspection" << m_path.toUserOutput();
+
+        return Entry { std::move(payload), stale };
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionCache::store(const QByteArray &key,
+                                        const QByteArray &payload,
+                                        const std::vector<Utils::FilePath> &project_files) const
+        -> bool {
+        auto file = QSaveFile { m_path.toString() };
+        if (!file.open(QIODevice::WriteOnly)) return false;
+
+        auto stream = QDataStream { &file };
+        stream << CACHE_MAGIC << CACHE_VERSION << key;
+
+        const auto config_files = configFiles();
+
+        stream << static_cast<quint32>(std::size(project_files) + std::size(config_files));
+        for (const auto &files : { std::cref(project_files), std::cref(config_files) })
+            for (const auto &file_path : files.get())
+                stream << file_path.toString() << fileHash(file_path);
+
+        stream << payload;
+
+        if (stream.status() != QDataStream::Ok || !file.commit()) {
+            qCWarning(xmake_introspection_cache_log) << "Failed to write" << m_path.toUserOutput();
+            return false;
+        }
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionCache::remove() const -> void {
+        if (m_path.exists()) m_path.removeFile();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionCache::configHash() const -> QByteArray {
+        const auto info_dir = m_build_dir.pathAppended(Constants::XMAKE_INFO_DIR);
+
+        auto files = configFiles();
+        std::sort(std::begin(files), std::end(files));
+
+        auto hash = QCryptographicHash { QCryptographicHash::Sha1 };
+        for (const auto &file_path : files) {
+            hash.addData(file_path.relativeChildPath(info_dir).toString().toUtf8());
+
+            // xmake.conf has one key per line, buildir is the -o of xmake f
+            for (const auto &line : file_path.fileContents().split('\n')) {
+                if (line.left(line.indexOf('=')).trimmed() == "buildir") continue;
+
+                hash.addData(line);
+            }
+        }
+
+        return hash.result();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionCache::configFiles() const -> std::vector<Utils::FilePath> {
+        // toolchains and options are resolved from the configuration written by xmake f
+        const auto info_dir = m_build_dir.pathAppended(Constants::XMAKE_INFO_DIR);
+
+        auto files = std::vector<Utils::FilePath> {};
+
+        auto it = QDirIterator { info_dir.toString(),
+                                 { "xmake.conf" },
+                                 QDir::Files,
+                                 QDirIterator::Subdirectories };
+        while (it.hasNext()) files.emplace_back(Utils::FilePath::fromString(it.next()));
+
+        return files;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionCache::fileHash(const Utils::FilePath &file_path) -> QByteArray {
+        auto file = QFile { file_path.toString() };
+        if (!file.open(QIODevice::ReadOnly)) return {};
+
+        auto hash = QCryptographicHash { QCryptographicHash::Sha1 };
+        hash.addData(&file);
+
+        return hash.result();
+    }
+} // namespace XMakeProjectManager::Internal
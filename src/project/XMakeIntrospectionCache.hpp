@@ -0,0 +1,53 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <utils/filepath.h>
+#include <utils/optional.h>
+
+#include <QByteArray>
+#include <QStringList>
+
+#include <vector>
+
+namespace XMakeProjectManager::Internal {
+    class XMakeIntrospectionCache {
+      public:
+        explicit XMakeIntrospectionCache(const Utils::FilePath &build_dir);
+
+        // a stale entry was stored before a project file changed, it still describes the same
+        // configuration and is good enough to show until the next introspection. A fresh one
+        // may miss the files matched by a glob, it is only shown until the next one too
+        struct Entry {
+            QByteArray payload;
+            bool stale = false;
+        };
+
+        static QByteArray key(const Utils::FilePath &xmake, const QStringList &config_args);
+
+        Utils::optional<Entry> load(const QByteArray &key) const;
+        bool store(const QByteArray &key,
+                   const QByteArray &payload,
+                   const std::vector<Utils::FilePath> &project_files) const;
+        void remove() const;
+
+        // hash of the configuration written by xmake f, without the build output directory it
+        // records and the location of the configuration itself
+        QByteArray configHash() const;
+
+        const Utils::FilePath &path() const noexcept;
+
+      private:
+        Utils::FilePath m_build_dir;
+
+        std::vector<Utils::FilePath> configFiles() const;
+
+        static QByteArray fileHash(const Utils::FilePath &file);
+
+        Utils::FilePath m_path;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakeIntrospectionCache.inl"
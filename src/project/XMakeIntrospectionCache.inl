@@ -0,0 +1,13 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeIntrospectionCache::path() const noexcept -> const Utils::FilePath & {
+        return m_path;
+    }
+} // namespace XMakeProjectManager::Internal
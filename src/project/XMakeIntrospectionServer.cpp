@@ -0,0 +1,339 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeIntrospectionServer.hpp"
+
+#include <XMakeProjectConstant.hpp>
+
+#include <project/XMakeProcessQueue.hpp>
+#include <project/parsers/XMakeOutputParser.hpp>
+#include <settings/general/Settings.hpp>
+
+#include <projectexplorer/buildsystem.h>
+
+#include <utils/qtcprocess.h>
+
+#include <QCryptographicHash>
+#include <QLoggingCategory>
+
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
+#include <utility>
+
+namespace XMakeProjectManager::Internal {
+    static Q_LOGGING_CATEGORY(xmake_introspection_server_log,
+                              "qtc.xmake.introspectionserver",
+                              QtDebugMsg);
+
+    static constexpr auto MINUTE = 60 * 1000;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto servers()
+        -> std::unordered_map<QString, std::unique_ptr<XMakeIntrospectionServer>> & {
+        static auto servers =
+            std::unordered_map<QString, std::unique_ptr<XMakeIntrospectionServer>> {};
+
+        return servers;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeIntrospectionServer::XMakeIntrospectionServer(Command command, Utils::Environment env)
+        : m_command { std::move(command) }, m_env { std::move(env) } {
+        m_idle_timer.setSingleShot(true);
+
+        connect(&m_idle_timer, &QTimer::timeout, this, &XMakeIntrospectionServer::shutdown);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeIntrospectionServer::~XMakeIntrospectionServer() {
+        XMakeProcessQueue::instance().release(this);
+
+        if (!m_process) return;
+
+        m_process->disconnect();
+        m_process->close();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionServer::instance(const Command &command, const Utils::Environment &env)
+        -> XMakeIntrospectionServer & {
+        // the configuration directory selects the build directory the project is loaded from, a
+        // changed environment (toolchain paths, XMAKE_GLOBALDIR) needs a new process
+        auto variables = env.toStringList();
+        variables.sort();
+
+        const auto env_hash =
+            QCryptographicHash::hash(variables.join('\n').toUtf8(), QCryptographicHash::Sha1)
+                .toHex();
+
+        const auto prefix =
+            command.toUserOutput() + '|' + env.expandedValueForKey("XMAKE_CONFIGDIR") + '|';
+        const auto key = prefix + QString::fromLatin1(env_hash);
+
+        // an idle server of the previous environment is stopped, a busy one times out later
+        for (auto &[other_key, other] : servers())
+            if (other_key != key && other_key.startsWith(prefix)) other->shutdown();
+
+        auto &server = servers()[key];
+        if (!server) server = std::make_unique<XMakeIntrospectionServer>(command, env);
+
+        return *server;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionServer::shutdownAll() -> void { servers().clear(); }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionServer::introspect(QObject *context,
+                                              Callback callback,
+                                              QStringList project_files,
+                                              DataCallback on_data) -> void {
+        m_idle_timer.stop();
+
+        m_pending_requests.push_back(
+            { context, std::move(callback), std::move(project_files), std::move(on_data) });
+
+        if (!m_process) {
+            queueStart();
+            return;
+        }
+
+        if (!m_stopping && !isBusy()) sendRequest();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionServer::query(QObject *context, QByteArray query, Callback callback)
+        -> void {
+        m_idle_timer.stop();
+
+        m_pending_requests.push_back({ context, std::move(callback), {}, {}, std::move(query) });
+
+        if (!m_process) {
+            queueStart();
+            return;
+        }
+
+        if (!m_stopping && !isBusy()) sendRequest();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionServer::shutdown() -> void {
+        if (!m_process || m_stopping || isBusy()) return;
+
+        qCDebug(xmake_introspection_server_log)
+            << "Stopping idle introspection server" << m_command.toUserOutput();
+
+        m_idle_timer.stop();
+        m_stopping = true;
+
+        m_process->writeRaw(Constants::Introspection::SERVER_QUIT);
+        m_process->closeWriteChannel();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionServer::queueStart() -> void {
+        if (std::exchange(m_starting, true)) return;
+
+        // the server holds a slot of the queue while it runs, idle it gives it back
+        XMakeProcessQueue::instance().enqueue(
+            this,
+            m_command.workDir(),
+            [this] {
+                m_starting = false;
+
+                if (!start()) {
+                    XMakeProcessQueue::instance().release(this);
+                    finishRequest(-1, {});
+                    return;
+                }
+
+                sendRequest();
+            },
+            [this] {
+                if (isBusy() || !m_pending_requests.empty()) return false;
+
+                shutdown();
+                return m_stopping;
+            });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionServer::start() -> bool {
+        qCDebug(xmake_introspection_server_log)
+            << "Starting introspection server" << m_command.toUserOutput();
+
+        m_buffer.clear();
+
+        m_process = std::make_unique<Utils::QtcProcess>();
+        m_process->setProcessMode(Utils::ProcessMode::Writer);
+        m_process->setWorkingDirectory(m_command.workDir());
+        m_process->setEnvironment(m_env);
+        m_process->setCommand(m_command.cmdLine());
+
+        m_process->setStdErrLineCallback([](const QString &s) {
+            // the answers come without a progress bar
+            if (XMakeOutputParser::isProgressLine(s)) return;
+
+            ProjectExplorer::BuildSystem::appendBuildSystemOutput(s.trimmed());
+        });
+
+        connect(m_process.get(),
+                &Utils::QtcProcess::readyReadStandardOutput,
+                this,
+                &XMakeIntrospectionServer::handleStdOut);
+        connect(m_process.get(),
+                &Utils::QtcProcess::done,
+                this,
+                &XMakeIntrospectionServer::handleProcessDone);
+
+        m_process->start();
+
+        if (!m_process->waitForStarted()) {
+            m_process->disconnect();
+            m_process.reset();
+
+            return false;
+        }
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionServer::sendRequest() -> void {
+        if (!m_pending_requests.front().query.isEmpty()) {
+            m_running_requests.push_back(std::move(m_pending_requests.front()));
+            m_pending_requests.erase(std::begin(m_pending_requests));
+
+            m_process->writeRaw(m_running_requests.front().query + '\n');
+            return;
+        }
+
+        // every introspection queued while the previous answer was computed is served by one
+        // answer, the queries wait for the next one
+        const auto queries = std::stable_partition(std::begin(m_pending_requests),
+                                                   std::end(m_pending_requests),
+                                                   [](const auto &request) {
+                                                       return request.query.isEmpty();
+                                                   });
+        m_running_requests.assign(std::make_move_iterator(std::begin(m_pending_requests)),
+                                  std::make_move_iterator(queries));
+        m_pending_requests.erase(std::begin(m_pending_requests), queries);
+
+        auto project_files = QStringList {};
+        for (const auto &request : m_running_requests) {
+            // one of the requests needs the whole project, no need to filter the answer
+            if (request.project_files.isEmpty()) {
+                project_files.clear();
+                break;
+            }
+
+            project_files.append(request.project_files);
+        }
+        project_files.removeDuplicates();
+
+        auto request = QByteArray { Constants::Introspection::SERVER_REQUEST };
+        if (!project_files.isEmpty())
+            request += ' ' + project_files.join(Constants::Introspection::FILTER_SEPARATOR).toUtf8();
+        request += '\n';
+
+        m_process->writeRaw(request);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionServer::handleStdOut() -> void {
+        static const auto marker = QByteArray { Constants::Introspection::SERVER_END_MARKER };
+
+        const auto chunk = m_process->readAllStandardOutput();
+
+        // streamed targets are decoded while the answer is still being written
+        for (const auto &request : m_running_requests)
+            if (request.context && request.on_data) request.on_data(chunk);
+
+        m_buffer.append(chunk);
+
+        for (auto pos = m_buffer.indexOf(marker); pos != -1; pos = m_buffer.indexOf(marker)) {
+            const auto end = m_buffer.indexOf('\n', pos);
+            if (end == -1) return;
+
+            const auto status_begin = pos + marker.size();
+            const auto status = m_buffer.mid(status_begin, end - status_begin).trimmed().toInt();
+            const auto data   = m_buffer.left(pos);
+
+            m_buffer.remove(0, end + 1);
+
+            finishRequest(status, data);
+        }
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionServer::handleProcessDone() -> void {
+        qCDebug(xmake_introspection_server_log)
+            << "Introspection server exited" << m_process->exitCode();
+
+        m_process.release()->deleteLater();
+        m_idle_timer.stop();
+
+        XMakeProcessQueue::instance().release(this);
+
+        // the requests came after the quit one, a new process answers them
+        if (std::exchange(m_stopping, false) && m_running_requests.empty() &&
+            !m_pending_requests.empty()) {
+            queueStart();
+            return;
+        }
+
+        auto requests = std::move(m_running_requests);
+        m_running_requests.clear();
+
+        std::move(std::begin(m_pending_requests),
+                  std::end(m_pending_requests),
+                  std::back_inserter(requests));
+        m_pending_requests.clear();
+
+        for (auto &request : requests)
+            if (request.context) request.callback(-1, {});
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionServer::finishRequest(int code, const QByteArray &data) -> void {
+        auto requests = std::move(m_running_requests);
+        m_running_requests.clear();
+
+        if (!m_process) {
+            std::move(std::begin(m_pending_requests),
+                      std::end(m_pending_requests),
+                      std::back_inserter(requests));
+            m_pending_requests.clear();
+        }
+
+        for (auto &request : requests)
+            if (request.context) request.callback(code, data);
+
+        if (!m_process) return;
+
+        if (!m_pending_requests.empty()) sendRequest();
+        else if (!isBusy()) {
+            // other xmake processes wait for the slot of the idle server
+            if (XMakeProcessQueue::instance().pendingCount() > 0) shutdown();
+            else
+                m_idle_timer.start(
+                    Settings::instance()->introspection_server_idle_timeout.value() * MINUTE);
+        }
+    }
+} // namespace XMakeProjectManager::Internal
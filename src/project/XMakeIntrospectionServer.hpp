@@ -0,0 +1,88 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <exewrappers/XMakeWrapper.hpp>
+
+#include <utils/environment.h>
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Utils {
+    class QtcProcess;
+} // namespace Utils
+
+namespace XMakeProjectManager::Internal {
+    class XMakeIntrospectionServer final: public QObject {
+        Q_OBJECT
+
+      public:
+        using Callback     = std::function<void(int, QByteArray)>;
+        using DataCallback = std::function<void(const QByteArray &)>;
+
+        XMakeIntrospectionServer(Command command, Utils::Environment env);
+        ~XMakeIntrospectionServer() override;
+
+        XMakeIntrospectionServer(XMakeIntrospectionServer &&)      = delete;
+        XMakeIntrospectionServer(const XMakeIntrospectionServer &) = delete;
+
+        XMakeIntrospectionServer &operator=(XMakeIntrospectionServer &&)      = delete;
+        XMakeIntrospectionServer &operator=(const XMakeIntrospectionServer &) = delete;
+
+        static XMakeIntrospectionServer &instance(const Command &command,
+                                                  const Utils::Environment &env);
+        static void shutdownAll();
+
+        void introspect(QObject *context,
+                        Callback callback,
+                        QStringList project_files = {},
+                        DataCallback on_data      = {});
+        // a request line of the script other than an introspection, answered on its own
+        void query(QObject *context, QByteArray query, Callback callback);
+        void shutdown();
+
+        [[nodiscard]] bool isRunning() const noexcept;
+        [[nodiscard]] bool isBusy() const noexcept;
+
+      private:
+        struct Request {
+            QPointer<QObject> context;
+            Callback callback;
+            QStringList project_files;
+            DataCallback on_data;
+            QByteArray query;
+        };
+
+        void queueStart();
+        bool start();
+        void sendRequest();
+        void handleStdOut();
+        void handleProcessDone();
+        void finishRequest(int code, const QByteArray &data);
+
+        Command m_command;
+        Utils::Environment m_env;
+
+        std::unique_ptr<Utils::QtcProcess> m_process;
+        QByteArray m_buffer;
+
+        QTimer m_idle_timer;
+        // waiting for a slot of the process queue
+        bool m_starting = false;
+        // the quit request was written, the next requests go to a new process
+        bool m_stopping = false;
+
+        std::vector<Request> m_running_requests;
+        std::vector<Request> m_pending_requests;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakeIntrospectionServer.inl"
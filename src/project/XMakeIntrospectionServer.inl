@@ -0,0 +1,19 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeIntrospectionServer::isRunning() const noexcept -> bool {
+        return m_process != nullptr;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeIntrospectionServer::isBusy() const noexcept -> bool {
+        return !m_running_requests.empty();
+    }
+} // namespace XMakeProjectManager::Internal
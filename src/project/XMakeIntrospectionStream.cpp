@@ -0,0 +1,57 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeIntrospectionStream.hpp"
+
+#include <XMakeProjectConstant.hpp>
+
+#include <xmakeinfoparser/parsers/TargetParser.hpp>
+
+#include <projectexplorer/projectexplorer.h>
+
+#include <utils/runextensions.h>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeIntrospectionStream::XMakeIntrospectionStream(Utils::FilePath root)
+        : m_root { std::move(root) } {}
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionStream::append(const QByteArray &chunk) -> void {
+        static const auto marker = QByteArray { Constants::Introspection::TARGET_MARKER };
+
+        m_buffer.append(chunk);
+
+        // only complete lines are looked at, the tail waits for the next chunk
+        auto begin = qsizetype { 0 };
+        for (auto end = m_buffer.indexOf('\n'); end != -1; end = m_buffer.indexOf('\n', begin)) {
+            const auto line = QByteArrayView { m_buffer }.sliced(begin, end - begin);
+            begin           = end + 1;
+
+            if (!line.startsWith(marker)) continue;
+
+            // the line is parsed on the worker too, it is most of the decoding time
+            m_targets.emplace_back(
+                Utils::runAsync(ProjectExplorer::ProjectExplorerPlugin::sharedThreadPool(),
+                                [json = line.sliced(marker.size()).toByteArray(), root = m_root] {
+                                    const auto document = QJsonDocument::fromJson(json);
+
+                                    return TargetParser::loadTarget(document.object(), root);
+                                }));
+        }
+
+        m_buffer.remove(0, begin);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeIntrospectionStream::takeTargets() -> TargetsList {
+        return TargetParser::takeTargets(m_targets);
+    }
+} // namespace XMakeProjectManager::Internal
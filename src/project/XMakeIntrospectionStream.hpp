@@ -0,0 +1,32 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <xmakeinfoparser/XMakeTargetParser.hpp>
+
+#include <utils/filepath.h>
+
+#include <QByteArray>
+#include <QFuture>
+
+#include <vector>
+
+namespace XMakeProjectManager::Internal {
+    class XMakeIntrospectionStream {
+      public:
+        explicit XMakeIntrospectionStream(Utils::FilePath root);
+
+        void append(const QByteArray &chunk);
+
+        TargetsList takeTargets();
+
+      private:
+        Utils::FilePath m_root;
+
+        QByteArray m_buffer;
+
+        std::vector<QFuture<Target>> m_targets;
+    };
+} // namespace XMakeProjectManager::Internal
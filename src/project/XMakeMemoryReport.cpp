@@ -0,0 +1,132 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeMemoryReport.hpp"
+
+#include <project/projecttree/XMakeProjectNodes.hpp>
+
+#include <QLocale>
+#include <QSet>
+
+namespace XMakeProjectManager::Internal {
+    // header of the Qt containers data blocks
+    static constexpr auto DATA_HEADER = qint64 { 16 };
+
+    class ByteCounter {
+      public:
+        auto string(const QString &value) -> qint64 {
+            if (value.isEmpty() || !unique(value.constData())) return 0;
+
+            return DATA_HEADER + value.capacity() * qint64 { sizeof(QChar) };
+        }
+
+        auto bytes(const QByteArray &value) -> qint64 {
+            if (value.isEmpty() || !unique(value.constData())) return 0;
+
+            return DATA_HEADER + value.capacity();
+        }
+
+        auto list(const QStringList &values) -> qint64 {
+            if (values.isEmpty() || !unique(values.constData())) return 0;
+
+            auto size = DATA_HEADER + values.capacity() * qint64 { sizeof(QString) };
+            for (const auto &value : values) size += string(value);
+
+            return size;
+        }
+
+      private:
+        auto unique(const void *data) -> bool {
+            if (m_seen.contains(data)) return false;
+
+            m_seen.insert(data);
+            return true;
+        }
+
+        QSet<const void *> m_seen;
+    };
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto MemoryReport::toString() const -> QString {
+        const auto locale = QLocale {};
+
+        return QString { "%1 (targets %2, paths %3, arguments %4, tree nodes %5, project parts "
+                         "%6)" }
+            .arg(locale.formattedDataSize(total()),
+                 locale.formattedDataSize(targets),
+                 locale.formattedDataSize(paths),
+                 locale.formattedDataSize(arguments),
+                 locale.formattedDataSize(tree_nodes),
+                 locale.formattedDataSize(project_parts));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto MemoryReport::estimate(const TargetsList &targets,
+                                const XMakeProjectNode *root_node,
+                                const ProjectExplorer::RawProjectParts &project_parts)
+        -> MemoryReport {
+        auto counter = ByteCounter {};
+        auto report  = MemoryReport {};
+
+        // the paths are interned, counted first they are not charged to the project parts
+        for (const auto &target : targets) {
+            report.paths += counter.list(target.headers) + counter.list(target.modules);
+
+            for (const auto &group : target.sources) {
+                report.paths += counter.list(group.sources);
+                report.arguments += counter.list(group.arguments);
+            }
+        }
+
+        for (const auto &target : targets) {
+            report.targets += qint64 { sizeof(Target) } +
+                              qint64 { sizeof(Target::SourceGroup) } *
+                                  static_cast<qint64>(target.sources.capacity()) +
+                              counter.string(target.name) + counter.string(target.defined_in) +
+                              counter.string(target.target_file) +
+                              counter.list(target.languages) + counter.list(target.group) +
+                              counter.list(target.packages) + counter.list(target.frameworks) +
+                              counter.list(target.deps) + counter.list(target.qml_import_paths) +
+                              qint64 { sizeof(std::size_t) } *
+                                  static_cast<qint64>(target.dependencies.capacity());
+
+            for (const auto &group : target.sources) report.targets += counter.string(group.kind);
+            for (const auto &[name, value] : target.set_env)
+                report.targets += counter.string(name) + counter.string(value);
+            for (const auto &[name, values] : target.add_env)
+                report.targets += counter.string(name) + counter.list(values);
+        }
+
+        if (root_node) {
+            // the nodes compose their paths, they don't share the target ones
+            root_node->forEachGenericNode([&report](const ProjectExplorer::Node *node) {
+                const auto size = node->asFileNode() ? sizeof(ProjectExplorer::FileNode)
+                                                     : sizeof(ProjectExplorer::FolderNode);
+                report.tree_nodes += static_cast<qint64>(size) + DATA_HEADER +
+                                     node->filePath().toString().size() * qint64 { sizeof(QChar) };
+            });
+        }
+
+        for (const auto &part : project_parts) {
+            report.project_parts +=
+                qint64 { sizeof(ProjectExplorer::RawProjectPart) } +
+                counter.string(part.displayName) + counter.string(part.projectFile) +
+                counter.list(part.files) + counter.list(part.precompiledHeaders) +
+                counter.list(part.includedFiles) +
+                counter.list(part.flagsForC.commandLineFlags) +
+                counter.list(part.flagsForCxx.commandLineFlags);
+
+            for (const auto &header_path : part.headerPaths)
+                report.project_parts += qint64 { sizeof(ProjectExplorer::HeaderPath) } +
+                                        counter.string(header_path.path);
+            for (const auto &macro : part.projectMacros)
+                report.project_parts += qint64 { sizeof(ProjectExplorer::Macro) } +
+                                        counter.bytes(macro.key) + counter.bytes(macro.value);
+        }
+
+        return report;
+    }
+} // namespace XMakeProjectManager::Internal
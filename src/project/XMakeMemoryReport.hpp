@@ -0,0 +1,33 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <xmakeinfoparser/XMakeTargetParser.hpp>
+
+#include <projectexplorer/rawprojectpart.h>
+
+#include <QString>
+
+namespace XMakeProjectManager::Internal {
+    class XMakeProjectNode;
+
+    // estimated bytes held by a parse result, implicitly shared data is only counted once
+    struct MemoryReport {
+        qint64 targets       = 0;
+        qint64 paths         = 0;
+        qint64 arguments     = 0;
+        qint64 tree_nodes    = 0;
+        qint64 project_parts = 0;
+
+        qint64 total() const noexcept;
+        QString toString() const;
+
+        static MemoryReport estimate(const TargetsList &targets,
+                                     const XMakeProjectNode *root_node,
+                                     const ProjectExplorer::RawProjectParts &project_parts);
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakeMemoryReport.inl"
@@ -0,0 +1,54 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeMimeTypeCache.hpp"
+
+#include <utils/mimeutils.h>
+
+#include <algorithm>
+#include <array>
+
+namespace XMakeProjectManager::Internal {
+    // listed in the Headers and Modules nodes of a target instead of its Source Files
+    static constexpr auto HEADER_AND_MODULE_SUFFIXES = std::array {
+        QLatin1String { "h" },   QLatin1String { "hpp" }, QLatin1String { "hxx" },
+        QLatin1String { "inl" }, QLatin1String { "tpp" }, QLatin1String { "mpp" },
+        QLatin1String { "ixx" },
+    };
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeMimeTypeCache::mimeTypeName(const QString &path) -> QString {
+        const auto file_suffix = suffix(path);
+
+        // without a suffix only the content can tell
+        if (file_suffix.isEmpty()) return Utils::mimeTypeForFile(path).name();
+
+        const auto key = file_suffix.toString();
+
+        {
+            const auto lock = QReadLocker { &m_lock };
+
+            const auto it = m_names.constFind(key);
+            if (it != std::cend(m_names)) return *it;
+        }
+
+        auto name = Utils::mimeTypeForFile(path, Utils::MimeMatchMode::MatchExtension).name();
+
+        const auto lock = QWriteLocker { &m_lock };
+        m_names.insert(key, name);
+
+        return name;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeMimeTypeCache::isHeaderOrModule(QStringView path) noexcept -> bool {
+        const auto file_suffix = suffix(path);
+
+        return std::any_of(std::cbegin(HEADER_AND_MODULE_SUFFIXES),
+                           std::cend(HEADER_AND_MODULE_SUFFIXES),
+                           [&file_suffix](const auto &s) { return file_suffix == s; });
+    }
+} // namespace XMakeProjectManager::Internal
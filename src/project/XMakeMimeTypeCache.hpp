@@ -0,0 +1,33 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QStringView>
+
+#include <algorithm>
+
+namespace XMakeProjectManager::Internal {
+    class XMakeMimeTypeCache {
+      public:
+        XMakeMimeTypeCache() = default;
+
+        XMakeMimeTypeCache(const XMakeMimeTypeCache &)            = delete;
+        XMakeMimeTypeCache &operator=(const XMakeMimeTypeCache &) = delete;
+
+        QString mimeTypeName(const QString &path);
+
+        static QStringView suffix(QStringView path) noexcept;
+        static bool isHeaderOrModule(QStringView path) noexcept;
+
+      private:
+        QReadWriteLock m_lock;
+        QHash<QString, QString> m_names;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakeMimeTypeCache.inl"
@@ -0,0 +1,18 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeMimeTypeCache::suffix(QStringView path) noexcept -> QStringView {
+        const auto dot   = path.lastIndexOf('.');
+        const auto slash = std::max(path.lastIndexOf('/'), path.lastIndexOf('\\'));
+
+        if (dot == -1 || dot < slash) return {};
+
+        return path.mid(dot + 1);
+    }
+} // namespace XMakeProjectManager::Internal
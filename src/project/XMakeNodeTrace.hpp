@@ -0,0 +1,15 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <QLoggingCategory>
+
+// a line for each node or project part of a parse, compiled out unless the plugin is built with
+// XMAKE_TRACE_NODES, the phase summaries stay in the regular categories
+#ifdef XMAKE_TRACE_NODES
+    #define XMAKE_NODE_TRACE(category) qCDebug(category)
+#else
+    #define XMAKE_NODE_TRACE(category) while (false) qCDebug(category)
+#endif
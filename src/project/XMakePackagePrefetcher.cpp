@@ -0,0 +1,197 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakePackagePrefetcher.hpp"
+
+#include <project/XMakeProcessQueue.hpp>
+
+#include <coreplugin/progressmanager/progressmanager.h>
+
+#include <projectexplorer/buildsystem.h>
+
+#include <utils/qtcassert.h>
+#include <utils/qtcprocess.h>
+
+#include <QLoggingCategory>
+
+namespace XMakeProjectManager::Internal {
+    static Q_LOGGING_CATEGORY(xmake_package_prefetcher_log,
+                              "qtc.xmake.packageprefetcher",
+                              QtDebugMsg);
+
+    // a package is downloaded then built
+    static constexpr auto PACKAGE_STEPS = 2;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakePackagePrefetcher::XMakePackagePrefetcher()
+        : m_listed_regex { R"(^\s*->\s+(\S+))" },
+          m_download_regex { R"(^\s*=>\s+download\s+(\S+)\s+\.\.\s+(ok|failed))" },
+          m_install_regex { R"(^\s*=>\s+install\s+(\S+)(?:\s+\S+)?\s+\.\.\s+(ok|failed))" } {}
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakePackagePrefetcher::~XMakePackagePrefetcher() { stop(); }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakePackagePrefetcher::run(const Command &command,
+                                     const Utils::Environment &env,
+                                     const QString &project_name) -> void {
+        QTC_ASSERT(!m_process, return);
+
+        qCDebug(xmake_package_prefetcher_log) << "Prefetching packages" << command.toUserOutput();
+
+        // the package lines are matched without the escape sequences of the colored output
+        auto process_env = env;
+        process_env.set("XMAKE_COLORTERM", "nocolor");
+
+        m_process = std::make_unique<Utils::QtcProcess>();
+        m_process->setWorkingDirectory(command.workDir());
+        m_process->setEnvironment(process_env);
+        m_process->setCommand(command.cmdLine());
+        m_process->setStdOutLineCallback([this](const QString &line) { handleLine(line); });
+        m_process->setStdErrLineCallback([](const QString &line) {
+            ProjectExplorer::BuildSystem::appendBuildSystemOutput(line.trimmed());
+        });
+
+        connect(m_process.get(),
+                &Utils::QtcProcess::done,
+                this,
+                &XMakePackagePrefetcher::handleProcessDone);
+
+        ProjectExplorer::BuildSystem::startNewBuildSystemOutput(
+            tr("Fetching the packages of %1.").arg(project_name));
+
+        m_progress = QFutureInterface<void> {};
+        m_progress.setProgressRange(0, 0);
+        m_progress.reportStarted();
+
+        Core::ProgressManager::addTask(m_progress.future(),
+                                       tr("Fetching packages of \"%1\"").arg(project_name),
+                                       "XMake.Packages");
+
+        XMakeProcessQueue::instance().enqueue(m_process.get(),
+                                              command.workDir(),
+                                              [process = m_process.get()] { process->start(); });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakePackagePrefetcher::stop() -> void {
+        if (!m_process) return;
+
+        XMakeProcessQueue::instance().release(m_process.get());
+
+        m_process->disconnect();
+        m_process->close();
+        m_process.reset();
+
+        for (auto &progress : m_package_progress) finishProgress(progress, false);
+        m_package_progress.clear();
+
+        finishProgress(m_progress, false);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakePackagePrefetcher::handleLine(const QString &line) -> void {
+        ProjectExplorer::BuildSystem::appendBuildSystemOutput(line.trimmed());
+
+        if (const auto match = m_install_regex.match(line); match.hasMatch()) {
+            setStatus(match.captured(1),
+                      match.captured(2) == "ok" ? Package::Status::Built : Package::Status::Failed);
+            return;
+        }
+
+        if (const auto match = m_download_regex.match(line); match.hasMatch()) {
+            // the download lines only give the url, which contains the package name
+            const auto url = match.captured(1);
+            for (auto it = std::cbegin(m_package_progress); it != std::cend(m_package_progress);
+                 ++it) {
+                if (!url.contains(it.key(), Qt::CaseInsensitive)) continue;
+
+                setStatus(it.key(),
+                          match.captured(2) == "ok" ? Package::Status::Building
+                                                    : Package::Status::Failed);
+                break;
+            }
+            return;
+        }
+
+        // packages to install are listed before xmake starts fetching them
+        if (const auto match = m_listed_regex.match(line); match.hasMatch())
+            setStatus(match.captured(1), Package::Status::Downloading);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakePackagePrefetcher::handleProcessDone() -> void {
+        const auto success = m_process->result() == Utils::ProcessResult::FinishedWithSuccess;
+
+        qCDebug(xmake_package_prefetcher_log) << "Package prefetch finished" << success;
+
+        XMakeProcessQueue::instance().release(m_process.get());
+        m_process.release()->deleteLater();
+
+        // without an install line, a package was either installed as a dependency of another one or
+        // not reached before xmake stopped
+        const auto status = success ? Package::Status::Built : Package::Status::Failed;
+        for (auto it = std::begin(m_package_progress); it != std::end(m_package_progress); ++it) {
+            Q_EMIT statusChanged(it.key(), status);
+            finishProgress(it.value(), success);
+        }
+        m_package_progress.clear();
+
+        finishProgress(m_progress, success);
+
+        Q_EMIT finished(success);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakePackagePrefetcher::setStatus(const QString &name, Package::Status status) -> void {
+        qCDebug(xmake_package_prefetcher_log) << "Package" << name << "is now"
+                                              << static_cast<int>(status);
+
+        Q_EMIT statusChanged(name, status);
+
+        if (status == Package::Status::Downloading) {
+            if (m_package_progress.contains(name)) return;
+
+            auto &progress = m_package_progress[name];
+            progress.setProgressRange(0, PACKAGE_STEPS);
+            progress.reportStarted();
+
+            Core::ProgressManager::addTask(progress.future(),
+                                           tr("Fetching package %1").arg(name),
+                                           Utils::Id { "XMake.Package." }.withSuffix(name));
+            return;
+        }
+
+        auto it = m_package_progress.find(name);
+        if (it == std::end(m_package_progress)) return;
+
+        if (status == Package::Status::Building) {
+            it->setProgressValue(1);
+            return;
+        }
+
+        finishProgress(*it, status == Package::Status::Built);
+        m_package_progress.erase(it);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakePackagePrefetcher::finishProgress(QFutureInterface<void> &progress, bool success)
+        -> void {
+        if (progress.isFinished()) return;
+
+        if (success) progress.setProgressValue(progress.progressMaximum());
+        else
+            progress.reportCanceled();
+
+        progress.reportFinished();
+    }
+} // namespace XMakeProjectManager::Internal
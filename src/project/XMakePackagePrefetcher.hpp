@@ -0,0 +1,66 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <exewrappers/XMakeWrapper.hpp>
+
+#include <xmakeinfoparser/XMakePackage.hpp>
+
+#include <utils/environment.h>
+
+#include <QFutureInterface>
+#include <QHash>
+#include <QObject>
+#include <QRegularExpression>
+
+#include <memory>
+
+namespace Utils {
+    class QtcProcess;
+} // namespace Utils
+
+namespace XMakeProjectManager::Internal {
+    // installs the xmake packages of a project before it is configured, each package gets its own
+    // progress entry and reports its status while xmake fetches and builds them
+    class XMakePackagePrefetcher final: public QObject {
+        Q_OBJECT
+
+      public:
+        XMakePackagePrefetcher();
+        ~XMakePackagePrefetcher() override;
+
+        XMakePackagePrefetcher(XMakePackagePrefetcher &&)      = delete;
+        XMakePackagePrefetcher(const XMakePackagePrefetcher &) = delete;
+
+        XMakePackagePrefetcher &operator=(XMakePackagePrefetcher &&)      = delete;
+        XMakePackagePrefetcher &operator=(const XMakePackagePrefetcher &) = delete;
+
+        void run(const Command &command, const Utils::Environment &env, const QString &project_name);
+        void stop();
+
+        [[nodiscard]] bool isRunning() const noexcept;
+
+      Q_SIGNALS:
+        void statusChanged(const QString &name, Package::Status status);
+        void finished(bool success);
+
+      private:
+        void handleLine(const QString &line);
+        void handleProcessDone();
+        void setStatus(const QString &name, Package::Status status);
+        void finishProgress(QFutureInterface<void> &progress, bool success);
+
+        std::unique_ptr<Utils::QtcProcess> m_process;
+
+        QFutureInterface<void> m_progress;
+        QHash<QString, QFutureInterface<void>> m_package_progress;
+
+        QRegularExpression m_listed_regex;
+        QRegularExpression m_download_regex;
+        QRegularExpression m_install_regex;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakePackagePrefetcher.inl"
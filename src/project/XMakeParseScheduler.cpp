@@ -0,0 +1,68 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeParseScheduler.hpp"
+
+#include <QLoggingCategory>
+
+#include <algorithm>
+#include <utility>
+
+namespace XMakeProjectManager::Internal {
+    static Q_LOGGING_CATEGORY(xmake_parse_scheduler_log, "qtc.xmake.parsescheduler", QtDebugMsg);
+
+    // saving several files in a row only starts one xmake run
+    static constexpr auto DEBOUNCE_INTERVAL = 250;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeParseScheduler::XMakeParseScheduler() {
+        m_debounce_timer.setSingleShot(true);
+        m_debounce_timer.setInterval(DEBOUNCE_INTERVAL);
+
+        connect(&m_debounce_timer, &QTimer::timeout, this, &XMakeParseScheduler::run);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeParseScheduler::schedule(Action action, const Utils::FilePaths &changed_files)
+        -> void {
+        m_pending_action = std::max(m_pending_action.value_or(action), action);
+
+        // a trigger without files needs the whole project, it can't be narrowed afterward
+        if (changed_files.isEmpty()) m_full_parse = true;
+        for (const auto &file : changed_files)
+            if (!m_changed_files.contains(file)) m_changed_files.append(file);
+
+        qCDebug(xmake_parse_scheduler_log)
+            << "Scheduled" << static_cast<int>(*m_pending_action) << m_changed_files
+            << (m_running ? "after the running parse" : "");
+
+        // requests arriving during a run are merged into one follow-up run
+        if (!m_running) m_debounce_timer.start();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeParseScheduler::finished() -> void {
+        m_running = false;
+
+        if (m_pending_action) m_debounce_timer.start();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeParseScheduler::run() -> void {
+        if (m_running || !m_pending_action) return;
+
+        const auto action  = *std::exchange(m_pending_action, Utils::nullopt);
+        auto changed_files = std::exchange(m_changed_files, {});
+        if (std::exchange(m_full_parse, false) || action != Action::Introspect)
+            changed_files.clear();
+
+        m_running = true;
+
+        Q_EMIT runRequested(action, changed_files);
+    }
+} // namespace XMakeProjectManager::Internal
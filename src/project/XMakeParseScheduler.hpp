@@ -0,0 +1,44 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <utils/filepath.h>
+#include <utils/optional.h>
+
+#include <QObject>
+#include <QTimer>
+
+namespace XMakeProjectManager::Internal {
+    class XMakeParseScheduler final: public QObject {
+        Q_OBJECT
+
+      public:
+        // ordered by cost, a merged request runs the most expensive action asked for
+        enum class Action { Introspect, Configure, Wipe };
+
+        XMakeParseScheduler();
+
+        void schedule(Action action, const Utils::FilePaths &changed_files = {});
+        void finished();
+
+        [[nodiscard]] bool isRunning() const noexcept;
+
+      Q_SIGNALS:
+        void runRequested(Action action, const Utils::FilePaths &changed_files);
+
+      private:
+        void run();
+
+        QTimer m_debounce_timer;
+
+        bool m_running = false;
+
+        Utils::optional<Action> m_pending_action;
+        Utils::FilePaths m_changed_files;
+        bool m_full_parse = false;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakeParseScheduler.inl"
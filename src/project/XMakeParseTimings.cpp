@@ -0,0 +1,73 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeParseTimings.hpp"
+
+#include <settings/general/Settings.hpp>
+
+#include <QLoggingCategory>
+#include <QStringList>
+
+namespace XMakeProjectManager::Internal {
+    static Q_LOGGING_CATEGORY(xmake_parse_timings_log, "qtc.xmake.timings", QtDebugMsg);
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto ParseTimings::toString() const -> QString {
+        const auto phase = [](qint64 duration) {
+            return duration < 0 ? QString { "-" } : QString { "%1 ms" }.arg(duration);
+        };
+
+        const auto text =
+            QString { "%1%2: spawn %3, configure %4, introspection %5, document %6, targets %7, "
+                      "tree %8, project parts %9, code model %10, %11 bytes, %12 targets, "
+                      "%13 files, memory %14" }
+                .arg(project,
+                     cached ? QString { " (cached)" } : QString {},
+                     phase(spawn),
+                     phase(configure),
+                     phase(introspection),
+                     phase(document),
+                     phase(targets),
+                     phase(tree),
+                     phase(project_parts))
+                .arg(phase(code_model))
+                .arg(payload_size)
+                .arg(target_count)
+                .arg(file_count)
+                .arg(memory.toString());
+
+        if (slowest_targets.empty()) return text;
+
+        auto names = QStringList {};
+        for (const auto &target : slowest_targets)
+            names << QString { "%1 %2 ms" }.arg(target.name).arg(target.total, 0, 'f', 1);
+
+        return text + QString { ", slowest targets: %1" }.arg(names.join(", "));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeParseTimings::instance() -> XMakeParseTimings & {
+        static auto timings = XMakeParseTimings {};
+
+        return timings;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeParseTimings::record(ParseTimings timings) -> void {
+        timings.finished_at = QDateTime::currentDateTime();
+
+        qCDebug(xmake_parse_timings_log).noquote() << timings.toString();
+
+        m_runs.push_back(std::move(timings));
+
+        const auto history =
+            static_cast<std::size_t>(Settings::instance()->parse_timings_history.value());
+        while (std::size(m_runs) > history) m_runs.pop_front();
+
+        Q_EMIT recorded();
+    }
+} // namespace XMakeProjectManager::Internal
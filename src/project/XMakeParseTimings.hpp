@@ -0,0 +1,74 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <QDateTime>
+#include <QObject>
+#include <QString>
+
+#include <project/XMakeMemoryReport.hpp>
+
+#include <xmakeinfoparser/XMakeTargetProfile.hpp>
+
+#include <deque>
+
+namespace XMakeProjectManager::Internal {
+    // durations in milliseconds, -1 when the phase didn't run
+    struct ParseTimings {
+        static constexpr auto SLOWEST_TARGETS = std::size_t { 5 };
+
+        QString project;
+        QDateTime started_at;
+        QDateTime finished_at;
+        bool cached = false;
+
+        qint64 spawn         = -1;
+        qint64 configure     = -1;
+        qint64 introspection = -1;
+        qint64 document      = -1;
+        qint64 targets       = -1;
+        qint64 tree          = -1;
+        qint64 project_parts = -1;
+        qint64 code_model    = -1;
+
+        qint64 payload_size = 0;
+        int target_count    = 0;
+        int file_count      = 0;
+
+        MemoryReport memory;
+
+        // the slowest targets of the introspection script, when it measured them
+        TargetProfilesList slowest_targets;
+
+        QString toString() const;
+    };
+
+    class XMakeParseTimings final: public QObject {
+        Q_OBJECT
+      public:
+        XMakeParseTimings() = default;
+
+        XMakeParseTimings(XMakeParseTimings &&)      = delete;
+        XMakeParseTimings(const XMakeParseTimings &) = delete;
+
+        XMakeParseTimings &operator=(XMakeParseTimings &&) = delete;
+        XMakeParseTimings &operator=(const XMakeParseTimings &) = delete;
+
+        static XMakeParseTimings &instance();
+
+        void record(ParseTimings timings);
+
+        // oldest first, at most Settings::parse_timings_history runs
+        const std::deque<ParseTimings> &runs() const noexcept;
+
+      Q_SIGNALS:
+        void recorded();
+
+      private:
+        std::deque<ParseTimings> m_runs;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakeParseTimings.inl"
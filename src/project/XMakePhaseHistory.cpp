@@ -0,0 +1,73 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakePhaseHistory.hpp"
+
+#include <XMakeProjectConstant.hpp>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+
+namespace XMakeProjectManager::Internal {
+    // a one-off slow run (a package downloaded, a cold disk cache) fades out after a few runs
+    static constexpr auto KEPT_RUNS = 5;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto phaseKey(XMakePhaseHistory::Phase phase) -> QString {
+        switch (phase) {
+            case XMakePhaseHistory::Phase::Configure: return QStringLiteral("configure");
+            case XMakePhaseHistory::Phase::Introspection: return QStringLiteral("introspection");
+            case XMakePhaseHistory::Phase::ConfigureAndIntrospection:
+                return QStringLiteral("configure_introspection");
+        }
+
+        return {};
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakePhaseHistory::XMakePhaseHistory(const Utils::FilePath &build_dir)
+        : m_path { build_dir.isEmpty()
+                       ? Utils::FilePath {}
+                       : build_dir.pathAppended(Constants::PHASE_HISTORY) } {}
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakePhaseHistory::estimate(Phase phase) const -> qint64 {
+        const auto runs = load()[phaseKey(phase)].toArray();
+        if (runs.isEmpty()) return -1;
+
+        auto total = qint64 { 0 };
+        for (const auto &run : runs) total += run.toInteger();
+
+        return total / runs.size();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakePhaseHistory::record(Phase phase, qint64 duration) const -> void {
+        if (m_path.isEmpty() || duration < 0) return;
+
+        auto history = load();
+
+        const auto key = phaseKey(phase);
+
+        auto runs = history[key].toArray();
+        runs.append(duration);
+        while (runs.size() > KEPT_RUNS) runs.removeFirst();
+
+        history[key] = runs;
+
+        m_path.writeFileContents(QJsonDocument { history }.toJson(QJsonDocument::Compact));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakePhaseHistory::load() const -> QJsonObject {
+        if (m_path.isEmpty() || !m_path.exists()) return {};
+
+        return QJsonDocument::fromJson(m_path.fileContents()).object();
+    }
+} // namespace XMakeProjectManager::Internal
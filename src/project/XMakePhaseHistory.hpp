@@ -0,0 +1,29 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <utils/filepath.h>
+
+#include <QJsonObject>
+
+namespace XMakeProjectManager::Internal {
+    // durations of the last xmake runs of a build directory, they drive the progress estimate
+    // of the next ones
+    class XMakePhaseHistory {
+      public:
+        enum class Phase { Configure, Introspection, ConfigureAndIntrospection };
+
+        explicit XMakePhaseHistory(const Utils::FilePath &build_dir);
+
+        // milliseconds, -1 until the phase was measured once
+        qint64 estimate(Phase phase) const;
+        void record(Phase phase, qint64 duration) const;
+
+      private:
+        QJsonObject load() const;
+
+        Utils::FilePath m_path;
+    };
+} // namespace XMakeProjectManager::Internal
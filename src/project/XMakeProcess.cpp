@@ -6,6 +6,9 @@
 #include "projectexplorer/task.h"
 #include <project/XMakeProcess.hpp>
 
+#include <XMakeProjectConstant.hpp>
+
+#include <project/XMakeProcessQueue.hpp>
 #include <project/parsers/XMakeBuildParser.hpp>
 
 #include <coreplugin/progressmanager/progressmanager.h>
@@ -22,9 +25,17 @@
 #include <QFutureWatcher>
 #include <QLoggingCategory>
 
+#include <algorithm>
+#include <utility>
+
 namespace XMakeProjectManager::Internal {
     static constexpr auto CANCEL_TIMER_INTERVAL         = 500;
-    static constexpr auto CONFIGURE_TASK_ESTIMATED_TIME = 10;
+    static constexpr auto PROGRESS_TIMER_INTERVAL       = 250;
+    static constexpr auto PROGRESS_RANGE                = 1000;
+    // in milliseconds, until a run of the phase was measured
+    static constexpr auto CONFIGURE_TASK_ESTIMATED_TIME = 10 * 1000;
+    static constexpr auto OUTPUT_FLUSH_INTERVAL         = 100;
+    static constexpr auto OUTPUT_FLUSH_SIZE             = 64 * 1024;
 
     static QString stripTrailingNewline(QStringView str) {
         if (str.endsWith('\n')) str.chop(1);
@@ -35,12 +46,23 @@ namespace XMakeProjectManager::Internal {
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    XMakeProcess::XMakeProcess() = default;
+    XMakeProcess::XMakeProcess() {
+        m_output_timer.setSingleShot(true);
+        m_output_timer.setInterval(OUTPUT_FLUSH_INTERVAL);
+
+        connect(&m_output_timer, &QTimer::timeout, this, &XMakeProcess::flushOutput);
+
+        m_progress_timer.setInterval(PROGRESS_TIMER_INTERVAL);
+        connect(&m_progress_timer, &QTimer::timeout, this, &XMakeProcess::updateProgress);
+    }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     XMakeProcess::~XMakeProcess() {
+        XMakeProcessQueue::instance().release(this);
+
         m_parser.flush();
+        flushOutput();
 
         if (m_future_watcher) {
             m_future_watcher.reset();
@@ -56,16 +78,25 @@ namespace XMakeProjectManager::Internal {
                            const Utils::Environment &env,
                            const QString &project_name,
                            const Utils::FilePath &source_path,
-                           bool capture_stdio) -> void {
+                           bool capture_stdio,
+                           bool low_priority) -> void {
         QTC_ASSERT(!m_process, return );
         if (!sanityCheck(command)) return;
 
-        m_output_parser = new XMakeOutputParser { capture_stdio };
+        m_output_parser = new XMakeOutputParser {};
         m_output_parser->setSourceDirectory(source_path);
         m_parser.addLineParser(m_output_parser);
 
+        connect(m_output_parser,
+                &XMakeOutputParser::progressReported,
+                this,
+                &XMakeProcess::reportProgress);
+
         setupProcess(command, env, capture_stdio);
 
+        // nice on unix, BELOW_NORMAL_PRIORITY_CLASS on windows
+        if (low_priority) m_process->setLowPriority();
+
         ProjectExplorer::TaskHub::clearTasks(
             static_cast<const char *>(ProjectExplorer::Constants::TASK_CATEGORY_BUILDSYSTEM));
 
@@ -73,20 +104,33 @@ namespace XMakeProjectManager::Internal {
             tr("Running %1 in %2.").arg(command.toUserOutput(), command.workDir().toUserOutput()));
 
         m_future_interface = QFutureInterface<void>();
-        m_future_interface.setProgressRange(0, 1);
+        m_future_interface.setProgressRange(0, PROGRESS_RANGE);
+        m_future_interface.reportStarted();
 
-        Core::ProgressManager::addTimedTask(m_future_interface,
-                                            tr("Configuring \"%1\".").arg(project_name),
-                                            "XMake.Configure",
-                                            CONFIGURE_TASK_ESTIMATED_TIME);
+        m_progress_reported = false;
+
+        Core::ProgressManager::addTask(m_future_interface.future(),
+                                       tr("Configuring \"%1\".").arg(project_name),
+                                       "XMake.Configure");
 
         m_future_watcher = std::make_unique<QFutureWatcher<void>>();
         connect(m_future_watcher.get(), &QFutureWatcher<void>::canceled, this, &XMakeProcess::stop);
         m_future_watcher->setFuture(m_future_interface.future());
 
+        m_spawn_time = -1;
+        m_elapsed.start();
+
+        // on session load, the processes of the other projects wait for a free slot
+        XMakeProcessQueue::instance().enqueue(this, source_path, [this] { startProcess(); });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProcess::startProcess() -> void {
         Q_EMIT started();
 
-        m_elapsed.start();
+        m_elapsed.restart();
+        m_progress_timer.start();
         m_process->start();
     }
 
@@ -100,9 +144,19 @@ namespace XMakeProjectManager::Internal {
         handleProcessDone({ -1, QProcess::CrashExit, QProcess::Crashed, {} });
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProcess::isRunning() const -> bool {
+        return m_process && m_process->state() != QProcess::NotRunning;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeProcess::handleProcessDone(const Utils::ProcessResultData &result_data) -> void {
+        XMakeProcessQueue::instance().release(this);
+
+        m_progress_timer.stop();
+
         if (m_future_watcher) {
             m_future_watcher->disconnect();
             m_future_watcher.release()->deleteLater();
@@ -129,18 +183,29 @@ namespace XMakeProjectManager::Internal {
         m_last_exit_code = code;
 
         if (!message.isEmpty()) {
+            // captured output never went through the line parser, give it a chance to report
+            // the errors xmake printed on stdout
+            if (!m_std_out.isEmpty()) {
+                const auto std_out = QString::fromLocal8Bit(m_std_out);
+
+                m_parser.appendMessage(std_out, Utils::StdOutFormat);
+                appendOutput(std_out, false);
+            }
+
+            flushOutput();
+
             ProjectExplorer::BuildSystem::appendBuildSystemOutput(message + '\n');
             ProjectExplorer::TaskHub::addTask(
                 ProjectExplorer::BuildSystemTask { ProjectExplorer::Task::Error, message });
             m_future_interface.reportCanceled();
         } else
-            m_future_interface.setProgressValue(1);
+            m_future_interface.setProgressValue(PROGRESS_RANGE);
 
         m_future_interface.reportFinished();
 
-        auto std_out = m_output_parser->data();
+        flushOutput();
 
-        Q_EMIT finished(code, std_out);
+        Q_EMIT finished(code, std::exchange(m_std_out, {}));
 
         auto elapsed_time = Utils::formatElapsedTime(m_elapsed.elapsed());
         ProjectExplorer::BuildSystem::appendBuildSystemOutput(elapsed_time + '\n');
@@ -155,16 +220,36 @@ namespace XMakeProjectManager::Internal {
         m_process->setWorkingDirectory(command.workDir());
         m_process->setEnvironment(env);
 
-        m_process->setStdOutLineCallback([this, capture_stdio = capture_stdio](const QString &s) {
-            m_parser.appendMessage(s, Utils::StdOutFormat);
-
-            if (!capture_stdio)
-                ProjectExplorer::BuildSystem::appendBuildSystemOutput(stripTrailingNewline(s));
-        });
+        m_std_out.clear();
+        m_payload_started = false;
+
+        if (capture_stdio) {
+            // the introspection payload is kept as raw bytes, it is only decoded once by the
+            // parser running on a worker thread
+            connect(m_process.get(), &Utils::QtcProcess::readyReadStandardOutput, this, [this] {
+                const auto chunk = m_process->readAllStandardOutput();
+                m_std_out.append(chunk);
+
+                Q_EMIT readyReadStandardOutput(chunk);
+
+                if (!m_payload_started) consumeMessages();
+            });
+        } else {
+            m_process->setStdOutLineCallback([this](const QString &s) {
+                m_parser.appendMessage(s, Utils::StdOutFormat);
+                appendOutput(s, false);
+            });
+        }
 
         m_process->setStdErrLineCallback([this](const QString &s) {
             m_parser.appendMessage(s, Utils::StdErrFormat);
-            ProjectExplorer::BuildSystem::appendBuildSystemOutput(stripTrailingNewline(s));
+
+            // the introspection progress only feeds the progress bar
+            if (!XMakeOutputParser::isProgressLine(s)) appendOutput(s, true);
+        });
+
+        connect(m_process.get(), &Utils::QtcProcess::started, this, [this] {
+            m_spawn_time = m_elapsed.elapsed();
         });
 
         connect(m_process.get(), &Utils::QtcProcess::done, this, [this] {
@@ -176,6 +261,81 @@ namespace XMakeProjectManager::Internal {
         m_process->setCommand(command.cmdLine());
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProcess::consumeMessages() -> void {
+        // xmake diagnostics printed before the introspection document still go through the
+        // output parser, the document itself is left untouched
+        static const auto target_marker = QByteArray { Constants::Introspection::TARGET_MARKER };
+
+        while (!m_std_out.isEmpty() && !m_std_out.startsWith('{') &&
+               !m_std_out.startsWith(target_marker)) {
+            const auto end = m_std_out.indexOf('\n');
+            if (end == -1) return;
+
+            const auto line = QString::fromLocal8Bit(m_std_out.constData(), end + 1);
+            m_std_out.remove(0, end + 1);
+
+            m_parser.appendMessage(line, Utils::StdOutFormat);
+            appendOutput(line, false);
+        }
+
+        m_payload_started = !m_std_out.isEmpty();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProcess::updateProgress() -> void {
+        if (m_progress_reported) return;
+
+        const auto expected = m_expected_duration > 0
+                                  ? m_expected_duration
+                                  : qint64 { CONFIGURE_TASK_ESTIMATED_TIME };
+        const auto elapsed = m_elapsed.elapsed();
+
+        // a run slower than the previous ones waits near the end instead of wrapping around
+        const auto value = std::min<qint64>(elapsed * PROGRESS_RANGE / expected,
+                                            PROGRESS_RANGE * 95 / 100);
+
+        const auto remaining = static_cast<int>((expected - elapsed) / 1000);
+        m_future_interface.setProgressValueAndText(
+            static_cast<int>(value),
+            m_expected_duration > 0 && remaining > 0 ? tr("About %n s left", nullptr, remaining)
+                                                     : QString {});
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProcess::reportProgress(int done, int total) -> void {
+        if (total <= 0) return;
+
+        m_progress_reported = true;
+
+        m_future_interface.setProgressValueAndText(
+            static_cast<int>(qint64 { done } * PROGRESS_RANGE / total),
+            tr("%1/%2 targets").arg(done).arg(total));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProcess::appendOutput(QStringView line, bool urgent) -> void {
+        if (!m_pending_output.isEmpty()) m_pending_output += '\n';
+        m_pending_output += stripTrailingNewline(line);
+
+        if (urgent || m_pending_output.size() >= OUTPUT_FLUSH_SIZE) flushOutput();
+        else if (!m_output_timer.isActive())
+            m_output_timer.start();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProcess::flushOutput() -> void {
+        m_output_timer.stop();
+        if (m_pending_output.isEmpty()) return;
+
+        ProjectExplorer::BuildSystem::appendBuildSystemOutput(std::exchange(m_pending_output, {}));
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeProcess::sanityCheck(const Command &command) const -> bool {
@@ -189,7 +349,8 @@ namespace XMakeProjectManager::Internal {
             return false;
         }
 
-        if (!exe.toFileInfo().isExecutable()) {
+        // the executable may be on a remote or container device
+        if (!exe.isExecutableFile()) {
             ProjectExplorer::TaskHub::addTask(ProjectExplorer::BuildSystemTask {
                 ProjectExplorer::Task::TaskType::Error,
                 tr("Command is not executable: %1").arg(exe.toUserOutput()) });
@@ -12,6 +12,7 @@
 #include <QElapsedTimer>
 #include <QFutureInterface>
 #include <QObject>
+#include <QTimer>
 
 #include <memory>
 
@@ -38,20 +39,40 @@ namespace XMakeProjectManager::Internal {
                  const Utils::Environment &env,
                  const QString &project_name,
                  const Utils::FilePath &source_path,
-                 bool capture_stdio);
+                 bool capture_stdio,
+                 bool low_priority = false);
         void stop();
 
+        // milliseconds the last runs of the same phase took, -1 when unknown
+        void setExpectedDuration(qint64 duration) noexcept;
+
+        [[nodiscard]] bool isRunning() const;
         [[nodiscard]] int lastExitCode() const noexcept;
 
+        // milliseconds until the process started, -1 while it didn't
+        [[nodiscard]] qint64 spawnTime() const noexcept;
+
       Q_SIGNALS:
         void started();
-        void finished(int, QString);
+        void finished(int, QByteArray);
+        void readyReadStandardOutput(const QByteArray &chunk);
 
       private:
+        void startProcess();
         void handleProcessDone(const Utils::ProcessResultData &result_data);
         void
             setupProcess(const Command &command, const Utils::Environment &env, bool capture_stdio);
 
+        void consumeMessages();
+
+        // follows the expected duration until the introspection reports its progress
+        void updateProgress();
+        void reportProgress(int done, int total);
+
+        // the lines are handed to the general messages in chunks, stderr right away
+        void appendOutput(QStringView line, bool urgent);
+        void flushOutput();
+
         bool sanityCheck(const Command &command) const;
 
         std::unique_ptr<Utils::QtcProcess> m_process;
@@ -61,10 +82,19 @@ namespace XMakeProjectManager::Internal {
         Utils::OutputFormatter m_parser;
         QElapsedTimer m_elapsed;
         int m_last_exit_code = 0;
+        qint64 m_spawn_time  = -1;
 
         XMakeOutputParser *m_output_parser;
 
-        QString m_data;
+        QByteArray m_std_out;
+        bool m_payload_started = false;
+
+        QString m_pending_output;
+        QTimer m_output_timer;
+
+        qint64 m_expected_duration = -1;
+        bool m_progress_reported   = false;
+        QTimer m_progress_timer;
     };
 } // namespace XMakeProjectManager::Internal
 
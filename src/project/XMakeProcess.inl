@@ -10,4 +10,14 @@ namespace XMakeProjectManager::Internal {
     inline auto XMakeProcess::lastExitCode() const noexcept -> int {
         return m_last_exit_code;
     }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProcess::spawnTime() const noexcept -> qint64 { return m_spawn_time; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProcess::setExpectedDuration(qint64 duration) noexcept -> void {
+        m_expected_duration = duration;
+    }
 } // namespace XMakeProjectManager::Internal
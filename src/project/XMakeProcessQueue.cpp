@@ -0,0 +1,106 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeProcessQueue.hpp"
+
+#include <settings/general/Settings.hpp>
+
+#include <projectexplorer/project.h>
+#include <projectexplorer/session.h>
+
+#include <QLoggingCategory>
+
+#include <algorithm>
+
+namespace XMakeProjectManager::Internal {
+    static Q_LOGGING_CATEGORY(xmake_process_queue_log, "qtc.xmake.processqueue", QtDebugMsg);
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProcessQueue::instance() -> XMakeProcessQueue & {
+        static auto queue = XMakeProcessQueue {};
+
+        return queue;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProcessQueue::enqueue(const QObject *owner,
+                                    const Utils::FilePath &source_path,
+                                    StartFunction start,
+                                    YieldFunction yield) -> void {
+        release(owner);
+
+        m_pending.push_back({ owner, source_path, std::move(start), std::move(yield) });
+
+        if (m_running.size() >= maxProcesses())
+            qCDebug(xmake_process_queue_log)
+                << "Delaying xmake in" << source_path.toUserOutput() << "," << m_running.size()
+                << "processes running," << std::size(m_pending) << "waiting";
+
+        startNext();
+        reclaim();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProcessQueue::release(const QObject *owner) -> void {
+        const auto it = std::find_if(std::begin(m_pending),
+                                     std::end(m_pending),
+                                     [owner](const auto &pending) {
+                                         return pending.owner == owner;
+                                     });
+        if (it != std::end(m_pending)) m_pending.erase(it);
+
+        if (m_running.remove(owner)) startNext();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProcessQueue::maxProcesses() const -> int {
+        return Settings::instance()->max_xmake_processes.value();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProcessQueue::startNext() -> void {
+        const auto *startup_project = ProjectExplorer::SessionManager::startupProject();
+        const auto startup_dir =
+            startup_project ? startup_project->projectDirectory() : Utils::FilePath {};
+
+        while (!std::empty(m_pending) && m_running.size() < maxProcesses()) {
+            // the startup project goes first, the others are started in the order they came
+            auto it = std::find_if(std::begin(m_pending),
+                                   std::end(m_pending),
+                                   [&startup_dir](const auto &pending) {
+                                       return !startup_dir.isEmpty() &&
+                                              pending.source_path == startup_dir;
+                                   });
+            if (it == std::end(m_pending)) it = std::begin(m_pending);
+
+            auto pending = std::move(*it);
+            m_pending.erase(it);
+
+            m_running.insert(pending.owner, std::move(pending.yield));
+
+            pending.start();
+        }
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProcessQueue::reclaim() -> void {
+        if (std::empty(m_pending) || m_running.size() < maxProcesses()) return;
+
+        // one owner at a time, its slot is released once its process exited
+        for (auto it = std::begin(m_running); it != std::end(m_running); ++it) {
+            if (!it.value() || !it.value()()) continue;
+
+            qCDebug(xmake_process_queue_log) << "Stopping an idle process to make room";
+
+            it.value() = {};
+            return;
+        }
+    }
+} // namespace XMakeProjectManager::Internal
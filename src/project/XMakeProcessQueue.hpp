@@ -0,0 +1,68 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <utils/filepath.h>
+
+#include <QHash>
+
+#include <deque>
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+class QObject;
+QT_END_NAMESPACE
+
+namespace XMakeProjectManager::Internal {
+    // caps the xmake processes running at once over all the projects of the session, the
+    // processes of the startup project are started first
+    class XMakeProcessQueue final {
+      public:
+        using StartFunction = std::function<void()>;
+        // asks a running owner to give its slot back, true when it will release it
+        using YieldFunction = std::function<bool()>;
+
+        XMakeProcessQueue() = default;
+
+        XMakeProcessQueue(XMakeProcessQueue &&)      = delete;
+        XMakeProcessQueue(const XMakeProcessQueue &) = delete;
+
+        XMakeProcessQueue &operator=(XMakeProcessQueue &&) = delete;
+        XMakeProcessQueue &operator=(const XMakeProcessQueue &) = delete;
+
+        static XMakeProcessQueue &instance();
+
+        // start is called once a slot is free, right away when one already is. The owners
+        // passing yield, an idle introspection server, are stopped when a start waits
+        void enqueue(const QObject *owner,
+                     const Utils::FilePath &source_path,
+                     StartFunction start,
+                     YieldFunction yield = {});
+
+        // frees the slot of owner or forgets its pending start
+        void release(const QObject *owner);
+
+        int runningCount() const noexcept;
+        int pendingCount() const noexcept;
+
+      private:
+        struct PendingProcess {
+            const QObject *owner;
+            Utils::FilePath source_path;
+            StartFunction start;
+            YieldFunction yield;
+        };
+
+        int maxProcesses() const;
+        void startNext();
+        void reclaim();
+
+        std::deque<PendingProcess> m_pending;
+        // the yield function of the owners, empty for the ones that can't stop early
+        QHash<const QObject *, YieldFunction> m_running;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakeProcessQueue.inl"
@@ -0,0 +1,19 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProcessQueue::runningCount() const noexcept -> int {
+        return m_running.size();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProcessQueue::pendingCount() const noexcept -> int {
+        return static_cast<int>(std::size(m_pending));
+    }
+} // namespace XMakeProjectManager::Internal
@@ -59,7 +59,8 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeProject::deploymentKnowledge() const -> ProjectExplorer::DeploymentKnowledge {
-        return ProjectExplorer::DeploymentKnowledge::Bad;
+        // the target files are known, the files installed by custom rules are not
+        return ProjectExplorer::DeploymentKnowledge::Approximative;
     }
 } // namespace XMakeProjectManager::Internal
 
@@ -4,16 +4,128 @@
 
 #include "XMakeProjectImporter.hpp"
 
+#include <XMakeProjectConstant.hpp>
+#include <project/XMakeBuildConfiguration.hpp>
+
+#include <QDir>
+#include <QDirIterator>
 #include <QLoggingCategory>
+#include <QRegularExpression>
 #include <QString>
 
+#include <projectexplorer/abi.h>
 #include <projectexplorer/kit.h>
+#include <projectexplorer/kitinformation.h>
+#include <projectexplorer/projectexplorerconstants.h>
+#include <projectexplorer/toolchain.h>
+
+#include <qtsupport/qtkitinformation.h>
+
+#include <utils/hostosinfo.h>
+
+#include <array>
+#include <memory>
+#include <utility>
 
 namespace {
     static Q_LOGGING_CATEGORY(mInputLog, "qtc.xmake.import", QtDebugMsg)
 }
 
 namespace XMakeProjectManager::Internal {
+    // values of the xmake.conf written by xmake f in <config dir>/.xmake/<host>/<arch>
+    struct DirectoryData {
+        Utils::FilePath build_directory;
+
+        QString plat;
+        QString arch;
+        QString mode;
+        QString toolchain;
+
+        Utils::FilePath qt;
+        Utils::FilePath cc;
+        Utils::FilePath cxx;
+    };
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto findConfigFile(const Utils::FilePath &directory) -> Utils::FilePath {
+        const auto info_dir =
+            directory.pathAppended(QString::fromLatin1(Constants::XMAKE_INFO_DIR));
+        if (!info_dir.isDir()) return {};
+
+        auto it = QDirIterator { info_dir.toString(),
+                                 { QStringLiteral("xmake.conf") },
+                                 QDir::Files,
+                                 QDirIterator::Subdirectories };
+
+        while (it.hasNext()) {
+            const auto file = Utils::FilePath::fromString(it.next());
+
+            // the package and cache directories may hold other lua tables
+            if (file.parentDir().parentDir().parentDir() == info_dir) return file;
+        }
+
+        return {};
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto readConfigFile(const Utils::FilePath &file) -> QHash<QString, QString> {
+        static const auto entry =
+            QRegularExpression { R"(^\s*\[?"?([\w.]+)"?\]?\s*=\s*"?(.*?)"?\s*,?\s*$)" };
+
+        auto values = QHash<QString, QString> {};
+
+        const auto contents = QString::fromUtf8(file.fileContents());
+        for (const auto &line : contents.split('\n')) {
+            const auto match = entry.match(line);
+            if (match.hasMatch()) values.insert(match.captured(1), match.captured(2));
+        }
+
+        return values;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto matchesToolchain(const ProjectExplorer::ToolChain &toolchain, const QString &name)
+        -> bool {
+        // most specific prefixes first, xmake names may carry a version (gcc-12, clang-15)
+        static const auto type_ids = std::array {
+            std::pair { "clang-cl", ProjectExplorer::Constants::CLANG_CL_TOOLCHAIN_TYPEID },
+            std::pair { "clang", ProjectExplorer::Constants::CLANG_TOOLCHAIN_TYPEID },
+            std::pair { "gcc", ProjectExplorer::Constants::GCC_TOOLCHAIN_TYPEID },
+            std::pair { "mingw", ProjectExplorer::Constants::MINGW_TOOLCHAIN_TYPEID },
+            std::pair { "msvc", ProjectExplorer::Constants::MSVC_TOOLCHAIN_TYPEID },
+        };
+
+        // a mingw gcc is configured as gcc too
+        if (name.startsWith("gcc") &&
+            toolchain.typeId() == ProjectExplorer::Constants::MINGW_TOOLCHAIN_TYPEID)
+            return true;
+
+        for (const auto &[prefix, type_id] : type_ids)
+            if (name.startsWith(QLatin1String { prefix })) return toolchain.typeId() == type_id;
+
+        return toolchain.compilerCommand().fileName().contains(name);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto matchesArch(const ProjectExplorer::Abi &abi, const QString &arch) -> bool {
+        using Abi = ProjectExplorer::Abi;
+
+        if (arch == "x86_64" || arch == "x64" || arch == "amd64")
+            return abi.architecture() == Abi::X86Architecture && abi.wordWidth() == 64;
+        if (arch == "i386" || arch == "i686" || arch == "x86")
+            return abi.architecture() == Abi::X86Architecture && abi.wordWidth() == 32;
+        if (arch == "arm64" || arch == "arm64-v8a" || arch == "aarch64")
+            return abi.architecture() == Abi::ArmArchitecture && abi.wordWidth() == 64;
+        if (arch.startsWith("arm"))
+            return abi.architecture() == Abi::ArmArchitecture && abi.wordWidth() == 32;
+
+        return true;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     XMakeProjectImporter::XMakeProjectImporter(const Utils::FilePath &path)
@@ -22,52 +134,163 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeProjectImporter::importCandidates() -> QStringList {
-        // TODO
-        return {};
+        const auto project_dir = projectDirectory();
+
+        auto candidates = QStringList {};
+
+        // xmake configures in the project directory unless XMAKE_CONFIGDIR says otherwise
+        if (!findConfigFile(project_dir).isEmpty()) candidates << project_dir.toString();
+
+        const auto sub_dirs = QDir { project_dir.toString() }.entryList(QDir::Dirs |
+                                                                         QDir::NoDotAndDotDot);
+        for (const auto &sub_dir : sub_dirs) {
+            const auto directory = project_dir.pathAppended(sub_dir);
+            if (!findConfigFile(directory).isEmpty()) candidates << directory.toString();
+        }
+
+        qCDebug(mInputLog()) << "import candidates" << candidates;
+
+        return candidates;
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeProjectImporter::examineDirectory(const Utils::FilePath &import_path,
-                                                [[maybe_unused]] QString *warning_message) const
+                                                QString *warning_message) const
         -> QList<void *> {
         qCDebug(mInputLog()) << "examining build directory" << import_path.toUserOutput();
 
-        // TODO
-        auto data = QList<void *> {};
+        const auto config_file = findConfigFile(import_path);
+        if (config_file.isEmpty()) return {};
 
-        return data;
+        const auto values = readConfigFile(config_file);
+        if (values.isEmpty()) {
+            if (warning_message)
+                *warning_message = tr("Could not read the xmake configuration %1.")
+                                       .arg(config_file.toUserOutput());
+            return {};
+        }
+
+        const auto path = [&values](const QString &key) {
+            const auto value = values.value(key);
+            return value.isEmpty() ? Utils::FilePath {} : Utils::FilePath::fromUserInput(value);
+        };
+
+        auto data             = std::make_unique<DirectoryData>();
+        data->build_directory = import_path;
+        data->plat            = values.value("plat");
+        data->arch            = values.value("arch");
+        data->mode            = values.value("mode");
+        data->toolchain       = values.value("toolchain");
+        data->qt              = path("qt");
+        data->cc              = path("cc");
+        data->cxx             = path("cxx");
+
+        qCDebug(mInputLog()) << "found xmake configuration" << data->plat << data->arch
+                             << data->mode << data->toolchain << data->qt.toUserOutput();
+
+        return { data.release() };
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeProjectImporter::matchKit([[maybe_unused]] void *directory_data,
-                                        [[maybe_unused]] const ProjectExplorer::Kit *kit) const
-        -> bool {
-        // TODO
-        return false;
+    auto XMakeProjectImporter::matchKit(void *directory_data,
+                                        const ProjectExplorer::Kit *kit) const -> bool {
+        const auto *data = static_cast<const DirectoryData *>(directory_data);
+
+        if (!data->qt.isEmpty()) {
+            const auto *qt_version = QtSupport::QtKitAspect::qtVersion(kit);
+            if (!qt_version || qt_version->prefix().cleanPath() != data->qt.cleanPath())
+                return false;
+        }
+
+        for (const auto &[compiler, language] :
+             { std::pair { &data->cc, ProjectExplorer::Constants::C_LANGUAGE_ID },
+               std::pair { &data->cxx, ProjectExplorer::Constants::CXX_LANGUAGE_ID } }) {
+            if (compiler->isEmpty()) continue;
+
+            const auto *toolchain = ProjectExplorer::ToolChainKitAspect::toolChain(kit, language);
+            if (!toolchain ||
+                toolchain->compilerCommand().canonicalPath() != compiler->canonicalPath())
+                return false;
+        }
+
+        const auto *toolchain = ProjectExplorer::ToolChainKitAspect::cxxToolChain(kit);
+        if (!data->toolchain.isEmpty() &&
+            (!toolchain || !matchesToolchain(*toolchain, data->toolchain)))
+            return false;
+
+        if (!data->arch.isEmpty() && toolchain && !matchesArch(toolchain->targetAbi(), data->arch))
+            return false;
+
+        return true;
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeProjectImporter::createKit([[maybe_unused]] void *directory_data) const
-        -> ProjectExplorer::Kit * {
-        // TODO
-        return {};
+    auto XMakeProjectImporter::createKit(void *directory_data) const -> ProjectExplorer::Kit * {
+        const auto *data = static_cast<const DirectoryData *>(directory_data);
+
+        const auto qmake =
+            data->qt.isEmpty()
+                ? Utils::FilePath {}
+                : data->qt.pathAppended(
+                      Utils::HostOsInfo::withExecutableSuffix(QStringLiteral("bin/qmake")));
+
+        const auto setup = [this, data](ProjectExplorer::Kit *kit) {
+            for (const auto &[compiler, language] :
+                 { std::pair { &data->cc, ProjectExplorer::Constants::C_LANGUAGE_ID },
+                   std::pair { &data->cxx, ProjectExplorer::Constants::CXX_LANGUAGE_ID } }) {
+                if (compiler->isEmpty()) continue;
+
+                const auto toolchain_data = findOrCreateToolChains({ *compiler, language });
+                if (toolchain_data.tcs.isEmpty()) continue;
+
+                auto *toolchain = toolchain_data.tcs.first();
+                if (toolchain_data.areTemporary)
+                    addTemporaryData(ProjectExplorer::ToolChainKitAspect::id(),
+                                     toolchain->id(),
+                                     kit);
+
+                ProjectExplorer::ToolChainKitAspect::setToolChain(kit, toolchain);
+            }
+        };
+
+        return QtProjectImporter::createTemporaryKit(findOrCreateQtVersion(qmake), setup);
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeProjectImporter::buildInfoList([[maybe_unused]] void *directory_data) const
+    auto XMakeProjectImporter::buildInfoList(void *directory_data) const
         -> const QList<ProjectExplorer::BuildInfo> {
-        // TODO
-        return {};
+        const auto *data = static_cast<const DirectoryData *>(directory_data);
+
+        const auto type = xmakeBuildType(data->mode);
+
+        auto b_info           = ProjectExplorer::BuildInfo {};
+        b_info.typeName       = xmakeBuildTypeName(type);
+        b_info.displayName    = xmakeBuildTypeDisplayName(type);
+        b_info.buildType      = buildType(type);
+        b_info.buildDirectory = data->build_directory;
+
+        // keeps the next configure runs on the imported platform and toolchain
+        auto parameters = QStringList {};
+        if (!data->plat.isEmpty()) parameters << QString { "-p %1" }.arg(data->plat);
+        if (!data->arch.isEmpty()) parameters << QString { "-a %1" }.arg(data->arch);
+        if (!data->toolchain.isEmpty())
+            parameters << QString { "--toolchain=%1" }.arg(data->toolchain);
+
+        b_info.extraInfo = QVariantMap {
+            { QString::fromLatin1(Constants::BuildConfiguration::IMPORT_PARAMETERS_KEY),
+              parameters.join(' ') }
+        };
+
+        return { b_info };
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeProjectImporter::deleteDirectoryData([[maybe_unused]] void *directory_data) const
-        -> void {
-        // TODO
+    auto XMakeProjectImporter::deleteDirectoryData(void *directory_data) const -> void {
+        delete static_cast<DirectoryData *>(directory_data);
     }
 } // namespace XMakeProjectManager::Internal
@@ -6,40 +6,79 @@
 #include "project/XMakeProcess.hpp"
 #include "qtmetamacros.h"
 
+#include <XMakeProjectConstant.hpp>
+
 #include <algorithm>
 
 #include <exewrappers/XMakeTools.hpp>
 #include <iterator>
+#include <project/XMakeCompilationDatabase.hpp>
+#include <project/XMakeFixtureRecorder.hpp>
+#include <project/XMakeIntrospectionCache.hpp>
+#include <project/XMakeIntrospectionServer.hpp>
+#include <project/XMakeMimeTypeCache.hpp>
+#include <project/XMakeNodeTrace.hpp>
+#include <project/XMakeTraceExport.hpp>
 #include <project/projecttree/ProjectTree.hpp>
 
+#include <settings/general/Settings.hpp>
+
+#include <xmakeinfoparser/parsers/Common.hpp>
+#include <xmakeinfoparser/parsers/TargetParser.hpp>
+
 #include <coreplugin/messagemanager.h>
 
 #include <projectexplorer/headerpath.h>
 #include <projectexplorer/projectexplorer.h>
 #include <projectexplorer/rawprojectpart.h>
+#include <projectexplorer/toolchain.h>
 
 #include <cppeditor/cppeditorconstants.h>
 
 #include <utils/fileinprojectfinder.h>
 #include <utils/filepath.h>
+#include <utils/hostosinfo.h>
 #include <utils/mimeutils.h>
 #include <utils/runextensions.h>
 
+#include <qtsupport/baseqtversion.h>
 #include <qtsupport/qtcppkitinfo.h>
 #include <qtsupport/qtkitinformation.h>
 
+#include <QCryptographicHash>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
 #include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QScopeGuard>
+#include <QSet>
 #include <QStringList>
 
+#include <array>
+#include <string_view>
+#include <utility>
+
 namespace XMakeProjectManager::Internal {
     static Q_LOGGING_CATEGORY(xmake_project_parser_log, "qtc.xmake.projectparser", QtDebugMsg);
 
     struct CompilerArgs {
         QStringList arguments;
+        QStringList c_arguments;
+        QStringList cxx_arguments;
+        QStringList forced_includes;
         ProjectExplorer::HeaderPaths include_paths;
         ProjectExplorer::Macros macros;
     };
 
+    // the targets of a module mostly share their flags, the parsed set is shared between parts
+    using CompilerArgsSets = QHash<QStringList, CompilerArgs>;
+
+    // Qt include paths of a framework list, computed once per kit
+    using QtHeaderPathsSets = QHash<QStringList, ProjectExplorer::HeaderPaths>;
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto toAbsolutePath(const Utils::FilePath &ref_path, const QStringList &path_list)
@@ -58,40 +97,121 @@ namespace XMakeProjectManager::Internal {
         return output;
     }
 
-    ////////////////////////////////////////////////////
-    ////////////////////////////////////////////////////
-    auto extractValueIfMatches(const QString &arg, const QStringList &candidates)
-        -> Utils::optional<QString> {
-        for (const auto &flag : candidates)
-            if (arg.startsWith(flag)) return arg.mid(flag.length());
+    enum class FlagKind {
+        UserInclude,
+        SystemInclude,
+        Define,
+        Undefine,
+        ForcedInclude,
+        LanguageStandard,
+        Argument
+    };
 
-        return Utils::nullopt;
-    }
+    struct FlagPrefix {
+        std::string_view prefix;
+        FlagKind kind;
+        bool separable; // the value may be given as the next argument
+    };
+
+    // GCC, clang and MSVC spellings, the first match wins so a longer prefix comes before the
+    // shorter one it starts with
+    static constexpr auto FLAG_PREFIXES = std::array {
+        FlagPrefix { "-I", FlagKind::UserInclude, true },
+        FlagPrefix { "-iquote", FlagKind::UserInclude, true },
+        FlagPrefix { "-isystem", FlagKind::SystemInclude, true },
+        FlagPrefix { "-idirafter", FlagKind::SystemInclude, true },
+        FlagPrefix { "-imsvc", FlagKind::SystemInclude, true },
+        FlagPrefix { "-include-pch", FlagKind::Argument, true },
+        FlagPrefix { "-include", FlagKind::ForcedInclude, true },
+        FlagPrefix { "-external:I", FlagKind::SystemInclude, true },
+        FlagPrefix { "-D", FlagKind::Define, true },
+        FlagPrefix { "-U", FlagKind::Undefine, true },
+        FlagPrefix { "-FI", FlagKind::ForcedInclude, true },
+        FlagPrefix { "-std=", FlagKind::LanguageStandard, false },
+        FlagPrefix { "-std:", FlagKind::LanguageStandard, false },
+        FlagPrefix { "/I", FlagKind::UserInclude, true },
+        FlagPrefix { "/imsvc", FlagKind::SystemInclude, true },
+        FlagPrefix { "/external:I", FlagKind::SystemInclude, true },
+        FlagPrefix { "/D", FlagKind::Define, true },
+        FlagPrefix { "/U", FlagKind::Undefine, true },
+        FlagPrefix { "/FI", FlagKind::ForcedInclude, true },
+        FlagPrefix { "/std:", FlagKind::LanguageStandard, false },
+    };
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto extractInclude(const QString &arg) -> Utils::optional<ProjectExplorer::HeaderPath> {
-        auto path = extractValueIfMatches(arg, { "-I", "/I", "-imsvc", "/imsvc" });
-        if (path) return ProjectExplorer::HeaderPath::makeUser(*path);
+    auto classifyFlag(QStringView arg) -> const FlagPrefix * {
+        if (arg.size() < 2 || (arg[0] != '-' && arg[0] != '/')) return nullptr;
+
+        for (const auto &flag : FLAG_PREFIXES) {
+            // most arguments are rejected on their first two characters
+            if (arg[0] != QLatin1Char { flag.prefix[0] } || arg[1] != QLatin1Char { flag.prefix[1] })
+                continue;
 
-        path = extractValueIfMatches(arg, { "-isystem ", "/external:I ", "-external:I " });
-        if (path) return ProjectExplorer::HeaderPath::makeSystem(*path);
+            if (arg.startsWith(QLatin1String { flag.prefix.data(),
+                                               static_cast<qsizetype>(flag.prefix.size()) }))
+                return &flag;
+        }
 
-        return Utils::nullopt;
+        return nullptr;
     }
 
+    // flags changing neither the predefined macros nor the built-in include paths, spelled
+    // without their leading - or /, Qt Creator caches the toolchain probes on the flags a part
+    // keeps so they are left out. The optimization levels stay, they set __OPTIMIZE__,
+    // __OPTIMIZE_SIZE__ and __NO_INLINE__
+    static constexpr auto NON_PREPROCESSING_FLAGS = std::array<std::string_view, 26> {
+        "W", "w", "g", "fdiagnostics-", "fcolor-diagnostics", "fno-color-diagnostics",
+        "fansi-escape-codes", "fmessage-length", "ftime-trace", "fvisibility",
+        "ffunction-sections", "fdata-sections", "fomit-frame-pointer", "fno-omit-frame-pointer",
+        "fdebug-prefix-map", "ffile-prefix-map", "pipe", "Z7", "Zi", "ZI", "Fd", "Fo", "FS",
+        "nologo", "diagnostics:", "showIncludes",
+    };
+
+    // flags whose value is the next argument, the value is kept along with them
+    static constexpr auto SEPARATE_VALUE_FLAGS = std::array<std::string_view, 7> {
+        "-isysroot", "--sysroot", "-target", "-arch", "-gcc-toolchain", "-Xclang", "-Xpreprocessor",
+    };
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto extractMacro(const QString &arg) -> Utils::optional<ProjectExplorer::Macro> {
-        auto define = extractValueIfMatches(arg, { "-D", "/D" });
-        if (define) return ProjectExplorer::Macro::fromKeyValue(define->toLatin1());
+    auto affectsPreprocessing(QStringView arg) -> bool {
+        if (arg.size() < 2 || (arg[0] != '-' && arg[0] != '/')) return true;
+
+        // an absolute path given as a value, or -Wp, forwarding options to the preprocessor
+        if (arg[0] == '/' && arg.mid(1).contains('/')) return true;
+        if (arg.startsWith(QLatin1String { "-Wp," }) ||
+            arg.startsWith(QLatin1String { "-gcc-toolchain" }))
+            return true;
+
+        const auto name = arg.mid(1);
+        return std::none_of(std::cbegin(NON_PREPROCESSING_FLAGS),
+                            std::cend(NON_PREPROCESSING_FLAGS),
+                            [&name](const auto &flag) {
+                                return name.startsWith(QLatin1String {
+                                    flag.data(),
+                                    static_cast<qsizetype>(flag.size()) });
+                            });
+    }
 
-        auto undef = extractValueIfMatches(arg, { "-U", "/U" });
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto takesSeparateValue(QStringView arg) -> bool {
+        return std::any_of(std::cbegin(SEPARATE_VALUE_FLAGS),
+                           std::cend(SEPARATE_VALUE_FLAGS),
+                           [&arg](const auto &flag) {
+                               return arg == QLatin1String { flag.data(),
+                                                             static_cast<qsizetype>(flag.size()) };
+                           });
+    }
 
-        if (undef)
-            return ProjectExplorer::Macro(undef->toLatin1(), ProjectExplorer::MacroType::Undefine);
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto resolvePath(const QString &path, const Utils::FilePath &src_dir) -> QString {
+        const auto file_path = Utils::FilePath::fromString(path).cleanPath();
+        if (file_path.isAbsolutePath()) return file_path.toString();
 
-        return Utils::nullopt;
+        return src_dir.resolvePath(file_path).toString();
     }
 
     ////////////////////////////////////////////////////
@@ -99,26 +219,302 @@ namespace XMakeProjectManager::Internal {
     auto splitArgs(const QStringList &args, const Utils::FilePath &src_dir) -> CompilerArgs {
         auto splited = CompilerArgs {};
 
-        for (const QString &arg : args) {
-            auto inc = extractInclude(arg);
-            if (inc) {
-                auto p = *inc;
-                p.path = Utils::FilePath::fromString(p.path).cleanPath().toString();
-                if (auto path = Utils::FilePath::fromString(p.path); !path.isAbsolutePath())
-                    p.path = src_dir.resolvePath(path.cleanPath()).toString();
-
-                splited.include_paths << p;
-            } else {
-                auto macro = extractMacro(arg);
-                if (macro) splited.macros << *macro;
-                else
+        for (auto it = std::cbegin(args); it != std::cend(args); ++it) {
+            const auto &arg  = *it;
+            const auto *flag = classifyFlag(arg);
+            if (!flag) {
+                if (takesSeparateValue(arg) && std::next(it) != std::cend(args))
+                    splited.arguments << arg << *++it;
+                else if (affectsPreprocessing(arg))
+                    splited.arguments << arg;
+                continue;
+            }
+
+            // xmake may also hand "-isystem path" as a single argument
+            auto value = arg.mid(static_cast<qsizetype>(flag->prefix.size())).trimmed();
+            if (value.isEmpty()) {
+                if (!flag->separable || std::next(it) == std::cend(args)) {
+                    splited.arguments << arg;
+                    continue;
+                }
+
+                value = *++it;
+            }
+
+            switch (flag->kind) {
+                case FlagKind::Argument:
                     splited.arguments << arg;
+                    if (arg.size() == static_cast<qsizetype>(flag->prefix.size()))
+                        splited.arguments << value;
+                    break;
+                case FlagKind::UserInclude:
+                    splited.include_paths << ProjectExplorer::HeaderPath::makeUser(
+                        resolvePath(value, src_dir));
+                    break;
+                case FlagKind::SystemInclude:
+                    splited.include_paths << ProjectExplorer::HeaderPath::makeSystem(
+                        resolvePath(value, src_dir));
+                    break;
+                case FlagKind::Define:
+                    splited.macros << ProjectExplorer::Macro::fromKeyValue(value.toLatin1());
+                    break;
+                case FlagKind::Undefine:
+                    splited.macros << ProjectExplorer::Macro { value.toLatin1(),
+                                                               ProjectExplorer::MacroType::Undefine };
+                    break;
+                case FlagKind::ForcedInclude:
+                    splited.forced_includes << resolvePath(value, src_dir);
+                    break;
+                case FlagKind::LanguageStandard:
+                    // only the compiler of the matching language understands it
+                    if (value.contains(QLatin1String { "++" })) splited.cxx_arguments << arg;
+                    else
+                        splited.c_arguments << arg;
+                    break;
             }
         }
 
         return splited;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto sharedCompilerArgs(CompilerArgsSets &sets,
+                            QMutex &mutex,
+                            const QStringList &args,
+                            const Utils::FilePath &src_dir) -> CompilerArgs {
+        {
+            const auto lock = QMutexLocker { &mutex };
+
+            const auto it = sets.constFind(args);
+            if (it != std::cend(sets)) return *it;
+        }
+
+        // split outside of the lock, a set parsed twice by two targets is only stored once
+        auto splited = splitArgs(args, src_dir);
+
+        const auto lock = QMutexLocker { &mutex };
+        return *sets.insert(args, std::move(splited));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto qtHeaderPaths(const QStringList &frameworks, const QtSupport::QtVersion &qt_version)
+        -> ProjectExplorer::HeaderPaths {
+        const auto private_str    = QString { "private" };
+        const auto qt_header_path = qt_version.headerPath();
+
+        auto include_paths = ProjectExplorer::HeaderPaths {
+            ProjectExplorer::HeaderPath::makeSystem(qt_header_path)
+        };
+
+        for (const auto &framework : frameworks) {
+            if (framework.startsWith("Qt") && framework.endsWith(private_str)) {
+                auto name = framework.left(framework.size() - private_str.size());
+
+                include_paths.emplace_back(ProjectExplorer::HeaderPath::makeSystem(
+                    qt_header_path / name / qt_version.qtVersionString()));
+                include_paths.emplace_back(ProjectExplorer::HeaderPath::makeSystem(
+                    qt_header_path / name / qt_version.qtVersionString() / name));
+            } else if (framework.startsWith("Qt"))
+                include_paths.emplace_back(
+                    ProjectExplorer::HeaderPath::makeSystem(qt_header_path / framework));
+        }
+
+        return include_paths;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto sharedQtHeaderPaths(QtHeaderPathsSets &sets,
+                             QMutex &mutex,
+                             QStringList frameworks,
+                             const QtSupport::QtVersion &qt_version)
+        -> ProjectExplorer::HeaderPaths {
+        // the kit is the same for the whole run, only the frameworks select the set
+        frameworks.sort();
+        frameworks.removeDuplicates();
+
+        const auto lock = QMutexLocker { &mutex };
+
+        auto it = sets.find(frameworks);
+        if (it == std::end(sets))
+            it = sets.insert(frameworks, qtHeaderPaths(frameworks, qt_version));
+
+        return *it;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto appendUniqueHeaderPaths(ProjectExplorer::HeaderPaths paths,
+                                 const ProjectExplorer::HeaderPaths &extra)
+        -> ProjectExplorer::HeaderPaths {
+        auto known = QSet<QString> {};
+        known.reserve(paths.size() + extra.size());
+
+        for (const auto &path : paths) known.insert(path.path);
+
+        for (const auto &path : extra)
+            if (!known.contains(path.path)) {
+                known.insert(path.path);
+                paths.append(path);
+            }
+
+        return paths;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto runEnvironmentDelta(const Target &target) -> Utils::EnvironmentItems {
+        auto delta = Utils::EnvironmentItems {};
+        delta.reserve(static_cast<int>(std::size(target.set_env) + std::size(target.add_env)));
+
+        for (const auto &[name, value] : target.set_env)
+            delta.append({ name, value, Utils::EnvironmentItem::SetEnabled });
+
+        // the values added to a variable are appended at once, paths are normalized here instead
+        // of on each application
+        const auto separator = QString { Utils::HostOsInfo::pathListSeparator() };
+        for (const auto &[name, values] : target.add_env) {
+            auto normalized = values;
+            if (name == "PATH" || name == "LD_LIBRARY_PATH")
+                for (auto &value : normalized) {
+                    const auto path = Utils::FilePath::fromString(value).cleanPath();
+                    value           = name == "PATH" ? path.nativePath() : path.toString();
+                }
+
+            delta.append({ name, normalized.join(separator), Utils::EnvironmentItem::Append });
+        }
+
+        // the maps are unordered, the hash must not depend on their iteration order
+        std::stable_sort(std::begin(delta), std::end(delta), [](const auto &a, const auto &b) {
+            if (a.operation != b.operation) return a.operation < b.operation;
+            return a.name < b.name;
+        });
+
+        return delta;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto kitFingerprint(const QtSupport::CppKitInfo &kit_info) -> QByteArray {
+        auto hash = QCryptographicHash { QCryptographicHash::Sha1 };
+
+        if (kit_info.kit) hash.addData(kit_info.kit->id().name());
+        if (kit_info.cxxToolChain) hash.addData(kit_info.cxxToolChain->id());
+        if (kit_info.cToolChain) hash.addData(kit_info.cToolChain->id());
+        if (kit_info.qtVersion) hash.addData(kit_info.qtVersion->qmakeFilePath().toString().toUtf8());
+
+        return hash.result();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto targetFingerprint(const Target &target,
+                           const Utils::FilePath &src_dir,
+                           const QByteArray &kit_fingerprint) -> QByteArray {
+        // covers everything buildProjectPart reads from the target
+        auto hash = QCryptographicHash { QCryptographicHash::Sha1 };
+
+        const auto add_list = [&hash](const QStringList &list) {
+            for (const auto &value : list) {
+                hash.addData(value.toUtf8());
+                hash.addData("\0", 1);
+            }
+            hash.addData("\1", 1);
+        };
+
+        hash.addData(kit_fingerprint);
+        hash.addData(src_dir.toString().toUtf8());
+        add_list({ target.name, target.defined_in, QString::number(static_cast<int>(target.kind)) });
+
+        for (const auto &group : target.sources) {
+            add_list({ group.kind });
+            add_list(group.sources);
+            add_list(group.arguments);
+
+            auto files = group.file_flags.keys();
+            files.sort();
+            for (const auto &file : files) {
+                const auto &delta = group.file_flags[file];
+
+                add_list({ file });
+                add_list(delta.added);
+                add_list(delta.arguments);
+            }
+        }
+
+        add_list(target.headers);
+        add_list(target.frameworks);
+        hash.addData(target.use_qt ? "1" : "0", 1);
+
+        // a new BMI changes the module arguments of the parts
+        for (const auto &unit : target.module_units) {
+            add_list({ unit.name, unit.file, unit.bmi });
+            add_list(unit.imports);
+        }
+
+        return hash.result();
+    }
+
+    using ModuleUnits = QHash<QString, const Target::ModuleUnit *>;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto moduleInterfaces(const Target &target, const TargetsList &targets) -> ModuleUnits {
+        // the modules a target can import are its own and the ones of its dependencies
+        auto interfaces = ModuleUnits {};
+
+        auto visited = std::vector<bool>(std::size(targets), false);
+        auto pending = std::vector<const Target *> { &target };
+        while (!std::empty(pending)) {
+            const auto *current = pending.back();
+            pending.pop_back();
+
+            for (const auto &unit : current->module_units)
+                if (!unit.bmi.isEmpty() || !interfaces.contains(unit.name))
+                    interfaces.insert(unit.name, &unit);
+
+            for (auto dep : current->dependencies) {
+                if (visited[dep]) continue;
+
+                visited[dep] = true;
+                pending.push_back(&targets[dep]);
+            }
+        }
+
+        return interfaces;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto moduleFileArguments(const QStringList &imports, const ModuleUnits &interfaces)
+        -> QStringList {
+        // clangd maps the imported names to the interfaces compiled by clang, the modules
+        // the imported ones import are needed too
+        auto arguments = QStringList {};
+
+        auto visited = QSet<QString> {};
+        auto pending = imports;
+        while (!pending.isEmpty()) {
+            const auto name = pending.takeLast();
+            if (visited.contains(name)) continue;
+            visited.insert(name);
+
+            const auto *unit = interfaces.value(name);
+            if (!unit) continue;
+
+            if (unit->bmi.endsWith(".pcm"))
+                arguments.append(QString { "-fmodule-file=%1=%2" }.arg(name, unit->bmi));
+
+            pending.append(unit->imports);
+        }
+
+        arguments.sort();
+
+        return arguments;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     XMakeProjectParser::XMakeProjectParser(const Utils::Id &xmake,
@@ -136,19 +532,40 @@ namespace XMakeProjectManager::Internal {
                                        const Utils::FilePath &build_path,
                                        const QStringList &args,
                                        bool wipe) -> bool {
-        m_src_dir   = source_path;
-        m_build_dir = build_path;
+        m_src_dir     = source_path;
+        m_build_dir   = build_path;
+        m_config_args = args;
+        m_filtered    = false;
 
-        m_env.setupEnglishOutput();
-        m_env.appendOrSet("XMAKE_PROJECTDIR", m_src_dir.nativePath());
-        m_env.appendOrSet("XMAKE_CONFIGDIR", m_build_dir.nativePath());
+        startTimings();
+
+        setupEnvironment();
+
+        if (useMode(Settings::instance()->combined_configure,
+                    XMakeWrapper::Capability::CombinedConfigure)) {
+            if (const auto output = cborOutput(); output.exists()) output.removeFile();
+
+            auto cmd = XMakeTools::xmakeWrapper(m_xmake)->configureAndIntrospect(
+                m_src_dir,
+                m_build_dir,
+                args,
+                wipe,
+                cborOutput(),
+                streaming());
+
+            m_configuring   = false;
+            m_history_phase = XMakePhaseHistory::Phase::ConfigureAndIntrospection;
+
+            return runIntrospectionCommand(cmd, source_path, lowPriority(true));
+        }
 
         auto cmd = XMakeTools::xmakeWrapper(m_xmake)->configure(m_src_dir, m_build_dir, args, wipe);
 
-        m_pending_commands.enqueue(
-            std::make_tuple(XMakeTools::xmakeWrapper(m_xmake)->introspect(source_path),
-                            m_src_dir,
-                            true));
+        m_configuring   = true;
+        m_history_phase = XMakePhaseHistory::Phase::Configure;
+
+        startRun();
+        startPhase();
 
         m_process = std::make_unique<XMakeProcess>();
         connect(m_process.get(),
@@ -156,7 +573,9 @@ namespace XMakeProjectManager::Internal {
                 this,
                 &XMakeProjectParser::processFinished);
 
-        m_process->run(cmd, m_env, m_project_name, source_path, false);
+        m_process->setExpectedDuration(
+            XMakePhaseHistory { m_build_dir }.estimate(XMakePhaseHistory::Phase::Configure));
+        m_process->run(cmd, m_env, m_project_name, source_path, false, lowPriority(true));
         return true;
     }
 
@@ -171,31 +590,374 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeProjectParser::parse(const Utils::FilePath &source_path,
-                                   const Utils::FilePath &build_path) -> bool {
+                                   const Utils::FilePath &build_path,
+                                   const Utils::FilePaths &changed_files) -> bool {
         m_src_dir   = source_path;
         m_build_dir = build_path;
 
-        return parse(source_path);
+        startTimings();
+
+        return parse(source_path, affectedProjectFiles(changed_files));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::parse(const Utils::FilePath &source_path,
+                                   const QStringList &project_files) -> bool {
+        m_src_dir  = source_path;
+        m_filtered = !project_files.isEmpty();
+
+        if (parseShared()) return true;
+
+        if (!project_files.isEmpty())
+            qCDebug(xmake_project_parser_log) << "Introspecting targets defined in" << project_files;
+
+        // a document left by a previous run must not be taken for the answer of this one
+        if (const auto output = cborOutput(); output.exists()) output.removeFile();
+
+        // the server is shared with the active configuration and runs at normal priority, a
+        // background reparse gets a one-shot process of its own
+        if (!lowPriority(false) && useMode(Settings::instance()->introspection_server,
+                                           XMakeWrapper::Capability::Server)) {
+            auto &server = introspectionServer();
+
+            const auto generation = startRun();
+
+            resetStream();
+
+            ProjectExplorer::BuildSystem::startNewBuildSystemOutput(
+                tr("Introspecting %1.").arg(source_path.toUserOutput()));
+
+            m_history_phase.reset();
+            startPhase();
+
+            server.introspect(
+                this,
+                [this, source_path, project_files, generation](int code, QByteArray std_out) {
+                    if (generation != m_generation) {
+                        qCDebug(xmake_project_parser_log)
+                            << "Dropping the answer of a superseded introspection";
+                        return;
+                    }
+
+                    if (code == 0) processFinished(code, std::move(std_out));
+                    else {
+                        qCDebug(xmake_project_parser_log)
+                            << "Introspection server failed, falling back to a one-shot process";
+                        runIntrospection(source_path, project_files);
+                    }
+                },
+                project_files,
+                [stream = m_stream](const QByteArray &chunk) {
+                    if (stream) stream->append(chunk);
+                });
+
+            return true;
+        }
+
+        return runIntrospection(source_path, project_files);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::parseCached(const Utils::FilePath &source_path,
+                                         const Utils::FilePath &build_path) -> bool {
+        if (!Settings::instance()->introspection_cache.value()) return false;
+
+        m_src_dir   = source_path;
+        m_build_dir = build_path;
+
+        const auto cache = XMakeIntrospectionCache { m_build_dir };
+        if (!cache.path().exists()) return false;
+
+        const auto key =
+            XMakeIntrospectionCache::key(XMakeTools::xmakeWrapper(m_xmake)->exe(), m_config_args);
+
+        const auto generation = startRun();
+        startTimings(true);
+
+        m_parser_future_result = Utils::runAsync(
+            ProjectExplorer::ProjectExplorerPlugin::sharedThreadPool(),
+            [cache, key, src_dir = m_src_dir, options = extractOptions()](
+                QFutureInterface<ParserDataPtr> &future) {
+                const auto entry = cache.load(key);
+                if (!entry) {
+                    future.reportResult(ParserDataPtr {});
+                    return;
+                }
+
+                auto result = XMakeInfoParser::parse(entry->payload);
+                mapDevicePaths(result, src_dir);
+
+                auto parser_data =
+                    extractParserResults(src_dir, std::move(result), options, future);
+                if (!parser_data) return;
+
+                // the hashes miss the files matched by a glob, add_files("src/*.cpp") gives the
+                // same xmake.lua for a new source, a cache hit is always introspected again
+                if (!entry->stale)
+                    qCDebug(xmake_project_parser_log)
+                        << "No project file changed, revalidating the globbed files";
+                parser_data->stale = true;
+                future.reportResult(std::move(parser_data));
+            });
+
+        watchParser(generation);
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::queryFileArguments(const Utils::FilePath &file) -> void {
+        if (!lazyFileFlags()) return;
+
+        for (const auto &owner : m_file_index.owners(file)) {
+            if (owner.group < 0) continue;
+
+            const auto &target = m_parser_result.targets[owner.target];
+            const auto &group  = target.sources[static_cast<std::size_t>(owner.group)];
+
+            const auto lazy_file =
+                std::find_if(std::cbegin(group.lazy_files),
+                             std::cend(group.lazy_files),
+                             [this, &file](const auto &path) {
+                                 return m_src_dir.resolvePath(path).cleanPath() == file;
+                             });
+            if (lazy_file == std::cend(group.lazy_files) ||
+                group.file_flags.contains(*lazy_file))
+                continue;
+
+            const auto query_key = target.name + '|' + *lazy_file;
+            if (m_file_queries.contains(query_key)) continue;
+            m_file_queries.insert(query_key);
+
+            qCDebug(xmake_project_parser_log)
+                << "Querying the flags of" << *lazy_file << "in" << target.name;
+
+            const auto query = QString { "%1 %2|%3" }.arg(
+                Constants::Introspection::SERVER_FILE_FLAGS,
+                target.name,
+                Utils::FilePath::fromString(*lazy_file).path());
+
+            introspectionServer()
+                .query(this,
+                       query.toUtf8(),
+                       [this,
+                        generation  = m_generation,
+                        target_name = target.name,
+                        file_name   = *lazy_file](int code, QByteArray std_out) {
+                           if (generation != m_generation) return;
+                           if (code != 0) {
+                               qCDebug(xmake_project_parser_log)
+                                   << "Failed to get the flags of" << file_name;
+                               return;
+                           }
+
+                           const auto answer = QJsonDocument::fromJson(std_out).object();
+                           setFileArguments(target_name,
+                                            file_name,
+                                            extractArray(answer["arguments"].toArray()));
+                       });
+        }
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::queryBuildInputs(QObject *context, BuildInputsCallback callback)
+        -> void {
+        if (!useMode(Settings::instance()->introspection_server,
+                     XMakeWrapper::Capability::Server)) {
+            callback(Utils::nullopt);
+            return;
+        }
+
+        introspectionServer()
+            .query(context,
+                   Constants::Introspection::SERVER_BUILD_INPUTS,
+                   [src_dir  = m_src_dir,
+                    callback = std::move(callback)](int code, QByteArray std_out) {
+                       if (code != 0) {
+                           qCDebug(xmake_project_parser_log) << "Failed to get the build inputs";
+                           callback(Utils::nullopt);
+                           return;
+                       }
+
+                       const auto targets =
+                           QJsonDocument::fromJson(std_out).object()["targets"].toObject();
+
+                       auto inputs = BuildInputs {};
+                       for (auto it = std::cbegin(targets); it != std::cend(targets); ++it) {
+                           auto &files = inputs[it.key()];
+                           for (const auto &file : it.value().toArray())
+                               files.append(
+                                   src_dir
+                                       .withNewPath(QDir::fromNativeSeparators(file.toString()))
+                                       .cleanPath());
+                       }
+
+                       callback(std::move(inputs));
+                   });
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeProjectParser::parse(const Utils::FilePath &source_path) -> bool {
-        m_src_dir = source_path;
+    auto XMakeProjectParser::setFileArguments(const QString &target_name,
+                                              const QString &file,
+                                              QStringList arguments) -> void {
+        auto &targets = m_parser_result.targets;
+
+        const auto target = std::find_if(std::begin(targets),
+                                         std::end(targets),
+                                         [&target_name](const auto &target) {
+                                             return target.name == target_name;
+                                         });
+        if (target == std::end(targets)) return;
+
+        auto changed = false;
+        for (auto &group : target->sources) {
+            if (!group.lazy_files.contains(file)) continue;
+
+            // an empty delta when the batch flags are right for this file, its part doesn't
+            // need to be split
+            auto delta = Target::FlagsDelta::between(group.arguments, arguments);
+            changed |= !delta.isEmpty();
+
+            group.file_flags.insert(file, std::move(delta));
+        }
+
+        if (changed) rebuildProjectParts();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::rebuildProjectParts() -> void {
+        // a running parse builds the project parts again anyway
+        if (!m_kit_info || m_parser_future_result.isRunning()) return;
+
+        if (m_parts_future.isRunning()) m_parts_future.cancel();
+
+        m_parts_future = Utils::runAsync(
+            ProjectExplorer::ProjectExplorerPlugin::sharedThreadPool(),
+            [src_dir        = m_src_dir,
+             targets        = m_parser_result.targets,
+             kit_info       = m_kit_info,
+             previous_parts = m_project_parts.by_target](QFutureInterface<ParserDataPtr> &future) {
+                auto parser_data = std::make_unique<ParserData>();
+                parser_data->project_parts =
+                    buildProjectParts(src_dir, targets, *kit_info, previous_parts, future);
+
+                if (!future.isCanceled()) future.reportResult(std::move(parser_data));
+            });
+
+        Utils::onFinished(m_parts_future,
+                          this,
+                          [this, generation = m_generation](QFuture<ParserDataPtr> future) {
+                              if (generation != m_generation || future.isCanceled() ||
+                                  future.resultCount() == 0)
+                                  return;
+
+                              m_project_parts = std::move(future.takeResult()->project_parts);
+
+                              Q_EMIT projectPartsUpdated();
+                          });
+    }
 
-        auto cmd = XMakeTools::xmakeWrapper(m_xmake)->introspect(source_path);
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::runIntrospection(const Utils::FilePath &source_path,
+                                              const QStringList &project_files) -> bool {
+        auto cmd = XMakeTools::xmakeWrapper(m_xmake)->introspect(source_path,
+                                                                 cborOutput(),
+                                                                 streaming(),
+                                                                 project_files);
+
+        // introspecting a few project files says little about the whole project
+        if (project_files.isEmpty()) m_history_phase = XMakePhaseHistory::Phase::Introspection;
+        else
+            m_history_phase.reset();
+
+        return runIntrospectionCommand(cmd, source_path, lowPriority(false));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::runIntrospectionCommand(const Command &cmd,
+                                                     const Utils::FilePath &source_path,
+                                                     bool low_priority) -> bool {
         qCDebug(xmake_project_parser_log) << "Starting parser " << cmd.toUserOutput();
 
+        setupEnvironment();
+
+        startRun();
+        resetStream();
+
         m_process = std::make_unique<XMakeProcess>();
         connect(m_process.get(),
                 &XMakeProcess::finished,
                 this,
                 &XMakeProjectParser::processFinished);
-        m_process->run(cmd, m_env, m_project_name, source_path, true);
+        if (m_stream)
+            connect(m_process.get(),
+                    &XMakeProcess::readyReadStandardOutput,
+                    this,
+                    [stream = m_stream](const QByteArray &chunk) { stream->append(chunk); });
+
+        if (m_history_phase)
+            m_process->setExpectedDuration(
+                XMakePhaseHistory { m_build_dir }.estimate(*m_history_phase));
+
+        startPhase();
+        m_process->run(cmd, m_env, m_project_name, source_path, true, low_priority);
 
         return true;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::lowPriority(bool configure) const -> bool {
+        const auto &settings = *Settings::instance();
+        if (!m_background || !settings.background_low_priority.value()) return false;
+
+        return !configure || settings.background_configure_low_priority.value();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::affectedProjectFiles(const Utils::FilePaths &changed_files) const
+        -> QStringList {
+        if (changed_files.isEmpty() || m_parser_result.targets.empty()) return {};
+
+        const auto root_file = m_src_dir.pathAppended("xmake.lua");
+
+        auto project_files = QStringList {};
+        for (const auto &changed_file : changed_files) {
+            // the root file scope applies to every target
+            if (changed_file == root_file) return {};
+
+            const auto directory = changed_file.absolutePath();
+
+            auto defines_targets = false;
+            for (const auto &target : m_parser_result.targets) {
+                const auto defined_in = Utils::FilePath::fromString(target.defined_in);
+
+                // targets of included sub directories inherit the scope of the changed file
+                if (defined_in == changed_file) defines_targets = true;
+                else if (!defined_in.isChildOf(directory))
+                    continue;
+
+                project_files.append(target.defined_in);
+            }
+
+            // options, includes or helpers, we can't know which targets are affected
+            if (!defines_targets) return {};
+        }
+
+        project_files.removeDuplicates();
+
+        return project_files;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeProjectParser::appTargets() const -> QList<ProjectExplorer::BuildTargetInfo> {
@@ -205,42 +967,22 @@ namespace XMakeProjectManager::Internal {
             if (target.kind == Target::Kind::BINARY) {
                 auto &target_info = apps.emplace_back();
 
-                target_info.runEnvModifier = [add = target.add_env,
-                                              set = target.set_env](Utils::Environment &env,
-                                                                    bool add_to_path) {
-                    if (!add_to_path) return;
-
-                    for (const auto &[name, value] : set) env.set(name, value);
-
-                    for (const auto &[name, values] : add) {
-                        if (name == "PATH" || name == "LD_LIBRARY_PATH") {
-                            if (name == "PATH")
-                                for (const auto &value : values)
-                                    env.appendOrSetPath(
-                                        Utils::FilePath::fromString(value).cleanPath());
-                            else
-                                for (const auto &value : values)
-                                    env.appendOrSet(
-                                        name,
-                                        Utils::FilePath::fromString(value).cleanPath().toString());
-                        } else
-                            for (const auto &value : values) env.appendOrSet(name, value);
-                    }
-                };
-
-                const auto env = [&] {
-                    auto output = QStringList {};
-
-                    for (const auto &[name, value] : target.set_env) output.emplace_back(value);
+                const auto delta = runEnvironmentDelta(target);
 
-                    for (const auto &[name, values] : target.add_env) {
-                        for (const auto &value : values) output.emplace_back(value);
-                    }
-
-                    return output;
-                }();
+                target_info.runEnvModifier = [delta](Utils::Environment &env, bool add_to_path) {
+                    if (add_to_path) env.modify(delta);
+                };
 
-                target_info.runEnvModifierHash = qHash(env);
+                // run configurations only update when a name, a value or an operation changed
+                auto hash = QCryptographicHash { QCryptographicHash::Sha1 };
+                for (const auto &item : delta) {
+                    hash.addData(item.name.toUtf8());
+                    hash.addData("\0", 1);
+                    hash.addData(item.value.toUtf8());
+                    hash.addData("\0", 1);
+                    hash.addData(QByteArray::number(static_cast<int>(item.operation)));
+                }
+                target_info.runEnvModifierHash = qHash(hash.result());
 
                 target_info.displayName = target.name;
                 target_info.buildKey =
@@ -259,18 +1001,20 @@ namespace XMakeProjectManager::Internal {
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeProjectParser::buildProjectParts(const QtSupport::CppKitInfo &kit_info) const
-        -> ProjectExplorer::RawProjectParts {
-        auto parts = ProjectExplorer::RawProjectParts {};
-
-        auto qt_version     = Utils::QtMajorVersion::Unknown;
-        auto qt_header_path = Utils::FilePath {};
-
-        const auto private_str = QString { "private" };
+    auto XMakeProjectParser::buildProjectParts(const Utils::FilePath &src_dir,
+                                               const TargetsList &targets,
+                                               const QtSupport::CppKitInfo &kit_info,
+                                               const TargetPartsMap &previous_parts,
+                                               QFutureInterface<ParserDataPtr> &future)
+        -> ProjectParts {
+        auto qt_version = Utils::QtMajorVersion::Unknown;
+
+        auto args_sets     = CompilerArgsSets {};
+        auto qt_paths_sets = QtHeaderPathsSets {};
+        auto args_mutex    = QMutex {};
+        auto mime_types    = XMakeMimeTypeCache {};
 
         if (kit_info.qtVersion) {
-            qt_header_path = kit_info.qtVersion->headerPath();
-
             if (kit_info.qtVersion->qtVersion().majorVersion == 6)
                 qt_version = Utils::QtMajorVersion::Qt6;
             else if (kit_info.qtVersion->qtVersion().majorVersion == 5)
@@ -279,121 +1023,769 @@ namespace XMakeProjectManager::Internal {
                 qt_version = Utils::QtMajorVersion::Qt4;
         }
 
-        for (const auto &target : m_parser_result.targets) {
-            qCDebug(xmake_project_parser_log)
+        const auto build_target_parts = [&](const Target &target) {
+            auto target_parts = TargetParts {};
+            if (future.isCanceled()) return target_parts;
+
+            auto &parts = target_parts.parts;
+
+            XMAKE_NODE_TRACE(xmake_project_parser_log)
                 << "---------------- TARGET " << target.name << " -------------------";
 
+            // the headers are indexed once, with the C++ sources or else with the C ones
+            const auto header_group = [&target] {
+                for (const auto *kind : { "cxx", "cc" }) {
+                    const auto it = std::find_if(std::cbegin(target.sources),
+                                                 std::cend(target.sources),
+                                                 [kind](const auto &group) {
+                                                     return group.kind == QLatin1String { kind };
+                                                 });
+                    if (it != std::cend(target.sources)) return &*it;
+                }
+
+                return static_cast<const Target::SourceGroup *>(nullptr);
+            }();
+
             auto id = 0;
-            parts.reserve(std::size(parts) + std::size(target.sources));
+            parts.reserve(std::size(target.sources));
             for (const auto &source_group : target.sources) {
                 if (source_group.kind != "cxx" && source_group.kind != "cc" &&
-                    source_group.kind != "cuda" && source_group.kind != "headers" &&
-                    source_group.kind != "cxxmodules")
+                    source_group.kind != "cuda" && source_group.kind != "cxxmodules")
                     continue;
 
-                parts.emplace_back(buildProjectPart(target, source_group, kit_info, id++));
-            }
+                const auto flags =
+                    sharedCompilerArgs(args_sets, args_mutex, source_group.arguments, src_dir);
+
+                // the files configured with their own flags get one part per distinct set of
+                // flags, sorted to keep the part ids stable
+                auto batch      = source_group;
+                auto file_parts = std::vector<std::pair<QStringList, QStringList>> {};
+
+                if (&source_group == header_group) batch.sources.append(target.headers);
 
-            if (target.use_qt) {
-                auto include_paths = ProjectExplorer::HeaderPaths {};
+                auto configured_files = source_group.file_flags.keys();
+                configured_files.sort();
+                for (const auto &file : configured_files) {
+                    const auto &delta = source_group.file_flags[file];
+                    if (delta.isEmpty()) continue;
 
-                for (const auto &framework : target.frameworks) {
-                    if (framework.startsWith("Qt") && framework.endsWith(private_str)) {
-                        auto name = framework.left(framework.size() - private_str.size());
+                    batch.sources.removeAll(file);
 
-                        include_paths.emplace_back(ProjectExplorer::HeaderPath::makeSystem(
-                            qt_header_path / name / kit_info.qtVersion->qtVersionString()));
-                        include_paths.emplace_back(ProjectExplorer::HeaderPath::makeSystem(
-                            qt_header_path / name / kit_info.qtVersion->qtVersionString() / name));
-                    } else if (framework.startsWith("Qt"))
-                        include_paths.emplace_back(
-                            ProjectExplorer::HeaderPath::makeSystem(qt_header_path / framework));
+                    auto arguments = delta.applyTo(source_group.arguments);
+
+                    auto it = std::find_if(std::begin(file_parts),
+                                           std::end(file_parts),
+                                           [&arguments](const auto &part) {
+                                               return part.first == arguments;
+                                           });
+                    if (it == std::end(file_parts))
+                        file_parts.emplace_back(std::move(arguments), QStringList { file });
+                    else
+                        it->second.append(file);
                 }
 
-                for (auto &part : parts) {
-                    if (!target.use_qt) continue;
+                for (const auto &[arguments, files] : file_parts) {
+                    const auto file_flags =
+                        sharedCompilerArgs(args_sets, args_mutex, arguments, src_dir);
+                    parts.emplace_back(buildProjectPart(target,
+                                                        { source_group.kind, files, arguments },
+                                                        file_flags,
+                                                        kit_info,
+                                                        mime_types,
+                                                        id++));
+                }
+
+                if (std::empty(target.module_units) || source_group.kind != "cxx") {
+                    parts.emplace_back(
+                        buildProjectPart(target, batch, flags, kit_info, mime_types, id++));
+                    continue;
+                }
+
+                // every module unit gets a part with the interfaces it imports, the other
+                // sources may import any of the modules the target sees
+                const auto interfaces = moduleInterfaces(target, targets);
+
+                auto group       = std::move(batch);
+                auto group_flags = flags;
+                group_flags.cxx_arguments += moduleFileArguments(interfaces.keys(), interfaces);
+
+                for (const auto &unit : target.module_units) {
+                    group.sources.removeAll(unit.file);
+                    if (!source_group.file_flags.value(unit.file).isEmpty()) continue;
+
+                    auto unit_flags = flags;
+                    unit_flags.cxx_arguments += moduleFileArguments(unit.imports, interfaces);
+
+                    parts.emplace_back(buildProjectPart(target,
+                                                        { source_group.kind,
+                                                          { unit.file },
+                                                          source_group.arguments },
+                                                        unit_flags,
+                                                        kit_info,
+                                                        mime_types,
+                                                        id++));
+                }
+
+                parts.emplace_back(
+                    buildProjectPart(target, group, group_flags, kit_info, mime_types, id++));
+            }
+
+            if (target.use_qt && kit_info.qtVersion) {
+                const auto &qt_paths = sharedQtHeaderPaths(qt_paths_sets,
+                                                           args_mutex,
+                                                           target.frameworks,
+                                                           *kit_info.qtVersion);
 
+                // parts sharing their include paths keep sharing them once merged
+                auto merged = std::vector<std::pair<ProjectExplorer::HeaderPaths,
+                                                    ProjectExplorer::HeaderPaths>> {};
+
+                for (auto &part : parts) {
                     part.setQtVersion(qt_version);
 
-                    part.headerPaths.append(
-                        ProjectExplorer::HeaderPath::makeSystem(qt_header_path));
-                    part.headerPaths.append(include_paths);
+                    auto it = std::find_if(std::begin(merged),
+                                           std::end(merged),
+                                           [&part](const auto &pair) {
+                                               return pair.first == part.headerPaths;
+                                           });
+                    if (it == std::end(merged))
+                        it = merged.emplace(std::end(merged),
+                                            part.headerPaths,
+                                            appendUniqueHeaderPaths(part.headerPaths, qt_paths));
+
+                    part.setHeaderPaths(it->second);
                 }
             }
+
+            target_parts.compile_commands =
+                XMakeCompilationDatabase::targetEntries(target, src_dir, kit_info);
+
+            return target_parts;
+        };
+
+        const auto kit_fingerprint = kitFingerprint(kit_info);
+
+        auto result = ProjectParts {};
+
+        // targets are independent, only the argument sets are shared between them
+        auto futures = std::vector<QFuture<TargetParts>> {};
+        futures.reserve(std::size(targets));
+
+        auto fingerprints = QByteArrayList {};
+        fingerprints.reserve(std::size(targets));
+
+        for (const auto &target : targets) {
+            auto fingerprint = targetFingerprint(target, src_dir, kit_fingerprint);
+
+            // an unchanged target keeps the parts the code model already knows
+            const auto previous = previous_parts.constFind(target.name);
+            if (previous != std::cend(previous_parts) && previous->fingerprint == fingerprint)
+                futures.emplace_back(QtFuture::makeReadyFuture(*previous));
+            else {
+                result.changed_targets.append(target.name);
+                futures.emplace_back(
+                    Utils::runAsync(ProjectExplorer::ProjectExplorerPlugin::sharedThreadPool(),
+                                    [&build_target_parts, &target] {
+                                        return build_target_parts(target);
+                                    }));
+            }
+
+            fingerprints.append(std::move(fingerprint));
         }
 
-        return parts;
+        for (auto i = 0u; i < std::size(targets); ++i) {
+            auto target_parts        = futures[i].result();
+            target_parts.fingerprint = fingerprints[i];
+
+            result.parts.append(target_parts.parts);
+            for (const auto &entry : std::as_const(target_parts.compile_commands))
+                result.compile_commands.append(entry);
+
+            result.by_target.insert(targets[i].name, std::move(target_parts));
+        }
+
+        for (const auto &name : previous_parts.keys())
+            if (!result.by_target.contains(name)) result.changed_targets.append(name);
+
+        qCDebug(xmake_project_parser_log)
+            << result.parts.size() << "project parts share" << args_sets.size()
+            << "argument sets," << result.changed_targets.size() << "targets changed";
+
+        return result;
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeProjectParser::startParser(const QByteArray &data) -> bool {
-        m_parser_future_result =
-            Utils::runAsync(ProjectExplorer::ProjectExplorerPlugin::sharedThreadPool(),
-                            [data, build_dir = m_build_dir.toString(), src_dir = m_src_dir] {
-                                return extractParserResults(src_dir, XMakeInfoParser::parse(data));
-                            });
+    auto XMakeProjectParser::startParser(QByteArray data, Utils::FilePath mapped_output) -> bool {
+        const auto cache_key = [this] {
+            if (!Settings::instance()->introspection_cache.value()) return QByteArray {};
+
+            return XMakeIntrospectionCache::key(XMakeTools::xmakeWrapper(m_xmake)->exe(),
+                                                m_config_args);
+        }();
+
+        m_timings.payload_size = mapped_output.isEmpty() ? data.size() : mapped_output.fileSize();
+
+        m_parser_future_result = Utils::runAsync(
+            ProjectExplorer::ProjectExplorerPlugin::sharedThreadPool(),
+            [data         = std::move(data),
+             src_dir      = m_src_dir,
+             build_dir    = m_build_dir,
+             fixtures_dir = XMakeFixtureRecorder::directory(),
+             // only the answer to a target filter is merged with the targets it replaces
+             previous_targets = m_filtered ? m_parser_result.targets : TargetsList {},
+             previous_files   = m_filtered ? m_parser_result.build_system_files
+                                           : std::vector<Utils::FilePath> {},
+             cache            = XMakeIntrospectionCache { m_build_dir },
+             cache_key,
+             shared_key = sharedKey(),
+             output_dir = XMakeSharedIntrospection::outputDir(m_config_args, m_src_dir),
+             options    = extractOptions(),
+             mapped_output = std::move(mapped_output),
+             stream  = std::exchange(m_stream, {})](QFutureInterface<ParserDataPtr> &future) {
+                auto file          = QFile { mapped_output.toString() };
+                const auto cleanup = qScopeGuard([&file] {
+                    if (!file.isOpen()) return;
+
+                    file.close();
+                    file.remove();
+                });
+
+                // the document is decoded straight from the mapped pages, without a copy
+                auto payload = data;
+                if (!mapped_output.isEmpty() && file.open(QIODevice::ReadOnly)) {
+                    if (const auto *mapped = file.map(0, file.size()))
+                        payload = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped),
+                                                          file.size());
+                    else
+                        payload = file.readAll();
+                }
+
+                auto streamed_targets = Utils::optional<TargetsList> {};
+                if (stream) streamed_targets = stream->takeTargets();
 
-        Utils::onFinished(m_parser_future_result, this, &XMakeProjectParser::update);
+                auto result = XMakeInfoParser::parse(payload, std::move(streamed_targets));
+                if (future.isCanceled()) return;
+
+                // a partial document only makes sense with the targets it replaces
+                if (!fixtures_dir.isEmpty() && !payload.isEmpty() &&
+                    result.partial_files.isEmpty())
+                    XMakeFixtureRecorder::record(fixtures_dir,
+                                                 result.format,
+                                                 payload,
+                                                 src_dir,
+                                                 build_dir);
+
+                mapDevicePaths(result, src_dir);
+
+                if (!result.partial_files.isEmpty()) {
+                    if (!mergePartialResult(result, previous_targets, previous_files)) {
+                        auto parser_data              = std::make_unique<ParserData>();
+                        parser_data->needs_full_parse = true;
+
+                        future.reportResult(std::move(parser_data));
+                        return;
+                    }
+                } else if (!cache_key.isEmpty() && !std::empty(result.targets))
+                    cache.store(cache_key, payload, result.build_system_files);
+
+                auto shared = XMakeSharedIntrospection::ResultPtr {};
+                if (!shared_key.isEmpty() && !std::empty(result.targets))
+                    shared = XMakeSharedIntrospection::publish(shared_key,
+                                                               result,
+                                                               build_dir,
+                                                               output_dir);
+
+                auto parser_data =
+                    extractParserResults(src_dir, std::move(result), options, future);
+                if (!parser_data) return;
+
+                parser_data->shared = std::move(shared);
+                future.reportResult(std::move(parser_data));
+            });
+
+        watchParser(m_generation);
+
+        return true;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::parseShared() -> bool {
+        const auto key = sharedKey();
+        if (key.isEmpty()) return false;
+
+        auto shared = XMakeSharedIntrospection::find(key);
+
+        // asking again for the result this parser already shows means a fresh run is wanted
+        if (!shared || shared == m_shared_result) return false;
+
+        qCDebug(xmake_project_parser_log)
+            << "Reusing the introspection of another build configuration";
+
+        const auto generation = startRun();
+        startTimings(true);
+
+        m_parser_future_result = Utils::runAsync(
+            ProjectExplorer::ProjectExplorerPlugin::sharedThreadPool(),
+            [shared     = std::move(shared),
+             src_dir    = m_src_dir,
+             build_dir  = m_build_dir,
+             output_dir = XMakeSharedIntrospection::outputDir(m_config_args, m_src_dir),
+             options    = extractOptions()](QFutureInterface<ParserDataPtr> &future) {
+                // the target files, autogen directories and module BMIs are the ones of this
+                // build configuration
+                auto parser_data = extractParserResults(
+                    src_dir,
+                    XMakeSharedIntrospection::rebase(*shared, build_dir, output_dir),
+                    options,
+                    future);
+                if (!parser_data) return;
+
+                parser_data->shared = shared;
+                future.reportResult(std::move(parser_data));
+            });
+
+        watchParser(generation);
 
         return true;
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeProjectParser::processFinished(int code, QString std_out) -> void {
+    auto XMakeProjectParser::sharedKey() const -> QByteArray {
+        const auto xmake = XMakeTools::xmakeWrapper(m_xmake);
+        if (!Settings::instance()->shared_introspection.value() || !xmake) return {};
+
+        return XMakeSharedIntrospection::key(xmake->exe(), m_config_args, m_src_dir, m_build_dir);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::processFinished(int code, QByteArray std_out) -> void {
+        // the introspection server answers without spawning a process
+        if (m_process && m_process->spawnTime() >= 0)
+            m_timings.spawn = std::max<qint64>(m_timings.spawn, 0) + m_process->spawnTime();
+
+        (m_configuring ? m_timings.configure : m_timings.introspection) =
+            m_phase_timer.elapsed();
+
+        if (code == 0 && m_history_phase)
+            XMakePhaseHistory { m_build_dir }.record(*m_history_phase, m_phase_timer.elapsed());
+        m_history_phase.reset();
+
         if (code != 0) {
+            m_configuring = false;
+
             Q_EMIT parsingCompleted(false);
             return;
         }
 
-        auto json_output = [&] {
-            auto json = QJsonDocument::fromJson(std_out.toLatin1());
+        if (m_configuring) {
+            m_configuring = false;
 
-            auto str = QString::fromLocal8Bit(json.toJson());
+            parse(m_src_dir, QStringList {});
+            return;
+        }
 
-            if (str.size()) return str;
+        // a local document is mapped by the parser worker, the main thread never reads it
+        if (const auto output = cborOutput(); !output.isEmpty() && !output.needsDevice() &&
+                                              output.exists()) {
+            startParser({}, output);
+            return;
+        }
 
-            return QString::fromLocal8Bit(std_out.toLatin1());
-        }();
+        startParser(takeIntrospectionOutput(std::move(std_out)));
+    }
 
-        if (m_pending_commands.isEmpty()) startParser(json_output.toLocal8Bit());
-        else {
-            auto args = m_pending_commands.dequeue();
-            m_process = std::make_unique<XMakeProcess>();
-            connect(m_process.get(),
-                    &XMakeProcess::finished,
-                    this,
-                    &XMakeProjectParser::processFinished);
-            m_process->run(std::get<0>(args),
-                           m_env,
-                           m_project_name,
-                           std::get<1>(args),
-                           std::get<2>(args));
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::resetStream() -> void {
+        if (!streaming()) {
+            m_stream.reset();
+            return;
         }
+
+        m_stream = std::make_shared<XMakeIntrospectionStream>(m_src_dir.cleanPath());
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::useMode(const Utils::BoolAspect &setting,
+                                     XMakeWrapper::Capability capability) const -> bool {
+        const auto xmake = XMakeTools::xmakeWrapper(m_xmake);
+
+        return setting.value() && xmake && xmake->hasCapability(capability);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::streaming() const -> bool {
+        // the output of a device process goes through its shell, one CBOR file is cheaper
+        if (m_src_dir.needsDevice()) return false;
+
+        return useMode(Settings::instance()->introspection_streaming,
+                       XMakeWrapper::Capability::Stream);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::lazyFileFlags() const -> bool {
+        const auto xmake = XMakeTools::xmakeWrapper(m_xmake);
+
+        return Settings::instance()->lazy_file_flags.value() &&
+               useMode(Settings::instance()->introspection_server,
+                       XMakeWrapper::Capability::Server) &&
+               xmake->hasCapability(XMakeWrapper::Capability::FileFlags);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::serverCommand() const -> Command {
+        return XMakeTools::xmakeWrapper(m_xmake)->introspectServer(m_src_dir,
+                                                                   cborOutput(),
+                                                                   streaming(),
+                                                                   lazyFileFlags());
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::setupEnvironment() -> void {
+        m_env.setupEnglishOutput();
+        m_env.appendOrSet("XMAKE_PROJECTDIR", m_src_dir.nativePath());
+        m_env.appendOrSet("XMAKE_CONFIGDIR", m_build_dir.nativePath());
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::introspectionServer() -> XMakeIntrospectionServer & {
+        // a parse without a configure still has to pick the server of its build directory
+        setupEnvironment();
+
+        return XMakeIntrospectionServer::instance(serverCommand(), m_env);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::cborOutput() const -> Utils::FilePath {
+        // streamed targets are printed on stdout, the CBOR document only pays off in one piece
+        if (m_build_dir.isEmpty() || streaming()) return {};
+
+        const auto xmake = XMakeTools::xmakeWrapper(m_xmake);
+        if (!xmake || !xmake->hasCapability(XMakeWrapper::Capability::Cbor)) return {};
+
+        return m_build_dir.pathAppended(Constants::Introspection::CBOR_OUTPUT);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::compileCommandsOutput() const -> Utils::FilePath {
+        if (m_build_dir.isEmpty() || !Settings::instance()->compile_commands.value()) return {};
+
+        return m_build_dir.pathAppended(Constants::COMPILE_COMMANDS);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::takeIntrospectionOutput(QByteArray std_out) const -> QByteArray {
+        // the script falls back to JSON on stdout when it can't write the CBOR document
+        const auto output = cborOutput();
+        if (output.isEmpty() || !output.exists()) return std_out;
+
+        // read in one transfer when the build directory is on a device
+        auto data = output.fileContents();
+        output.removeFile();
+
+        return data;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::mapDevicePaths(XMakeInfoParser::Result &result,
+                                            const Utils::FilePath &src_dir) -> void {
+        if (!src_dir.needsDevice()) return;
+
+        const auto device_root = src_dir.withNewPath("/");
+
+        result.project_dir = device_root.withNewPath(result.project_dir.path());
+
+        for (auto &file : result.build_system_files) file = device_root.withNewPath(file.path());
+
+        for (auto &path : result.qml_import_paths)
+            path = device_root.withNewPath(path).toString();
+
+        for (auto &target : result.targets)
+            for (auto &path : target.qml_import_paths)
+                path = device_root.withNewPath(path).toString();
+
+        result.paths.setDevice(device_root);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::mergePartialResult(XMakeInfoParser::Result &result,
+                                                const TargetsList &previous_targets,
+                                                const std::vector<Utils::FilePath> &previous_files)
+        -> bool {
+        const auto introspected_files = QSet<QString> { std::cbegin(result.partial_files),
+                                                        std::cend(result.partial_files) };
+
+        // an includes() added or removed, the filter missed the targets of the other files
+        const auto files = [](const auto &paths) {
+            return QSet<Utils::FilePath> { std::cbegin(paths), std::cend(paths) };
+        };
+        if (files(result.build_system_files) != files(previous_files)) {
+            qCDebug(xmake_project_parser_log)
+                << "The project files changed, the partial introspection is dropped";
+            return false;
+        }
+
+        // a target moved to or from another file, the kept targets no longer match
+        auto introspected_targets = QSet<QString> {};
+        for (const auto &target : result.targets) introspected_targets.insert(target.name);
+
+        auto replaced_targets = QSet<QString> {};
+        for (const auto &target : previous_targets)
+            if (introspected_files.contains(target.defined_in))
+                replaced_targets.insert(target.name);
+
+        if (introspected_targets != replaced_targets) {
+            qCDebug(xmake_project_parser_log)
+                << "The introspected targets changed, the partial introspection is dropped";
+            return false;
+        }
+
+        qCDebug(xmake_project_parser_log)
+            << "Merging" << std::size(result.targets) << "re-introspected targets";
+
+        // the import paths of the replaced targets are the ones the script answered with
+        for (const auto &target : previous_targets) {
+            if (introspected_files.contains(target.defined_in)) continue;
+
+            result.targets.push_back(target);
+            result.qml_import_paths.append(target.qml_import_paths);
+        }
+
+        std::sort(std::begin(result.targets),
+                  std::end(result.targets),
+                  [](const auto &a, const auto &b) { return a.name < b.name; });
+
+        result.qml_import_paths.removeDuplicates();
+
+        // the kept targets come from the previous result, share their paths with the new ones
+        result.paths.intern(result.targets);
+        TargetParser::resolveDependencies(result.targets);
+
+        return true;
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeProjectParser::extractParserResults(const Utils::FilePath &src_dir,
-                                                  XMakeInfoParser::Result &&parser_result)
-        -> XMakeProjectParser::ParserData * {
+                                                  XMakeInfoParser::Result &&parser_result,
+                                                  const ExtractOptions &options,
+                                                  QFutureInterface<ParserDataPtr> &future)
+        -> ParserDataPtr {
         qCDebug(xmake_project_parser_log) << "Extract parser results";
+
+        auto timings     = ParseTimings {};
+        timings.document = parser_result.document_time;
+        timings.targets  = parser_result.targets_time;
+
+        timings.target_count = static_cast<int>(std::size(parser_result.targets));
+        timings.file_count   = 0;
+        for (const auto &target : parser_result.targets) {
+            timings.file_count += target.headers.size() + target.modules.size();
+            for (const auto &group : target.sources) timings.file_count += group.sources.size();
+        }
+
+        const auto &profiles = parser_result.profiles;
+        timings.slowest_targets.assign(
+            std::cbegin(profiles),
+            std::next(std::cbegin(profiles),
+                      static_cast<std::ptrdiff_t>(
+                          std::min(std::size(profiles), ParseTimings::SLOWEST_TARGETS))));
+
+        auto timer = QElapsedTimer {};
+        timer.start();
+
         auto root_node = ProjectTree::buildTree(src_dir,
                                                 parser_result.project_dir,
                                                 parser_result.targets,
-                                                parser_result.build_system_files);
+                                                parser_result.build_system_files,
+                                                parser_result.paths,
+                                                !options.lazy_tree,
+                                                [&future] { return future.isCanceled(); });
+        if (!root_node) return nullptr;
+
+        timings.tree = timer.restart();
+
+        auto project_parts = ProjectParts {};
+        if (options.kit_info)
+            project_parts = buildProjectParts(src_dir,
+                                              parser_result.targets,
+                                              *options.kit_info,
+                                              options.previous_parts,
+                                              future);
+        if (future.isCanceled()) return nullptr;
+
+        if (options.kit_info) timings.project_parts = timer.elapsed();
+
+        timings.memory =
+            MemoryReport::estimate(parser_result.targets, root_node.get(), project_parts.parts);
+
+        const auto &compile_commands = options.compile_commands;
+        if (options.kit_info && !compile_commands.isEmpty() &&
+            (!project_parts.changed_targets.isEmpty() || !compile_commands.exists()))
+            XMakeCompilationDatabase::write(compile_commands, project_parts.compile_commands);
+
+        auto file_index = XMakeFileIndex { src_dir, parser_result.targets };
+
+        return std::make_unique<ParserData>(ParserData { std::move(parser_result),
+                                                         std::move(root_node),
+                                                         std::move(project_parts),
+                                                         options.lazy_tree,
+                                                         std::move(timings),
+                                                         {},
+                                                         std::move(file_index) });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::extractOptions() const -> ExtractOptions {
+        return { m_kit_info,
+                 m_project_parts.by_target,
+                 compileCommandsOutput(),
+                 Settings::instance()->lazy_project_tree.value() };
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::populateTree(quint64 generation) -> void {
+        // the targets are already shown, their files are listed in a second tree
+        m_tree_future = Utils::runAsync(
+            ProjectExplorer::ProjectExplorerPlugin::sharedThreadPool(),
+            [src_dir     = m_src_dir,
+             project_dir = m_parser_result.project_dir,
+             targets     = m_parser_result.targets,
+             bs_files    = m_parser_result.build_system_files,
+             paths       = m_parser_result.paths](
+                QFutureInterface<std::unique_ptr<XMakeProjectNode>> &future) {
+                auto root_node = ProjectTree::buildTree(src_dir,
+                                                        project_dir,
+                                                        targets,
+                                                        bs_files,
+                                                        paths,
+                                                        true,
+                                                        [&future] { return future.isCanceled(); });
+                if (root_node) future.reportResult(std::move(root_node));
+            });
+
+        Utils::onFinished(
+            m_tree_future,
+            this,
+            [this, generation](QFuture<std::unique_ptr<XMakeProjectNode>> future) {
+                // a dropped tree is freed with the future
+                if (future.resultCount() == 0) return;
+                if (generation != m_generation || future.isCanceled()) return;
+
+                m_root_node = future.takeResult();
+
+                Q_EMIT projectTreePopulated();
+            });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::startTimings(bool cached) -> void {
+        m_timings            = ParseTimings {};
+        m_timings.cached     = cached;
+        m_timings.started_at = QDateTime::currentDateTime();
 
-        return new ParserData { std::move(parser_result), std::move(root_node) };
+        m_phase_timer.invalidate();
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeProjectParser::update(const QFuture<ParserData *> &data) -> void {
-        auto parser_data = data.result();
+    auto XMakeProjectParser::startPhase() -> void { m_phase_timer.start(); }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::recordTimings() -> void {
+        m_timings.project = m_project_name;
+
+        if (Settings::instance()->trace_export.value()) {
+            const auto trace =
+                m_build_dir.pathAppended(QString::fromLatin1(Constants::PARSE_TRACE));
+            if (XMakeTraceExport::write(trace,
+                                        m_project_name,
+                                        XMakeTraceExport::parseThreadNames(),
+                                        XMakeTraceExport::parseSpans(m_timings)))
+                ProjectExplorer::BuildSystem::appendBuildSystemOutput(
+                    tr("The parse trace is in %1.").arg(trace.toUserOutput()));
+        }
+
+        XMakeParseTimings::instance().record(std::exchange(m_timings, {}));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::startRun() -> quint64 {
+        // the process may be the one which emitted the signal we are handling
+        if (m_process) {
+            m_process->disconnect(this);
+            if (m_process->isRunning()) m_process->stop();
+
+            m_process.release()->deleteLater();
+        }
+
+        if (m_parser_future_result.isRunning()) m_parser_future_result.cancel();
+        if (m_tree_future.isRunning()) m_tree_future.cancel();
+        if (m_parts_future.isRunning()) m_parts_future.cancel();
+
+        m_file_queries.clear();
+
+        return ++m_generation;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::watchParser(quint64 generation) -> void {
+        Utils::onFinished(m_parser_future_result,
+                          this,
+                          [this, generation](QFuture<ParserDataPtr> future) {
+                              if (generation == m_generation && !future.isCanceled()) {
+                                  update(std::move(future));
+                                  return;
+                              }
+
+                              // the dropped parser data is freed with the future
+                              qCDebug(xmake_project_parser_log)
+                                  << "Dropping the results of a superseded parse";
+                          });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeProjectParser::update(QFuture<ParserDataPtr> data) -> void {
+        const auto parser_data = data.takeResult();
+        if (!parser_data) {
+            Q_EMIT cacheMissed();
+            return;
+        }
+
+        if (parser_data->needs_full_parse) {
+            startTimings();
+            parse(m_src_dir, QStringList {});
+            return;
+        }
 
         m_parser_result = std::move(parser_data->data);
         m_root_node     = std::move(parser_data->root_node);
+        m_project_parts = std::move(parser_data->project_parts);
+        m_shared_result = std::move(parser_data->shared);
+        m_file_index    = std::move(parser_data->file_index);
+        m_stale         = parser_data->stale;
 
         m_targets_names.clear();
 
@@ -404,26 +1796,44 @@ namespace XMakeProjectManager::Internal {
 
         m_targets_names.sort();
 
-        delete parser_data;
+        auto &timings           = parser_data->timings;
+        m_timings.document      = timings.document;
+        m_timings.targets       = timings.targets;
+        m_timings.tree          = timings.tree;
+        m_timings.project_parts = timings.project_parts;
+        m_timings.target_count  = timings.target_count;
+        m_timings.file_count    = timings.file_count;
+        m_timings.memory        = timings.memory;
+
+        // a cached result holds the measures of the run which stored it
+        if (!m_timings.cached) m_timings.slowest_targets = std::move(timings.slowest_targets);
+
+        const auto lazy_tree = parser_data->lazy_tree;
 
         Q_EMIT parsingCompleted(true);
+
+        recordTimings();
+
+        if (lazy_tree) populateTree(m_generation);
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeProjectParser::buildProjectPart(const Target &target,
                                               const Target::SourceGroup &sources,
+                                              const CompilerArgs &flags,
                                               const QtSupport::CppKitInfo &kit_info,
-                                              int id) const -> ProjectExplorer::RawProjectPart {
-        const auto flags = splitArgs(sources.arguments, m_src_dir);
+                                              XMakeMimeTypeCache &mime_types,
+                                              int id) -> ProjectExplorer::RawProjectPart {
         for (const auto &path : flags.include_paths)
-            qCDebug(xmake_project_parser_log)
+            XMAKE_NODE_TRACE(xmake_project_parser_log)
                 << "INCLUDEPATH: " << path.path << ":" << static_cast<int>(path.type);
         for (const auto &macro : flags.macros)
-            qCDebug(xmake_project_parser_log) << "MACRO: " << macro.key << ":" << macro.value;
-        qCDebug(xmake_project_parser_log) << "ARGUMENTS: " << flags.arguments;
-        qCDebug(xmake_project_parser_log) << "SOURCES: " << sources.sources;
-        qCDebug(xmake_project_parser_log) << "SOURCES KIND: " << sources.kind;
+            XMAKE_NODE_TRACE(xmake_project_parser_log)
+                << "MACRO: " << macro.key << ":" << macro.value;
+        XMAKE_NODE_TRACE(xmake_project_parser_log) << "ARGUMENTS: " << flags.arguments;
+        XMAKE_NODE_TRACE(xmake_project_parser_log) << "SOURCES: " << sources.sources;
+        XMAKE_NODE_TRACE(xmake_project_parser_log) << "SOURCES KIND: " << sources.kind;
 
         auto part = ProjectExplorer::RawProjectPart {};
 
@@ -432,22 +1842,22 @@ namespace XMakeProjectManager::Internal {
         part.setBuildSystemTarget(target.name);
         part.setProjectFileLocation(target.defined_in);
 
-        auto include_paths = flags.include_paths;
-
         auto _sources = sources.sources;
         _sources.removeDuplicates();
 
-        part.setFiles(_sources, {}, [](const auto &path) {
-            return Utils::mimeTypeForFile(path).name();
+        part.setFiles(_sources, {}, [&mime_types](const auto &path) {
+            return mime_types.mimeTypeName(path);
         });
         part.setMacros(flags.macros);
-        part.setHeaderPaths(include_paths);
+        part.setHeaderPaths(flags.include_paths);
+        part.setIncludedFiles(flags.forced_includes);
 
         auto base_dir = Utils::FilePath::fromString(target.defined_in).absolutePath().toString();
         if (kit_info.cxxToolChain)
-            part.setFlagsForCxx({ kit_info.cxxToolChain, flags.arguments, base_dir });
+            part.setFlagsForCxx(
+                { kit_info.cxxToolChain, flags.arguments + flags.cxx_arguments, base_dir });
         if (kit_info.cToolChain)
-            part.setFlagsForC({ kit_info.cToolChain, flags.arguments, base_dir });
+            part.setFlagsForC({ kit_info.cToolChain, flags.arguments + flags.c_arguments, base_dir });
 
         part.setBuildTargetType((target.kind == Target::Kind::BINARY)
                                     ? ProjectExplorer::BuildTargetType::Executable
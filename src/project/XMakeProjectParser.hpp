@@ -4,17 +4,25 @@
 
 #pragma once
 
+#include <QElapsedTimer>
 #include <QFuture>
+#include <QHash>
+#include <QJsonArray>
 #include <QObject>
-#include <QQueue>
-
-#include <tuple>
+#include <QSet>
 
 #include <projectexplorer/buildsystem.h>
 #include <projectexplorer/kit.h>
 #include <projectexplorer/rawprojectpart.h>
 
+#include <exewrappers/XMakeWrapper.hpp>
+
+#include <project/XMakeFileIndex.hpp>
+#include <project/XMakeIntrospectionStream.hpp>
+#include <project/XMakeParseTimings.hpp>
+#include <project/XMakePhaseHistory.hpp>
 #include <project/XMakeProcess.hpp>
+#include <project/XMakeSharedIntrospection.hpp>
 #include <project/parsers/XMakeOutputParser.hpp>
 
 #include <project/projecttree/XMakeProjectNodes.hpp>
@@ -22,17 +30,27 @@
 #include <xmakeinfoparser/XMakeBuildOptionsParser.hpp>
 #include <xmakeinfoparser/XMakeInfoParser.hpp>
 
+#include <qtsupport/qtcppkitinfo.h>
+
+#include <utils/aspects.h>
 #include <utils/environment.h>
+#include <utils/optional.h>
+
+#include <functional>
 
 namespace ProjectExplorer {
     class Project;
 }
 
-namespace QtSupport {
-    class CppKitInfo;
-}
-
 namespace XMakeProjectManager::Internal {
+    struct CompilerArgs;
+    class XMakeIntrospectionServer;
+    class XMakeMimeTypeCache;
+#ifdef WITH_TESTS
+    class XMakeParseBenchmarks;
+    class XMakeFixtureReplayTest;
+#endif
+
     class XMakeProjectParser: public QObject {
         Q_OBJECT
 
@@ -52,52 +70,180 @@ namespace XMakeProjectManager::Internal {
                   const Utils::FilePath &build_path,
                   const QStringList &args);
 
-        bool parse(const Utils::FilePath &source_path, const Utils::FilePath &build_path);
-        bool parse(const Utils::FilePath &source_path);
+        bool parse(const Utils::FilePath &source_path,
+                   const Utils::FilePath &build_path,
+                   const Utils::FilePaths &changed_files = {});
+        bool parse(const Utils::FilePath &source_path, const QStringList &project_files);
+        bool parseCached(const Utils::FilePath &source_path, const Utils::FilePath &build_path);
+
+        void setConfigArgs(QStringList args);
+        void setKitInfo(const QtSupport::CppKitInfo &kit_info);
+
+        // the next runs were not asked for by the user, they may run at low priority
+        void setBackground(bool background) noexcept;
 
         std::unique_ptr<XMakeProjectNode> takeProjectNode() noexcept;
 
         const TargetsList &targets() const noexcept;
         const QStringList &targetsNames() const noexcept;
+        const XMakeFileIndex &fileIndex() const noexcept;
+
+        // the result comes from the cache, a real introspection has to follow to catch the
+        // changes the cache can't see
+        bool isStale() const noexcept;
 
         const QStringList &qmlImportPaths() const noexcept;
 
+        const std::vector<Utils::FilePath> &buildSystemFiles() const noexcept;
+
+        const PackagesList &packages() const noexcept;
+
         const BuildOptionsList &options() const noexcept;
 
         void setEnvironment(const Utils::Environment &environment);
 
         QList<ProjectExplorer::BuildTargetInfo> appTargets() const;
-        ProjectExplorer::RawProjectParts
-            buildProjectParts(const QtSupport::CppKitInfo &kit_info) const;
+        const ProjectExplorer::RawProjectParts &projectParts() const noexcept;
+        const QStringList &changedTargets() const noexcept;
 
         const Utils::FilePath &srcDir() const noexcept;
         const Utils::FilePath &buildDir() const noexcept;
+
+        // handing the project parts to the code model is done by the build system
+        void setCodeModelTime(qint64 duration) noexcept;
+
+        // in lazy mode, asks the introspection process for the flags of a file configured with
+        // its own flags, the project parts are rebuilt once they are known
+        void queryFileArguments(const Utils::FilePath &file);
+
+        // the files each target was compiled from at its last build, as xmake recorded them in
+        // its dependency files, a target missing from the answer has no record yet
+        using BuildInputs         = QHash<QString, Utils::FilePaths>;
+        using BuildInputsCallback = std::function<void(Utils::optional<BuildInputs>)>;
+
+        // answered with nullopt without an introspection server or when xmake failed
+        void queryBuildInputs(QObject *context, BuildInputsCallback callback);
       Q_SIGNALS:
         void parsingCompleted(bool success);
+        void projectPartsUpdated();
+        void cacheMissed();
+        void projectTreePopulated();
 
       private:
+#ifdef WITH_TESTS
+        friend class XMakeParseBenchmarks;
+        friend class XMakeFixtureReplayTest;
+#endif
+
+        using KitInfoPtr = std::shared_ptr<const QtSupport::CppKitInfo>;
+
+        struct TargetParts {
+            QByteArray fingerprint;
+            ProjectExplorer::RawProjectParts parts;
+            QJsonArray compile_commands;
+        };
+        using TargetPartsMap = QHash<QString, TargetParts>;
+
+        struct ProjectParts {
+            ProjectExplorer::RawProjectParts parts;
+            TargetPartsMap by_target;
+            QStringList changed_targets;
+            QJsonArray compile_commands;
+        };
+
         struct ParserData {
             XMakeInfoParser::Result data;
             std::unique_ptr<XMakeProjectNode> root_node;
+            ProjectParts project_parts;
+            bool lazy_tree = false;
+            bool stale     = false;
+            // the partial introspection can't be merged, the whole project is introspected
+            bool needs_full_parse = false;
+            ParseTimings timings;
+            XMakeSharedIntrospection::ResultPtr shared;
+            XMakeFileIndex file_index;
         };
+        using ParserDataPtr = std::unique_ptr<ParserData>;
 
-        bool startParser(const QByteArray &data);
-        void processFinished(int code, QString std_out);
-
-        static ParserData *extractParserResults(const Utils::FilePath &source_dir,
-                                                XMakeInfoParser::Result &&parser_result);
-
-        void update(const QFuture<ParserData *> &data);
+        struct ExtractOptions {
+            KitInfoPtr kit_info;
+            TargetPartsMap previous_parts;
+            Utils::FilePath compile_commands;
+            bool lazy_tree = false;
+        };
 
-        ProjectExplorer::RawProjectPart buildProjectPart(const Target &target,
-                                                         const Target::SourceGroup &sources,
-                                                         const QtSupport::CppKitInfo &kit_info,
-                                                         int id) const;
+        bool runIntrospection(const Utils::FilePath &source_path, const QStringList &project_files);
+        bool runIntrospectionCommand(const Command &cmd,
+                                     const Utils::FilePath &source_path,
+                                     bool low_priority);
+        bool lowPriority(bool configure) const;
+        QStringList affectedProjectFiles(const Utils::FilePaths &changed_files) const;
+        void resetStream();
+        bool useMode(const Utils::BoolAspect &setting, XMakeWrapper::Capability capability) const;
+        bool streaming() const;
+        bool lazyFileFlags() const;
+        Command serverCommand() const;
+        void setupEnvironment();
+        XMakeIntrospectionServer &introspectionServer();
+        void setFileArguments(const QString &target_name,
+                              const QString &file,
+                              QStringList arguments);
+        void rebuildProjectParts();
+        Utils::FilePath cborOutput() const;
+        Utils::FilePath compileCommandsOutput() const;
+        QByteArray takeIntrospectionOutput(QByteArray std_out) const;
+        bool startParser(QByteArray data, Utils::FilePath mapped_output = {});
+        bool parseShared();
+        QByteArray sharedKey() const;
+        void processFinished(int code, QByteArray std_out);
+
+        static void mapDevicePaths(XMakeInfoParser::Result &result,
+                                   const Utils::FilePath &source_dir);
+        static bool mergePartialResult(XMakeInfoParser::Result &result,
+                                       const TargetsList &previous_targets,
+                                       const std::vector<Utils::FilePath> &previous_files);
+        static ParserDataPtr extractParserResults(const Utils::FilePath &source_dir,
+                                                  XMakeInfoParser::Result &&parser_result,
+                                                  const ExtractOptions &options,
+                                                  QFutureInterface<ParserDataPtr> &future);
+        ExtractOptions extractOptions() const;
+
+        void startTimings(bool cached = false);
+        void startPhase();
+        void recordTimings();
+
+        quint64 startRun();
+        void watchParser(quint64 generation);
+        void update(QFuture<ParserDataPtr> data);
+        void populateTree(quint64 generation);
+
+        static ProjectParts buildProjectParts(const Utils::FilePath &source_dir,
+                                              const TargetsList &targets,
+                                              const QtSupport::CppKitInfo &kit_info,
+                                              const TargetPartsMap &previous_parts,
+                                              QFutureInterface<ParserDataPtr> &future);
+        static ProjectExplorer::RawProjectPart buildProjectPart(const Target &target,
+                                                                const Target::SourceGroup &sources,
+                                                                const CompilerArgs &flags,
+                                                                const QtSupport::CppKitInfo &kit_info,
+                                                                XMakeMimeTypeCache &mime_types,
+                                                                int id);
 
         std::unique_ptr<XMakeProcess> m_process;
-        bool m_configuring;
+        std::shared_ptr<XMakeIntrospectionStream> m_stream;
+        bool m_configuring = false;
+        bool m_background  = false;
+        // the running introspection was restricted to the targets of a few project files
+        bool m_filtered = false;
+
+        QStringList m_config_args;
+        KitInfoPtr m_kit_info;
 
-        QFuture<ParserData *> m_parser_future_result;
+        QFuture<ParserDataPtr> m_parser_future_result;
+        QFuture<std::unique_ptr<XMakeProjectNode>> m_tree_future;
+        QFuture<ParserDataPtr> m_parts_future;
+        QSet<QString> m_file_queries;
+        quint64 m_generation = 0;
 
         XMakeOutputParser m_output_parser;
 
@@ -108,13 +254,20 @@ namespace XMakeProjectManager::Internal {
         Utils::FilePath m_src_dir;
 
         XMakeInfoParser::Result m_parser_result;
+        XMakeSharedIntrospection::ResultPtr m_shared_result;
         QStringList m_targets_names;
+        XMakeFileIndex m_file_index;
+        bool m_stale = false;
+        ProjectParts m_project_parts;
 
         std::unique_ptr<XMakeProjectNode> m_root_node;
 
         QString m_project_name;
 
-        QQueue<std::tuple<Command, Utils::FilePath, bool>> m_pending_commands;
+        ParseTimings m_timings;
+        QElapsedTimer m_phase_timer;
+        // the phase the running process measures for the next progress estimates
+        Utils::optional<XMakePhaseHistory::Phase> m_history_phase;
     };
 } // namespace XMakeProjectManager::Internal
 
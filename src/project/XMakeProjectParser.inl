@@ -11,6 +11,19 @@ namespace XMakeProjectManager::Internal {
         m_xmake = xmake;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProjectParser::setConfigArgs(QStringList args) -> void {
+        m_config_args = std::move(args);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProjectParser::setKitInfo(const QtSupport::CppKitInfo &kit_info) -> void {
+        // read by the worker building the project parts, a copy keeps it alive until then
+        m_kit_info = std::make_shared<const QtSupport::CppKitInfo>(kit_info);
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     inline auto XMakeProjectParser::takeProjectNode() noexcept
@@ -30,18 +43,66 @@ namespace XMakeProjectManager::Internal {
         return m_targets_names;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProjectParser::fileIndex() const noexcept -> const XMakeFileIndex & {
+        return m_file_index;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProjectParser::isStale() const noexcept -> bool { return m_stale; }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     inline auto XMakeProjectParser::qmlImportPaths() const noexcept -> const QStringList & {
         return m_parser_result.qml_import_paths;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProjectParser::setCodeModelTime(qint64 duration) noexcept -> void {
+        m_timings.code_model = duration;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProjectParser::setBackground(bool background) noexcept -> void {
+        m_background = background;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProjectParser::buildSystemFiles() const noexcept
+        -> const std::vector<Utils::FilePath> & {
+        return m_parser_result.build_system_files;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProjectParser::packages() const noexcept -> const PackagesList & {
+        return m_parser_result.packages;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     inline auto XMakeProjectParser::options() const noexcept -> const BuildOptionsList & {
         return m_parser_result.options;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProjectParser::projectParts() const noexcept
+        -> const ProjectExplorer::RawProjectParts & {
+        return m_project_parts.parts;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProjectParser::changedTargets() const noexcept -> const QStringList & {
+        return m_project_parts.changed_targets;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     inline auto XMakeProjectParser::setEnvironment(const Utils::Environment &env) -> void {
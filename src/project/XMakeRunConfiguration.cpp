@@ -90,8 +90,7 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     XMakeRunConfigurationFactory::XMakeRunConfigurationFactory() {
-        registerRunConfiguration<XMakeRunConfiguration>(
-            "XMakeProjectManager.XMakeRunConfiguration");
+        registerRunConfiguration<XMakeRunConfiguration>(Constants::XMAKE_RUN_CONFIG_ID);
 
         addSupportedProjectType(Constants::Project::ID);
         addSupportedTargetDeviceType(ProjectExplorer::Constants::DESKTOP_DEVICE_TYPE);
@@ -0,0 +1,297 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeSharedIntrospection.hpp"
+
+#include <project/XMakeIntrospectionCache.hpp>
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QLoggingCategory>
+#include <QMutex>
+#include <QMutexLocker>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace XMakeProjectManager::Internal {
+    static Q_LOGGING_CATEGORY(xmake_shared_introspection_log,
+                              "qtc.xmake.sharedintrospection",
+                              QtDebugMsg);
+
+    struct SharedIntrospectionEntry {
+        std::weak_ptr<const XMakeSharedIntrospection::Shared> result;
+        QHash<QString, QByteArray> file_hashes;
+    };
+    using SharedIntrospectionEntries = QHash<QByteArray, SharedIntrospectionEntry>;
+
+    using Replacements = std::vector<std::pair<QString, QString>>;
+
+    static constexpr auto OUTPUT_DIR_ARG = "--buildir";
+    // xmake builds in the build directory of the project without -o
+    static constexpr auto DEFAULT_OUTPUT_DIR = "build";
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto isOutputDirArg(const QString &arg) -> bool {
+        return arg == "-o" || arg == QLatin1String { OUTPUT_DIR_ARG };
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto withoutOutputDir(const QStringList &config_args) -> QStringList {
+        auto args = QStringList {};
+        for (auto it = std::cbegin(config_args); it != std::cend(config_args); ++it) {
+            if (isOutputDirArg(*it)) {
+                if (std::next(it) != std::cend(config_args)) ++it;
+                continue;
+            }
+            if (it->startsWith(QLatin1String { OUTPUT_DIR_ARG } + '=')) continue;
+
+            args.append(*it);
+        }
+
+        return args;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto replace(QString string, const Replacements &replacements) -> QString {
+        // the directories only match whole, <build>-old isn't under <build>
+        const auto is_boundary = [&string](qsizetype end) {
+            if (end == std::size(string)) return true;
+
+            const auto c = string[end];
+            return !c.isLetterOrNumber() && c != '_' && c != '-' && c != '.';
+        };
+
+        for (const auto &[from, to] : replacements) {
+            auto begin = string.indexOf(from);
+            while (begin != -1) {
+                if (!is_boundary(begin + std::size(from))) {
+                    begin = string.indexOf(from, begin + std::size(from));
+                    continue;
+                }
+
+                string.replace(begin, std::size(from), to);
+                begin = string.indexOf(from, begin + std::size(to));
+            }
+        }
+
+        return string;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto replace(QStringList &strings, const Replacements &replacements) -> void {
+        for (auto &string : strings) string = replace(std::move(string), replacements);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto replace(Target &target, const Replacements &replacements) -> void {
+        // autogen and module outputs, generated sources and run environments all point into
+        // the output directory
+        target.target_file        = replace(target.target_file, replacements);
+        target.object_dir         = replace(target.object_dir, replacements);
+        target.precompiled_header = replace(target.precompiled_header, replacements);
+        target.install_dir        = replace(target.install_dir, replacements);
+        replace(target.qml_import_paths, replacements);
+
+        for (auto &group : target.sources) {
+            replace(group.sources, replacements);
+            replace(group.arguments, replacements);
+            replace(group.lazy_files, replacements);
+
+            auto file_flags = QHash<QString, Target::FlagsDelta> {};
+            for (auto it = group.file_flags.cbegin(); it != group.file_flags.cend(); ++it) {
+                auto delta = it.value();
+                replace(delta.added, replacements);
+                replace(delta.arguments, replacements);
+
+                file_flags.insert(replace(it.key(), replacements), std::move(delta));
+            }
+            group.file_flags = std::move(file_flags);
+        }
+
+        replace(target.headers, replacements);
+        replace(target.modules, replacements);
+
+        for (auto &unit : target.module_units) {
+            unit.file = replace(unit.file, replacements);
+            unit.bmi  = replace(unit.bmi, replacements);
+        }
+
+        for (auto &generated : target.generated_files) {
+            generated.source = replace(generated.source, replacements);
+            replace(generated.outputs, replacements);
+        }
+
+        for (auto &[name, value] : target.set_env) value = replace(value, replacements);
+        for (auto &[name, values] : target.add_env) replace(values, replacements);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto fileHash(const QString &path) -> QByteArray {
+        auto file = QFile { path };
+        if (!file.open(QIODevice::ReadOnly)) return {};
+
+        auto hash = QCryptographicHash { QCryptographicHash::Sha1 };
+        hash.addData(&file);
+
+        return hash.result();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto mutex() -> QMutex & {
+        static auto mutex = QMutex {};
+
+        return mutex;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto entries() -> SharedIntrospectionEntries & {
+        static auto entries = SharedIntrospectionEntries {};
+
+        return entries;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeSharedIntrospection::key(const Utils::FilePath &xmake,
+                                       const QStringList &config_args,
+                                       const Utils::FilePath &src_dir,
+                                       const Utils::FilePath &build_dir) -> QByteArray {
+        auto hash = QCryptographicHash { QCryptographicHash::Sha1 };
+
+        // the outputs are moved to the directories of the configuration reusing the result
+        const auto cache = XMakeIntrospectionCache { build_dir };
+        hash.addData(XMakeIntrospectionCache::key(xmake, withoutOutputDir(config_args)));
+        hash.addData(src_dir.toString().toUtf8());
+        hash.addData(cache.configHash());
+
+        return hash.result();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeSharedIntrospection::outputDir(const QStringList &config_args,
+                                             const Utils::FilePath &src_dir) -> Utils::FilePath {
+        auto output_dir = QString { DEFAULT_OUTPUT_DIR };
+        for (auto it = std::cbegin(config_args); it != std::cend(config_args); ++it) {
+            const auto prefix = QLatin1String { OUTPUT_DIR_ARG } + '=';
+
+            if (isOutputDirArg(*it) && std::next(it) != std::cend(config_args))
+                output_dir = *std::next(it);
+            else if (it->startsWith(prefix))
+                output_dir = it->mid(std::size(prefix));
+        }
+
+        return src_dir.resolvePath(QDir::fromNativeSeparators(output_dir)).cleanPath();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeSharedIntrospection::find(const QByteArray &key) -> ResultPtr {
+        auto file_hashes = QHash<QString, QByteArray> {};
+        auto result      = ResultPtr {};
+
+        {
+            const auto lock = QMutexLocker { &mutex() };
+
+            const auto it = entries().find(key);
+            if (it == std::end(entries())) return nullptr;
+
+            result = it->result.lock();
+            if (!result) {
+                entries().erase(it);
+                return nullptr;
+            }
+
+            file_hashes = it->file_hashes;
+        }
+
+        for (auto it = file_hashes.cbegin(); it != file_hashes.cend(); ++it) {
+            if (fileHash(it.key()) != it.value()) {
+                qCDebug(xmake_shared_introspection_log)
+                    << it.key() << "changed since the shared introspection";
+                return nullptr;
+            }
+        }
+
+        return result;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeSharedIntrospection::publish(const QByteArray &key,
+                                           const XMakeInfoParser::Result &result,
+                                           const Utils::FilePath &build_dir,
+                                           const Utils::FilePath &output_dir) -> ResultPtr {
+        const auto shared =
+            std::make_shared<const Shared>(Shared { XMakeInfoParser::copy(result),
+                                                    build_dir,
+                                                    output_dir });
+
+        auto entry   = SharedIntrospectionEntry {};
+        entry.result = shared;
+
+        for (const auto &file : result.build_system_files)
+            entry.file_hashes.insert(file.toString(), fileHash(file.toString()));
+
+        const auto lock = QMutexLocker { &mutex() };
+
+        entries().removeIf(
+            [](const SharedIntrospectionEntries::iterator &it) { return it->result.expired(); });
+        entries().insert(key, std::move(entry));
+
+        return shared;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeSharedIntrospection::rebase(const Shared &shared,
+                                          const Utils::FilePath &build_dir,
+                                          const Utils::FilePath &output_dir)
+        -> XMakeInfoParser::Result {
+        auto result = XMakeInfoParser::copy(shared.result);
+
+        auto replacements = Replacements {};
+        for (const auto &[from, to] :
+             { std::pair { shared.output_dir, output_dir },
+               std::pair { shared.build_dir, build_dir } }) {
+            if (from.isEmpty() || to.isEmpty() || from == to) continue;
+
+            replacements.emplace_back(from.path(), to.path());
+            if (from.nativePath() != from.path())
+                replacements.emplace_back(from.nativePath(), to.nativePath());
+        }
+        if (replacements.empty()) return result;
+
+        // the output directory is usually inside the build directory or the other way around
+        std::stable_sort(std::begin(replacements),
+                         std::end(replacements),
+                         [](const auto &lhs, const auto &rhs) {
+                             return std::size(lhs.first) > std::size(rhs.first);
+                         });
+
+        qCDebug(xmake_shared_introspection_log)
+            << "Moving the outputs of" << shared.output_dir << "to" << output_dir;
+
+        for (auto &target : result.targets) replace(target, replacements);
+        replace(result.qml_import_paths, replacements);
+
+        // the moved paths are interned again, the table gives them their device
+        result.paths.intern(result.targets);
+
+        return result;
+    }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,54 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <xmakeinfoparser/XMakeInfoParser.hpp>
+
+#include <utils/filepath.h>
+
+#include <QByteArray>
+#include <QStringList>
+
+#include <memory>
+
+namespace XMakeProjectManager::Internal {
+    // introspection results shared by the build configurations configured the same way, an
+    // entry lives as long as one of the parsers which use it
+    class XMakeSharedIntrospection {
+      public:
+        // the outputs of a result are under the directories of the configuration it came from
+        struct Shared {
+            XMakeInfoParser::Result result;
+            Utils::FilePath build_dir;
+            Utils::FilePath output_dir;
+        };
+        using ResultPtr = std::shared_ptr<const Shared>;
+
+        XMakeSharedIntrospection() = delete;
+
+        // the build and output directories are left out of the key, a configuration only
+        // differing by them reuses the result through rebase
+        static QByteArray key(const Utils::FilePath &xmake,
+                              const QStringList &config_args,
+                              const Utils::FilePath &src_dir,
+                              const Utils::FilePath &build_dir);
+
+        // where xmake builds the targets, the -o of the configuration or its default
+        static Utils::FilePath outputDir(const QStringList &config_args,
+                                         const Utils::FilePath &src_dir);
+
+        // nullptr when no parser holds a result for the key or a project file changed since
+        static ResultPtr find(const QByteArray &key);
+        static ResultPtr publish(const QByteArray &key,
+                                 const XMakeInfoParser::Result &result,
+                                 const Utils::FilePath &build_dir,
+                                 const Utils::FilePath &output_dir);
+
+        // a copy of the shared result with its outputs moved to these directories
+        static XMakeInfoParser::Result rebase(const Shared &shared,
+                                              const Utils::FilePath &build_dir,
+                                              const Utils::FilePath &output_dir);
+    };
+} // namespace XMakeProjectManager::Internal
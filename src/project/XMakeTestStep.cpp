@@ -0,0 +1,228 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeTestStep.hpp"
+
+#include <XMakeProjectConstant.hpp>
+#include <project/XMakeBuildSystem.hpp>
+#include <project/parsers/XMakeTestParser.hpp>
+
+#include <coreplugin/find/itemviewfind.h>
+
+#include <settings/tools/kitaspect/XMakeToolKitAspect.hpp>
+
+#include <projectexplorer/processparameters.h>
+#include <projectexplorer/project.h>
+#include <projectexplorer/target.h>
+
+#include <utils/commandline.h>
+
+#include <QFormLayout>
+#include <QListWidget>
+#include <QSignalBlocker>
+#include <QSpinBox>
+
+#include <algorithm>
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeTestStep::XMakeTestStep(ProjectExplorer::BuildStepList *bsl, Utils::Id id)
+        : ProjectExplorer::AbstractProcessStep { bsl, id } {
+        setLowPriority();
+
+        setCommandLineProvider([this] { return command(); });
+        setEnvironmentModifier([this](Utils::Environment &env) {
+            env.setupEnglishOutput();
+            env.appendOrSet("XMAKE_CONFIGDIR", buildDirectory().nativePath());
+            env.appendOrSet("XMAKE_THEME", "plain");
+        });
+        setWorkingDirectoryProvider([this] { return project()->rootProjectDirectory(); });
+
+        connect(target(), &ProjectExplorer::Target::parsingFinished, this, &XMakeTestStep::update);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTestStep::createConfigWidget() -> QWidget * {
+        auto widget = new QWidget {};
+        setDisplayName(tr("Test"));
+
+        auto tests_list = new QListWidget { widget };
+        tests_list->setMinimumHeight(200);
+        tests_list->setFrameShape(QFrame::StyledPanel);
+        tests_list->setFrameShadow(QFrame::Raised);
+        tests_list->setToolTip(tr("Run every test when none is checked."));
+
+        auto jobs = new QSpinBox { widget };
+        jobs->setRange(0, 1024);
+        jobs->setSpecialValueText(tr("Default"));
+        jobs->setValue(m_jobs);
+
+        auto wrapper =
+            Core::ItemViewFind::createSearchableWrapper(tests_list,
+                                                        Core::ItemViewFind::LightColored);
+
+        auto form_layout = new QFormLayout { widget };
+        form_layout->setFieldGrowthPolicy(QFormLayout::ExpandingFieldsGrow);
+        form_layout->setContentsMargins(0, 0, 0, 0);
+        form_layout->addRow(tr("Parallel jobs:"), jobs);
+        form_layout->addRow(tr("Tests:"), wrapper);
+
+        auto update_details = [this] {
+            auto param = ProjectExplorer::ProcessParameters {};
+            setupProcessParameters(&param);
+            setSummaryText(param.summary(displayName()));
+        };
+
+        auto update_test_list = [this, tests_list] {
+            const auto blocker = QSignalBlocker { tests_list };
+
+            tests_list->clear();
+
+            for (const auto &test : projectTests()) {
+                auto item = new QListWidgetItem { test, tests_list };
+
+                item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+                item->setCheckState(m_tests.contains(test) ? Qt::Checked : Qt::Unchecked);
+            }
+        };
+
+        update_details();
+        update_test_list();
+
+        connect(this, &XMakeTestStep::testListChanged, widget, update_test_list);
+        connect(this, &XMakeTestStep::testListChanged, widget, update_details);
+
+        connect(jobs,
+                QOverload<int>::of(&QSpinBox::valueChanged),
+                this,
+                [this, update_details](auto value) {
+                    setJobs(value);
+                    update_details();
+                });
+
+        connect(tests_list,
+                &QListWidget::itemChanged,
+                this,
+                [this, update_details](auto *item) {
+                    auto tests = m_tests;
+                    if (item->checkState() == Qt::Checked) tests.append(item->text());
+                    else
+                        tests.removeAll(item->text());
+
+                    setTests(tests);
+                    update_details();
+                });
+
+        return widget;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTestStep::command() const -> Utils::CommandLine {
+        auto tool = XMakeToolKitAspect::xmakeTool(kit());
+        if (!tool) return {};
+
+        auto cmd = Utils::CommandLine { tool->exe(), { "test" } };
+
+        // xmake runs the tests on as many jobs as the build by default
+        if (m_jobs > 0) cmd.addArgs({ "-j", QString::number(m_jobs) });
+
+        cmd.addArgs(m_tests);
+
+        return cmd;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTestStep::projectTests() const -> QStringList {
+        auto tests = QStringList {};
+
+        const auto *build_system = qobject_cast<XMakeBuildSystem *>(buildSystem());
+        if (!build_system) return tests;
+
+        for (const auto &test : build_system->testcasesInfo()) tests.append(test.name);
+
+        return tests;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTestStep::toMap() const -> QVariantMap {
+        auto map = AbstractProcessStep::toMap();
+
+        map[QString::fromLatin1(Constants::TestStep::TESTS_KEY)] = m_tests;
+        map[QString::fromLatin1(Constants::TestStep::JOBS_KEY)]  = m_jobs;
+
+        return map;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTestStep::fromMap(const QVariantMap &map) -> bool {
+        setTests(map.value(QString::fromLatin1(Constants::TestStep::TESTS_KEY)).toStringList());
+        setJobs(map.value(QString::fromLatin1(Constants::TestStep::JOBS_KEY), 0).toInt());
+
+        return AbstractProcessStep::fromMap(map);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTestStep::update(bool parsing_successful) -> void {
+        if (!parsing_successful) return;
+
+        // drop the tests removed from the project
+        const auto tests = projectTests();
+        m_tests.erase(std::remove_if(std::begin(m_tests),
+                                     std::end(m_tests),
+                                     [&tests](const auto &test) { return !tests.contains(test); }),
+                      std::end(m_tests));
+
+        Q_EMIT testListChanged();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTestStep::testFiles() const -> QHash<QString, Utils::FilePath> {
+        const auto *build_system = qobject_cast<XMakeBuildSystem *>(buildSystem());
+        if (!build_system) return {};
+
+        auto files = QHash<QString, Utils::FilePath> {};
+        for (const auto &test : build_system->testcasesInfo()) files.insert(test.name, test.path);
+
+        return files;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTestStep::setupOutputFormatter(Utils::OutputFormatter *formatter) -> void {
+        auto *parser = new XMakeTestParser {};
+        parser->setTestFiles(testFiles());
+
+        formatter->addLineParser(parser);
+        formatter->addSearchDir(processParameters()->effectiveWorkingDirectory());
+
+        AbstractProcessStep::setupOutputFormatter(formatter);
+
+        connect(parser, &XMakeTestParser::reportProgress, this, [this](auto percent) {
+            Q_EMIT progress(percent, QString {});
+        });
+        connect(parser, &XMakeTestParser::reportDurations, this, [this](const auto &report) {
+            Q_EMIT addOutput(report, OutputFormat::NormalMessage);
+        });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeTestStepFactory::XMakeTestStepFactory() {
+        registerStep<XMakeTestStep>(Constants::XMAKE_TEST_STEP_ID);
+        setSupportedProjectType(Constants::Project::ID);
+        setDisplayName(XMakeTestStep::tr("XMake test"));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeTestStepFactory::~XMakeTestStepFactory() = default;
+} // namespace XMakeProjectManager::Internal
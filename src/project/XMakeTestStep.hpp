@@ -0,0 +1,59 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <projectexplorer/abstractprocessstep.h>
+#include <projectexplorer/buildstep.h>
+
+namespace XMakeProjectManager::Internal {
+    class XMakeTestStep final: public ProjectExplorer::AbstractProcessStep {
+        Q_OBJECT
+      public:
+        XMakeTestStep(ProjectExplorer::BuildStepList *bsl, Utils::Id id);
+
+        QWidget *createConfigWidget() override;
+
+        Utils::CommandLine command() const;
+
+        // the tests of the project, named <target>/<test>
+        QStringList projectTests() const;
+
+        // empty runs every test
+        const QStringList &tests() const noexcept;
+        void setTests(const QStringList &tests);
+
+        // 0 lets xmake pick the job count
+        int jobs() const noexcept;
+        void setJobs(int jobs) noexcept;
+
+        QVariantMap toMap() const override;
+        bool fromMap(const QVariantMap &map) override;
+
+      Q_SIGNALS:
+        void testListChanged();
+
+      private:
+        void update(bool parsing_successful);
+        void setupOutputFormatter(Utils::OutputFormatter *formatter) override;
+        QHash<QString, Utils::FilePath> testFiles() const;
+
+        QStringList m_tests;
+        int m_jobs = 0;
+    };
+
+    class XMakeTestStepFactory final: public ProjectExplorer::BuildStepFactory {
+      public:
+        XMakeTestStepFactory();
+        ~XMakeTestStepFactory();
+
+        XMakeTestStepFactory(XMakeTestStepFactory &&)      = delete;
+        XMakeTestStepFactory(const XMakeTestStepFactory &) = delete;
+
+        XMakeTestStepFactory &operator=(XMakeTestStepFactory &&)      = delete;
+        XMakeTestStepFactory &operator=(const XMakeTestStepFactory &) = delete;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakeTestStep.inl"
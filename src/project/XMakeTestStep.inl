@@ -0,0 +1,28 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeTestStep::tests() const noexcept -> const QStringList & { return m_tests; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeTestStep::setTests(const QStringList &tests) -> void {
+        m_tests = tests;
+        m_tests.removeDuplicates();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeTestStep::jobs() const noexcept -> int { return m_jobs; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeTestStep::setJobs(int jobs) noexcept -> void {
+        m_jobs = (jobs > 0) ? jobs : 0;
+    }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,121 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeTraceExport.hpp"
+
+#include <project/XMakeParseTimings.hpp>
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+namespace XMakeProjectManager::Internal {
+    // trace events count microseconds
+    static constexpr auto USECS = qint64 { 1000 };
+
+    enum ParseThread { ProcessThread, LuaThread, PluginThread };
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTraceExport::parseSpans(const ParseTimings &timings) -> SpansList {
+        auto spans = SpansList {};
+        if (!timings.started_at.isValid()) return spans;
+
+        auto time        = timings.started_at.toMSecsSinceEpoch();
+        const auto phase = [&spans, &time](const QString &name,
+                                           const QString &category,
+                                           qint64 duration,
+                                           int thread) {
+            if (duration < 0) return;
+
+            spans.push_back({ name, category, time, duration, thread, {} });
+            time += duration;
+        };
+
+        // spawning is part of the first process run
+        if (timings.spawn >= 0)
+            spans.push_back({ "spawn", "xmake", time, timings.spawn, ProcessThread, {} });
+
+        phase("xmake configure", "xmake", timings.configure, ProcessThread);
+
+        // the script only measured the slowest targets, they are listed from its start
+        auto lua_time = time;
+        for (const auto &target : timings.slowest_targets) {
+            const auto duration = static_cast<qint64>(target.total);
+            spans.push_back({ target.name,
+                              "lua",
+                              lua_time,
+                              duration,
+                              LuaThread,
+                              { { "source batches (ms)", target.source_batches },
+                                { "compile flags (ms)", target.compile_flags },
+                                { "run envs (ms)", target.run_envs } } });
+            lua_time += duration;
+        }
+
+        phase("xmake introspection", "xmake", timings.introspection, ProcessThread);
+        phase("decode document", "decode", timings.document, PluginThread);
+        phase("decode targets", "decode", timings.targets, PluginThread);
+        phase("ProjectTree::buildTree", "tree", timings.tree, PluginThread);
+        phase("buildProjectParts", "code model", timings.project_parts, PluginThread);
+        phase("code model update", "code model", timings.code_model, PluginThread);
+
+        if (!spans.empty())
+            spans.insert(std::begin(spans),
+                         Span { timings.project,
+                                "parse",
+                                timings.started_at.toMSecsSinceEpoch(),
+                                time - timings.started_at.toMSecsSinceEpoch(),
+                                PluginThread,
+                                { { "cached", timings.cached },
+                                  { "payload (bytes)", timings.payload_size },
+                                  { "targets", timings.target_count },
+                                  { "files", timings.file_count } } });
+
+        return spans;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTraceExport::parseThreadNames() -> QStringList {
+        return { "xmake", "lua (slowest targets)", "Qt Creator" };
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTraceExport::write(const Utils::FilePath &path,
+                                 const QString &process_name,
+                                 const QStringList &thread_names,
+                                 const SpansList &spans) -> bool {
+        auto events = QJsonArray {};
+
+        events.append(QJsonObject { { "name", "process_name" },
+                                    { "ph", "M" },
+                                    { "pid", 1 },
+                                    { "args", QJsonObject { { "name", process_name } } } });
+        for (auto i = 0; i < thread_names.size(); ++i)
+            events.append(
+                QJsonObject { { "name", "thread_name" },
+                              { "ph", "M" },
+                              { "pid", 1 },
+                              { "tid", i },
+                              { "args", QJsonObject { { "name", thread_names[i] } } } });
+
+        for (const auto &span : spans)
+            events.append(QJsonObject { { "name", span.name },
+                                        { "cat", span.category },
+                                        { "ph", "X" },
+                                        { "ts", span.start * USECS },
+                                        { "dur", span.duration * USECS },
+                                        { "pid", 1 },
+                                        { "tid", span.thread },
+                                        { "args", QJsonObject::fromVariantMap(span.args) } });
+
+        const auto document = QJsonDocument {
+            QJsonObject { { "traceEvents", events }, { "displayTimeUnit", "ms" } }
+        };
+
+        return path.writeFileContents(document.toJson(QJsonDocument::Compact));
+    }
+} // namespace XMakeProjectManager::Internal
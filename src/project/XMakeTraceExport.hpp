@@ -0,0 +1,43 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <utils/filepath.h>
+
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+
+#include <vector>
+
+namespace XMakeProjectManager::Internal {
+    struct ParseTimings;
+
+    // writes the phases of a parse or a build as a Chrome trace event document, opened by
+    // Perfetto or chrome://tracing
+    class XMakeTraceExport {
+      public:
+        // start in milliseconds since the epoch, thread is an index in the thread names
+        struct Span {
+            QString name;
+            QString category;
+            qint64 start;
+            qint64 duration;
+            int thread = 0;
+            QVariantMap args;
+        };
+
+        using SpansList = std::vector<Span>;
+
+        // the phases of a parse follow each other from its start
+        static SpansList parseSpans(const ParseTimings &timings);
+        static QStringList parseThreadNames();
+
+        static bool write(const Utils::FilePath &path,
+                          const QString &process_name,
+                          const QStringList &thread_names,
+                          const SpansList &spans);
+    };
+} // namespace XMakeProjectManager::Internal
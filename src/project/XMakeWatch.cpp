@@ -0,0 +1,205 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeWatch.hpp"
+
+#include <project/XMakeBuildSystem.hpp>
+#include <project/parsers/XMakeBuildParser.hpp>
+
+#include <settings/tools/kitaspect/XMakeToolKitAspect.hpp>
+
+#include <coreplugin/progressmanager/progressmanager.h>
+
+#include <projectexplorer/buildconfiguration.h>
+#include <projectexplorer/kit.h>
+#include <projectexplorer/project.h>
+#include <projectexplorer/projectexplorerconstants.h>
+#include <projectexplorer/taskhub.h>
+
+#include <utils/outputformatter.h>
+#include <utils/qtcprocess.h>
+
+#include <QLoggingCategory>
+
+#include <utility>
+
+namespace XMakeProjectManager::Internal {
+    static Q_LOGGING_CATEGORY(xmake_watch_log, "qtc.xmake.watch", QtDebugMsg);
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeWatch::XMakeWatch(XMakeBuildSystem *build_system) : m_build_system { build_system } {
+        connect(ProjectExplorer::TaskHub::instance(),
+                &ProjectExplorer::TaskHub::taskAdded,
+                this,
+                [this](const ProjectExplorer::Task &task) {
+                    if (m_building &&
+                        task.category == ProjectExplorer::Constants::TASK_CATEGORY_COMPILE)
+                        m_tasks.append(task);
+                });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeWatch::~XMakeWatch() { stop(); }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeWatch::start(const QStringList &target_names) -> void {
+        if (isWatching(target_names)) return;
+
+        stop();
+
+        const auto *build_configuration = m_build_system->buildConfiguration();
+        const auto *kit                 = build_configuration->kit();
+
+        const auto tool = XMakeToolKitAspect::xmakeTool(kit);
+        if (!tool) return;
+
+        // xmake watch rebuilds a single target or the default ones
+        auto args = QStringList { "watch" };
+        if (target_names.size() == 1) args.append("--target=" + target_names.front());
+
+        const auto command = Utils::CommandLine { tool->exe(), args };
+
+        auto env = build_configuration->environment();
+        env.setupEnglishOutput();
+        env.appendOrSet("XMAKE_CONFIGDIR", build_configuration->buildDirectory().nativePath());
+        env.appendOrSet("XMAKE_THEME", "plain");
+
+        qCDebug(xmake_watch_log) << "Running" << command.toUserOutput();
+
+        m_target_names = target_names;
+        m_last_build   = true;
+
+        m_process = std::make_unique<Utils::QtcProcess>();
+        m_process->setLowPriority();
+        m_process->setWorkingDirectory(m_build_system->project()->rootProjectDirectory());
+        m_process->setEnvironment(env);
+        m_process->setCommand(command);
+        m_process->setStdOutLineCallback(
+            [this](const QString &line) { handleLine(line, false); });
+        m_process->setStdErrLineCallback([this](const QString &line) { handleLine(line, true); });
+
+        connect(m_process.get(), &Utils::QtcProcess::done, this, &XMakeWatch::handleProcessDone);
+
+        m_process->start();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeWatch::stop() -> void {
+        if (!m_process) return;
+
+        qCDebug(xmake_watch_log) << "Stopping xmake watch" << m_target_names;
+
+        m_process->disconnect();
+        m_process->close();
+        m_process.reset();
+
+        if (m_building) finishBuild(false);
+        m_target_names.clear();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeWatch::restoreTasks() const -> void {
+        for (const auto &task : m_tasks) ProjectExplorer::TaskHub::addTask(task);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeWatch::handleLine(const QString &line, bool std_err) -> void {
+        // xmake watch is silent until a change starts a rebuild
+        if (!m_building) startBuild();
+
+        m_formatter->appendMessage(line, std_err ? Utils::StdErrFormat : Utils::StdOutFormat);
+
+        // the rebuild ends with the status of xmake build, the errors of the compilers start
+        // with their file
+        const auto trimmed = line.trimmed();
+        if (trimmed.contains(QLatin1String { "build ok" })) finishBuild(true);
+        else if (trimmed.startsWith(QLatin1String { "error:" }))
+            finishBuild(false);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeWatch::startBuild() -> void {
+        for (const auto &task : std::exchange(m_tasks, {}))
+            ProjectExplorer::TaskHub::removeTask(task);
+
+        auto *kit              = m_build_system->buildConfiguration()->kit();
+        const auto project_dir = m_build_system->project()->projectDirectory();
+
+        auto *xmake_parser = new XMakeBuildParser { XMakeBuildParser::typeForKit(kit) };
+        xmake_parser->setSourceDirectory(project_dir);
+
+        auto parsers = QList<Utils::OutputLineParser *> { xmake_parser };
+        for (auto *parser : kit->createOutputParsers()) {
+            parser->setRedirectionDetector(xmake_parser);
+            parsers.append(parser);
+        }
+
+        for (auto *parser : parsers)
+            if (auto *task_parser = qobject_cast<ProjectExplorer::OutputTaskParser *>(parser))
+                connect(task_parser,
+                        &ProjectExplorer::OutputTaskParser::newTask,
+                        this,
+                        [](const ProjectExplorer::Task &task) {
+                            ProjectExplorer::TaskHub::addTask(task);
+                        });
+
+        m_formatter = std::make_unique<Utils::OutputFormatter>();
+        m_formatter->setLineParsers(parsers);
+        m_formatter->addSearchDir(project_dir);
+
+        m_future_interface = QFutureInterface<void>();
+        m_future_interface.setProgressRange(0, 100);
+        m_future_interface.reportStarted();
+
+        connect(xmake_parser,
+                &XMakeBuildParser::reportProgress,
+                this,
+                [this](auto percent, const auto &text) {
+                    m_future_interface.setProgressValueAndText(percent, text);
+                });
+
+        const auto title =
+            tr("xmake watch: %1").arg(m_build_system->buildConfiguration()->displayName());
+        Core::ProgressManager::addTask(m_future_interface.future(), title, "XMake.Watch");
+
+        m_building = true;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeWatch::finishBuild(bool success) -> void {
+        // the batched tasks are submitted while they are still collected
+        m_formatter->flush();
+        m_formatter.reset();
+
+        m_building   = false;
+        m_last_build = success;
+
+        // a failed rebuild shows as a canceled task in the progress bar
+        if (!success) m_future_interface.reportCanceled();
+        m_future_interface.reportFinished();
+
+        qCDebug(xmake_watch_log) << "Rebuild of" << m_target_names << "finished with" << success;
+
+        Q_EMIT buildFinished(success);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeWatch::handleProcessDone() -> void {
+        qCDebug(xmake_watch_log) << "xmake watch exited with" << m_process->exitCode();
+
+        m_process.release()->deleteLater();
+        m_target_names.clear();
+
+        if (m_building) finishBuild(false);
+    }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,73 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <projectexplorer/task.h>
+
+#include <QFutureInterface>
+#include <QObject>
+#include <QStringList>
+
+#include <memory>
+
+namespace Utils {
+    class OutputFormatter;
+    class QtcProcess;
+} // namespace Utils
+
+namespace XMakeProjectManager::Internal {
+    class XMakeBuildSystem;
+
+    // keeps an xmake watch process running for the build configuration, every rebuild it starts
+    // on a change goes through the build parsers and replaces the diagnostics of the previous one
+    class XMakeWatch final: public QObject {
+        Q_OBJECT
+
+      public:
+        explicit XMakeWatch(XMakeBuildSystem *build_system);
+        ~XMakeWatch() override;
+
+        XMakeWatch(XMakeWatch &&)      = delete;
+        XMakeWatch(const XMakeWatch &) = delete;
+
+        XMakeWatch &operator=(XMakeWatch &&)      = delete;
+        XMakeWatch &operator=(const XMakeWatch &) = delete;
+
+        // a process watching other targets is replaced, empty watches the default targets
+        void start(const QStringList &target_names);
+        void stop();
+
+        [[nodiscard]] bool isWatching(const QStringList &target_names) const noexcept;
+        [[nodiscard]] bool isBuilding() const noexcept;
+        [[nodiscard]] bool lastBuildSucceeded() const noexcept;
+
+        // the build queue cleared the compile tasks when it started
+        void restoreTasks() const;
+
+      Q_SIGNALS:
+        void buildFinished(bool success);
+
+      private:
+        void handleLine(const QString &line, bool std_err);
+        void startBuild();
+        void finishBuild(bool success);
+        void handleProcessDone();
+
+        XMakeBuildSystem *m_build_system;
+
+        std::unique_ptr<Utils::QtcProcess> m_process;
+        std::unique_ptr<Utils::OutputFormatter> m_formatter;
+        QFutureInterface<void> m_future_interface;
+
+        QStringList m_target_names;
+        bool m_building   = false;
+        bool m_last_build = false;
+
+        // tasks of the last rebuild, removed when the next one starts
+        ProjectExplorer::Tasks m_tasks;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakeWatch.inl"
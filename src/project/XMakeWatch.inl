@@ -0,0 +1,21 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeWatch::isWatching(const QStringList &target_names) const noexcept -> bool {
+        return m_process != nullptr && m_target_names == target_names;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeWatch::isBuilding() const noexcept -> bool { return m_building; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeWatch::lastBuildSucceeded() const noexcept -> bool { return m_last_build; }
+} // namespace XMakeProjectManager::Internal
@@ -11,6 +11,9 @@
 
 #include <utils/treemodel.h>
 
+#include <QHash>
+#include <QSet>
+
 #include <QtWidgets/QCheckBox>
 #include <QtWidgets/QComboBox>
 #include <QtWidgets/QLineEdit>
@@ -29,31 +32,41 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto BuildOptionsModel::setConfiguration(const BuildOptionsList &options) -> void {
-        clear();
-
-        m_options.clear();
+        // the options are updated in place, resetting the model would drop the edits, the
+        // selection and the scroll position of the view
+        auto items = QHash<QString, BuildOptionTreeItem *> {};
+        items.reserve(rootItem()->childCount());
+        for (auto i = 0; i < rootItem()->childCount(); ++i) {
+            auto *item = static_cast<BuildOptionTreeItem *>(rootItem()->childAt(i));
+            items.insert(item->option().name(), item);
+        }
 
-        m_options.reserve(std::size(options));
-        std::transform(std::begin(options),
-                       std::end(options),
-                       std::back_inserter(m_options),
-                       [](const auto &option) {
-                           auto it =
-                               std::find_if(std::begin(LOCKED_OPTIONS),
-                                            std::end(LOCKED_OPTIONS),
-                                            [name = option->name.toStdString()](
-                                                const auto &opt_name) { return opt_name == name; });
+        for (const auto &option : options) {
+            if (auto *item = items.take(option->name); item) {
+                if (item->option().update(*option)) item->update();
+                continue;
+            }
 
-                           return std::make_unique<CancellableOption>(*option,
-                                                                      it !=
-                                                                          std::end(LOCKED_OPTIONS));
-                       });
+            const auto &cancellable = m_options.emplace_back(
+                std::make_unique<CancellableOption>(*option, isLocked(option->name)));
+            rootItem()->appendChild(new BuildOptionTreeItem { *cancellable });
+        }
 
-        auto root = new Utils::TreeItem {};
+        if (items.isEmpty()) return;
 
-        for (const auto &option : m_options) root->appendChild(new BuildOptionTreeItem { *option });
+        // options no longer declared by the project
+        auto removed = QSet<const CancellableOption *> {};
+        for (auto *item : std::as_const(items)) {
+            removed.insert(&item->option());
+            destroyItem(item);
+        }
 
-        setRootItem(root);
+        m_options.erase(std::remove_if(std::begin(m_options),
+                                       std::end(m_options),
+                                       [&removed](const auto &option) {
+                                           return removed.contains(option.get());
+                                       }),
+                        std::end(m_options));
     }
 
     ////////////////////////////////////////////////////
@@ -72,8 +85,9 @@ namespace XMakeProjectManager::Internal {
     auto BuildOptionsModel::changesAsXMakeArgs() const noexcept -> QStringList {
         auto args = QStringList {};
 
+        // xmake f keeps the value of the options not passed, unless the config is wiped
         for (const auto &option : m_options)
-            args.emplace_back(option->xmakeArg()); // XMake doesn't support incremental config
+            if (option->changed()) args.emplace_back(option->xmakeArg());
 
         return args;
     }
@@ -87,6 +101,46 @@ namespace XMakeProjectManager::Internal {
         return false;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto BuildOptionsModel::isLocked(const QString &name) noexcept -> bool {
+        const auto std_name = name.toStdString();
+
+        return std::find(std::begin(LOCKED_OPTIONS), std::end(LOCKED_OPTIONS), std_name) !=
+               std::end(LOCKED_OPTIONS);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    BuildOptionsFilterModel::BuildOptionsFilterModel(QObject *parent)
+        : Utils::CategorySortFilterModel { parent } {}
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto BuildOptionsFilterModel::setFilterText(const QString &text) -> void {
+        if (text == m_filter_text) return;
+
+        m_filter_text = text;
+        invalidateFilter();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto BuildOptionsFilterModel::filterAcceptsRow(int source_row,
+                                                   const QModelIndex &source_parent) const
+        -> bool {
+        if (m_filter_text.isEmpty()) return true;
+
+        const auto *model = sourceModel();
+        for (auto column = 0; column < model->columnCount(source_parent); ++column) {
+            const auto index = model->index(source_row, column, source_parent);
+            if (index.data(Qt::DisplayRole).toString().contains(m_filter_text, Qt::CaseInsensitive))
+                return true;
+        }
+
+        return false;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     BuildOptionDelegate::BuildOptionDelegate(QObject *parent) : QStyledItemDelegate { parent } {
@@ -6,6 +6,8 @@
 
 #include "../../xmakeinfoparser/XMakeBuildOptionsParser.hpp"
 
+#include <utils/categorysortfiltermodel.h>
+#include <utils/optional.h>
 #include <utils/qtcassert.h>
 #include <utils/treemodel.h>
 
@@ -26,6 +28,9 @@ namespace XMakeProjectManager::Internal {
         void apply();
         void cancel();
 
+        // takes the value of a new introspection, an edit not applied yet is kept
+        bool update(const BuildOption &option);
+
         const QString &name() const noexcept;
         const QString &description() const noexcept;
         const QString &savedValue() const noexcept;
@@ -37,7 +42,7 @@ namespace XMakeProjectManager::Internal {
         const QString &value() const noexcept;
 
       private:
-        bool m_changed;
+        bool m_changed = false;
         bool m_locked;
 
         std::unique_ptr<BuildOption> m_saved_value;
@@ -61,6 +66,8 @@ namespace XMakeProjectManager::Internal {
       private:
         bool changed() const noexcept;
 
+        static bool isLocked(const QString &name) noexcept;
+
         CancellableOptionsList m_options;
     };
 
@@ -76,10 +83,27 @@ namespace XMakeProjectManager::Internal {
 
         const QString &toolTip() const noexcept;
 
+        CancellableOption &option() const noexcept;
+
       private:
         CancellableOption *m_option;
     };
 
+    // plain substring match, options are filtered on each keystroke
+    class BuildOptionsFilterModel final: public Utils::CategorySortFilterModel {
+        Q_OBJECT
+      public:
+        explicit BuildOptionsFilterModel(QObject *parent = nullptr);
+
+        void setFilterText(const QString &text);
+
+      protected:
+        bool filterAcceptsRow(int source_row, const QModelIndex &source_parent) const override;
+
+      private:
+        QString m_filter_text;
+    };
+
     class BuildOptionDelegate final: public QStyledItemDelegate {
         Q_OBJECT
       public:
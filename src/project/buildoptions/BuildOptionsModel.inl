@@ -44,6 +44,26 @@ namespace XMakeProjectManager::Internal {
         }
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline bool CancellableOption::update(const BuildOption &option) {
+        const auto &current = *m_current_value;
+        const auto &saved   = *m_saved_value;
+        if (option.value == saved.value && option.description == current.description &&
+            option.values == current.values)
+            return false;
+
+        const auto edited = m_changed ? Utils::optional<QString> { current.value } : Utils::nullopt;
+
+        m_saved_value   = std::make_unique<BuildOption>(option);
+        m_current_value = std::make_unique<BuildOption>(option);
+        m_changed       = false;
+
+        if (edited) setValue(*edited);
+
+        return true;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     inline const QString &CancellableOption::name() const noexcept {
@@ -197,4 +217,10 @@ namespace XMakeProjectManager::Internal {
     inline auto BuildOptionTreeItem::toolTip() const noexcept -> const QString & {
         return m_option->description();
     }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto BuildOptionTreeItem::option() const noexcept -> CancellableOption & {
+        return *m_option;
+    }
 } // namespace XMakeProjectManager::Internal
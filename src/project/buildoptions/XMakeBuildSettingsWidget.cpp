@@ -25,8 +25,6 @@
 #include <utils/layoutbuilder.h>
 #include <utils/progressindicator.h>
 
-#include <QtCore/QRegularExpression>
-
 #include <QtWidgets/QHBoxLayout>
 #include <QtWidgets/QLineEdit>
 #include <QtWidgets/QVBoxLayout>
@@ -62,7 +60,7 @@ namespace XMakeProjectManager::Internal {
         m_kit_configuration->setFixedWidth(m_kit_configuration->sizeHint().width());
         QObject::connect(m_kit_configuration, &QPushButton::clicked, this, )*/
 
-        m_options_filter = new Utils::CategorySortFilterModel { this };
+        m_options_filter = new BuildOptionsFilterModel { this };
         m_options_filter->setSourceModel(&m_options_model);
         m_options_filter->setSortRole(Qt::DisplayRole);
         m_options_filter->setFilterKeyColumn(-1);
@@ -77,11 +75,7 @@ namespace XMakeProjectManager::Internal {
         QObject::connect(m_options_filter_line_edit,
                          &QLineEdit::textChanged,
                          m_options_filter,
-                         [this](const QString &txt) {
-                             m_options_filter->setFilterRegularExpression(
-                                 QRegularExpression { QRegularExpression::escape(txt),
-                                                      QRegularExpression::CaseInsensitiveOption });
-                         });
+                         [this](const QString &txt) { m_options_filter->setFilterText(txt); });
 
         m_options_tree_view = new Utils::TreeView {};
         QObject::connect(m_options_tree_view,
@@ -142,7 +136,7 @@ namespace XMakeProjectManager::Internal {
                                        Break {},
                                        find_wrapper };
 
-            Column { Form { build_dir_aspect },
+            Column { Form { build_dir_aspect, Break {}, build_cfg->outputDirectoryAspect() },
                      Column { Group { xmake_configuration,
                                       Row { m_options_tree_view },
                                       m_configure_button,
@@ -162,9 +156,15 @@ namespace XMakeProjectManager::Internal {
             }
         });
 
-        bs->triggerParsing();
+        // the options of the last parse are still current, the project files watcher reparses
+        // when they change, only a project which was never parsed needs a run
+        if (!bs->isParsing() && !bs->hasParsingData()) bs->triggerParsing();
+
         if (bs->isParsing()) m_show_progress_timer.start();
-        else { m_options_model.setConfiguration(bs->buildOptionsList()); }
+        else {
+            m_options_model.setConfiguration(bs->buildOptionsList());
+            m_wipe_button->setEnabled(bs->hasParsingData());
+        }
 
         connect(bs, &ProjectExplorer::BuildSystem::parsingFinished, this, [this, bs] {
             m_options_model.setConfiguration(bs->buildOptionsList());
@@ -189,6 +189,11 @@ namespace XMakeProjectManager::Internal {
             m_options_tree_view->resizeColumnToContents(0);
         });
 
+        // the model is updated in place, only new options change the names column
+        QObject::connect(m_options_filter, &QAbstractItemModel::rowsInserted, this, [this] {
+            m_options_tree_view->resizeColumnToContents(0);
+        });
+
         QObject::connect(m_options_tree_view,
                          &Utils::TreeView::activated,
                          m_options_tree_view,
@@ -30,7 +30,7 @@ namespace XMakeProjectManager::Internal {
         ~XMakeBuildSettingsWidget();
 
       private:
-        Utils::CategorySortFilterModel *m_options_filter;
+        BuildOptionsFilterModel *m_options_filter;
         Utils::ProgressIndicator *m_progress_indicator;
         QTimer m_show_progress_timer;
 
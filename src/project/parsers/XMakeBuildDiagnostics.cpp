@@ -0,0 +1,90 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeBuildDiagnostics.hpp"
+
+#include <projectexplorer/projectexplorerconstants.h>
+#include <projectexplorer/taskhub.h>
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeBuildDiagnostics::XMakeBuildDiagnostics() {
+        // the xmake parser and the kit parsers all end up in the hub
+        connect(ProjectExplorer::TaskHub::instance(),
+                &ProjectExplorer::TaskHub::taskAdded,
+                this,
+                [this](const ProjectExplorer::Task &task) {
+                    if (!m_collecting || task.file.isEmpty() ||
+                        task.category != ProjectExplorer::Constants::TASK_CATEGORY_COMPILE)
+                        return;
+
+                    m_new_tasks[task.file.cleanPath()].append(task);
+                });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeBuildDiagnostics::~XMakeBuildDiagnostics() = default;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildDiagnostics::start() -> void {
+        m_collecting = true;
+        m_started    = QDateTime::currentDateTime();
+
+        m_compiled.clear();
+        m_new_tasks.clear();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildDiagnostics::compiled(const Utils::FilePath &source) -> void {
+        if (m_collecting) m_compiled.insert(source.cleanPath());
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildDiagnostics::finish() -> void {
+        if (!m_collecting) return;
+        m_collecting = false;
+
+        auto restored = ProjectExplorer::Tasks {};
+        for (auto it = std::begin(m_entries); it != std::end(m_entries);) {
+            const auto &file = it.key();
+
+            // recompiled or reported again, the tasks of this build replace the old ones
+            const auto replaced = m_compiled.contains(file) || m_new_tasks.contains(file);
+
+            // a header changed since, the translation units including it were rebuilt without
+            // reporting it again
+            const auto outdated = file.lastModified() > it->reported;
+
+            if (replaced || outdated) {
+                it = m_entries.erase(it);
+                continue;
+            }
+
+            restored.append(it->tasks);
+            ++it;
+        }
+
+        for (auto it = std::cbegin(m_new_tasks); it != std::cend(m_new_tasks); ++it)
+            m_entries.insert(it.key(), { it.value(), m_started });
+
+        m_compiled.clear();
+        m_new_tasks.clear();
+
+        for (const auto &task : restored) ProjectExplorer::TaskHub::addTask(task);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildDiagnostics::clear() -> void {
+        m_entries.clear();
+        m_compiled.clear();
+        m_new_tasks.clear();
+        m_collecting = false;
+    }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,54 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <projectexplorer/task.h>
+
+#include <utils/filepath.h>
+
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+
+namespace XMakeProjectManager::Internal {
+    // keeps the compile tasks of each file across the incremental builds, a build only replaces
+    // the tasks of the files it compiled or reported, the others are put back once it is over
+    class XMakeBuildDiagnostics final: public QObject {
+        Q_OBJECT
+
+      public:
+        XMakeBuildDiagnostics();
+        ~XMakeBuildDiagnostics() override;
+
+        XMakeBuildDiagnostics(XMakeBuildDiagnostics &&)      = delete;
+        XMakeBuildDiagnostics(const XMakeBuildDiagnostics &) = delete;
+
+        XMakeBuildDiagnostics &operator=(XMakeBuildDiagnostics &&)      = delete;
+        XMakeBuildDiagnostics &operator=(const XMakeBuildDiagnostics &) = delete;
+
+        // the hub lost the compile tasks when the build started, the ones added from now on
+        // belong to this build
+        void start();
+        void compiled(const Utils::FilePath &source);
+        void finish();
+
+        // a clean leaves nothing to keep
+        void clear();
+
+      private:
+        struct Entry {
+            ProjectExplorer::Tasks tasks;
+            QDateTime reported;
+        };
+
+        QHash<Utils::FilePath, Entry> m_entries;
+
+        bool m_collecting = false;
+        QDateTime m_started;
+        QSet<Utils::FilePath> m_compiled;
+        QHash<Utils::FilePath, ProjectExplorer::Tasks> m_new_tasks;
+    };
+} // namespace XMakeProjectManager::Internal
@@ -4,14 +4,55 @@
 
 #include "XMakeBuildParser.hpp"
 
+#include <projectexplorer/kitinformation.h>
+#include <projectexplorer/projectexplorerconstants.h>
+#include <projectexplorer/toolchain.h>
+
 #include <utils/fileutils.h>
 
-#include <projectexplorer/taskhub.h>
+#include <QCoreApplication>
+
+#include <algorithm>
 
 namespace XMakeProjectManager::Internal {
+    static constexpr auto TIMINGS_REPORT_SIZE = 10;
+    static constexpr auto MINUTE              = 60;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto remainingText(qint64 remaining) -> QString {
+        if (remaining < 0) return {};
+
+        const auto seconds = remaining / 1000;
+        if (seconds >= MINUTE)
+            return QCoreApplication::translate("XMakeBuildParser",
+                                               "About %n min left",
+                                               nullptr,
+                                               static_cast<int>(seconds / MINUTE));
+
+        return QCoreApplication::translate("XMakeBuildParser",
+                                           "About %n s left",
+                                           nullptr,
+                                           static_cast<int>(std::max<qint64>(seconds, 1)));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildParser::typeForKit(const ProjectExplorer::Kit *kit) -> Type {
+        const auto *toolchain = ProjectExplorer::ToolChainKitAspect::cxxToolChain(kit);
+        const auto msvc_like =
+            toolchain &&
+            (toolchain->typeId() == ProjectExplorer::Constants::MSVC_TOOLCHAIN_TYPEID ||
+             toolchain->typeId() == ProjectExplorer::Constants::CLANG_CL_TOOLCHAIN_TYPEID);
+
+        return msvc_like ? Type::MSVC : Type::GCC_Clang;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    XMakeBuildParser::XMakeBuildParser(Type type) : m_has_char_number { type != Type::MSVC } {
+    XMakeBuildParser::XMakeBuildParser(Type type)
+        : m_error_marker { (type == Type::MSVC) ? "): " : "error: " },
+          m_has_char_number { type != Type::MSVC } {
         m_error_regex =
             QRegularExpression { (type == Type::MSVC) ? m_msvc_error_regex : m_gcc_error_regex };
     }
@@ -23,17 +64,60 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeBuildParser::handleLine(const QString &line, Utils::OutputFormat type) -> Result {
+        if (m_full_log) {
+            m_full_log->write(line.toUtf8());
+            if (!line.endsWith('\n')) m_full_log->write("\n");
+        }
+
         if (type != Utils::OutputFormat::StdOutFormat)
             return ProjectExplorer::OutputTaskParser::Status::NotHandled;
 
-        auto progress = extractProgress(line);
+        // verbose builds print very long command lines, only run the regexes on candidates
+        if (line.startsWith('[')) {
+            auto progress = extractProgress(line);
+
+            if (progress) {
+                extractJob(line);
+
+                const auto estimate = m_timings.estimate(*progress);
+                auto text           = remainingText(estimate.remaining);
+
+                if (!m_full_log) {
+                    Q_EMIT reportProgress(estimate.progress, text);
+                    return ProjectExplorer::OutputTaskParser::Status::InProgress;
+                }
+
+                if (!m_current_job.isEmpty())
+                    text = text.isEmpty() ? m_current_job : m_current_job + " - " + text;
+                Q_EMIT reportProgress(estimate.progress, text);
+
+                // the empty content drops the line from the output
+                return { ProjectExplorer::OutputTaskParser::Status::InProgress, {}, QString {} };
+            }
+        }
+
+        if (line.startsWith(QLatin1String { "cache " })) {
+            const auto count = m_build_cache_regex.match(line);
+            if (count.hasMatch())
+                m_cache_statistics.addBuildCacheCount(count.capturedView(1) ==
+                                                          QLatin1String { "hit" },
+                                                      count.captured(2).toInt());
+
+            return ProjectExplorer::OutputTaskParser::Status::NotHandled;
+        }
 
-        if (progress) {
-            Q_EMIT reportProgress(*progress);
+        if (m_diagnostics_format != XMakeStructuredDiagnostics::Format::None &&
+            XMakeStructuredDiagnostics::isDocument(line, m_diagnostics_format)) {
+            for (auto &task :
+                 XMakeStructuredDiagnostics::decode(line, m_diagnostics_format, m_source_dir))
+                m_tasks.add(std::move(task));
 
-            return ProjectExplorer::OutputTaskParser::Status::InProgress;
+            return ProjectExplorer::OutputTaskParser::Status::Done;
         }
 
+        if (!isDiagnosticCandidate(line))
+            return ProjectExplorer::OutputTaskParser::Status::NotHandled;
+
         auto error = m_error_regex.match(line);
         if (error.hasMatch()) {
             auto link_specs = addTask(ProjectExplorer::Task::TaskType::Error, error, 1, 2, 3, 4);
@@ -43,9 +127,51 @@ namespace XMakeProjectManager::Internal {
         return ProjectExplorer::OutputTaskParser::Status::NotHandled;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildParser::flush() -> void {
+        if (!m_diagnostics_log_dir.isEmpty())
+            for (auto &task :
+                 XMakeStructuredDiagnostics::readLogs(m_diagnostics_log_dir, m_source_dir))
+                m_tasks.add(std::move(task));
+
+        m_tasks.flush();
+
+        if (m_full_log) {
+            m_full_log->close();
+            Q_EMIT reportFullLog(Utils::FilePath::fromString(m_full_log->fileName()));
+            m_full_log.reset();
+        }
+
+        m_timings.finish();
+        m_timings.storeHistory();
+        if (!m_trace_file.isEmpty() && !m_timings.isEmpty() &&
+            XMakeTraceExport::write(m_trace_file,
+                                    QCoreApplication::translate("XMakeBuildParser", "xmake build"),
+                                    { QCoreApplication::translate("XMakeBuildParser", "jobs") },
+                                    m_timings.traceSpans()))
+            Q_EMIT reportTrace(m_trace_file);
+        if (!m_timings.isEmpty()) Q_EMIT reportTimings(m_timings.report(TIMINGS_REPORT_SIZE));
+
+        m_cache_statistics.load();
+        if (!m_cache_statistics.isEmpty())
+            Q_EMIT reportCacheStatistics(m_cache_statistics.report());
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildParser::setFullLog(Utils::FilePath log) -> void {
+        m_full_log = std::make_unique<QFile>(log.toString());
+
+        if (!m_full_log->open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+            m_full_log.reset();
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeBuildParser::setSourceDirectory(const Utils::FilePath &source_dir) -> void {
+        m_source_dir = source_dir;
+
         Q_EMIT newSearchDirFound(source_dir);
     }
 
@@ -59,6 +185,29 @@ namespace XMakeProjectManager::Internal {
         return Utils::nullopt;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildParser::extractJob(QStringView line) -> void {
+        const auto job = m_job_regex.match(line);
+        if (!job.hasMatch()) {
+            // "build ok" and the other progress lines end the last job
+            m_timings.finish();
+            m_current_job.clear();
+            return;
+        }
+
+        const auto path = job.captured(2).trimmed();
+        m_current_job   = job.captured(1) + ' ' + path;
+        if (job.capturedView(1) == QLatin1String { "compiling" }) {
+            const auto source = m_source_dir.resolvePath(path).cleanPath();
+            m_timings.start(XMakeBuildTimings::Kind::Compile, source.toString());
+
+            Q_EMIT sourceCompiled(source);
+        } else
+            m_timings.start(XMakeBuildTimings::Kind::Link,
+                            Utils::FilePath::fromString(path).fileName());
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeBuildParser::addTask(ProjectExplorer::Task::TaskType type,
@@ -81,7 +230,7 @@ namespace XMakeProjectManager::Internal {
         };
 
         addLinkSpecForAbsoluteFilePath(link_specs, task.file, task.line, match, file_cap_index);
-        ProjectExplorer::TaskHub::addTask(std::move(task));
+        m_tasks.add(std::move(task));
 
         return link_specs;
     }
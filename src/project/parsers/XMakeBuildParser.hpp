@@ -4,10 +4,22 @@
 
 #pragma once
 
+#include <project/parsers/XMakeBuildTimings.hpp>
+#include <project/parsers/XMakeCacheStatistics.hpp>
+#include <project/parsers/XMakeStructuredDiagnostics.hpp>
+#include <project/parsers/XMakeTaskQueue.hpp>
+
 #include <projectexplorer/ioutputparser.h>
 
+#include <QFile>
 #include <QRegularExpression>
 
+#include <memory>
+
+namespace ProjectExplorer {
+    class Kit;
+} // namespace ProjectExplorer
+
 namespace XMakeProjectManager::Internal {
     class XMakeBuildParser final: public ProjectExplorer::OutputTaskParser {
         Q_OBJECT
@@ -15,6 +27,8 @@ namespace XMakeProjectManager::Internal {
         enum class Type { MSVC, GCC_Clang };
 
         XMakeBuildParser(Type type);
+        // the diagnostics format of the C++ compiler of kit
+        static Type typeForKit(const ProjectExplorer::Kit *kit);
         ~XMakeBuildParser();
 
         XMakeBuildParser(XMakeBuildParser &&)      = delete;
@@ -24,17 +38,39 @@ namespace XMakeProjectManager::Internal {
         XMakeBuildParser &operator=(const XMakeBuildParser &&) const = delete;
 
         Result handleLine(const QString &line, Utils::OutputFormat type) override;
+        void flush() override;
         void setSourceDirectory(const Utils::FilePath &source_dir);
+        void setTimingOwners(QHash<QString, QString> owners);
+        // the job durations of the previous builds weight the progress, updated with this one
+        void setDurationsHistory(Utils::FilePath history);
+        // the progress lines are left out of the output, the text of the progress names the
+        // running job and every line is written to log
+        void setFullLog(Utils::FilePath log);
+        // the jobs of the build are written there as Chrome trace events once it is over
+        void setTraceFile(Utils::FilePath trace);
+        // the compilations ccache logs there are reported once the build is over
+        void setCacheStatsLog(Utils::FilePath stats_log, const Utils::Environment &env);
+        // decodes the documents the compilers print in this format instead of the text lines,
+        // the side files of log_dir are read once the build is over
+        void setStructuredDiagnostics(XMakeStructuredDiagnostics::Format format,
+                                      Utils::FilePath log_dir = {});
 
         bool hasDetectedRedirection() const noexcept override;
 
         bool hasFatalErrors() const noexcept override;
 
       Q_SIGNALS:
-        void reportProgress(int progress);
+        void reportProgress(int progress, const QString &text);
+        void reportTimings(const QString &report);
+        void reportCacheStatistics(const QString &report);
+        void sourceCompiled(const Utils::FilePath &source);
+        void reportFullLog(const Utils::FilePath &log);
+        void reportTrace(const Utils::FilePath &trace);
 
       private:
         Utils::optional<int> extractProgress(QStringView line);
+        void extractJob(QStringView line);
+        bool isDiagnosticCandidate(QStringView line) const noexcept;
         LinkSpecs addTask(ProjectExplorer::Task::TaskType type,
                           const QRegularExpressionMatch &match,
                           int file_cap_index,
@@ -42,14 +78,40 @@ namespace XMakeProjectManager::Internal {
                           int char_number_cap_index,
                           int error_cap_index);
 
+        // cache hit: 12, printed by xmake -D when its build cache is enabled
+        const QRegularExpression m_build_cache_regex { R"(^cache (hit|miss): (\d+)$)" };
+
         // error: test/main.cpp:12:3: error: ‘a’ was not declared in this scope
         const QRegularExpression m_progress_regex { R"(^\[\s*(\d+)\%\])" };
 
+        // [ 25%]: cache compiling.release src/main.cpp
+        const QRegularExpression m_job_regex {
+            R"(^\[\s*\d+\%\]:\s+(?:\S+\s+)?(compiling|linking|archiving)\.\S+\s+(.+)$)"
+        };
+
         QRegularExpression m_error_regex;
         const QString m_msvc_error_regex { QStringLiteral(R"((.+)\((\d+)\): (.+))") };
         const QString m_gcc_error_regex { QStringLiteral(R"(error: (.*):(\d+):(\d+): (.*))") };
 
+        // literal part every line matched by m_error_regex contains
+        QLatin1String m_error_marker;
+
         bool m_has_char_number = false;
+
+        XMakeTaskQueue m_tasks;
+
+        Utils::FilePath m_source_dir;
+        XMakeBuildTimings m_timings;
+        XMakeCacheStatistics m_cache_statistics;
+
+        XMakeStructuredDiagnostics::Format m_diagnostics_format =
+            XMakeStructuredDiagnostics::Format::None;
+        Utils::FilePath m_diagnostics_log_dir;
+
+        std::unique_ptr<QFile> m_full_log;
+        QString m_current_job;
+
+        Utils::FilePath m_trace_file;
     };
 } // namespace XMakeProjectManager::Internal
 
@@ -15,4 +15,45 @@ namespace XMakeProjectManager::Internal {
         // TODO
         return false;
     }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildParser::setTimingOwners(QHash<QString, QString> owners) -> void {
+        m_cache_statistics.setOwners(owners);
+        m_timings.setOwners(std::move(owners));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildParser::setDurationsHistory(Utils::FilePath history) -> void {
+        m_timings.loadHistory(std::move(history));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildParser::setTraceFile(Utils::FilePath trace) -> void {
+        m_trace_file = std::move(trace);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildParser::setCacheStatsLog(Utils::FilePath stats_log,
+                                                   const Utils::Environment &env) -> void {
+        m_cache_statistics.setStatsLog(std::move(stats_log), env);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto
+        XMakeBuildParser::setStructuredDiagnostics(XMakeStructuredDiagnostics::Format format,
+                                                   Utils::FilePath log_dir) -> void {
+        m_diagnostics_format  = format;
+        m_diagnostics_log_dir = std::move(log_dir);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeBuildParser::isDiagnosticCandidate(QStringView line) const noexcept -> bool {
+        return line.contains(m_error_marker);
+    }
 } // namespace XMakeProjectManager::Internal
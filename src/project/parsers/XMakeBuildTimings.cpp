@@ -0,0 +1,218 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeBuildTimings.hpp"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+
+#include <algorithm>
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto formatDuration(qint64 msecs) -> QString {
+        return QString { "%1 s" }.arg(static_cast<double>(msecs) / 1000., 8, 'f', 2);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeBuildTimings::XMakeBuildTimings() { m_timer.start(); }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildTimings::setOwners(QHash<QString, QString> owners) -> void {
+        m_owners = std::move(owners);
+
+        // the sources are absolute paths, the linked files are only named
+        m_link_keys.clear();
+        for (auto it = std::cbegin(m_owners); it != std::cend(m_owners); ++it)
+            if (!it.key().contains('/')) m_link_keys.insert(it.value(), it.key());
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildTimings::loadHistory(Utils::FilePath history) -> void {
+        m_history_path = std::move(history);
+        m_history.clear();
+
+        if (!m_history_path.exists()) return;
+
+        const auto object = QJsonDocument::fromJson(m_history_path.fileContents()).object();
+
+        auto compile_total = qint64 { 0 };
+        auto compile_count = 0;
+        for (auto it = std::cbegin(object); it != std::cend(object); ++it) {
+            const auto duration = it.value().toInteger();
+            m_history.insert(it.key(), duration);
+
+            if (!it.key().contains('/')) continue;
+
+            compile_total += duration;
+            ++compile_count;
+        }
+
+        m_mean_compile = compile_count > 0 ? compile_total / compile_count : 0;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildTimings::storeHistory() const -> void {
+        if (m_history_path.isEmpty() || m_jobs.empty()) return;
+
+        auto object = QJsonObject {};
+        for (auto it = std::cbegin(m_history); it != std::cend(m_history); ++it)
+            object.insert(it.key(), it.value());
+
+        // halfway between the previous measure and this one, a single slow build fades out
+        for (const auto &job : m_jobs) {
+            if (job.duration < 0) continue;
+
+            const auto previous = m_history.value(job.path, -1);
+            object.insert(job.path, previous < 0 ? job.duration : (previous + job.duration) / 2);
+        }
+
+        m_history_path.writeFileContents(QJsonDocument { object }.toJson(QJsonDocument::Compact));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildTimings::start(Kind kind, const QString &path) -> void {
+        // xmake only prints when a job starts, a job lasts until the next one is printed
+        finish();
+
+        m_jobs.push_back({ kind, path, m_timer.elapsed(), -1 });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildTimings::finish() -> void {
+        if (m_jobs.empty() || m_jobs.back().duration >= 0) return;
+
+        auto &job    = m_jobs.back();
+        job.duration = m_timer.elapsed() - job.start;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildTimings::traceSpans() const -> XMakeTraceExport::SpansList {
+        const auto origin = QDateTime::currentMSecsSinceEpoch() - m_timer.elapsed();
+
+        auto spans = XMakeTraceExport::SpansList {};
+        spans.reserve(std::size(m_jobs) + 1);
+        spans.push_back({ "build", "build", origin, m_timer.elapsed(), 0, {} });
+
+        for (const auto &job : m_jobs) {
+            if (job.duration < 0) continue;
+
+            const auto compile = job.kind == Kind::Compile;
+            spans.push_back({ compile ? QFileInfo { job.path }.fileName() : job.path,
+                              compile ? "compile" : "link",
+                              origin + job.start,
+                              job.duration,
+                              0,
+                              { { "path", job.path },
+                                { "target", m_owners.value(job.path, job.path) } } });
+        }
+
+        return spans;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildTimings::estimate(int percent) -> Estimate {
+        if (m_history.isEmpty() || m_jobs.empty() || percent <= 0) return { percent, -1 };
+
+        const auto elapsed = m_timer.elapsed();
+        const auto started = static_cast<qint64>(std::size(m_jobs));
+        const auto total   = std::max(started, started * 100 / percent);
+
+        // the targets compiled by this build and not linked yet link before the end
+        auto compiled = QSet<QString> {};
+        auto linked   = QSet<QString> {};
+        for (const auto &job : m_jobs) {
+            if (job.kind == Kind::Compile) {
+                const auto owner = m_owners.value(job.path);
+                if (!owner.isEmpty()) compiled.insert(owner);
+            } else
+                linked.insert(m_owners.value(job.path, job.path));
+        }
+
+        auto remaining     = qint64 { 0 };
+        auto pending_links = qint64 { 0 };
+        for (const auto &target : compiled) {
+            if (linked.contains(target)) continue;
+
+            remaining += m_history.value(m_link_keys.value(target), m_mean_compile);
+            ++pending_links;
+        }
+
+        remaining += std::max<qint64>(total - started - pending_links, 0) * m_mean_compile;
+
+        const auto &current = m_jobs.back();
+        if (current.duration < 0)
+            remaining += std::max<qint64>(m_history.value(current.path, m_mean_compile) -
+                                              (elapsed - current.start),
+                                          0);
+
+        // the bar never goes back, and is only full once xmake is done
+        const auto progress =
+            elapsed + remaining > 0 ? static_cast<int>(elapsed * 100 / (elapsed + remaining)) : 0;
+        m_last_progress = std::clamp(progress, m_last_progress, 99);
+
+        return { m_last_progress, remaining };
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildTimings::report(int count) const -> QString {
+        auto units   = std::vector<const Job *> {};
+        auto targets = QHash<QString, qint64> {};
+
+        for (const auto &job : m_jobs) {
+            if (job.duration < 0) continue;
+
+            if (job.kind == Kind::Compile) units.push_back(&job);
+
+            const auto owner =
+                m_owners.value(job.path, job.kind == Kind::Link ? job.path : QString {});
+            if (!owner.isEmpty()) targets[owner] += job.duration;
+        }
+
+        std::sort(std::begin(units), std::end(units), [](const auto *a, const auto *b) {
+            return a->duration > b->duration;
+        });
+
+        auto sorted_targets = std::vector<std::pair<QString, qint64>> {};
+        sorted_targets.reserve(std::size(targets));
+        for (auto it = std::cbegin(targets); it != std::cend(targets); ++it)
+            sorted_targets.emplace_back(it.key(), it.value());
+
+        std::sort(std::begin(sorted_targets),
+                  std::end(sorted_targets),
+                  [](const auto &a, const auto &b) { return a.second > b.second; });
+
+        auto output = QStringList {};
+
+        const auto unit_count   = std::min(std::size(units), static_cast<std::size_t>(count));
+        const auto target_count =
+            std::min(std::size(sorted_targets), static_cast<std::size_t>(count));
+
+        output << QCoreApplication::translate("XMakeBuildTimings", "Slowest translation units:");
+        for (auto i = 0u; i < unit_count; ++i)
+            output << QString { "  %1  %2" }.arg(formatDuration(units[i]->duration),
+                                                 units[i]->path);
+
+        output << QCoreApplication::translate("XMakeBuildTimings", "Slowest targets:");
+        for (auto i = 0u; i < target_count; ++i)
+            output << QString { "  %1  %2" }.arg(formatDuration(sorted_targets[i].second),
+                                                 sorted_targets[i].first);
+
+        return output.join('\n');
+    }
+} // namespace XMakeProjectManager::Internal
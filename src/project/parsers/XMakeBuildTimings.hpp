@@ -0,0 +1,72 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <project/XMakeTraceExport.hpp>
+
+#include <utils/filepath.h>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+
+#include <vector>
+
+namespace XMakeProjectManager::Internal {
+    // durations of the compile and link jobs of a build, measured from the xmake progress lines
+    class XMakeBuildTimings {
+      public:
+        enum class Kind { Compile, Link };
+
+        // remaining is in milliseconds, -1 when no job of a previous build is known
+        struct Estimate {
+            int progress;
+            qint64 remaining;
+        };
+
+        XMakeBuildTimings();
+
+        // maps the absolute path of the sources and target files to their target name
+        void setOwners(QHash<QString, QString> owners);
+
+        // the job durations of the previous builds, saved back with this build by store()
+        void loadHistory(Utils::FilePath history);
+        void storeHistory() const;
+
+        void start(Kind kind, const QString &path);
+        void finish();
+
+        // xmake counts jobs, the percentage is weighted by the time the jobs took before
+        Estimate estimate(int percent);
+
+        [[nodiscard]] bool isEmpty() const noexcept;
+        QString report(int count) const;
+
+        // the jobs of this build on a single thread, xmake only prints when one starts
+        XMakeTraceExport::SpansList traceSpans() const;
+
+      private:
+        struct Job {
+            Kind kind;
+            QString path;
+            qint64 start;
+            qint64 duration;
+        };
+
+        QElapsedTimer m_timer;
+
+        QHash<QString, QString> m_owners;
+        // target name to the file name xmake prints when linking it
+        QHash<QString, QString> m_link_keys;
+        std::vector<Job> m_jobs;
+
+        Utils::FilePath m_history_path;
+        QHash<QString, qint64> m_history;
+        qint64 m_mean_compile = 0;
+        int m_last_progress   = 0;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakeBuildTimings.inl"
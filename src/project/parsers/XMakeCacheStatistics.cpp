@@ -0,0 +1,155 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeCacheStatistics.hpp"
+
+#include <utils/qtcprocess.h>
+
+#include <QCoreApplication>
+#include <QLocale>
+
+#include <algorithm>
+#include <vector>
+
+namespace XMakeProjectManager::Internal {
+    // a target missing most of the time while the rest of the build hits usually has flags
+    // changing from one build to the other (dates, absolute paths, random seeds)
+    static constexpr auto LOW_HIT_RATE        = 20;
+    static constexpr auto BUILD_HIT_RATE      = 50;
+    static constexpr auto MIN_TARGET_COMPILES = 4;
+    static constexpr auto CCACHE_TIMEOUT_S    = 5;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto hitRate(int hits, int misses) -> int {
+        const auto total = hits + misses;
+
+        return total > 0 ? hits * 100 / total : 0;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeCacheStatistics::setStatsLog(Utils::FilePath stats_log,
+                                           const Utils::Environment &env) -> void {
+        m_stats_log = std::move(stats_log);
+        m_env       = env;
+
+        if (m_stats_log.exists()) m_stats_log.removeFile();
+
+        m_size_before = cacheSize(m_env);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeCacheStatistics::load() -> void {
+        if (m_stats_log.isEmpty() || !m_stats_log.exists()) return;
+
+        // "# <source file>" followed by the counters the compilation incremented
+        auto source = QString {};
+
+        const auto contents = QString::fromUtf8(m_stats_log.fileContents());
+        for (const auto &line : contents.split('\n', Qt::SkipEmptyParts)) {
+            if (line.startsWith(QLatin1String { "# " })) {
+                source = Utils::FilePath::fromUserInput(line.mid(2).trimmed())
+                             .cleanPath()
+                             .toString();
+                continue;
+            }
+
+            const auto counter = line.trimmed();
+            const auto hit     = counter == QLatin1String { "direct_cache_hit" } ||
+                             counter == QLatin1String { "preprocessed_cache_hit" };
+            if (!hit && counter != QLatin1String { "cache_miss" }) continue;
+
+            (hit ? m_ccache.hits : m_ccache.misses)++;
+
+            const auto owner = m_owners.value(source);
+            if (!owner.isEmpty()) (hit ? m_targets[owner].hits : m_targets[owner].misses)++;
+        }
+
+        m_size_after = cacheSize(m_env);
+
+        // the log is read once, a second flush of the parser has nothing more to count
+        m_stats_log = {};
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeCacheStatistics::report() const -> QString {
+        auto output = QStringList {};
+
+        const auto counters = [](const Counters &counters) {
+            return QCoreApplication::translate("XMakeCacheStatistics", "%1 hits, %2 misses (%3%)")
+                .arg(counters.hits)
+                .arg(counters.misses)
+                .arg(hitRate(counters.hits, counters.misses));
+        };
+
+        if (m_ccache.hits + m_ccache.misses > 0) {
+            auto line = QCoreApplication::translate("XMakeCacheStatistics", "ccache: %1")
+                            .arg(counters(m_ccache));
+            if (m_size_before >= 0 && m_size_after >= 0)
+                line += QCoreApplication::translate("XMakeCacheStatistics",
+                                                    ", %1 added to the cache")
+                            .arg(QLocale {}.formattedDataSize(
+                                std::max<qint64>(m_size_after - m_size_before, 0)));
+            output << line;
+        }
+
+        if (m_build_cache.hits + m_build_cache.misses > 0)
+            output << QCoreApplication::translate("XMakeCacheStatistics", "xmake build cache: %1")
+                          .arg(counters(m_build_cache));
+
+        auto low_targets = std::vector<std::pair<QString, int>> {};
+        for (auto it = std::cbegin(m_targets); it != std::cend(m_targets); ++it) {
+            const auto &target = it.value();
+            if (target.hits + target.misses < MIN_TARGET_COMPILES) continue;
+
+            const auto rest_hits   = m_ccache.hits - target.hits;
+            const auto rest_misses = m_ccache.misses - target.misses;
+
+            const auto rate = hitRate(target.hits, target.misses);
+            if (rate < LOW_HIT_RATE && hitRate(rest_hits, rest_misses) >= BUILD_HIT_RATE)
+                low_targets.emplace_back(it.key(), rate);
+        }
+
+        std::sort(std::begin(low_targets), std::end(low_targets), [](const auto &a, const auto &b) {
+            return a.second < b.second;
+        });
+
+        if (!low_targets.empty()) {
+            output << QCoreApplication::translate(
+                "XMakeCacheStatistics",
+                "Targets rarely found in the cache, their flags may change on each build:");
+            for (const auto &[name, rate] : low_targets)
+                output << QString { "  %1%  %2" }.arg(rate, 3).arg(name);
+        }
+
+        return output.join('\n');
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeCacheStatistics::cacheSize(const Utils::Environment &env) -> qint64 {
+        const auto ccache = env.searchInPath("ccache");
+        if (ccache.isEmpty()) return -1;
+
+        auto process = Utils::QtcProcess {};
+        process.setEnvironment(env);
+        process.setTimeoutS(CCACHE_TIMEOUT_S);
+        process.setCommand({ ccache, { "--print-stats" } });
+        process.runBlocking();
+
+        if (process.result() != Utils::ProcessResult::FinishedWithSuccess) return -1;
+
+        // tab separated counters, one per line
+        for (const auto &line : process.stdOut().split('\n')) {
+            const auto fields = line.split('\t');
+            if (fields.size() == 2 && fields[0] == QLatin1String { "cache_size_kibibyte" })
+                return fields[1].trimmed().toLongLong() * 1024;
+        }
+
+        return -1;
+    }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,55 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+
+#include <utils/environment.h>
+#include <utils/filepath.h>
+
+namespace XMakeProjectManager::Internal {
+    // compiler cache hits and misses of a build, from the ccache stats log and the build cache
+    // summary xmake prints in diagnosis mode
+    class XMakeCacheStatistics {
+      public:
+        XMakeCacheStatistics() = default;
+
+        // maps the absolute path of the sources to their target name
+        void setOwners(QHash<QString, QString> owners);
+
+        // cleared before the build, ccache appends one entry per compilation to it
+        void setStatsLog(Utils::FilePath stats_log, const Utils::Environment &env);
+
+        void addBuildCacheCount(bool hit, int count) noexcept;
+
+        void load();
+
+        [[nodiscard]] bool isEmpty() const noexcept;
+        QString report() const;
+
+      private:
+        struct Counters {
+            int hits   = 0;
+            int misses = 0;
+        };
+
+        // size of the ccache directory in bytes, -1 when ccache can't tell
+        static qint64 cacheSize(const Utils::Environment &env);
+
+        QHash<QString, QString> m_owners;
+        Utils::FilePath m_stats_log;
+        Utils::Environment m_env;
+
+        qint64 m_size_before = -1;
+        qint64 m_size_after  = -1;
+
+        Counters m_ccache;
+        Counters m_build_cache;
+        QHash<QString, Counters> m_targets;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakeCacheStatistics.inl"
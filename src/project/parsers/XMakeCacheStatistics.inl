@@ -0,0 +1,25 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeCacheStatistics::setOwners(QHash<QString, QString> owners) -> void {
+        m_owners = std::move(owners);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeCacheStatistics::addBuildCacheCount(bool hit, int count) noexcept -> void {
+        (hit ? m_build_cache.hits : m_build_cache.misses) += count;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeCacheStatistics::isEmpty() const noexcept -> bool {
+        return m_ccache.hits + m_ccache.misses + m_build_cache.hits + m_build_cache.misses == 0;
+    }
+} // namespace XMakeProjectManager::Internal
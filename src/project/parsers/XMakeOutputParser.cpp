@@ -5,15 +5,14 @@
 #include "XMakeOutputParser.hpp"
 #include "projectexplorer/ioutputparser.h"
 
-#include <utils/fileutils.h>
+#include <XMakeProjectConstant.hpp>
 
-#include <projectexplorer/taskhub.h>
+#include <utils/fileutils.h>
 
 namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    XMakeOutputParser::XMakeOutputParser(bool capture_stdio) : m_capture_stdio { capture_stdio } {
-    }
+    XMakeOutputParser::XMakeOutputParser() = default;
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
@@ -22,6 +21,16 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeOutputParser::handleLine(const QString &line, Utils::OutputFormat type) -> Result {
+        if (type == Utils::OutputFormat::StdErrFormat && isProgressLine(line)) {
+            const auto values = QStringView { line }
+                                    .mid(qstrlen(Constants::Introspection::PROGRESS_MARKER))
+                                    .trimmed()
+                                    .split(' ');
+            if (values.size() == 2) Q_EMIT progressReported(values[0].toInt(), values[1].toInt());
+
+            return ProjectExplorer::OutputTaskParser::Status::Done;
+        }
+
         if (type != Utils::OutputFormat::StdOutFormat)
             return ProjectExplorer::OutputTaskParser::Status::NotHandled;
 
@@ -33,13 +42,17 @@ namespace XMakeProjectManager::Internal {
         auto result = processErrors(line);
         if (result.status == ProjectExplorer::OutputTaskParser::Status::Done) return result;
 
-        result = processWarnings(line);
-        if (result.status == ProjectExplorer::OutputTaskParser::Status::NotHandled &&
-            m_capture_stdio) {
-            m_data += line;
-        }
+        return processWarnings(line);
+    }
 
-        return result;
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeOutputParser::flush() -> void { m_tasks.flush(); }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeOutputParser::isProgressLine(QStringView line) -> bool {
+        return line.startsWith(QLatin1String { Constants::Introspection::PROGRESS_MARKER });
     }
 
     ////////////////////////////////////////////////////
@@ -120,7 +133,7 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeOutputParser::addTask(ProjectExplorer::Task task) -> void {
-        ProjectExplorer::TaskHub::addTask(task);
+        m_tasks.add(std::move(task));
     }
 
     ////////////////////////////////////////////////////
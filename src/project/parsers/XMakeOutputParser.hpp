@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <project/parsers/XMakeTaskQueue.hpp>
+
 #include <projectexplorer/ioutputparser.h>
 
 #include <QRegularExpression>
@@ -12,7 +14,7 @@ namespace XMakeProjectManager::Internal {
     class XMakeOutputParser final: public ProjectExplorer::OutputTaskParser {
         Q_OBJECT
       public:
-        XMakeOutputParser(bool capture_stdio = false);
+        XMakeOutputParser();
         ~XMakeOutputParser();
 
         XMakeOutputParser(XMakeOutputParser &&)      = delete;
@@ -22,13 +24,16 @@ namespace XMakeProjectManager::Internal {
         XMakeOutputParser &operator=(const XMakeOutputParser &&) const = delete;
 
         Result handleLine(const QString &line, Utils::OutputFormat type) override;
+        void flush() override;
 
         void setSourceDirectory(const Utils::FilePath &source_dir);
 
-        const QString &data() const noexcept;
+        // the "<marker> <done> <total>" lines the introspection script prints on stderr
+        static bool isProgressLine(QStringView line);
 
       Q_SIGNALS:
         void new_search_dir_found(const Utils::FilePath &);
+        void progressReported(int done, int total);
 
       private:
         void pushLine(const QString &line);
@@ -55,8 +60,7 @@ namespace XMakeProjectManager::Internal {
 
         QStringList m_pending_lines;
 
-        bool m_capture_stdio;
-        QString m_data;
+        XMakeTaskQueue m_tasks;
     };
 } // namespace XMakeProjectManager::Internal
 
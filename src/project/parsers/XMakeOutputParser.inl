@@ -5,9 +5,4 @@
 #pragma once
 
 namespace XMakeProjectManager::Internal {
-    ////////////////////////////////////////////////////
-    ////////////////////////////////////////////////////
-    inline const QString &XMakeOutputParser::data() const noexcept {
-        return m_data;
-    }
 } // namespace XMakeProjectManager::Internal
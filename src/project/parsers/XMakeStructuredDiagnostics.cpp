@@ -0,0 +1,201 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeStructuredDiagnostics.hpp"
+
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QUrl>
+
+#include <tuple>
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto taskType(QStringView kind) -> ProjectExplorer::Task::TaskType {
+        if (kind == QLatin1String { "error" } || kind == QLatin1String { "fatal error" })
+            return ProjectExplorer::Task::Error;
+        if (kind == QLatin1String { "warning" }) return ProjectExplorer::Task::Warning;
+
+        return ProjectExplorer::Task::Unknown;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto resolve(const Utils::FilePath &source_dir, const QString &file)
+        -> Utils::FilePath {
+        if (file.isEmpty()) return {};
+
+        const auto path = file.startsWith(QLatin1String { "file:" })
+                              ? QUrl { file }.toLocalFile()
+                              : file;
+
+        return source_dir.resolvePath(path).cleanPath();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto location(const Utils::FilePath &file, int line, int column) -> QString {
+        return QString { "%1:%2:%3" }.arg(file.toUserOutput()).arg(line).arg(column);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto decodeGCCJson(const QJsonArray &diagnostics, const Utils::FilePath &source_dir)
+        -> ProjectExplorer::Tasks {
+        auto tasks = ProjectExplorer::Tasks {};
+
+        for (const auto &value : diagnostics) {
+            const auto diagnostic = value.toObject();
+
+            const auto type = taskType(diagnostic["kind"].toString());
+            if (type == ProjectExplorer::Task::Unknown) continue;
+
+            const auto caret = diagnostic["locations"].toArray().at(0)["caret"].toObject();
+            const auto file  = resolve(source_dir, caret["file"].toString());
+
+            auto task = ProjectExplorer::CompileTask { type,
+                                                       diagnostic["message"].toString(),
+                                                       file,
+                                                       caret["line"].toInt(),
+                                                       caret["column"].toInt() };
+
+            // the notes and the "required from here" lines the text output splits over lines
+            for (const auto &child_value : diagnostic["children"].toArray()) {
+                const auto child       = child_value.toObject();
+                const auto child_caret = child["locations"].toArray().at(0)["caret"].toObject();
+
+                task.details.append(QString { "%1: %2: %3" }.arg(
+                    location(resolve(source_dir, child_caret["file"].toString()),
+                             child_caret["line"].toInt(),
+                             child_caret["column"].toInt()),
+                    child["kind"].toString(),
+                    child["message"].toString()));
+            }
+
+            tasks.append(std::move(task));
+        }
+
+        return tasks;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto decodeSarif(const QJsonObject &log, const Utils::FilePath &source_dir)
+        -> ProjectExplorer::Tasks {
+        const auto physical_location = [&source_dir](const QJsonValue &location) {
+            const auto physical = location["physicalLocation"].toObject();
+            const auto region   = physical["region"].toObject();
+
+            return std::tuple { resolve(source_dir,
+                                        physical["artifactLocation"]["uri"].toString()),
+                                region["startLine"].toInt(),
+                                region["startColumn"].toInt() };
+        };
+
+        auto tasks = ProjectExplorer::Tasks {};
+
+        for (const auto &run : log["runs"].toArray()) {
+            for (const auto &value : run["results"].toArray()) {
+                const auto result = value.toObject();
+
+                const auto type = taskType(result["level"].toString("warning"));
+                if (type == ProjectExplorer::Task::Unknown) continue;
+
+                const auto [file, line, column] =
+                    physical_location(result["locations"].toArray().at(0));
+
+                auto task = ProjectExplorer::CompileTask { type,
+                                                           result["message"]["text"].toString(),
+                                                           file,
+                                                           line,
+                                                           column };
+
+                for (const auto &related : result["relatedLocations"].toArray()) {
+                    const auto [related_file, related_line, related_column] =
+                        physical_location(related);
+
+                    task.details.append(QString { "%1: %2" }.arg(
+                        location(related_file, related_line, related_column),
+                        related["message"]["text"].toString()));
+                }
+
+                tasks.append(std::move(task));
+            }
+        }
+
+        return tasks;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeStructuredDiagnostics::compilerFlags(Format format, const Utils::FilePath &log_dir)
+        -> QString {
+        switch (format) {
+            case Format::GCCJson: return QStringLiteral("-fdiagnostics-format=json");
+            case Format::Sarif:
+                // msvc 17.8 writes a log per translation unit, clang prints it on stderr
+                if (!log_dir.isEmpty())
+                    return QString { "/experimental:log%1" }.arg(log_dir.nativePath() +
+                                                                 QDir::separator());
+                return QStringLiteral("-fdiagnostics-format=sarif -Wno-sarif-format-unstable");
+            case Format::None: break;
+        }
+
+        return {};
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeStructuredDiagnostics::isDocument(QStringView line, Format format) noexcept
+        -> bool {
+        switch (format) {
+            case Format::GCCJson: return line.contains(QLatin1String { "[{\"kind\": " });
+            case Format::Sarif: return line.contains(QLatin1String { "{\"$schema\":" });
+            case Format::None: break;
+        }
+
+        return false;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeStructuredDiagnostics::decode(QStringView document,
+                                            Format format,
+                                            const Utils::FilePath &source_dir)
+        -> ProjectExplorer::Tasks {
+        // skips the "error: " xmake prints before the output of a failed compilation
+        const auto begin = document.indexOf((format == Format::GCCJson) ? '[' : '{');
+        if (begin == -1) return {};
+
+        const auto json = QJsonDocument::fromJson(document.mid(begin).toUtf8());
+
+        if (format == Format::GCCJson && json.isArray())
+            return decodeGCCJson(json.array(), source_dir);
+        if (format == Format::Sarif && json.isObject())
+            return decodeSarif(json.object(), source_dir);
+
+        return {};
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeStructuredDiagnostics::readLogs(const Utils::FilePath &log_dir,
+                                              const Utils::FilePath &source_dir)
+        -> ProjectExplorer::Tasks {
+        auto tasks = ProjectExplorer::Tasks {};
+
+        for (const auto &log : log_dir.dirEntries({ { "*.sarif" }, QDir::Files })) {
+            const auto contents = log.fileContents();
+            log.removeFile();
+
+            const auto json = QJsonDocument::fromJson(contents);
+            if (json.isObject()) tasks.append(decodeSarif(json.object(), source_dir));
+        }
+
+        return tasks;
+    }
+} // namespace XMakeProjectManager::Internal
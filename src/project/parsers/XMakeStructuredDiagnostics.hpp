@@ -0,0 +1,42 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <projectexplorer/task.h>
+
+#include <utils/filepath.h>
+
+#include <QStringList>
+
+namespace XMakeProjectManager::Internal {
+    // machine readable diagnostics the compilers write instead of their text output, decoded
+    // with their notes and related locations kept in the task details
+    class XMakeStructuredDiagnostics {
+      public:
+        enum class Format {
+            None,
+            // an array per translation unit on stderr, gcc -fdiagnostics-format=json
+            GCCJson,
+            // a SARIF log per translation unit, on stderr (clang) or in a side file (msvc)
+            Sarif
+        };
+
+        XMakeStructuredDiagnostics() = delete;
+
+        // compiler flags selecting the format, the msvc logs are written in log_dir
+        static QString compilerFlags(Format format, const Utils::FilePath &log_dir);
+
+        // a line of the build output holding a whole document, xmake may prefix it
+        static bool isDocument(QStringView line, Format format) noexcept;
+
+        static ProjectExplorer::Tasks decode(QStringView document,
+                                             Format format,
+                                             const Utils::FilePath &source_dir);
+
+        // decodes the side files of log_dir, removed once read
+        static ProjectExplorer::Tasks readLogs(const Utils::FilePath &log_dir,
+                                               const Utils::FilePath &source_dir);
+    };
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,62 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeTaskQueue.hpp"
+
+#include <projectexplorer/taskhub.h>
+
+namespace XMakeProjectManager::Internal {
+    // a diagnostic storm reaches the issues pane a few times per second instead of per line
+    static constexpr auto FLUSH_INTERVAL = 200;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeTaskQueue::XMakeTaskQueue() {
+        m_flush_timer.setSingleShot(true);
+        m_flush_timer.setInterval(FLUSH_INTERVAL);
+
+        connect(&m_flush_timer, &QTimer::timeout, this, &XMakeTaskQueue::submit);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeTaskQueue::~XMakeTaskQueue() { flush(); }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTaskQueue::add(ProjectExplorer::Task task) -> void {
+        // a header diagnostic is reported once per translation unit including it
+        const auto type = static_cast<int>(task.type);
+        const auto key = QString { "%1|%2|%3|%4|%5" }.arg(QString::number(type),
+                                                          task.file.toString(),
+                                                          QString::number(task.line),
+                                                          QString::number(task.column),
+                                                          task.description());
+        if (m_seen_tasks.contains(key)) return;
+        m_seen_tasks.insert(key);
+
+        m_pending_tasks.append(std::move(task));
+
+        if (!m_flush_timer.isActive()) m_flush_timer.start();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTaskQueue::flush() -> void {
+        submit();
+
+        m_seen_tasks.clear();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTaskQueue::submit() -> void {
+        m_flush_timer.stop();
+
+        auto tasks = std::move(m_pending_tasks);
+        m_pending_tasks.clear();
+
+        for (const auto &task : tasks) ProjectExplorer::TaskHub::addTask(task);
+    }
+} // namespace XMakeProjectManager::Internal
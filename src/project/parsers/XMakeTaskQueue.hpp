@@ -0,0 +1,45 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <projectexplorer/task.h>
+
+#include <QObject>
+#include <QSet>
+#include <QTimer>
+
+namespace XMakeProjectManager::Internal {
+    // collects the tasks of an output parser and hands them to the TaskHub in batches
+    class XMakeTaskQueue final: public QObject {
+        Q_OBJECT
+
+      public:
+        XMakeTaskQueue();
+        ~XMakeTaskQueue();
+
+        XMakeTaskQueue(XMakeTaskQueue &&)      = delete;
+        XMakeTaskQueue(const XMakeTaskQueue &) = delete;
+
+        XMakeTaskQueue &operator=(XMakeTaskQueue &&)      = delete;
+        XMakeTaskQueue &operator=(const XMakeTaskQueue &) = delete;
+
+        void add(ProjectExplorer::Task task);
+
+        // end of the parsed output, the next tasks are no longer duplicates of the previous ones
+        void flush();
+
+        [[nodiscard]] bool isEmpty() const noexcept;
+
+      private:
+        void submit();
+
+        QTimer m_flush_timer;
+
+        ProjectExplorer::Tasks m_pending_tasks;
+        QSet<QString> m_seen_tasks;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakeTaskQueue.inl"
@@ -0,0 +1,87 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeTestParser.hpp"
+
+#include <algorithm>
+
+namespace XMakeProjectManager::Internal {
+    static constexpr auto DURATIONS_REPORT_SIZE = 10;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto formatDuration(qint64 msecs) -> QString {
+        return QString { "%1 s" }.arg(static_cast<double>(msecs) / 1000., 8, 'f', 2);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeTestParser::XMakeTestParser() = default;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeTestParser::~XMakeTestParser() = default;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTestParser::handleLine(const QString &line, Utils::OutputFormat type) -> Result {
+        if (type != Utils::OutputFormat::StdOutFormat || !line.startsWith('['))
+            return ProjectExplorer::OutputTaskParser::Status::NotHandled;
+
+        const auto match = m_result_regex.match(line);
+        if (!match.hasMatch()) return ProjectExplorer::OutputTaskParser::Status::NotHandled;
+
+        Q_EMIT reportProgress(match.captured(1).toInt());
+
+        auto result = TestResult { match.captured(2),
+                                   match.captured(3),
+                                   static_cast<qint64>(match.captured(4).toDouble() * 1000.) };
+
+        if (result.status != QLatin1String { "passed" })
+            m_tasks.add(ProjectExplorer::CompileTask {
+                ProjectExplorer::Task::Error,
+                tr("Test %1 %2 after %3 s.")
+                    .arg(result.name, result.status)
+                    .arg(static_cast<double>(result.duration) / 1000., 0, 'f', 2),
+                m_test_files.value(result.name) });
+
+        m_results.push_back(std::move(result));
+
+        return ProjectExplorer::OutputTaskParser::Status::Done;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTestParser::flush() -> void {
+        m_tasks.flush();
+
+        if (m_results.empty()) return;
+
+        auto results = std::vector<const TestResult *> {};
+        results.reserve(std::size(m_results));
+        for (const auto &result : m_results) results.push_back(&result);
+
+        std::sort(std::begin(results), std::end(results), [](const auto *a, const auto *b) {
+            return a->duration > b->duration;
+        });
+
+        auto output = QStringList { tr("Slowest tests:") };
+
+        const auto count = std::min(std::size(results), std::size_t { DURATIONS_REPORT_SIZE });
+        for (auto i = 0u; i < count; ++i)
+            output << QString { "  %1  %2  %3" }.arg(formatDuration(results[i]->duration),
+                                                     results[i]->name,
+                                                     results[i]->status);
+
+        m_results.clear();
+
+        Q_EMIT reportDurations(output.join('\n'));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTestParser::setTestFiles(QHash<QString, Utils::FilePath> files) -> void {
+        m_test_files = std::move(files);
+    }
+} // namespace XMakeProjectManager::Internal
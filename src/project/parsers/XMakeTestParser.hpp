@@ -0,0 +1,57 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <project/parsers/XMakeTaskQueue.hpp>
+
+#include <projectexplorer/ioutputparser.h>
+
+#include <QHash>
+#include <QRegularExpression>
+
+#include <vector>
+
+namespace XMakeProjectManager::Internal {
+    // results of "xmake test", a task per failed test and the durations once it is over
+    class XMakeTestParser final: public ProjectExplorer::OutputTaskParser {
+        Q_OBJECT
+      public:
+        XMakeTestParser();
+        ~XMakeTestParser();
+
+        XMakeTestParser(XMakeTestParser &&)      = delete;
+        XMakeTestParser(const XMakeTestParser &) = delete;
+
+        XMakeTestParser &operator=(XMakeTestParser &&)      = delete;
+        XMakeTestParser &operator=(const XMakeTestParser &) = delete;
+
+        Result handleLine(const QString &line, Utils::OutputFormat type) override;
+        void flush() override;
+
+        // maps "target/test" to the xmake.lua declaring the test
+        void setTestFiles(QHash<QString, Utils::FilePath> files);
+
+      Q_SIGNALS:
+        void reportProgress(int progress);
+        void reportDurations(const QString &report);
+
+      private:
+        struct TestResult {
+            QString name;
+            QString status;
+            qint64 duration;
+        };
+
+        // [ 50%]: test_1/args .................................... passed 7.000s
+        const QRegularExpression m_result_regex {
+            R"(^\[\s*(\d+)%\]:\s+(\S+)\s+\.*\s*(passed|failed|not passed|timeout)\s+([\d.]+)s)"
+        };
+
+        QHash<QString, Utils::FilePath> m_test_files;
+        std::vector<TestResult> m_results;
+
+        XMakeTaskQueue m_tasks;
+    };
+} // namespace XMakeProjectManager::Internal
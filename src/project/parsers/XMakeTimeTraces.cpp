@@ -0,0 +1,155 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeTimeTraces.hpp"
+
+#include <XMakeProjectConstant.hpp>
+
+#include <QCoreApplication>
+#include <QDirIterator>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto formatDuration(qint64 usecs) -> QString {
+        return QString { "%1 s" }.arg(static_cast<double>(usecs) / 1000000., 8, 'f', 2);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTimeTraces::collect(const Utils::FilePaths &object_dirs, const QDateTime &since)
+        -> XMakeTimeTraces {
+        auto traces = XMakeTimeTraces {};
+
+        for (const auto &object_dir : object_dirs) {
+            // clang writes <object>.json next to each object file
+            auto it = QDirIterator { object_dir.toString(),
+                                     { QStringLiteral("*.json") },
+                                     QDir::Files,
+                                     QDirIterator::Subdirectories };
+
+            while (it.hasNext()) {
+                it.next();
+                if (it.fileInfo().lastModified() < since) continue;
+
+                auto file = QFile { it.filePath() };
+                if (file.open(QIODevice::ReadOnly)) traces.add(file.readAll());
+            }
+        }
+
+        return traces;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTimeTraces::add(const QByteArray &trace) -> void {
+        const auto json = QJsonDocument::fromJson(trace);
+        if (!json.isObject()) return;
+
+        const auto events = json["traceEvents"].toArray();
+        if (events.isEmpty()) return;
+
+        ++m_translation_units;
+
+        for (const auto &value : events) {
+            const auto event = value.toObject();
+
+            // complete events only, the totals and the metadata have another phase
+            if (event["ph"].toString() != QLatin1String { "X" }) continue;
+
+            const auto name = event["name"].toString();
+
+            auto *entries = [&]() -> QHash<QString, Entry> * {
+                if (name == QLatin1String { "Source" }) return &m_headers;
+                if (name == QLatin1String { "InstantiateClass" } ||
+                    name == QLatin1String { "InstantiateFunction" })
+                    return &m_instantiations;
+
+                return nullptr;
+            }();
+            if (!entries) continue;
+
+            const auto detail = event["args"]["detail"].toString();
+            if (detail.isEmpty()) continue;
+
+            auto &entry = (*entries)[detail];
+            entry.name  = detail;
+            entry.duration += event["dur"].toInteger();
+            ++entry.count;
+        }
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTimeTraces::sorted(const QHash<QString, Entry> &entries, int count)
+        -> std::vector<Entry> {
+        auto result = std::vector<Entry> { std::cbegin(entries), std::cend(entries) };
+
+        const auto size    = std::min(std::size(result), static_cast<std::size_t>(count));
+        const auto longest = [](const auto &a, const auto &b) { return a.duration > b.duration; };
+        const auto middle  = std::begin(result) + static_cast<std::ptrdiff_t>(size);
+
+        std::partial_sort(std::begin(result), middle, std::end(result), longest);
+        result.erase(middle, std::end(result));
+
+        return result;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTimeTraces::report(int count) const -> QString {
+        auto output = QStringList {
+            QCoreApplication::translate("XMakeTimeTraces",
+                                        "Compile time traces of %n translation unit(s):",
+                                        nullptr,
+                                        m_translation_units)
+        };
+
+        // a header included by a header is part of its parse time too
+        output << QCoreApplication::translate("XMakeTimeTraces", "Most expensive headers:");
+        for (const auto &entry : sorted(m_headers, count))
+            output << QCoreApplication::translate("XMakeTimeTraces", "  %1  %2 (%n time(s))",
+                                                  nullptr,
+                                                  entry.count)
+                          .arg(formatDuration(entry.duration), entry.name);
+
+        output << QCoreApplication::translate("XMakeTimeTraces",
+                                              "Most expensive template instantiations:");
+        for (const auto &entry : sorted(m_instantiations, count))
+            output << QCoreApplication::translate("XMakeTimeTraces", "  %1  %2 (%n time(s))",
+                                                  nullptr,
+                                                  entry.count)
+                          .arg(formatDuration(entry.duration), entry.name);
+
+        return output.join('\n');
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTimeTraces::tasks(int count) const -> ProjectExplorer::Tasks {
+        auto tasks = ProjectExplorer::Tasks {};
+
+        for (const auto &entry : sorted(m_headers, count)) {
+            tasks.append(ProjectExplorer::Task {
+                ProjectExplorer::Task::Unknown,
+                QCoreApplication::translate("XMakeTimeTraces",
+                                            "%1 spent parsing this header in %n translation "
+                                            "unit(s)",
+                                            nullptr,
+                                            entry.count)
+                    .arg(formatDuration(entry.duration).trimmed()),
+                Utils::FilePath::fromString(entry.name),
+                -1,
+                Constants::TASK_CATEGORY_COMPILE_TIMES });
+        }
+
+        return tasks;
+    }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,52 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <projectexplorer/task.h>
+
+#include <utils/filepath.h>
+
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+
+#include <vector>
+
+namespace XMakeProjectManager::Internal {
+    // merges the clang -ftime-trace files of a build, the time spent parsing each header and
+    // instantiating each template summed over all the translation units
+    class XMakeTimeTraces {
+      public:
+        XMakeTimeTraces() = default;
+
+        // reads the traces written after since in the object directories of the targets
+        static XMakeTimeTraces collect(const Utils::FilePaths &object_dirs,
+                                       const QDateTime &since);
+
+        void add(const QByteArray &trace);
+
+        [[nodiscard]] bool isEmpty() const noexcept;
+        int translationUnits() const noexcept;
+
+        QString report(int count) const;
+        // the most expensive headers, opened from the issues pane
+        ProjectExplorer::Tasks tasks(int count) const;
+
+      private:
+        struct Entry {
+            QString name;
+            qint64 duration = 0;
+            int count       = 0;
+        };
+
+        static std::vector<Entry> sorted(const QHash<QString, Entry> &entries, int count);
+
+        QHash<QString, Entry> m_headers;
+        QHash<QString, Entry> m_instantiations;
+        int m_translation_units = 0;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakeTimeTraces.inl"
@@ -0,0 +1,19 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeTimeTraces::isEmpty() const noexcept -> bool {
+        return m_translation_units == 0;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeTimeTraces::translationUnits() const noexcept -> int {
+        return m_translation_units;
+    }
+} // namespace XMakeProjectManager::Internal
@@ -6,6 +6,11 @@
 #include "utils/filepath.h"
 
 #include <QApplication>
+#include <QCryptographicHash>
+#include <QHash>
+
+#include <project/XMakeMimeTypeCache.hpp>
+#include <project/XMakeNodeTrace.hpp>
 
 #include <utils/algorithm.h>
 #include <utils/utilsicons.h>
@@ -18,6 +23,37 @@
 
 namespace XMakeProjectManager::Internal {
     static Q_LOGGING_CATEGORY(xmake_project_tree_log, "qtc.xmake.projecttree", QtDebugMsg);
+    // counting the nodes walks the whole tree, only done once enabled with
+    // QT_LOGGING_RULES=qtc.xmake.projecttree.summary.debug=true
+    static Q_LOGGING_CATEGORY(xmake_project_tree_summary_log,
+                              "qtc.xmake.projecttree.summary",
+                              QtInfoMsg);
+
+    struct TreeIcons {
+        QIcon c;
+        QIcon cpp;
+        QIcon header;
+    };
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto treeIcons() -> TreeIcons & {
+        static auto icons = TreeIcons {};
+
+        return icons;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto overlayFileIcon(const QPixmap &pixmap, const char *overlay) -> QIcon {
+        auto icon = QIcon {};
+        icon.addPixmap(Core::FileIconProvider::overlayIcon(pixmap, QIcon { overlay }));
+
+        return icon;
+    }
+
+    // group nodes by path, targets are attached to them without searching the whole tree
+    using GroupIndex = QHash<Utils::FilePath, ProjectExplorer::VirtualFolderNode *>;
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
@@ -52,7 +88,7 @@ namespace XMakeProjectManager::Internal {
         auto node = createVirtualNode(path, name);
         if (!node) return nullptr;
 
-        qCDebug(xmake_project_tree_log)
+        XMAKE_NODE_TRACE(xmake_project_tree_log)
             << QString { "Group node '%1' %2" }.arg(path.baseName(), node->path().toUserOutput());
         node->setIsSourcesOrHeaders(false);
         node->setListInProject(false);
@@ -69,7 +105,7 @@ namespace XMakeProjectManager::Internal {
         auto node = createVirtualNode(path, name);
         if (!node) return nullptr;
 
-        qCDebug(xmake_project_tree_log)
+        XMAKE_NODE_TRACE(xmake_project_tree_log)
             << QString { "Source Group node '%1' %2" }.arg(name, node->path().toUserOutput());
 
         node->setIsSourcesOrHeaders(true);
@@ -81,7 +117,7 @@ namespace XMakeProjectManager::Internal {
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto findOrCreateGroup(XMakeProjectNode *root, const QStringList &group)
+    auto findOrCreateGroup(XMakeProjectNode *root, const QStringList &group, GroupIndex &index)
         -> ProjectExplorer::VirtualFolderNode * {
         using FolderNodePtr = ProjectExplorer::FolderNode *;
 
@@ -95,11 +131,10 @@ namespace XMakeProjectManager::Internal {
             return path;
         }();
 
-        auto *node = root->findNode([&path](auto *node) { return node->filePath() == path; });
-        if (node) { return dynamic_cast<ProjectExplorer::VirtualFolderNode *>(node); }
+        if (auto it = index.constFind(path); it != std::cend(index)) return *it;
 
         auto parent =
-            FolderNodePtr { findOrCreateGroup(root, path.parentDir().toString().split('/')) };
+            FolderNodePtr { findOrCreateGroup(root, group.mid(0, group.size() - 1), index) };
         if (parent == nullptr) parent = root;
 
         auto group_node = createGroupNode(path, path.baseName());
@@ -107,108 +142,119 @@ namespace XMakeProjectManager::Internal {
         auto ptr = group_node.get();
 
         parent->addNode(std::move(group_node));
+        index.insert(path, ptr);
 
         return ptr;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto compressFolders(ProjectExplorer::VirtualFolderNode *node) -> void {
+        // merges the single child folder chains (src/a/b/c) into one node
+        for (auto *folder : node->folderNodes()) folder->compress();
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto buildTargetSourceTree(ProjectExplorer::VirtualFolderNode *node,
-                               const Target::SourceGroupList &sources) -> void {
-        auto pixmap =
-            QApplication::style()->standardIcon(QStyle::SP_FileIcon).pixmap(QSize { 16, 16 });
-        auto cpp_icon = QIcon {};
-        cpp_icon.addPixmap(
-            Core::FileIconProvider::overlayIcon(pixmap,
-                                                QIcon {
-                                                    ProjectExplorer::Constants::FILEOVERLAY_CPP }));
-        auto c_icon = QIcon {};
-        c_icon.addPixmap(
-            Core::FileIconProvider::overlayIcon(pixmap,
-                                                QIcon {
-                                                    ProjectExplorer::Constants::FILEOVERLAY_C }));
+                               const Target::SourceGroupList &sources,
+                               const PathTable &paths) -> void {
+        const auto &icons = treeIcons();
 
         for (const auto &group : sources) {
             for (const auto &filename : group.sources) {
-                if (filename.endsWith(".inl") || filename.endsWith(".hpp") ||
-                    filename.endsWith(".h") || filename.endsWith(".mpp") ||
-                    filename.endsWith(".hxx") || filename.endsWith(".tpp") ||
-                    filename.endsWith(".ixx"))
-                    continue;
+                if (XMakeMimeTypeCache::isHeaderOrModule(filename)) continue;
 
-                auto file = Utils::FilePath::fromString(filename).absoluteFilePath();
+                auto file = paths.filePath(filename).absoluteFilePath();
 
-                qCDebug(xmake_project_tree_log) << "Source node" << file.toUserOutput();
+                XMAKE_NODE_TRACE(xmake_project_tree_log)
+                    << "Source node" << file.toUserOutput();
                 auto source_node =
                     std::make_unique<ProjectExplorer::FileNode>(file,
                                                                 ProjectExplorer::FileType::Source);
 
-                if (file.endsWith(".cpp")) source_node->setIcon(cpp_icon);
-                if (file.endsWith(".c")) source_node->setIcon(c_icon);
+                const auto suffix = XMakeMimeTypeCache::suffix(filename);
+                if (suffix == QLatin1String { "cpp" }) source_node->setIcon(icons.cpp);
+                else if (suffix == QLatin1String { "c" })
+                    source_node->setIcon(icons.c);
 
                 node->addNestedNode(std::move(source_node), {}, [](const Utils::FilePath &fn) {
-                    qCDebug(xmake_project_tree_log) << "Folder node" << fn;
+                    XMAKE_NODE_TRACE(xmake_project_tree_log) << "Folder node" << fn;
                     return std::make_unique<ProjectExplorer::FolderNode>(fn);
                 });
             }
         }
+
+        compressFolders(node);
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto buildTargetModuleTree(ProjectExplorer::VirtualFolderNode *node,
-                               const Target::SourceGroupList &sources) -> void {
-        auto pixmap =
-            QApplication::style()->standardIcon(QStyle::SP_FileIcon).pixmap(QSize { 16, 16 });
-        auto cpp_icon = QIcon {};
-        cpp_icon.addPixmap(
-            Core::FileIconProvider::overlayIcon(pixmap,
-                                                QIcon {
-                                                    ProjectExplorer::Constants::FILEOVERLAY_CPP }));
+                               const Target::SourceGroupList &sources,
+                               const PathTable &paths) -> void {
+        const auto &icons = treeIcons();
+
         auto nodes = std::vector<std::unique_ptr<ProjectExplorer::FileNode>> {};
         for (const auto &group : sources) {
             for (const auto &filename : group.sources) {
-                auto file = Utils::FilePath::fromString(filename).absoluteFilePath();
+                auto file = paths.filePath(filename).absoluteFilePath();
 
-                qCDebug(xmake_project_tree_log) << "Module node" << filename;
+                XMAKE_NODE_TRACE(xmake_project_tree_log) << "Module node" << filename;
                 auto module_node =
                     std::make_unique<ProjectExplorer::FileNode>(file,
                                                                 ProjectExplorer::FileType::Source);
-                if (file.endsWith(".mpp")) module_node->setIcon(cpp_icon);
+                if (file.endsWith(".mpp")) module_node->setIcon(icons.cpp);
                 nodes.emplace_back(std::move(module_node));
             }
         }
 
         node->addNestedNodes(std::move(nodes));
 
-        for (auto *n : node->folderNodes()) n->compress();
+        compressFolders(node);
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto buildTargetHeaderTree(ProjectExplorer::VirtualFolderNode *node, const QStringList &headers)
-        -> void {
-        auto pixmap =
-            QApplication::style()->standardIcon(QStyle::SP_FileIcon).pixmap(QSize { 16, 16 });
-        auto icon = QIcon {};
-        icon.addPixmap(
-            Core::FileIconProvider::overlayIcon(pixmap,
-                                                QIcon {
-                                                    ProjectExplorer::Constants::FILEOVERLAY_H }));
+    auto buildTargetHeaderTree(ProjectExplorer::VirtualFolderNode *node,
+                               const QStringList &headers,
+                               const PathTable &paths) -> void {
+        const auto &icons = treeIcons();
 
         for (const auto &filename : headers) {
-            auto file = Utils::FilePath::fromString(filename).absoluteFilePath();
+            auto file = paths.filePath(filename).absoluteFilePath();
 
-            qCDebug(xmake_project_tree_log) << "Header node" << file.toUserOutput();
+            XMAKE_NODE_TRACE(xmake_project_tree_log) << "Header node" << file.toUserOutput();
             auto header_node =
                 std::make_unique<ProjectExplorer::FileNode>(file,
                                                             ProjectExplorer::FileType::Header);
-            header_node->setIcon(icon);
+            header_node->setIcon(icons.header);
             node->addNestedNode(std::move(header_node), {}, [](const Utils::FilePath &fn) {
-                qCDebug(xmake_project_tree_log) << "Folder node" << fn;
+                XMAKE_NODE_TRACE(xmake_project_tree_log) << "Folder node" << fn;
                 return std::make_unique<ProjectExplorer::FolderNode>(fn);
             });
         }
+
+        compressFolders(node);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto buildTargetFormTree(ProjectExplorer::VirtualFolderNode *node,
+                             const QStringList &forms,
+                             const PathTable &paths) -> void {
+        // the icon comes from the mime type, like the other files of the designer
+        for (const auto &filename : forms)
+            node->addNestedNode(
+                std::make_unique<ProjectExplorer::FileNode>(paths.filePath(filename)
+                                                                .absoluteFilePath(),
+                                                            ProjectExplorer::FileType::Form),
+                {},
+                [](const Utils::FilePath &fn) {
+                    return std::make_unique<ProjectExplorer::FolderNode>(fn);
+                });
+
+        compressFolders(node);
     }
 
     ////////////////////////////////////////////////////
@@ -226,38 +272,48 @@ namespace XMakeProjectManager::Internal {
         parent->setIsSourcesOrHeaders(false);
         parent->setListInProject(false);
 
-        for (const auto &dependency_list : { std::cref(packages), std::cref(frameworks) })
-            for (const auto &package : dependency_list.get()) {
-                auto node =
-                    std::make_unique<ProjectExplorer::FileNode>(path / package,
-                                                                ProjectExplorer::FileType::Unknown);
-                node->setIcon(QIcon { ProjectExplorer::Constants::FILEOVERLAY_MODULES });
-                node->setListInProject(false);
+        // the package status is filled by the build system, it changes while packages are fetched
+        for (const auto &package : packages) {
+            parent->addNode(std::make_unique<XMakePackageNode>(path / package, package));
 
-                parent->addNode(std::move(node));
+            XMAKE_NODE_TRACE(xmake_project_tree_log) << "Package node" << package;
+        }
 
-                qCDebug(xmake_project_tree_log) << "Package node" << package;
-            }
+        for (const auto &framework : frameworks) {
+            auto node =
+                std::make_unique<ProjectExplorer::FileNode>(path / framework,
+                                                            ProjectExplorer::FileType::Unknown);
+            node->setIcon(QIcon { ProjectExplorer::Constants::FILEOVERLAY_MODULES });
+            node->setListInProject(false);
+
+            parent->addNode(std::move(node));
+
+            XMAKE_NODE_TRACE(xmake_project_tree_log) << "Framework node" << framework;
+        }
 
         return parent;
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto addTargetNode(ProjectExplorer::FolderNode *root, const Target &target)
-        -> XMakeTargetNode * {
+    auto addTargetNode(ProjectExplorer::FolderNode *root,
+                       const Target &target,
+                       const PathTable &paths) -> XMakeTargetNode * {
         using XMakeTargetNodePtr = XMakeTargetNode *;
         auto *output_node        = XMakeTargetNodePtr { nullptr };
 
-        auto target_node =
-            std::make_unique<XMakeTargetNode>(Utils::FilePath::fromString(target.defined_in)
-                                                  .absolutePath(),
-                                              target.name,
-                                              fromXMakeKind(target.kind));
-        qCDebug(xmake_project_tree_log)
-            << "Target node " << target.name << " defined in"
-            << Utils::FilePath::fromString(target.defined_in).toUserOutput();
+        const auto defined_in = paths.filePath(target.defined_in);
+
+        auto target_node = std::make_unique<XMakeTargetNode>(defined_in.absolutePath(),
+                                                             target.name,
+                                                             fromXMakeKind(target.kind));
+        XMAKE_NODE_TRACE(xmake_project_tree_log)
+            << "Target node " << target.name << " defined in" << defined_in.toUserOutput();
         target_node->setDisplayName(target.name);
+        target_node->setBuildOptions(target.unity_batch_size,
+                                     target.precompiled_header.isEmpty()
+                                         ? Utils::FilePath {}
+                                         : paths.filePath(target.precompiled_header));
 
         output_node = target_node.get();
 
@@ -268,90 +324,173 @@ namespace XMakeProjectManager::Internal {
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    ProjectTree::ProjectTree() = default;
+    auto shrinkToCommonDirectory(QString &directory, QStringView path) -> void {
+        // directory always ends with a separator, only its length ever changes
+        const auto size = std::min(directory.size(), path.size());
+
+        auto common = decltype(size) { 0 };
+        while (common < size && directory[common] == path[common]) ++common;
+
+        if (common == directory.size()) return;
+
+        directory.truncate((common == 0) ? 0 : directory.lastIndexOf('/', common - 1) + 1);
+    }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto ProjectTree::buildTree(const Utils::FilePath &src_dir,
-                                const Utils::FilePath &project_dir,
-                                const TargetsList &targets,
-                                const std::vector<Utils::FilePath> &bs_files)
-        -> std::unique_ptr<XMakeProjectNode> {
-        using FolderNodePtr = ProjectExplorer::FolderNode *;
-        auto target_paths   = std::set<Utils::FilePath> {};
+    template<typename Resolve>
+    auto commonDirectory(const QStringList &files,
+                         const PathTable &paths,
+                         Utils::FilePath &first,
+                         QString &directory,
+                         Resolve &&resolve) -> void {
+        for (const auto &file : files) {
+            const auto path = resolve(paths.filePath(file));
+
+            if (first.isEmpty()) {
+                first     = path;
+                directory = path.path();
+                directory.truncate(directory.lastIndexOf('/') + 1);
+            } else
+                shrinkToCommonDirectory(directory, path.path());
+        }
+    }
 
-        auto project_node = std::make_unique<XMakeProjectNode>(src_dir);
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto toDirectory(const Utils::FilePath &first, QString directory) -> Utils::FilePath {
+        if (first.isEmpty()) return {};
 
-        qCDebug(xmake_project_tree_log) << targets.size() << "target(s) found";
-        for (const auto &target : targets) {
-            auto sources = target.sources;
+        if (directory.size() > 1 && directory.endsWith('/')) directory.chop(1);
 
-            auto root = FolderNodePtr { findOrCreateGroup(project_node.get(), target.group) };
-            if (root == nullptr) root = project_node.get();
+        return first.withNewPath(directory);
+    }
 
-            auto *parent = addTargetNode(root, target);
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto commonDirectory(const QStringList &files, const PathTable &paths) -> Utils::FilePath {
+        auto first     = Utils::FilePath {};
+        auto directory = QString {};
 
-            auto base_directory = Utils::FilePath {};
-            for (const auto &source_group : sources) {
-                for (const auto &source : source_group.sources) {
-                    const auto source_path = [&] {
-                        auto path = Utils::FilePath::fromString(source);
+        commonDirectory(files, paths, first, directory, [](const auto &path) { return path; });
 
-                        if (!path.isAbsolutePath())
-                            path = project_dir.resolvePath(Utils::FilePath::fromString(source));
+        return toDirectory(first, std::move(directory));
+    }
 
-                        return path;
-                    }();
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto commonDirectory(const Target::SourceGroupList &groups,
+                         const PathTable &paths,
+                         const Utils::FilePath &project_dir) -> Utils::FilePath {
+        auto first     = Utils::FilePath {};
+        auto directory = QString {};
+
+        for (const auto &group : groups)
+            commonDirectory(group.sources,
+                            paths,
+                            first,
+                            directory,
+                            [&project_dir](const Utils::FilePath &path) {
+                                return path.isAbsolutePath() ? path : project_dir.resolvePath(path);
+                            });
+
+        return toDirectory(first, std::move(directory));
+    }
 
-                    if (base_directory.isEmpty()) base_directory = source_path.parentDir();
-                    else
-                        base_directory = Utils::FileUtils::commonPath(base_directory, source_path);
-                }
-            }
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto addTargetFileGroups(XMakeTargetNode *parent,
+                             const Target &target,
+                             const Utils::FilePath &project_dir,
+                             const PathTable &paths) -> void {
+        auto node = createSourceGroupNode(commonDirectory(target.sources, paths, project_dir),
+                                          "Source Files");
+        if (node) {
+            buildTargetSourceTree(node.get(), target.sources, paths);
+            parent->addNode(std::move(node));
+        }
 
-            auto node = createSourceGroupNode(base_directory, "Source Files");
+        if (!target.modules.empty()) {
+            node = createSourceGroupNode(commonDirectory(target.modules, paths), "Module Files");
             if (node) {
-                buildTargetSourceTree(node.get(), sources);
+                buildTargetHeaderTree(node.get(), target.modules, paths);
                 parent->addNode(std::move(node));
             }
+        }
 
-            if (!target.modules.empty()) {
-                base_directory = Utils::FilePath {};
-                for (const auto &source : target.modules) {
-                    const auto source_path = Utils::FilePath::fromString(source);
+        if (!target.headers.empty()) {
+            node = createSourceGroupNode(commonDirectory(target.headers, paths), "Header Files");
+            if (node) {
+                buildTargetHeaderTree(node.get(), target.headers, paths);
+                parent->addNode(std::move(node));
+            }
+        }
 
-                    if (base_directory.isEmpty()) base_directory = source_path.parentDir();
-                    else
-                        base_directory = Utils::FileUtils::commonPath(base_directory, source_path);
-                }
+        auto forms = QStringList {};
+        for (const auto &generated : target.generated_files)
+            if (generated.kind == QLatin1String { "ui" }) forms.append(generated.source);
 
-                node = createSourceGroupNode(base_directory, "Module Files");
-                if (node) {
-                    buildTargetHeaderTree(node.get(), target.modules);
-                    parent->addNode(std::move(node));
-                }
+        if (!forms.empty()) {
+            node = createSourceGroupNode(commonDirectory(forms, paths), "Form Files");
+            if (node) {
+                buildTargetFormTree(node.get(), forms, paths);
+                parent->addNode(std::move(node));
             }
+        }
+    }
 
-            if (!target.headers.empty()) {
-                base_directory = Utils::FilePath {};
-                for (const auto &source : target.headers) {
-                    const auto source_path = Utils::FilePath::fromString(source);
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    ProjectTree::ProjectTree() = default;
 
-                    if (base_directory.isEmpty()) base_directory = source_path.parentDir();
-                    else
-                        base_directory = Utils::FileUtils::commonPath(base_directory, source_path);
-                }
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto ProjectTree::initializeIcons() -> void {
+        // QStyle is only usable from the GUI thread, the trees are built by a worker
+        const auto pixmap =
+            QApplication::style()->standardIcon(QStyle::SP_FileIcon).pixmap(QSize { 16, 16 });
 
-                node = createSourceGroupNode(base_directory, "Header Files");
-                if (node) {
-                    buildTargetHeaderTree(node.get(), target.headers);
-                    parent->addNode(std::move(node));
-                }
-            }
+        auto &icons  = treeIcons();
+        icons.c      = overlayFileIcon(pixmap, ProjectExplorer::Constants::FILEOVERLAY_C);
+        icons.cpp    = overlayFileIcon(pixmap, ProjectExplorer::Constants::FILEOVERLAY_CPP);
+        icons.header = overlayFileIcon(pixmap, ProjectExplorer::Constants::FILEOVERLAY_H);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto ProjectTree::buildTree(const Utils::FilePath &src_dir,
+                                const Utils::FilePath &project_dir,
+                                const TargetsList &targets,
+                                const std::vector<Utils::FilePath> &bs_files,
+                                const PathTable &paths,
+                                bool with_files,
+                                const std::function<bool()> &is_canceled)
+        -> std::unique_ptr<XMakeProjectNode> {
+        using FolderNodePtr = ProjectExplorer::FolderNode *;
+        auto target_paths   = std::set<Utils::FilePath> {};
+
+        auto project_node = std::make_unique<XMakeProjectNode>(src_dir);
+        auto groups       = GroupIndex {};
+
+        project_node->setFingerprint(fingerprint(src_dir, project_dir, targets, bs_files));
+        project_node->setPopulated(with_files);
+
+        qCDebug(xmake_project_tree_log) << targets.size() << "target(s) found";
+        for (const auto &target : targets) {
+            // a newer parse superseded this one, nobody will look at the tree
+            if (is_canceled && is_canceled()) return nullptr;
+
+            auto root =
+                FolderNodePtr { findOrCreateGroup(project_node.get(), target.group, groups) };
+            if (root == nullptr) root = project_node.get();
+
+            auto *parent = addTargetNode(root, target, paths);
+
+            if (with_files) addTargetFileGroups(parent, target, project_dir, paths);
 
             if (!(target.packages.empty() && target.frameworks.empty())) {
                 auto node =
-                    buildTargetExternalPackagesTree(Utils::FilePath::fromString(target.defined_in),
+                    buildTargetExternalPackagesTree(paths.filePath(target.defined_in),
                                                     target.name,
                                                     target.packages,
                                                     target.frameworks);
@@ -361,34 +500,117 @@ namespace XMakeProjectManager::Internal {
                 }
             }
 
-            target_paths.insert(Utils::FilePath::fromString(target.defined_in).absolutePath());
+            target_paths.insert(paths.filePath(target.defined_in).absolutePath());
         }
 
+        // first folder of each directory in tree order, as a search from the root would find
+        auto folders = QHash<Utils::FilePath, ProjectExplorer::FolderNode *> {};
+        folders.insert(project_node->filePath(), project_node.get());
+        project_node->forEachFolderNode([&folders](ProjectExplorer::FolderNode *folder) {
+            if (!folders.contains(folder->filePath())) folders.insert(folder->filePath(), folder);
+        });
+
         for (auto bs_file : bs_files) {
             if (!bs_file.toFileInfo().isAbsolute())
                 bs_file = src_dir.pathAppended(bs_file.toString());
 
-            project_node->findNode([&project_node, &bs_file](ProjectExplorer::Node *node) {
-                qCDebug(xmake_project_tree_log) << node->filePath();
-                if (node->filePath() == bs_file.absolutePath()) {
-                    auto *as_folder = dynamic_cast<ProjectExplorer::FolderNode *>(node);
-                    if (as_folder != nullptr) {
-                        auto project_file_node = std::make_unique<ProjectExplorer::FileNode>(
-                            bs_file.absoluteFilePath(),
-                            ProjectExplorer::FileType::Project);
-                        qCDebug(xmake_project_tree_log)
-                            << "Project file node " << bs_file.toUserOutput();
-
-                        as_folder->addNode(std::move(project_file_node));
-                    }
-
-                    return true;
-                }
+            auto *folder = folders.value(bs_file.absolutePath());
+            if (!folder) continue;
+
+            XMAKE_NODE_TRACE(xmake_project_tree_log)
+                << "Project file node " << bs_file.toUserOutput();
 
-                return false;
+            folder->addNode(std::make_unique<ProjectExplorer::FileNode>(
+                bs_file.absoluteFilePath(),
+                ProjectExplorer::FileType::Project));
+        }
+
+        if (xmake_project_tree_summary_log().isDebugEnabled()) {
+            auto folder_count = 0;
+            auto file_count   = 0;
+            project_node->forEachGenericNode([&](ProjectExplorer::Node *node) {
+                if (node->asFolderNode()) ++folder_count;
+                else
+                    ++file_count;
             });
+
+            qCDebug(xmake_project_tree_summary_log)
+                << "Tree built with" << folder_count << "folder(s) and" << file_count << "file(s)";
         }
 
         return project_node;
     }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto ProjectTree::fingerprint(const Utils::FilePath &src_dir,
+                                  const Utils::FilePath &project_dir,
+                                  const TargetsList &targets,
+                                  const std::vector<Utils::FilePath> &bs_files) -> QByteArray {
+        // covers everything buildTree reads from the targets
+        auto hash = QCryptographicHash { QCryptographicHash::Sha1 };
+
+        const auto add_list = [&hash](const QStringList &list) {
+            for (const auto &value : list) {
+                hash.addData(value.toUtf8());
+                hash.addData("\0", 1);
+            }
+            hash.addData("\1", 1);
+        };
+
+        add_list({ src_dir.toString(), project_dir.toString() });
+
+        for (const auto &target : targets) {
+            add_list({ target.name,
+                       target.defined_in,
+                       QString::number(static_cast<int>(target.kind)),
+                       QString::number(target.unity_batch_size),
+                       target.precompiled_header });
+            add_list(target.group);
+
+            for (const auto &group : target.sources) add_list(group.sources);
+
+            add_list(target.headers);
+            add_list(target.modules);
+            for (const auto &generated : target.generated_files) add_list({ generated.source });
+            add_list(target.packages);
+            add_list(target.frameworks);
+        }
+
+        for (const auto &bs_file : bs_files) add_list({ bs_file.toString() });
+
+        return hash.result();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto ProjectTree::isUpToDate(const ProjectExplorer::ProjectNode *current,
+                                 const XMakeProjectNode &tree) -> bool {
+        const auto *node = dynamic_cast<const XMakeProjectNode *>(current);
+        if (!node || node->fingerprint() != tree.fingerprint()) return false;
+
+        // a targets only tree never replaces the populated one
+        return node->isPopulated() || !tree.isPopulated();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto ProjectTree::updatePackageStatus(ProjectExplorer::FolderNode *root,
+                                          const PackageStatusMap &status) -> bool {
+        if (!root) return false;
+
+        auto changed = false;
+        root->forEachGenericNode([&status, &changed](ProjectExplorer::Node *node) {
+            auto *package_node = dynamic_cast<XMakePackageNode *>(node);
+            if (!package_node) return;
+
+            const auto new_status = status.value(package_node->name(), Package::Status::Unknown);
+            if (package_node->status() == new_status) return;
+
+            package_node->setStatus(new_status);
+            changed = true;
+        });
+
+        return changed;
+    }
 } // namespace XMakeProjectManager::Internal
@@ -10,15 +10,35 @@
 
 #include <utils/fileutils.h>
 
+#include <functional>
+
 namespace XMakeProjectManager::Internal {
     class ProjectTree {
       public:
         ProjectTree();
 
+        static void initializeIcons();
+
         static std::unique_ptr<XMakeProjectNode>
             buildTree(const Utils::FilePath &src_dir,
                       const Utils::FilePath &project_dir,
                       const TargetsList &targets,
-                      const std::vector<Utils::FilePath> &bs_files);
+                      const std::vector<Utils::FilePath> &bs_files,
+                      const PathTable &paths,
+                      bool with_files                          = true,
+                      const std::function<bool()> &is_canceled = {});
+
+        static QByteArray fingerprint(const Utils::FilePath &src_dir,
+                                      const Utils::FilePath &project_dir,
+                                      const TargetsList &targets,
+                                      const std::vector<Utils::FilePath> &bs_files);
+
+        // a tree with the same fingerprint would only replace current with identical nodes
+        static bool isUpToDate(const ProjectExplorer::ProjectNode *current,
+                               const XMakeProjectNode &tree);
+
+        // returns true when a package node of the tree changed
+        static bool updatePackageStatus(ProjectExplorer::FolderNode *root,
+                                        const PackageStatusMap &status);
     };
 } // namespace XMakeProjectManager::Internal
@@ -12,6 +12,8 @@
 #include <projectexplorer/projectexplorerconstants.h>
 #include <projectexplorer/target.h>
 
+#include <QCoreApplication>
+
 namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
@@ -68,17 +70,77 @@ namespace XMakeProjectManager::Internal {
         if (target)
             static_cast<XMakeBuildSystem *>(target->buildSystem())
                 ->xmakeBuildConfiguration()
-                ->build(m_name);
+                ->build({ m_name });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTargetNode::tooltip() const -> QString {
+        auto lines = QStringList {};
+
+        if (m_unity_batch_size == 0)
+            lines << QCoreApplication::translate("XMakeTargetNode", "Unity build: on");
+        else if (m_unity_batch_size > 0)
+            lines << QCoreApplication::translate("XMakeTargetNode",
+                                                 "Unity build: on, batches of %1 files")
+                         .arg(m_unity_batch_size);
+
+        if (!m_precompiled_header.isEmpty())
+            lines << QCoreApplication::translate("XMakeTargetNode", "Precompiled header: %1")
+                         .arg(m_precompiled_header.toUserOutput());
+
+        return lines.join('\n');
     }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto XMakeTargetNode::tooltip() const -> QString { return {}; }
+    auto XMakeTargetNode::setBuildOptions(int unity_batch_size, Utils::FilePath precompiled_header)
+        -> void {
+        m_unity_batch_size   = unity_batch_size;
+        m_precompiled_header = std::move(precompiled_header);
+    }
 
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeTargetNode::buildKey() const -> QString { return m_name; }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakePackageNode::XMakePackageNode(const Utils::FilePath &file, const QString &name)
+        : ProjectExplorer::FileNode { file, ProjectExplorer::FileType::Unknown }, m_name { name } {
+        setIcon(QIcon { ProjectExplorer::Constants::FILEOVERLAY_MODULES });
+        setListInProject(false);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakePackageNode::displayName() const -> QString {
+        const auto status = statusText(m_status);
+        if (status.isEmpty()) return m_name;
+
+        return QStringLiteral("%1 (%2)").arg(m_name, status);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakePackageNode::tooltip() const -> QString { return {}; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakePackageNode::statusText(Package::Status status) -> QString {
+        switch (status) {
+            case Package::Status::Cached: return QObject::tr("cached");
+            case Package::Status::Missing: return QObject::tr("not installed");
+            case Package::Status::Downloading: return QObject::tr("downloading");
+            case Package::Status::Building: return QObject::tr("building");
+            case Package::Status::Built: return QObject::tr("built");
+            case Package::Status::Failed: return QObject::tr("failed");
+            case Package::Status::Unknown: break;
+        }
+
+        return {};
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     XMakeFileNode::XMakeFileNode(const Utils::FilePath &file)
@@ -10,10 +10,24 @@
 
 #include <utils/fileutils.h>
 
+#include <xmakeinfoparser/XMakePackage.hpp>
+
 namespace XMakeProjectManager::Internal {
     class XMakeProjectNode final: public ProjectExplorer::ProjectNode {
       public:
         XMakeProjectNode(const Utils::FilePath &directory);
+
+        // identifies the targets and files the tree was built from
+        const QByteArray &fingerprint() const noexcept;
+        void setFingerprint(QByteArray fingerprint);
+
+        // false while only the target nodes are listed
+        bool isPopulated() const noexcept;
+        void setPopulated(bool populated) noexcept;
+
+      private:
+        QByteArray m_fingerprint;
+        bool m_populated = true;
     };
 
     class XMakeDependencyNode final: public ProjectExplorer::Node {
@@ -43,8 +57,37 @@ namespace XMakeProjectManager::Internal {
         QString tooltip() const override;
         QString buildKey() const override;
 
+        const QString &name() const noexcept;
+
+        // state of the unity build rule and of the precompiled header, as introspected
+        int unityBatchSize() const noexcept;
+        const Utils::FilePath &precompiledHeader() const noexcept;
+        void setBuildOptions(int unity_batch_size, Utils::FilePath precompiled_header);
+
+      private:
+        QString m_name;
+
+        int m_unity_batch_size = -1;
+        Utils::FilePath m_precompiled_header;
+    };
+
+    class XMakePackageNode final: public ProjectExplorer::FileNode {
+      public:
+        XMakePackageNode(const Utils::FilePath &file, const QString &name);
+
+        QString displayName() const override;
+        QString tooltip() const override;
+
+        const QString &name() const noexcept;
+
+        Package::Status status() const noexcept;
+        void setStatus(Package::Status status) noexcept;
+
+        static QString statusText(Package::Status status);
+
       private:
         QString m_name;
+        Package::Status m_status = Package::Status::Unknown;
     };
 
     class XMakeFileNode final: public ProjectExplorer::ProjectNode {
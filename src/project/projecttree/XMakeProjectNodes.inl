@@ -7,6 +7,58 @@
 #include "XMakeProjectNodes.hpp"
 
 namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProjectNode::fingerprint() const noexcept -> const QByteArray & {
+        return m_fingerprint;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProjectNode::setFingerprint(QByteArray fingerprint) -> void {
+        m_fingerprint = std::move(fingerprint);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProjectNode::isPopulated() const noexcept -> bool { return m_populated; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeProjectNode::setPopulated(bool populated) noexcept -> void {
+        m_populated = populated;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeTargetNode::name() const noexcept -> const QString & { return m_name; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeTargetNode::unityBatchSize() const noexcept -> int {
+        return m_unity_batch_size;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakeTargetNode::precompiledHeader() const noexcept -> const Utils::FilePath & {
+        return m_precompiled_header;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakePackageNode::name() const noexcept -> const QString & { return m_name; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakePackageNode::status() const noexcept -> Package::Status { return m_status; }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto XMakePackageNode::setStatus(Package::Status status) noexcept -> void {
+        m_status = status;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     inline auto XMakeFileNode::showInSimpleTree() const -> bool { return false; }
@@ -6,8 +6,18 @@
 
 #include <XMakeProjectConstant.hpp>
 
+#include <project/XMakeParseTimings.hpp>
+
+#include <coreplugin/icore.h>
+
 #include <utils/layoutbuilder.h>
 
+#include <QHeaderView>
+#include <QLocale>
+#include <QThread>
+#include <QTreeWidget>
+
+#include <algorithm>
 #include <unordered_map>
 
 namespace XMakeProjectManager::Internal {
@@ -16,6 +26,195 @@ namespace XMakeProjectManager::Internal {
     Settings::Settings() {
         setSettingsGroup("XMakeProjectManager");
         setAutoApply(false);
+
+        introspection_server.setSettingsKey(Constants::GeneralSettings::INTROSPECTION_SERVER_KEY);
+        introspection_server.setLabelText(tr("Keep an introspection process alive per project"));
+        introspection_server.setToolTip(
+            tr("Reuse a long-running xmake process to introspect projects instead of starting "
+               "a new one on each parse."));
+        introspection_server.setDefaultValue(true);
+        registerAspect(&introspection_server);
+
+        introspection_server_idle_timeout.setSettingsKey(
+            Constants::GeneralSettings::INTROSPECTION_SERVER_IDLE_TIMEOUT_KEY);
+        introspection_server_idle_timeout.setLabelText(tr("Stop idle introspection process after:"));
+        introspection_server_idle_timeout.setSuffix(tr(" min"));
+        introspection_server_idle_timeout.setRange(1, 120);
+        introspection_server_idle_timeout.setDefaultValue(10);
+        introspection_server_idle_timeout.setEnabler(&introspection_server);
+        registerAspect(&introspection_server_idle_timeout);
+
+        introspection_cache.setSettingsKey(Constants::GeneralSettings::INTROSPECTION_CACHE_KEY);
+        introspection_cache.setLabelText(tr("Load projects from the last introspection result"));
+        introspection_cache.setToolTip(
+            tr("Store the introspection result in the build directory and reuse it when the "
+               "project is opened again. When an xmake.lua file changed, the last result is "
+               "shown while the project is introspected again."));
+        introspection_cache.setDefaultValue(true);
+        registerAspect(&introspection_cache);
+
+        shared_introspection.setSettingsKey(Constants::GeneralSettings::SHARED_INTROSPECTION_KEY);
+        shared_introspection.setLabelText(
+            tr("Share the introspection between identical build configurations"));
+        shared_introspection.setToolTip(
+            tr("Reuse the targets introspected by another build configuration of the project "
+               "when both are configured the same way and none of the xmake.lua files changed."));
+        shared_introspection.setDefaultValue(true);
+        registerAspect(&shared_introspection);
+
+        introspection_streaming.setSettingsKey(
+            Constants::GeneralSettings::INTROSPECTION_STREAMING_KEY);
+        introspection_streaming.setLabelText(tr("Decode targets while xmake is running"));
+        introspection_streaming.setToolTip(
+            tr("Let xmake print each target as soon as it is introspected so that it is decoded "
+               "in parallel. When disabled, the whole project is written at once in the binary "
+               "CBOR format."));
+        introspection_streaming.setDefaultValue(true);
+        registerAspect(&introspection_streaming);
+
+        lazy_file_flags.setSettingsKey(Constants::GeneralSettings::LAZY_FILE_FLAGS_KEY);
+        lazy_file_flags.setLabelText(tr("Ask for the flags of a file when it is opened"));
+        lazy_file_flags.setToolTip(
+            tr("Only compute the flags of each group of sources while introspecting. The files "
+               "configured with their own flags get them from the introspection process once "
+               "they are opened in an editor."));
+        lazy_file_flags.setDefaultValue(false);
+        lazy_file_flags.setEnabler(&introspection_server);
+        registerAspect(&lazy_file_flags);
+
+        combined_configure.setSettingsKey(Constants::GeneralSettings::COMBINED_CONFIGURE_KEY);
+        combined_configure.setLabelText(tr("Configure and introspect in a single xmake run"));
+        combined_configure.setToolTip(
+            tr("Run the configuration from the introspection script instead of starting "
+               "\"xmake f\" first, the project is then only loaded once."));
+        combined_configure.setDefaultValue(true);
+        registerAspect(&combined_configure);
+
+        max_xmake_processes.setSettingsKey(Constants::GeneralSettings::MAX_XMAKE_PROCESSES_KEY);
+        max_xmake_processes.setLabelText(tr("Maximum concurrent xmake processes:"));
+        max_xmake_processes.setToolTip(
+            tr("Configure and introspection runs of all the opened projects beyond this number "
+               "wait for a running one to finish, the startup project is served first."));
+        max_xmake_processes.setRange(1, std::max(1, QThread::idealThreadCount()));
+        max_xmake_processes.setDefaultValue(std::max(1, QThread::idealThreadCount()));
+        registerAspect(&max_xmake_processes);
+
+        background_low_priority.setSettingsKey(
+            Constants::GeneralSettings::BACKGROUND_LOW_PRIORITY_KEY);
+        background_low_priority.setLabelText(tr("Run the reparses on file change at low priority"));
+        background_low_priority.setToolTip(
+            tr("Lower the OS priority of the introspections started because a project file "
+               "changed so that they don't slow down a running build. Parses started "
+               "explicitly keep the normal priority."));
+        background_low_priority.setDefaultValue(true);
+        registerAspect(&background_low_priority);
+
+        background_configure_low_priority.setSettingsKey(
+            Constants::GeneralSettings::BACKGROUND_CONFIGURE_LOW_PRIORITY_KEY);
+        background_configure_low_priority.setLabelText(tr("Lower the configure runs too"));
+        background_configure_low_priority.setToolTip(
+            tr("Also lower the priority of the configurations these reparses run, xmake may "
+               "then take longer to install the missing packages."));
+        background_configure_low_priority.setDefaultValue(false);
+        background_configure_low_priority.setEnabler(&background_low_priority);
+        registerAspect(&background_configure_low_priority);
+
+        compile_commands.setSettingsKey(Constants::GeneralSettings::COMPILE_COMMANDS_KEY);
+        compile_commands.setLabelText(tr("Write compile_commands.json to the build directory"));
+        compile_commands.setToolTip(
+            tr("Generate the compilation database used by clangd from the introspection result, "
+               "without running \"xmake project -k compile_commands\"."));
+        compile_commands.setDefaultValue(true);
+        registerAspect(&compile_commands);
+
+        compile_on_save.setSettingsKey(Constants::GeneralSettings::COMPILE_ON_SAVE_KEY);
+        compile_on_save.setLabelText(tr("Compile the saved source files"));
+        compile_on_save.setToolTip(
+            tr("Build the object file of a saved source at low priority with \"xmake build "
+               "--files\", the compiler diagnostics are listed in the issues without waiting for "
+               "the next build. Skipped while the project is built or parsed."));
+        compile_on_save.setDefaultValue(false);
+        registerAspect(&compile_on_save);
+
+        lazy_project_tree.setSettingsKey(Constants::GeneralSettings::LAZY_PROJECT_TREE_KEY);
+        lazy_project_tree.setLabelText(tr("Show the targets before listing their files"));
+        lazy_project_tree.setToolTip(
+            tr("Publish a project tree with only the targets as soon as the project is parsed, "
+               "their source, header and module files are added in the background."));
+        lazy_project_tree.setDefaultValue(false);
+        registerAspect(&lazy_project_tree);
+
+        package_prefetch.setSettingsKey(Constants::GeneralSettings::PACKAGE_PREFETCH_KEY);
+        package_prefetch.setLabelText(tr("Install the packages before configuring"));
+        package_prefetch.setToolTip(
+            tr("Run \"xmake require\" before \"xmake f\" while a package is missing, showing the "
+               "progress of each package. Only used when the xmake tool auto accepts "
+               "installation requests."));
+        package_prefetch.setDefaultValue(true);
+        registerAspect(&package_prefetch);
+
+        background_configure.setSettingsKey(Constants::GeneralSettings::BACKGROUND_CONFIGURE_KEY);
+        background_configure.setLabelText(
+            tr("Prepare the other build configurations in the background"));
+        background_configure.setToolTip(
+            tr("Configure and introspect the inactive build configurations at idle priority once "
+               "the active one is loaded, starting with the active ones of the other kits, so "
+               "that switching to them loads their stored introspection result."));
+        background_configure.setDefaultValue(false);
+        registerAspect(&background_configure);
+
+        background_configure_jobs.setSettingsKey(
+            Constants::GeneralSettings::BACKGROUND_CONFIGURE_JOBS_KEY);
+        background_configure_jobs.setLabelText(tr("Maximum background xmake processes:"));
+        background_configure_jobs.setRange(1, std::max(1, QThread::idealThreadCount()));
+        background_configure_jobs.setDefaultValue(1);
+        background_configure_jobs.setEnabler(&background_configure);
+        registerAspect(&background_configure_jobs);
+
+        shared_detection.setSettingsKey(Constants::GeneralSettings::SHARED_DETECTION_KEY);
+        shared_detection.setLabelText(
+            tr("Share the toolchain detection between the build directories"));
+        shared_detection.setToolTip(
+            tr("Keep the toolchain and program detection results of xmake in a cache shared by "
+               "the build directories using the same xmake tool and kit, so that a new build "
+               "directory doesn't probe the compilers, the SDKs or Qt again. Wiping a build "
+               "directory detects them again."));
+        shared_detection.setDefaultValue(false);
+        registerAspect(&shared_detection);
+
+        parse_timings_history.setSettingsKey(Constants::GeneralSettings::PARSE_TIMINGS_HISTORY_KEY);
+        parse_timings_history.setLabelText(tr("Parse runs kept:"));
+        parse_timings_history.setToolTip(
+            tr("Number of parses whose phase durations are listed below, they are also logged "
+               "in the qtc.xmake.timings category."));
+        parse_timings_history.setRange(1, 100);
+        parse_timings_history.setDefaultValue(10);
+        registerAspect(&parse_timings_history);
+
+        trace_export.setSettingsKey(Constants::GeneralSettings::TRACE_EXPORT_KEY);
+        trace_export.setLabelText(tr("Write trace files"));
+        trace_export.setToolTip(
+            tr("Write the phases of the last parse and the jobs of the last build as Chrome trace "
+               "events, to %1 and %2 in the build directory. Open them in Perfetto or "
+               "chrome://tracing.")
+                .arg(QString::fromLatin1(Constants::PARSE_TRACE),
+                     QString::fromLatin1(Constants::BUILD_TRACE)));
+        trace_export.setDefaultValue(false);
+        registerAspect(&trace_export);
+
+        record_fixtures.setSettingsKey(Constants::GeneralSettings::RECORD_FIXTURES_KEY);
+        record_fixtures.setLabelText(tr("Record the introspection results"));
+        record_fixtures.setToolTip(
+            tr("Keep a copy of the last %1 complete introspection documents in the "
+               "xmake-fixtures directory of the Qt Creator settings, with the project, build and "
+               "home directories replaced by placeholders, to replay the parse of real projects. "
+               "Setting %2 to a directory records them there even when this is off.")
+                .arg(Constants::MAX_FIXTURES)
+                .arg(QString::fromLatin1(Constants::FIXTURES_DIR_VARIABLE)));
+        record_fixtures.setDefaultValue(false);
+        registerAspect(&record_fixtures);
+
+        readSettings(Core::ICore::settings());
     }
 
     ////////////////////////////////////////////////////
@@ -26,6 +225,88 @@ namespace XMakeProjectManager::Internal {
         return &settings;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto createTimingsView(QWidget *parent) -> QTreeWidget * {
+        auto view = new QTreeWidget { parent };
+        view->setAlternatingRowColors(true);
+        view->setHeaderLabels({ GeneralSettingsPage::tr("Finished"),
+                                GeneralSettingsPage::tr("Project"),
+                                GeneralSettingsPage::tr("Spawn"),
+                                GeneralSettingsPage::tr("Configure"),
+                                GeneralSettingsPage::tr("Introspection"),
+                                GeneralSettingsPage::tr("Document"),
+                                GeneralSettingsPage::tr("Targets"),
+                                GeneralSettingsPage::tr("Tree"),
+                                GeneralSettingsPage::tr("Project Parts"),
+                                GeneralSettingsPage::tr("Code Model"),
+                                GeneralSettingsPage::tr("Payload"),
+                                GeneralSettingsPage::tr("Target Count"),
+                                GeneralSettingsPage::tr("File Count"),
+                                GeneralSettingsPage::tr("Memory") });
+        view->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+
+        const auto update = [view] {
+            const auto phase = [](qint64 duration) {
+                return duration < 0 ? QString { "-" }
+                                    : GeneralSettingsPage::tr("%1 ms").arg(duration);
+            };
+
+            view->clear();
+
+            // most recent first
+            const auto &runs = XMakeParseTimings::instance().runs();
+            for (auto it = std::crbegin(runs); it != std::crend(runs); ++it) {
+                auto project = it->project;
+                if (it->cached) project += GeneralSettingsPage::tr(" (cached)");
+
+                auto item = new QTreeWidgetItem { view,
+                                                  { it->finished_at.time().toString(),
+                                                    project,
+                                                    phase(it->spawn),
+                                                    phase(it->configure),
+                                                    phase(it->introspection),
+                                                    phase(it->document),
+                                                    phase(it->targets),
+                                                    phase(it->tree),
+                                                    phase(it->project_parts),
+                                                    phase(it->code_model),
+                                                    QLocale {}.formattedDataSize(it->payload_size),
+                                                    QString::number(it->target_count),
+                                                    QString::number(it->file_count),
+                                                    QLocale {}.formattedDataSize(
+                                                        it->memory.total()) } };
+                item->setToolTip(13, it->memory.toString());
+
+                // the slowest targets of the introspection are listed under their run
+                for (const auto &target : it->slowest_targets) {
+                    const auto duration = [](double value) {
+                        return GeneralSettingsPage::tr("%1 ms").arg(value, 0, 'f', 1);
+                    };
+
+                    auto child = new QTreeWidgetItem { item };
+                    child->setText(1, target.name);
+                    child->setText(4, duration(target.total));
+                    child->setToolTip(
+                        1,
+                        GeneralSettingsPage::tr("Source batches: %1\nCompiler flags: %2\n"
+                                                "Run environment: %3")
+                            .arg(duration(target.source_batches),
+                                 duration(target.compile_flags),
+                                 duration(target.run_envs)));
+                }
+            }
+        };
+
+        QObject::connect(&XMakeParseTimings::instance(),
+                         &XMakeParseTimings::recorded,
+                         view,
+                         update);
+        update();
+
+        return view;
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     GeneralSettingsPage::GeneralSettingsPage() {
@@ -40,7 +321,49 @@ namespace XMakeProjectManager::Internal {
         setLayouter([](auto *widget) {
             auto &settings = *Settings::instance();
 
-            Utils::Layouting::Column { Utils::Layouting::Stretch {} }.attachTo(widget);
+            using namespace Utils::Layouting;
+
+            Column { Group { Title { tr("Introspection") },
+                             Form { settings.introspection_server,
+                                    Break {},
+                                    settings.introspection_server_idle_timeout,
+                                    Break {},
+                                    settings.introspection_cache,
+                                    Break {},
+                                    settings.shared_introspection,
+                                    Break {},
+                                    settings.introspection_streaming,
+                                    Break {},
+                                    settings.lazy_file_flags,
+                                    Break {},
+                                    settings.combined_configure,
+                                    Break {},
+                                    settings.max_xmake_processes,
+                                    Break {},
+                                    settings.background_low_priority,
+                                    Break {},
+                                    settings.background_configure_low_priority } },
+                     Group { Title { tr("Code Model") },
+                             Form { settings.compile_commands,
+                                    Break {},
+                                    settings.compile_on_save } },
+                     Group { Title { tr("Project Tree") }, Form { settings.lazy_project_tree } },
+                     Group { Title { tr("Packages") }, Form { settings.package_prefetch } },
+                     Group { Title { tr("Build Configurations") },
+                             Form { settings.background_configure,
+                                    Break {},
+                                    settings.background_configure_jobs,
+                                    Break {},
+                                    settings.shared_detection } },
+                     Group { Title { tr("Parse Timings") },
+                             Column { Form { settings.parse_timings_history,
+                                             Break {},
+                                             settings.trace_export,
+                                             Break {},
+                                             settings.record_fixtures },
+                                      createTimingsView(widget) } },
+                     Stretch {} }
+                .attachTo(widget);
         });
     }
 
@@ -16,7 +16,26 @@ namespace XMakeProjectManager::Internal {
 
         static Settings *instance();
 
-      private:
+        Utils::BoolAspect introspection_server;
+        Utils::IntegerAspect introspection_server_idle_timeout;
+        Utils::BoolAspect introspection_cache;
+        Utils::BoolAspect shared_introspection;
+        Utils::BoolAspect introspection_streaming;
+        Utils::BoolAspect lazy_file_flags;
+        Utils::BoolAspect combined_configure;
+        Utils::IntegerAspect max_xmake_processes;
+        Utils::BoolAspect background_low_priority;
+        Utils::BoolAspect background_configure_low_priority;
+        Utils::BoolAspect compile_commands;
+        Utils::BoolAspect compile_on_save;
+        Utils::BoolAspect lazy_project_tree;
+        Utils::BoolAspect package_prefetch;
+        Utils::BoolAspect background_configure;
+        Utils::IntegerAspect background_configure_jobs;
+        Utils::BoolAspect shared_detection;
+        Utils::IntegerAspect parse_timings_history;
+        Utils::BoolAspect trace_export;
+        Utils::BoolAspect record_fixtures;
     };
 
     class GeneralSettingsPage final: public Core::IOptionsPage {
@@ -23,6 +23,14 @@ namespace XMakeProjectManager::Internal {
         setDescription(tr("The XMake tool to use when building a project with XMake.<br>"
                           "This setting is ignored when using other build systems."));
         setPriority(9000);
+
+        // the kits are restored before the tools are needed, the ones without a tool get the
+        // detected one once it is known
+        const auto setup_kits = [this] {
+            for (auto *kit : ProjectExplorer::KitManager::kits()) setup(kit);
+        };
+        connect(&XMakeTools::instance(), &XMakeTools::toolsLoaded, this, setup_kits);
+        connect(&XMakeTools::instance(), &XMakeTools::toolAdded, this, setup_kits);
     }
 
     ////////////////////////////////////////////////////
@@ -31,6 +39,9 @@ namespace XMakeProjectManager::Internal {
         -> ProjectExplorer::Tasks {
         auto tasks = ProjectExplorer::Tasks {};
 
+        // validating every kit at startup doesn't restore the tools
+        if (!XMakeTools::isLoaded()) return tasks;
+
         const auto tool = xmakeTool(kit);
 
         if (tool && !tool->isValid())
@@ -43,6 +54,8 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto XMakeToolKitAspect::setup(ProjectExplorer::Kit *kit) -> void {
+        if (!XMakeTools::isLoaded()) return;
+
         const auto tool = xmakeTool(kit);
 
         if (!tool) {
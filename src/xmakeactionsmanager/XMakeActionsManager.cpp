@@ -4,20 +4,43 @@
 
 #include "XMakeActionsManager.hpp"
 
+#include <XMakeProjectConstant.hpp>
+#include <project/XMakeBuildConfiguration.hpp>
 #include <project/XMakeBuildSystem.hpp>
 #include <project/projecttree/XMakeProjectNodes.hpp>
 
 #include <coreplugin/actionmanager/actioncontainer.h>
 #include <coreplugin/actionmanager/actionmanager.h>
 #include <coreplugin/coreconstants.h>
+#include <coreplugin/editormanager/editormanager.h>
+#include <coreplugin/icore.h>
+#include <coreplugin/messagemanager.h>
+#include <coreplugin/idocument.h>
 
+#include <cppeditor/cppeditorconstants.h>
+
+#include <projectexplorer/buildmanager.h>
 #include <projectexplorer/projectexplorer.h>
 #include <projectexplorer/projectexplorerconstants.h>
 #include <projectexplorer/projecttree.h>
+#include <projectexplorer/session.h>
+#include <projectexplorer/target.h>
 
+#include <utils/fileutils.h>
+#include <utils/hostosinfo.h>
 #include <utils/parameteraction.h>
 
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QFormLayout>
+#include <QInputDialog>
+#include <QListWidget>
+#include <QSpinBox>
 #include <QStringLiteral>
+#include <QThread>
+
+#include <algorithm>
+#include <tuple>
 
 namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
@@ -27,7 +50,18 @@ namespace XMakeProjectManager::Internal {
                                                                    "Configure") },
           m_build_target_context_action { tr("Build"),
                                           tr("Build \"%1\""),
-                                          Utils::ParameterAction::AlwaysEnabled } {
+                                          Utils::ParameterAction::AlwaysEnabled },
+          m_enable_unity_build_action { tr("Enable Unity Build...") },
+          m_disable_unity_build_action { tr("Disable Unity Build") },
+          m_set_pch_action { tr("Set Precompiled Header...") },
+          m_clear_pch_action { tr("Clear Precompiled Header") },
+          m_compile_file_action { tr("Compile Current File"),
+                                  tr("Compile \"%1\""),
+                                  Utils::ParameterAction::AlwaysEnabled },
+          m_build_matrix_action { tr("Build Matrix...") },
+          m_profile_action { tr("Profile Target"),
+                             tr("Profile \"%1\""),
+                             Utils::ParameterAction::AlwaysEnabled } {
         const auto global_context  = Core::Context { Core::Constants::C_GLOBAL };
         const auto project_context = Core::Context { Constants::Project::ID };
 
@@ -80,6 +114,319 @@ namespace XMakeProjectManager::Internal {
                 }
             });
         }
+
+        {
+            // kept with the active build configuration, xmake.lua is left untouched
+            // action, id, unity build or precompiled header, set or clear
+            const auto actions = {
+                std::tuple { &m_enable_unity_build_action, "XMake.EnableUnity", true, true },
+                std::tuple { &m_disable_unity_build_action, "XMake.DisableUnity", true, false },
+                std::tuple { &m_set_pch_action, "XMake.SetPch", false, true },
+                std::tuple { &m_clear_pch_action, "XMake.ClearPch", false, false },
+            };
+
+            for (const auto &[action, id, unity_build, enable] : actions) {
+                auto *command = Core::ActionManager::registerAction(action, id, project_context);
+                command->setAttribute(Core::Command::CA_Hide);
+
+                m_subproject->addAction(command, ProjectExplorer::Constants::G_PROJECT_BUILD);
+
+                connect(action,
+                        &QAction::triggered,
+                        this,
+                        [this, unity_build = unity_build, enable = enable] {
+                            setTargetOptions(unity_build, enable);
+                        });
+            }
+        }
+
+        {
+            auto *command = Core::ActionManager::registerAction(&m_compile_file_action,
+                                                                "XMake.CompileCurrentFile",
+                                                                project_context);
+
+            command->setAttribute(Core::Command::CA_UpdateText);
+            command->setDescription(m_compile_file_action.text());
+            command->setDefaultKeySequence(QKeySequence { tr("Ctrl+Alt+B") });
+
+            Core::ActionManager::actionContainer(ProjectExplorer::Constants::M_BUILDPROJECT)
+                ->addAction(command, ProjectExplorer::Constants::G_BUILD_BUILD);
+
+            if (auto *editor_menu =
+                    Core::ActionManager::actionContainer(CppEditor::Constants::M_CONTEXT))
+                editor_menu->addAction(command);
+
+            connect(Core::EditorManager::instance(),
+                    &Core::EditorManager::currentEditorChanged,
+                    this,
+                    &XMakeActionsManager::updateCompileFileAction);
+            connect(ProjectExplorer::ProjectTree::instance(),
+                    &ProjectExplorer::ProjectTree::currentProjectChanged,
+                    this,
+                    &XMakeActionsManager::updateCompileFileAction);
+
+            connect(&m_compile_file_action,
+                    &Utils::ParameterAction::triggered,
+                    this,
+                    &XMakeActionsManager::compileCurrentFile);
+
+            updateCompileFileAction();
+        }
+
+        {
+            auto *command = Core::ActionManager::registerAction(&m_build_matrix_action,
+                                                                "XMake.BuildMatrix",
+                                                                project_context);
+
+            command->setDescription(tr("Build several build configurations at the same time"));
+
+            Core::ActionManager::actionContainer(ProjectExplorer::Constants::M_BUILDPROJECT)
+                ->addAction(command, ProjectExplorer::Constants::G_BUILD_BUILD);
+
+            connect(&m_build_matrix_action,
+                    &QAction::triggered,
+                    this,
+                    &XMakeActionsManager::buildMatrix);
+            connect(&m_build_matrix, &XMakeBuildMatrix::finished, this, [this] {
+                m_build_matrix_action.setEnabled(true);
+            });
+        }
+
+        {
+            auto *command = Core::ActionManager::registerAction(&m_profile_action,
+                                                                "XMake.ProfileRunConfiguration",
+                                                                project_context);
+
+            command->setAttribute(Core::Command::CA_UpdateText);
+            command->setDescription(m_profile_action.text());
+
+            Core::ActionManager::actionContainer(ProjectExplorer::Constants::M_BUILDPROJECT)
+                ->addAction(command, ProjectExplorer::Constants::G_BUILD_RUN);
+
+            connect(ProjectExplorer::ProjectExplorerPlugin::instance(),
+                    &ProjectExplorer::ProjectExplorerPlugin::updateRunActions,
+                    this,
+                    &XMakeActionsManager::updateProfileAction);
+
+            connect(&m_profile_action,
+                    &Utils::ParameterAction::triggered,
+                    this,
+                    &XMakeActionsManager::profileRunConfiguration);
+
+            updateProfileAction();
+        }
+    }
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto currentFileBuildSystem(Utils::FilePath &file) -> XMakeBuildSystem * {
+        const auto *document = Core::EditorManager::currentDocument();
+        if (!document) return nullptr;
+
+        file = document->filePath();
+
+        auto *project = ProjectExplorer::SessionManager::projectForFile(file);
+        auto *target  = project ? project->activeTarget() : nullptr;
+
+        return target ? qobject_cast<XMakeBuildSystem *>(target->buildSystem()) : nullptr;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeActionsManager::compileCurrentFile() -> void {
+        auto file = Utils::FilePath {};
+        auto *bs  = currentFileBuildSystem(file);
+        QTC_ASSERT(bs, return );
+
+        const auto target = bs->targetForSource(file);
+        if (target.isEmpty()) return;
+
+        if (!ProjectExplorer::ProjectExplorerPlugin::saveModifiedFiles()) return;
+
+        const auto project_dir = bs->projectDirectory();
+        const auto source =
+            file.isChildOf(project_dir) ? file.relativeChildPath(project_dir) : file;
+
+        bs->xmakeBuildConfiguration()->build({ target }, { source.toString() });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeActionsManager::updateCompileFileAction() -> void {
+        auto file      = Utils::FilePath {};
+        const auto *bs = currentFileBuildSystem(file);
+
+        // only the sources of a target can be compiled on their own
+        const auto compilable = bs && !bs->targetForSource(file).isEmpty();
+
+        m_compile_file_action.setParameter(compilable ? file.fileName() : QString {});
+        m_compile_file_action.setEnabled(compilable);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto selectConfigurations(const QList<XMakeBuildConfiguration *> &configurations,
+                                     int &jobs) -> QList<XMakeBuildConfiguration *> {
+        auto dialog = QDialog { Core::ICore::dialogParent() };
+        dialog.setWindowTitle(XMakeActionsManager::tr("Build Matrix"));
+
+        auto *list = new QListWidget { &dialog };
+        for (auto *configuration : configurations) {
+            auto *item = new QListWidgetItem { configuration->displayName(), list };
+            item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+            item->setCheckState(Qt::Checked);
+        }
+
+        auto *jobs_box = new QSpinBox { &dialog };
+        jobs_box->setRange(1, 1024);
+        jobs_box->setValue(QThread::idealThreadCount());
+        jobs_box->setToolTip(
+            XMakeActionsManager::tr("Shared between the configurations built at the same time."));
+
+        auto *buttons =
+            new QDialogButtonBox { QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dialog };
+        QObject::connect(buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+        QObject::connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+
+        auto *layout = new QFormLayout { &dialog };
+        layout->addRow(XMakeActionsManager::tr("Build configurations:"), list);
+        layout->addRow(XMakeActionsManager::tr("Parallel jobs:"), jobs_box);
+        layout->addRow(buttons);
+
+        if (dialog.exec() != QDialog::Accepted) return {};
+
+        jobs = jobs_box->value();
+
+        auto selected = QList<XMakeBuildConfiguration *> {};
+        for (auto i = 0; i < list->count(); ++i)
+            if (list->item(i)->checkState() == Qt::Checked) selected.append(configurations[i]);
+
+        return selected;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeActionsManager::buildMatrix() -> void {
+        auto *project = ProjectExplorer::ProjectTree::currentProject();
+        if (!project) project = ProjectExplorer::SessionManager::startupProject();
+
+        auto *target = project ? project->activeTarget() : nullptr;
+        QTC_ASSERT(target, return );
+
+        // the foreground build writes to the config directory of the active configuration
+        if (ProjectExplorer::BuildManager::isBuilding(project)) return;
+
+        auto configurations = QList<XMakeBuildConfiguration *> {};
+        for (auto *configuration : target->buildConfigurations())
+            if (auto *xmake_configuration = qobject_cast<XMakeBuildConfiguration *>(configuration))
+                configurations.append(xmake_configuration);
+
+        auto jobs           = 0;
+        const auto selected = selectConfigurations(configurations, jobs);
+        if (selected.isEmpty()) return;
+
+        if (!ProjectExplorer::ProjectExplorerPlugin::saveModifiedFiles()) return;
+
+        m_build_matrix_action.setEnabled(false);
+        m_build_matrix.start(selected, jobs);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto profiledRunConfiguration() -> ProjectExplorer::RunConfiguration * {
+        auto *project = ProjectExplorer::SessionManager::startupProject();
+        auto *target  = project ? project->activeTarget() : nullptr;
+        if (!target) return nullptr;
+
+        const auto *build_configuration =
+            qobject_cast<XMakeBuildConfiguration *>(target->activeBuildConfiguration());
+        if (!build_configuration || build_configuration->xmakeType() != XMakeBuildType::Profile)
+            return nullptr;
+
+        // the xmake run configurations are only created for the binary targets
+        auto *run_configuration = target->activeRunConfiguration();
+        if (!run_configuration ||
+            !run_configuration->id().name().startsWith(Constants::XMAKE_RUN_CONFIG_ID))
+            return nullptr;
+
+        return run_configuration;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeActionsManager::profileRunConfiguration() -> void {
+        auto *run_configuration = profiledRunConfiguration();
+        QTC_ASSERT(run_configuration, return );
+
+        // the performance analyzer only records with perf, there is no xperf or ETW support
+        if (!Utils::HostOsInfo::isLinuxHost()) {
+            Core::MessageManager::writeFlashing(
+                tr("Profiling needs perf, which is only available on Linux hosts."));
+            return;
+        }
+
+        ProjectExplorer::ProjectExplorerPlugin::runRunConfiguration(
+            run_configuration,
+            ProjectExplorer::Constants::PERFPROFILER_RUN_MODE,
+            true);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeActionsManager::updateProfileAction() -> void {
+        const auto *run_configuration = profiledRunConfiguration();
+
+        m_profile_action.setParameter(run_configuration ? run_configuration->displayName()
+                                                        : QString {});
+        m_profile_action.setEnabled(run_configuration &&
+                                    !ProjectExplorer::BuildManager::isBuilding());
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeActionsManager::setTargetOptions(bool unity_build, bool enable) -> void {
+        auto *bs =
+            qobject_cast<XMakeBuildSystem *>(ProjectExplorer::ProjectTree::currentBuildSystem());
+        const auto *target_node =
+            dynamic_cast<const XMakeTargetNode *>(ProjectExplorer::ProjectTree::currentNode());
+        QTC_ASSERT(bs && target_node, return );
+
+        auto *build_configuration = bs->xmakeBuildConfiguration();
+
+        auto options = build_configuration->targetOptions(target_node->name());
+
+        if (unity_build && enable) {
+            auto ok         = false;
+            const auto size = QInputDialog::getInt(
+                Core::ICore::dialogParent(),
+                tr("Unity Build"),
+                tr("Number of files merged per unit of %1, 0 for the xmake default:")
+                    .arg(target_node->name()),
+                std::max(target_node->unityBatchSize(), 0),
+                0,
+                1024,
+                1,
+                &ok);
+            if (!ok) return;
+
+            options.unity_batch_size = size;
+        } else if (unity_build)
+            options.unity_batch_size = -1;
+        else if (enable) {
+            const auto header = Utils::FileUtils::getOpenFilePath(
+                nullptr,
+                tr("Precompiled Header of %1").arg(target_node->name()),
+                target_node->precompiledHeader().isEmpty() ? bs->projectDirectory()
+                                                           : target_node->precompiledHeader(),
+                tr("Headers (*.h *.hh *.hpp *.hxx *.h++)"));
+            if (header.isEmpty()) return;
+
+            options.precompiled_header = header;
+        } else
+            options.precompiled_header = {};
+
+        build_configuration->setTargetOptions(target_node->name(), options);
     }
 
     ////////////////////////////////////////////////////
@@ -102,5 +449,17 @@ namespace XMakeProjectManager::Internal {
         m_build_target_context_action.setParameter(target_display_name);
         m_build_target_context_action.setEnabled(target_node);
         m_build_target_context_action.setVisible(target_node);
+
+        const auto *bs =
+            qobject_cast<XMakeBuildSystem *>(ProjectExplorer::ProjectTree::currentBuildSystem());
+        const auto options = (target_node && bs)
+                                 ? bs->xmakeBuildConfiguration()->targetOptions(target_node->name())
+                                 : XMakeTargetOptions {};
+
+        // only the options set from Qt Creator can be cleared, not the ones of xmake.lua
+        m_enable_unity_build_action.setVisible(target_node && bs);
+        m_disable_unity_build_action.setVisible(options.unity_batch_size >= 0);
+        m_set_pch_action.setVisible(target_node && bs);
+        m_clear_pch_action.setVisible(!options.precompiled_header.isEmpty());
     }
 } // namespace XMakeProjectManager::Internal
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <project/XMakeBuildMatrix.hpp>
+
 #include <utils/parameteraction.h>
 
 namespace XMakeProjectManager::Internal {
@@ -16,9 +18,24 @@ namespace XMakeProjectManager::Internal {
       private:
         void configureCurrentProject();
         void updateContextActions();
+        void compileCurrentFile();
+        void updateCompileFileAction();
+        void buildMatrix();
+        void profileRunConfiguration();
+        void updateProfileAction();
+        void setTargetOptions(bool unity_build, bool enable);
 
         QAction m_configure_action_context_menu;
         QAction m_configure_action_menu;
         Utils::ParameterAction m_build_target_context_action;
+        QAction m_enable_unity_build_action;
+        QAction m_disable_unity_build_action;
+        QAction m_set_pch_action;
+        QAction m_clear_pch_action;
+        Utils::ParameterAction m_compile_file_action;
+        QAction m_build_matrix_action;
+        Utils::ParameterAction m_profile_action;
+
+        XMakeBuildMatrix m_build_matrix;
     };
 } // namespace XMakeProjectManager::Internal
@@ -0,0 +1,166 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeTargetLocatorFilter.hpp"
+
+#include <XMakeProjectConstant.hpp>
+
+#include <project/XMakeBuildConfiguration.hpp>
+#include <project/XMakeBuildSystem.hpp>
+
+#include <projectexplorer/project.h>
+#include <projectexplorer/projectexplorer.h>
+#include <projectexplorer/projectexplorerconstants.h>
+#include <projectexplorer/runconfiguration.h>
+#include <projectexplorer/session.h>
+#include <projectexplorer/target.h>
+
+#include <QRegularExpression>
+
+#include <algorithm>
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto buildSystem(const Utils::FilePath &project_file) -> XMakeBuildSystem * {
+        auto *project = ProjectExplorer::SessionManager::projectWithProjectFilePath(project_file);
+        auto *target  = project ? project->activeTarget() : nullptr;
+
+        return target ? qobject_cast<XMakeBuildSystem *>(target->buildSystem()) : nullptr;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeTargetLocatorFilter::XMakeTargetLocatorFilter(bool executables_only)
+        : m_executables_only { executables_only } {
+        setPriority(High);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTargetLocatorFilter::prepareSearch([[maybe_unused]] const QString &entry) -> void {
+        m_index.clear();
+
+        for (const auto *project : ProjectExplorer::SessionManager::projects()) {
+            const auto *target = project->activeTarget();
+            const auto *bs =
+                target ? qobject_cast<XMakeBuildSystem *>(target->buildSystem()) : nullptr;
+            if (!bs) continue;
+
+            for (const auto &xmake_target : bs->targets()) {
+                if (m_executables_only && xmake_target.kind != Target::Kind::BINARY) continue;
+
+                m_index.push_back(
+                    { xmake_target.name, project->displayName(), project->projectFilePath() });
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTargetLocatorFilter::matchesFor(QFutureInterface<Core::LocatorFilterEntry> &future,
+                                              const QString &entry)
+        -> QList<Core::LocatorFilterEntry> {
+        const auto regexp = createRegExp(entry, caseSensitivity(entry));
+        if (!regexp.isValid()) return {};
+
+        auto prefix_matches = QList<Core::LocatorFilterEntry> {};
+        auto other_matches  = QList<Core::LocatorFilterEntry> {};
+
+        for (const auto &index_entry : m_index) {
+            if (future.isCanceled()) return {};
+
+            const auto match = regexp.match(index_entry.name);
+            if (!match.hasMatch()) continue;
+
+            auto filter_entry =
+                Core::LocatorFilterEntry { this,
+                                           index_entry.name,
+                                           QStringList { index_entry.project_file.toString(),
+                                                         index_entry.name } };
+            filter_entry.extraInfo     = index_entry.project_name;
+            filter_entry.highlightInfo = highlightInfo(match);
+
+            // the fuzzy matches come after the targets starting with what was typed
+            auto &matches =
+                index_entry.name.startsWith(entry, Qt::CaseInsensitive) ? prefix_matches
+                                                                        : other_matches;
+            matches.append(std::move(filter_entry));
+        }
+
+        return prefix_matches + other_matches;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTargetLocatorFilter::targetName(const Core::LocatorFilterEntry &selection)
+        -> QString {
+        return selection.internalData.toStringList().value(1);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeTargetLocatorFilter::projectFile(const Core::LocatorFilterEntry &selection)
+        -> Utils::FilePath {
+        return Utils::FilePath::fromString(selection.internalData.toStringList().value(0));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeBuildTargetLocatorFilter::XMakeBuildTargetLocatorFilter()
+        : XMakeTargetLocatorFilter { false } {
+        setId(Constants::Locator::BUILD_TARGET_FILTER_ID);
+        setDisplayName(tr("Build XMake Target"));
+        setDescription(tr("Builds a target of any open xmake project."));
+        setDefaultShortcutString("xb");
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeBuildTargetLocatorFilter::accept(const Core::LocatorFilterEntry &selection,
+                                               [[maybe_unused]] QString *new_text,
+                                               [[maybe_unused]] int *selection_start,
+                                               [[maybe_unused]] int *selection_length) const
+        -> void {
+        auto *bs = buildSystem(projectFile(selection));
+        if (!bs || !bs->xmakeBuildConfiguration()) return;
+
+        bs->xmakeBuildConfiguration()->build({ targetName(selection) });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    XMakeRunTargetLocatorFilter::XMakeRunTargetLocatorFilter()
+        : XMakeTargetLocatorFilter { true } {
+        setId(Constants::Locator::RUN_TARGET_FILTER_ID);
+        setDisplayName(tr("Run XMake Target"));
+        setDescription(tr("Runs an executable target of any open xmake project."));
+        setDefaultShortcutString("xr");
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeRunTargetLocatorFilter::accept(const Core::LocatorFilterEntry &selection,
+                                             [[maybe_unused]] QString *new_text,
+                                             [[maybe_unused]] int *selection_start,
+                                             [[maybe_unused]] int *selection_length) const
+        -> void {
+        const auto *bs = buildSystem(projectFile(selection));
+        if (!bs) return;
+
+        auto *target     = bs->target();
+        const auto name  = targetName(selection);
+        const auto &rcs  = target->runConfigurations();
+        const auto found = std::find_if(std::cbegin(rcs), std::cend(rcs), [&name](auto *rc) {
+            return rc->buildTargetInfo().displayName == name;
+        });
+        if (found == std::cend(rcs)) return;
+
+        // building before running follows the project explorer settings
+        target->setActiveRunConfiguration(*found);
+        ProjectExplorer::ProjectExplorerPlugin::runRunConfiguration(
+            *found,
+            ProjectExplorer::Constants::NORMAL_RUN_MODE);
+    }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,66 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <coreplugin/locator/ilocatorfilter.h>
+
+#include <utils/filepath.h>
+
+#include <vector>
+
+namespace XMakeProjectManager::Internal {
+    class XMakeTargetLocatorFilter: public Core::ILocatorFilter {
+        Q_OBJECT
+
+      public:
+        void prepareSearch(const QString &entry) override;
+        QList<Core::LocatorFilterEntry>
+            matchesFor(QFutureInterface<Core::LocatorFilterEntry> &future,
+                       const QString &entry) final;
+
+      protected:
+        explicit XMakeTargetLocatorFilter(bool executables_only);
+
+        // the project and the target name stored in the data of the entry
+        static QString targetName(const Core::LocatorFilterEntry &selection);
+        static Utils::FilePath projectFile(const Core::LocatorFilterEntry &selection);
+
+      private:
+        struct IndexEntry {
+            QString name;
+            QString project_name;
+            Utils::FilePath project_file;
+        };
+
+        bool m_executables_only;
+
+        // built on the GUI thread before each search, matched on the worker thread
+        std::vector<IndexEntry> m_index;
+    };
+
+    class XMakeBuildTargetLocatorFilter final: public XMakeTargetLocatorFilter {
+        Q_OBJECT
+
+      public:
+        XMakeBuildTargetLocatorFilter();
+
+        void accept(const Core::LocatorFilterEntry &selection,
+                    QString *new_text,
+                    int *selection_start,
+                    int *selection_length) const override;
+    };
+
+    class XMakeRunTargetLocatorFilter final: public XMakeTargetLocatorFilter {
+        Q_OBJECT
+
+      public:
+        XMakeRunTargetLocatorFilter();
+
+        void accept(const Core::LocatorFilterEntry &selection,
+                    QString *new_text,
+                    int *selection_start,
+                    int *selection_length) const override;
+    };
+} // namespace XMakeProjectManager::Internal
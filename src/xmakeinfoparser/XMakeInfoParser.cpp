@@ -4,30 +4,270 @@
 
 #include <xmakeinfoparser/XMakeInfoParser.hpp>
 
+#include <XMakeProjectConstant.hpp>
+
 #include <xmakeinfoparser/parsers/BuildSystemFilesParser.hpp>
 #include <xmakeinfoparser/parsers/Common.hpp>
 #include <xmakeinfoparser/parsers/InfoParser.hpp>
 #include <xmakeinfoparser/parsers/OptionParser.hpp>
+#include <xmakeinfoparser/parsers/PackageParser.hpp>
+#include <xmakeinfoparser/parsers/ProfileParser.hpp>
 #include <xmakeinfoparser/parsers/TargetParser.hpp>
 
+#include <QCborStreamReader>
+#include <QCborValue>
+#include <QElapsedTimer>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
 
 namespace XMakeProjectManager::Internal::XMakeInfoParser {
+    static Q_LOGGING_CATEGORY(xmake_info_parser_log, "qtc.xmake.infoparser", QtDebugMsg);
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto payload(const QByteArray &data) -> QByteArray {
+        // xmake may print diagnostics before the document, which is always the last line
+        if (data.startsWith('{')) return data;
+
+        const auto begin = data.lastIndexOf("\n{");
+        if (begin == -1) return data;
+
+        return QByteArray::fromRawData(data.constData() + begin + 1, data.size() - begin - 1);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto streamedTargets(const QByteArray &data) -> std::vector<QJsonObject> {
+        static const auto marker = QByteArray { Constants::Introspection::TARGET_MARKER };
+
+        // targets printed one per line in stream mode, when the output is loaded back at once
+        auto targets = std::vector<QJsonObject> {};
+        for (auto begin = data.indexOf(marker); begin != -1; begin = data.indexOf(marker, begin)) {
+            begin += marker.size();
+
+            auto end = data.indexOf('\n', begin);
+            if (end == -1) end = data.size();
+
+            targets.emplace_back(QJsonDocument::fromJson(data.mid(begin, end - begin)).object());
+
+            begin = end;
+        }
+
+        return targets;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto streamedTargets(const QByteArray &data, const Utils::FilePath &root)
+        -> TargetsList {
+        auto futures = std::vector<QFuture<Target>> {};
+        for (const auto &json : streamedTargets(data))
+            futures.emplace_back(TargetParser::loadTargetAsync(json, root));
+
+        return TargetParser::takeTargets(futures);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto isCbor(const QByteArray &data) -> bool {
+        // the script prefixes its CBOR documents with the self-described CBOR tag
+        return data.startsWith("\xd9\xd9\xf7");
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto readKey(QCborStreamReader &reader) -> QString {
+        if (!reader.isString()) {
+            reader.next();
+            return {};
+        }
+
+        auto key = QString {};
+        for (auto chunk = reader.readString(); chunk.status == QCborStreamReader::Ok;
+             chunk      = reader.readString())
+            key += chunk.data;
+
+        return key;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto parseCbor(const QByteArray &data) -> Result {
+        auto timer = QElapsedTimer {};
+        timer.start();
+
+        auto reader = QCborStreamReader { data };
+        if (reader.isTag() && reader.toTag() == QCborKnownTags::Signature) reader.next();
+
+        if (!reader.isMap() || !reader.enterContainer()) {
+            qCWarning(xmake_info_parser_log) << "Introspection output is not a CBOR map";
+            return {};
+        }
+
+        // targets are decoded one by one as they are read, the other entries are small enough
+        // to go through the JSON loaders
+        auto json            = QJsonObject {};
+        auto targets         = std::vector<QFuture<Target>> {};
+        auto pending_targets = QJsonArray {};
+        auto project_dir     = Utils::FilePath {};
+
+        while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+            const auto key = readKey(reader);
+
+            if (key == "targets" && reader.isArray() && reader.enterContainer()) {
+                while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+                    const auto json_target = QCborValue::fromCbor(reader).toJsonValue();
+
+                    // project_dir is written first, this is only a safety net
+                    if (project_dir.isEmpty()) pending_targets.append(json_target);
+                    else
+                        targets.emplace_back(
+                            TargetParser::loadTargetAsync(json_target, project_dir));
+                }
+
+                reader.leaveContainer();
+                continue;
+            }
+
+            const auto value = QCborValue::fromCbor(reader).toJsonValue();
+            if (key == "project_dir")
+                project_dir = Utils::FilePath::fromString(value.toString()).cleanPath();
+
+            json.insert(key, value);
+        }
+
+        if (reader.lastError() != QCborError::NoError)
+            qCWarning(xmake_info_parser_log)
+                << "Failed to parse introspection output:" << reader.lastError().toString()
+                << "at" << reader.currentOffset();
+
+        for (const auto &json_target : std::as_const(pending_targets))
+            targets.emplace_back(TargetParser::loadTargetAsync(json_target, project_dir));
+
+        const auto document = QJsonDocument { json };
+
+        // the targets are decoded while the document is read, only the wait is left
+        const auto document_time = timer.restart();
+        auto unique_targets = TargetParser::uniqueTargets(TargetParser::takeTargets(targets));
+
+        return { OptionParser { document }.options(),
+                 std::move(unique_targets),
+                 project_dir,
+                 BuildSystemFilesParser { document, project_dir }.files(),
+                 extractPathArray(json["qml_import_path"].toArray(), project_dir),
+                 InfoParser { document }.info(),
+                 extractPathArray(json["partial_files"].toArray(), project_dir),
+                 PackageParser { document }.packages(),
+                 {},
+                 document_time,
+                 timer.elapsed(),
+                 ProfileParser { document }.profiles() };
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    auto parse(const QByteArray &data) -> Result {
-        auto json = QJsonDocument::fromJson(data);
+    static auto parseJson(const QByteArray &data, Utils::optional<TargetsList> streamed_targets)
+        -> Result {
+        auto timer = QElapsedTimer {};
+        timer.start();
+
+        auto error = QJsonParseError {};
+        auto json  = QJsonDocument::fromJson(payload(data), &error);
+
+        const auto document_time = timer.restart();
+
+        if (error.error != QJsonParseError::NoError)
+            qCWarning(xmake_info_parser_log)
+                << "Failed to parse introspection output:" << error.errorString() << "at"
+                << error.offset;
 
         const auto json_qml_import_paths = json["qml_import_path"].toArray();
+        const auto json_partial_files    = json["partial_files"].toArray();
         const auto project_dir =
             Utils::FilePath::fromString(json["project_dir"].toString()).cleanPath();
 
+        auto targets = TargetParser { json, project_dir }.targets();
+        auto streamed = streamed_targets ? std::move(*streamed_targets)
+                                         : streamedTargets(data, project_dir);
+        std::move(std::begin(streamed), std::end(streamed), std::back_inserter(targets));
+
+        auto unique_targets = TargetParser::uniqueTargets(std::move(targets));
+
         return { OptionParser { json }.options(),
-                 TargetParser { json, project_dir }.targets(),
+                 std::move(unique_targets),
                  project_dir,
                  BuildSystemFilesParser { json, project_dir }.files(),
                  extractPathArray(json_qml_import_paths, project_dir),
-                 InfoParser { json }.info() };
+                 InfoParser { json }.info(),
+                 extractPathArray(json_partial_files, project_dir),
+                 PackageParser { json }.packages(),
+                 {},
+                 document_time,
+                 timer.elapsed(),
+                 ProfileParser { json }.profiles() };
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto parse(const QByteArray &data, Utils::optional<TargetsList> streamed_targets) -> Result {
+        const auto format = isCbor(data) ? Format::Cbor : Format::Json;
+
+        auto result = format == Format::Cbor ? parseCbor(data)
+                                             : parseJson(data, std::move(streamed_targets));
+        result.format = format;
+
+        auto timer = QElapsedTimer {};
+        timer.start();
+
+        result.paths.intern(result.targets);
+        TargetParser::resolveDependencies(result.targets);
+
+        result.targets_time += timer.elapsed();
+
+        return result;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto jsonDocument(const QByteArray &data) -> QByteArray {
+        auto document = QJsonDocument::fromJson(payload(data)).object();
+
+        auto targets = document["targets"].toArray();
+        for (const auto &target : streamedTargets(data)) targets.append(target);
+        document["targets"] = targets;
+
+        return QJsonDocument { document }.toJson(QJsonDocument::Compact);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto copy(const Result &result) -> Result {
+        auto options = BuildOptionsList {};
+        options.reserve(std::size(result.options));
+
+        std::transform(std::cbegin(result.options),
+                       std::cend(result.options),
+                       std::back_inserter(options),
+                       [](const auto &o) { return std::make_unique<BuildOption>(*o); });
+
+        return { std::move(options),
+                 result.targets,
+                 result.project_dir,
+                 result.build_system_files,
+                 result.qml_import_paths,
+                 result.xmake_info,
+                 result.partial_files,
+                 result.packages,
+                 result.paths,
+                 result.document_time,
+                 result.targets_time,
+                 result.profiles,
+                 result.format };
     }
 } // namespace XMakeProjectManager::Internal::XMakeInfoParser
@@ -8,7 +8,10 @@
 
 #include <xmakeinfoparser/XMakeBuildOptionsParser.hpp>
 #include <xmakeinfoparser/XMakeInfo.hpp>
+#include <xmakeinfoparser/XMakePackage.hpp>
+#include <xmakeinfoparser/XMakePathTable.hpp>
 #include <xmakeinfoparser/XMakeTargetParser.hpp>
+#include <xmakeinfoparser/XMakeTargetProfile.hpp>
 
 #include <utils/filepath.h>
 #include <utils/fileutils.h>
@@ -22,6 +25,8 @@ namespace XMakeProjectManager::Internal {
     class XmakeInfoParserPrivate;
 
     namespace XMakeInfoParser {
+        enum class Format { Json, Cbor };
+
         struct Result {
             BuildOptionsList options;
 
@@ -34,8 +39,34 @@ namespace XMakeProjectManager::Internal {
             QStringList qml_import_paths;
 
             Utils::optional<XMakeInfo> xmake_info;
+
+            // when not empty, only the targets defined in these files were introspected
+            QStringList partial_files;
+
+            PackagesList packages;
+
+            PathTable paths;
+
+            // milliseconds spent reading the document and decoding the targets
+            qint64 document_time = 0;
+            qint64 targets_time  = 0;
+
+            // slowest targets of the introspection script first
+            TargetProfilesList profiles;
+
+            // the encoding the document was decoded from
+            Format format = Format::Json;
         };
 
-        Result parse(const QByteArray &data);
+        // streamed_targets are the targets already decoded from the stream mode target lines
+        Result parse(const QByteArray &data,
+                     Utils::optional<TargetsList> streamed_targets = Utils::nullopt);
+
+        // the JSON document of data on its own, without the diagnostics printed before it and
+        // with the targets of the stream mode lines in its targets
+        QByteArray jsonDocument(const QByteArray &data);
+
+        // the options are owned by the result, the copy gets its own
+        Result copy(const Result &result);
     } // namespace XMakeInfoParser
 } // namespace XMakeProjectManager::Internal
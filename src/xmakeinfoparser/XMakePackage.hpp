@@ -0,0 +1,25 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+
+#include <vector>
+
+namespace XMakeProjectManager::Internal {
+    struct Package {
+        enum class Status { Unknown, Cached, Missing, Downloading, Building, Built, Failed };
+
+        QString name;
+        QString version;
+
+        // false when the last configuration could not install it
+        bool installed;
+    };
+
+    using PackagesList     = std::vector<Package>;
+    using PackageStatusMap = QHash<QString, Package::Status>;
+} // namespace XMakeProjectManager::Internal
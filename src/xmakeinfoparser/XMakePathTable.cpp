@@ -0,0 +1,104 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include <xmakeinfoparser/XMakePathTable.hpp>
+
+#include <QMutex>
+#include <QSet>
+
+#include <algorithm>
+
+namespace XMakeProjectManager::Internal {
+    static constexpr auto SHARED_PATHS_PRUNE_SIZE = qsizetype { 4096 };
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto sharedPath(const QString &path) -> QString {
+        // the build configurations of the other platforms list the same sources, every result
+        // in the process holds one copy of each path
+        static auto mutex    = QMutex {};
+        static auto paths    = QSet<QString> {};
+        static auto prune_at = SHARED_PATHS_PRUNE_SIZE;
+
+        const auto lock = QMutexLocker { &mutex };
+
+        if (const auto it = paths.constFind(path); it != std::cend(paths)) return *it;
+
+        if (paths.size() >= prune_at) {
+            // the pool holds the last copy of the paths of the dropped results
+            paths.removeIf([](const QString &shared) { return shared.isDetached(); });
+            prune_at = std::max(SHARED_PATHS_PRUNE_SIZE, paths.size() * 2);
+        }
+
+        return *paths.insert(path);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto PathTable::intern(const QString &path) -> const QString & {
+        auto it = m_paths.find(path);
+        if (it == std::end(m_paths)) {
+            const auto file_path = m_device_root.isEmpty() ? Utils::FilePath::fromString(path)
+                                                           : m_device_root.withNewPath(path);
+            it = m_paths.emplace(sharedPath(path), file_path).first;
+        }
+
+        return it->first;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto PathTable::intern(QStringList &paths) -> void {
+        for (auto &path : paths) path = intern(path);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto PathTable::intern(TargetsList &targets) -> void {
+        // modules are also part of the C++ source group, and shared headers appear in every
+        // target using them
+        for (auto &target : targets) {
+            target.defined_in  = intern(target.defined_in);
+            target.target_file = intern(target.target_file);
+
+            for (auto &group : target.sources) {
+                intern(group.sources);
+                intern(group.lazy_files);
+            }
+
+            intern(target.headers);
+            intern(target.modules);
+
+            for (auto &unit : target.module_units) {
+                unit.file = intern(unit.file);
+                if (!unit.bmi.isEmpty()) unit.bmi = intern(unit.bmi);
+            }
+
+            for (auto &generated : target.generated_files) {
+                generated.source = intern(generated.source);
+                intern(generated.outputs);
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto PathTable::filePath(const QString &path) const -> Utils::FilePath {
+        if (const auto it = m_paths.find(path); it != std::end(m_paths)) return it->second;
+
+        if (!m_device_root.isEmpty()) return m_device_root.withNewPath(path);
+
+        return Utils::FilePath::fromString(path);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto PathTable::setDevice(const Utils::FilePath &device_root) -> void {
+        m_device_root = device_root;
+
+        for (auto &[path, file_path] : m_paths)
+            file_path = m_device_root.isEmpty() ? Utils::FilePath::fromString(path)
+                                                : m_device_root.withNewPath(path);
+    }
+} // namespace XMakeProjectManager::Internal
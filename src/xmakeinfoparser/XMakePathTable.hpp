@@ -0,0 +1,37 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <xmakeinfoparser/XMakeTargetParser.hpp>
+
+#include <utils/filepath.h>
+
+#include <QString>
+#include <QStringList>
+
+#include <unordered_map>
+
+namespace XMakeProjectManager::Internal {
+    // every path of an introspection result is stored once, targets hold implicitly shared copies
+    class PathTable {
+      public:
+        const QString &intern(const QString &path);
+        void intern(QStringList &paths);
+        void intern(TargetsList &targets);
+
+        Utils::FilePath filePath(const QString &path) const;
+
+        // the paths reported by an xmake running on a device are mapped back onto it
+        void setDevice(const Utils::FilePath &device_root);
+
+        std::size_t size() const noexcept;
+
+      private:
+        std::unordered_map<QString, Utils::FilePath> m_paths;
+        Utils::FilePath m_device_root;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "XMakePathTable.inl"
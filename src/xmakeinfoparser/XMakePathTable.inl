@@ -0,0 +1,11 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto PathTable::size() const noexcept -> std::size_t { return std::size(m_paths); }
+} // namespace XMakeProjectManager::Internal
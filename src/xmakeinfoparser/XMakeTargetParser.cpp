@@ -7,7 +7,38 @@
 #include <utils/filepath.h>
 #include <utils/fileutils.h>
 
+#include <algorithm>
+
 namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto Target::FlagsDelta::isEmpty() const noexcept -> bool {
+        return added.isEmpty() && arguments.isEmpty();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto Target::FlagsDelta::applyTo(const QStringList &base) const -> QStringList {
+        if (!arguments.isEmpty()) return arguments;
+        if (added.isEmpty()) return base;
+
+        return base + added;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto Target::FlagsDelta::between(const QStringList &base, const QStringList &arguments)
+        -> FlagsDelta {
+        if (arguments == base) return {};
+
+        // the group flags end on a whole flag, what follows them can't take one of their values
+        if (arguments.size() > base.size() &&
+            std::equal(std::cbegin(base), std::cend(base), std::cbegin(arguments)))
+            return { arguments.mid(base.size()), {} };
+
+        return { {}, arguments };
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto Target::fullName(const Utils::FilePath &src_dir,
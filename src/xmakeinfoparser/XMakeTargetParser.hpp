@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <QHash>
 #include <QString>
 #include <QStringList>
 
@@ -16,13 +17,49 @@ namespace Utils {
 
 namespace XMakeProjectManager::Internal {
     struct Target {
+        // the flags of a file configured on its own, kept as the flags it appends to the ones of
+        // its group, or whole when it changes or reorders them: the flags taking their value as
+        // the next argument and the order of the -D and -U can't be split
+        struct FlagsDelta {
+            QStringList added;
+            QStringList arguments;
+
+            bool isEmpty() const noexcept;
+            QStringList applyTo(const QStringList &base) const;
+
+            static FlagsDelta between(const QStringList &base, const QStringList &arguments);
+        };
+
         struct SourceGroup {
             QString kind;
             QStringList sources;
             QStringList arguments;
+
+            // the files configured with their own flags, in lazy mode the files which will be
+            // queried once opened, an empty delta when the group flags fit
+            QStringList lazy_files;
+            QHash<QString, FlagsDelta> file_flags;
         };
         using SourceGroupList = std::vector<SourceGroup>;
 
+        // a C++20 module unit as declared in its source, bmi is empty until the target is built
+        struct ModuleUnit {
+            QString name;
+            QString file;
+            QStringList imports;
+            QString bmi;
+        };
+        using ModuleUnitList = std::vector<ModuleUnit>;
+
+        // a source xmake generates files from during the build, kind is the extension of the
+        // source handled by the matching Qt Creator extra compiler
+        struct GeneratedFile {
+            QString kind;
+            QString source;
+            QStringList outputs;
+        };
+        using GeneratedFileList = std::vector<GeneratedFile>;
+
         enum class Kind { SHARED, BINARY, STATIC, OBJECT, HEADERONLY, PHONY };
 
         QString name;
@@ -32,11 +69,24 @@ namespace XMakeProjectManager::Internal {
         SourceGroupList sources;
         QStringList headers;
         QStringList modules;
+        ModuleUnitList module_units;
+        GeneratedFileList generated_files;
 
         std::unordered_map<QString, QString> set_env;
         std::unordered_map<QString, QStringList> add_env;
 
         QString target_file;
+        // clang writes its time traces next to the objects
+        QString object_dir;
+        // -1 without the c++.unity_build rule, 0 when xmake picks the batch size
+        int unity_batch_size = -1;
+        QString precompiled_header;
+
+        // set_installdir or the configured one, empty to use the xmake default
+        QString install_dir;
+
+        // declared with add_tests, run as <target>/<test> by xmake test
+        QStringList tests;
 
         QStringList languages; // for MSVC code model
 
@@ -47,6 +97,12 @@ namespace XMakeProjectManager::Internal {
         QStringList frameworks;
 
         bool use_qt;
+        // the QML2_IMPORT_PATH of its run environment, the result lists those of every target
+        QStringList qml_import_paths;
+
+        // direct dependencies, as named in the introspection and as indices in the targets list
+        QStringList deps;
+        std::vector<std::size_t> dependencies;
 
         static QString fullName(const Utils::FilePath &srcDir,
                                 const QString &target_file,
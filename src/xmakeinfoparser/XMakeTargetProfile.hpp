@@ -0,0 +1,23 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <QString>
+
+#include <vector>
+
+namespace XMakeProjectManager::Internal {
+    // milliseconds the introspection script spent on a target
+    struct TargetProfile {
+        QString name;
+
+        double total;
+        double source_batches;
+        double compile_flags;
+        double run_envs;
+    };
+
+    using TargetProfilesList = std::vector<TargetProfile>;
+} // namespace XMakeProjectManager::Internal
@@ -22,7 +22,8 @@ namespace XMakeProjectManager::Internal {
       public:
         explicit BuildSystemFilesParser(const QJsonDocument &json, const Utils::FilePath &root);
 
-        const std::vector<Utils::FilePath> &files() const noexcept;
+        const std::vector<Utils::FilePath> &files() const & noexcept;
+        std::vector<Utils::FilePath> files() && noexcept;
 
       private:
         std::vector<Utils::FilePath> m_files;
@@ -7,8 +7,14 @@
 namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    inline auto BuildSystemFilesParser::files() const noexcept
+    inline auto BuildSystemFilesParser::files() const & noexcept
         -> const std::vector<Utils::FilePath> & {
         return m_files;
     }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto BuildSystemFilesParser::files() && noexcept -> std::vector<Utils::FilePath> {
+        return std::move(m_files);
+    }
 } // namespace XMakeProjectManager::Internal
@@ -18,7 +18,8 @@ namespace XMakeProjectManager::Internal {
       public:
         explicit InfoParser(const QJsonDocument &json);
 
-        const XMakeInfo &info() const noexcept;
+        const XMakeInfo &info() const & noexcept;
+        XMakeInfo info() && noexcept;
 
       private:
         static XMakeInfo loadInfo(const QJsonObject &obj);
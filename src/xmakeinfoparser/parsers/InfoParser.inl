@@ -5,5 +5,6 @@
 #pragma once
 
 namespace XMakeProjectManager::Internal {
-    inline auto InfoParser::info() const noexcept -> const XMakeInfo & { return m_info; }
+    inline auto InfoParser::info() const & noexcept -> const XMakeInfo & { return m_info; }
+    inline auto InfoParser::info() && noexcept -> XMakeInfo { return std::move(m_info); }
 } // namespace XMakeProjectManager::Internal
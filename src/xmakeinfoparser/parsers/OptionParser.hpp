@@ -21,7 +21,8 @@ namespace XMakeProjectManager::Internal {
       public:
         explicit OptionParser(const QJsonDocument &json);
 
-        BuildOptionsList options() const noexcept;
+        BuildOptionsList options() const & noexcept;
+        BuildOptionsList options() && noexcept;
 
       private:
         static BuildOptionsList loadOptions(const QJsonArray &json_options);
@@ -7,7 +7,7 @@
 namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    inline auto OptionParser::options() const noexcept -> BuildOptionsList {
+    inline auto OptionParser::options() const & noexcept -> BuildOptionsList {
         auto out = BuildOptionsList {};
         out.reserve(std::size(m_options));
 
@@ -18,4 +18,10 @@ namespace XMakeProjectManager::Internal {
 
         return out;
     }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto OptionParser::options() && noexcept -> BuildOptionsList {
+        return std::move(m_options);
+    }
 } // namespace XMakeProjectManager::Internal
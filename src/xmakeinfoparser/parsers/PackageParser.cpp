@@ -0,0 +1,27 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include <xmakeinfoparser/parsers/Common.hpp>
+#include <xmakeinfoparser/parsers/PackageParser.hpp>
+
+#include <QJsonDocument>
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    PackageParser::PackageParser(const QJsonDocument &json) {
+        auto json_packages = get<QJsonArray>(json.object(), "packages");
+        if (!json_packages) return;
+
+        m_packages.reserve(std::size(*json_packages));
+        for (const auto &json_package : std::as_const(*json_packages))
+            m_packages.emplace_back(loadPackage(json_package.toObject()));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto PackageParser::loadPackage(const QJsonObject &obj) -> Package {
+        return { obj["name"].toString(), obj["version"].toString(), obj["installed"].toBool() };
+    }
+} // namespace XMakeProjectManager::Internal
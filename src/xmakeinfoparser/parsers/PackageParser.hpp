@@ -0,0 +1,31 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <QtGlobal>
+
+#include <xmakeinfoparser/XMakePackage.hpp>
+
+QT_BEGIN_NAMESPACE
+class QJsonDocument;
+class QJsonObject;
+QT_END_NAMESPACE
+
+namespace XMakeProjectManager::Internal {
+    class PackageParser {
+      public:
+        explicit PackageParser(const QJsonDocument &json);
+
+        const PackagesList &packages() const & noexcept;
+        PackagesList packages() && noexcept;
+
+      private:
+        static Package loadPackage(const QJsonObject &obj);
+
+        PackagesList m_packages;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "PackageParser.inl"
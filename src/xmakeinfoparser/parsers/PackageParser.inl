@@ -0,0 +1,19 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto PackageParser::packages() const & noexcept -> const PackagesList & {
+        return m_packages;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto PackageParser::packages() && noexcept -> PackagesList {
+        return std::move(m_packages);
+    }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,38 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include <xmakeinfoparser/parsers/Common.hpp>
+#include <xmakeinfoparser/parsers/ProfileParser.hpp>
+
+#include <QJsonDocument>
+
+#include <algorithm>
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    ProfileParser::ProfileParser(const QJsonDocument &json) {
+        // absent from the outputs of older scripts
+        auto json_profiles = get<QJsonArray>(json.object(), "profile");
+        if (!json_profiles) return;
+
+        m_profiles.reserve(std::size(*json_profiles));
+        for (const auto &json_profile : std::as_const(*json_profiles))
+            m_profiles.emplace_back(loadProfile(json_profile.toObject()));
+
+        std::sort(std::begin(m_profiles),
+                  std::end(m_profiles),
+                  [](const auto &a, const auto &b) { return a.total > b.total; });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto ProfileParser::loadProfile(const QJsonObject &obj) -> TargetProfile {
+        return { obj["name"].toString(),
+                 obj["total"].toDouble(),
+                 obj["sourcebatches"].toDouble(),
+                 obj["compflags"].toDouble(),
+                 obj["runenvs"].toDouble() };
+    }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,31 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <QtGlobal>
+
+#include <xmakeinfoparser/XMakeTargetProfile.hpp>
+
+QT_BEGIN_NAMESPACE
+class QJsonDocument;
+class QJsonObject;
+QT_END_NAMESPACE
+
+namespace XMakeProjectManager::Internal {
+    class ProfileParser {
+      public:
+        explicit ProfileParser(const QJsonDocument &json);
+
+        const TargetProfilesList &profiles() const & noexcept;
+        TargetProfilesList profiles() && noexcept;
+
+      private:
+        static TargetProfile loadProfile(const QJsonObject &obj);
+
+        TargetProfilesList m_profiles;
+    };
+} // namespace XMakeProjectManager::Internal
+
+#include "ProfileParser.inl"
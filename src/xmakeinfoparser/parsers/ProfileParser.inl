@@ -0,0 +1,19 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+namespace XMakeProjectManager::Internal {
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto ProfileParser::profiles() const & noexcept -> const TargetProfilesList & {
+        return m_profiles;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto ProfileParser::profiles() && noexcept -> TargetProfilesList {
+        return std::move(m_profiles);
+    }
+} // namespace XMakeProjectManager::Internal
@@ -7,6 +7,11 @@
 
 #include <xmakeinfoparser/parsers/TargetParser.hpp>
 
+#include <projectexplorer/projectexplorer.h>
+
+#include <utils/runextensions.h>
+
+#include <QHash>
 #include <QJsonDocument>
 #include <QJsonValue>
 #include <QMapIterator>
@@ -25,14 +30,44 @@ namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     auto TargetParser::loadTargets(const QJsonArray &json_targets, const Utils::FilePath &root)
         -> TargetsList {
-        auto targets = TargetsList {};
-        targets.reserve(json_targets.size());
+        // targets are independent, their paths are resolved in parallel
+        auto futures = std::vector<QFuture<Target>> {};
+        futures.reserve(json_targets.size());
 
         std::transform(std::cbegin(json_targets),
                        std::cend(json_targets),
-                       std::back_inserter(targets),
-                       [&root](const auto &v) { return loadTarget(v, root); });
+                       std::back_inserter(futures),
+                       [&root](const auto &v) { return loadTargetAsync(v, root); });
+
+        return uniqueTargets(takeTargets(futures));
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto TargetParser::loadTargetAsync(QJsonValue json_target, const Utils::FilePath &root)
+        -> QFuture<Target> {
+        return Utils::runAsync(ProjectExplorer::ProjectExplorerPlugin::sharedThreadPool(),
+                               [json_target = std::move(json_target), root] {
+                                   return loadTarget(json_target, root);
+                               });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto TargetParser::takeTargets(std::vector<QFuture<Target>> &futures) -> TargetsList {
+        // results are collected in submission order so the output stays deterministic
+        auto targets = TargetsList {};
+        targets.reserve(std::size(futures));
+
+        for (auto &future : futures) targets.emplace_back(future.result());
+        futures.clear();
+
+        return targets;
+    }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto TargetParser::uniqueTargets(TargetsList targets) -> TargetsList {
         std::sort(targets.begin(), targets.end(), [](const auto &a, const auto &b) {
             return a.name < b.name;
         });
@@ -45,6 +80,24 @@ namespace XMakeProjectManager::Internal {
         return targets;
     }
 
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto TargetParser::resolveDependencies(TargetsList &targets) -> void {
+        auto indices = QHash<QString, std::size_t> {};
+        indices.reserve(std::size(targets));
+
+        for (auto i = 0u; i < std::size(targets); ++i) indices.insert(targets[i].name, i);
+
+        for (auto &target : targets) {
+            target.dependencies.clear();
+
+            // a dependency outside of the introspected targets has no index
+            for (const auto &dep : target.deps)
+                if (const auto it = indices.constFind(dep); it != std::cend(indices))
+                    target.dependencies.push_back(*it);
+        }
+    }
+
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
     auto TargetParser::loadTarget(const QJsonValue &json_target, const Utils::FilePath &root)
@@ -78,6 +131,30 @@ namespace XMakeProjectManager::Internal {
         target.modules    = extractPathArray(json_modules, root);
         target.modules.removeDuplicates();
 
+        const auto unit_path = [&root](const QJsonValue &value) {
+            if (value.toString().isEmpty()) return QString {};
+
+            return extractPathArray(QJsonArray { value }, root).first();
+        };
+
+        for (const auto &json_unit : json_target["module_units"].toArray()) {
+            const auto unit = json_unit.toObject();
+
+            target.module_units.push_back({ unit["name"].toString(),
+                                            unit_path(unit["file"]),
+                                            extractArray(unit["imports"].toArray()),
+                                            unit_path(unit["bmi"]) });
+        }
+
+        for (const auto &json_generated : json_target["generated_files"].toArray()) {
+            const auto generated = json_generated.toObject();
+
+            target.generated_files.push_back(
+                { generated["kind"].toString(),
+                  unit_path(generated["source"]),
+                  extractPathArray(generated["outputs"].toArray(), root) });
+        }
+
         auto json_run_envs = json_target["run_envs"].toObject();
         auto set_run_envs  = json_run_envs["set"].toObject().toVariantMap();
 
@@ -104,6 +181,12 @@ namespace XMakeProjectManager::Internal {
             return path.toString();
         }();
 
+        target.object_dir         = json_target["object_dir"].toString();
+        target.unity_batch_size   = json_target["unity_batch_size"].toInt(-1);
+        target.precompiled_header = json_target["precompiled_header"].toString();
+        target.install_dir = json_target["install_dir"].toString();
+        target.tests       = extractArray(json_target["tests"].toArray());
+
         auto json_languages = json_target["languages"].toArray();
         target.languages    = extractArray(json_languages);
         target.languages.removeDuplicates();
@@ -119,7 +202,11 @@ namespace XMakeProjectManager::Internal {
         target.frameworks    = extractArray(json_frameworks);
         target.frameworks.removeDuplicates();
 
-        target.use_qt = json_target["use_qt"].toBool();
+        target.use_qt           = json_target["use_qt"].toBool();
+        target.qml_import_paths = extractPathArray(json_target["qml_import_path"].toArray(), root);
+
+        auto json_deps = json_target["deps"].toArray();
+        target.deps    = extractArray(json_deps);
 
         return target;
     }
@@ -148,8 +235,22 @@ namespace XMakeProjectManager::Internal {
                                   extractPathArray(json_source["source_files"].toArray(), root),
                                   extractArray(json_source["arguments"].toArray()) };
 
+        // files configured with their own flags only store what differs from the group flags
+        const auto file_flags = json_source["file_flags"].toObject();
+        for (auto it = std::cbegin(file_flags); it != std::cend(file_flags); ++it) {
+            const auto json_delta = it.value().toObject();
+
+            auto path = Utils::FilePath::fromString(it.key()).cleanPath();
+            if (!path.isAbsolutePath()) path = root.resolvePath(path);
+
+            output.file_flags.insert(path.toString(),
+                                     { extractArray(json_delta["added"].toArray()),
+                                       extractArray(json_delta["arguments"].toArray()) });
+        }
+
+        output.lazy_files = extractPathArray(json_source["lazy_files"].toArray(), root);
+
         output.sources.removeDuplicates();
-        output.arguments.removeDuplicates();
 
         return output;
     }
@@ -7,6 +7,8 @@
 #include "utils/filepath.h"
 #include <vector>
 
+#include <QFuture>
+#include <QJsonValue>
 #include <QString>
 #include <QtGlobal>
 
@@ -16,7 +18,6 @@ QT_BEGIN_NAMESPACE
 class QJsonDocument;
 class QJsonObject;
 class QJsonArray;
-class QJsonValue;
 QT_END_NAMESPACE
 
 namespace XMakeProjectManager::Internal {
@@ -24,11 +25,18 @@ namespace XMakeProjectManager::Internal {
       public:
         explicit TargetParser(const QJsonDocument &json, const Utils::FilePath &root);
 
-        const TargetsList &targets() const noexcept;
+        const TargetsList &targets() const & noexcept;
+        TargetsList targets() && noexcept;
+
+        static Target loadTarget(const QJsonValue &json_target, const Utils::FilePath &root);
+        static QFuture<Target> loadTargetAsync(QJsonValue json_target, const Utils::FilePath &root);
+        static TargetsList takeTargets(std::vector<QFuture<Target>> &futures);
+        static TargetsList uniqueTargets(TargetsList targets);
+        // to run each time the targets list is reordered
+        static void resolveDependencies(TargetsList &targets);
 
       private:
         static TargetsList loadTargets(const QJsonArray &json_targets, const Utils::FilePath &root);
-        static Target loadTarget(const QJsonValue &json_target, const Utils::FilePath &root);
         static Target::SourceGroupList extractSources(const QJsonArray &json_sources, const Utils::FilePath &root);
         static Target::SourceGroup extractSource(const QJsonValue &json_source, const Utils::FilePath &root);
 
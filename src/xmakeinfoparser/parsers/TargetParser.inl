@@ -7,5 +7,11 @@
 namespace XMakeProjectManager::Internal {
     ////////////////////////////////////////////////////
     ////////////////////////////////////////////////////
-    inline auto TargetParser::targets() const noexcept -> const TargetsList & { return m_targets; }
+    inline auto TargetParser::targets() const & noexcept -> const TargetsList & {
+        return m_targets;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    inline auto TargetParser::targets() && noexcept -> TargetsList { return std::move(m_targets); }
 } // namespace XMakeProjectManager::Internal
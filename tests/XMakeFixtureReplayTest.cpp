@@ -0,0 +1,157 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeFixtureReplayTest.hpp"
+#include "XMakeSyntheticProject.hpp"
+
+#include <project/XMakeFixtureRecorder.hpp>
+#include <project/XMakeMemoryReport.hpp>
+#include <project/XMakeProjectParser.hpp>
+#include <project/projecttree/ProjectTree.hpp>
+
+#include <xmakeinfoparser/XMakeInfoParser.hpp>
+
+#include <coreplugin/icore.h>
+
+#include <projectexplorer/kitmanager.h>
+
+#include <qtsupport/qtcppkitinfo.h>
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QTest>
+
+#include <algorithm>
+#include <limits>
+
+namespace XMakeProjectManager::Internal {
+    // per file of the project, generous enough for a debug build
+    static constexpr auto TIME_BUDGET   = 100;      // microseconds
+    static constexpr auto MEMORY_BUDGET = 8 * 1024; // bytes
+
+    static constexpr auto TIME_BUDGET_VARIABLE   = "XMAKE_REPLAY_TIME_BUDGET";
+    static constexpr auto MEMORY_BUDGET_VARIABLE = "XMAKE_REPLAY_MEMORY_BUDGET";
+
+    // the fastest run is kept, the first one also fills the caches of Qt Creator
+    static constexpr auto REPLAY_RUNS = 3;
+
+    static constexpr auto SYNTHETIC_TARGETS = 100;
+    static constexpr auto SYNTHETIC_FILES   = 100;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto projectDir() -> Utils::FilePath {
+        return Utils::FilePath::fromString(QDir::tempPath()).pathAppended("xmake-fixture");
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto budget(const char *variable, qint64 fallback) -> qint64 {
+        auto ok          = false;
+        const auto value = qEnvironmentVariable(variable).toLongLong(&ok);
+
+        return ok && value > 0 ? value : fallback;
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto fileCount(const TargetsList &targets) -> qint64 {
+        auto count = qint64 { 0 };
+        for (const auto &target : targets) {
+            for (const auto &group : target.sources) count += std::size(group.sources);
+
+            count += std::size(target.headers) + std::size(target.modules);
+        }
+
+        return std::max(count, qint64 { 1 });
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeFixtureReplayTest::replay_data() -> void {
+        QTest::addColumn<QByteArray>("document");
+
+        const auto project_dir = projectDir();
+
+        QTest::newRow("synthetic") << XMakeSyntheticProject::introspection(project_dir,
+                                                                          SYNTHETIC_TARGETS,
+                                                                          SYNTHETIC_FILES);
+
+        // the documents recorded earlier are replayed even once the recording is turned off
+        auto directory = XMakeFixtureRecorder::directory();
+        if (directory.isEmpty()) directory = Core::ICore::userResourcePath("xmake-fixtures");
+
+        for (const auto &fixture :
+             directory.dirEntries({ { "*.json", "*.cbor" }, QDir::Files }, QDir::Name)) {
+            const auto format = fixture.suffix() == "cbor" ? XMakeInfoParser::Format::Cbor
+                                                           : XMakeInfoParser::Format::Json;
+
+            QTest::newRow(qPrintable(fixture.fileName()))
+                << XMakeFixtureRecorder::restore(fixture.fileContents(),
+                                                 format,
+                                                 project_dir,
+                                                 project_dir.pathAppended("build"));
+        }
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeFixtureReplayTest::replay() -> void {
+        QFETCH(QByteArray, document);
+
+        const auto project_dir = projectDir();
+        const auto kit_info = QtSupport::CppKitInfo { ProjectExplorer::KitManager::defaultKit() };
+
+        auto future = QFutureInterface<XMakeProjectParser::ParserDataPtr> {};
+        future.reportStarted();
+
+        auto elapsed = std::numeric_limits<qint64>::max();
+        auto files   = qint64 { 1 };
+        auto memory  = MemoryReport {};
+
+        for (auto i = 0; i < REPLAY_RUNS; ++i) {
+            auto timer = QElapsedTimer {};
+            timer.start();
+
+            const auto result = XMakeInfoParser::parse(document);
+            QVERIFY(!std::empty(result.targets));
+
+            const auto root_node = ProjectTree::buildTree(project_dir,
+                                                          result.project_dir,
+                                                          result.targets,
+                                                          result.build_system_files,
+                                                          result.paths);
+            QVERIFY(root_node);
+
+            const auto project_parts = XMakeProjectParser::buildProjectParts(project_dir,
+                                                                             result.targets,
+                                                                             kit_info,
+                                                                             {},
+                                                                             future);
+            QVERIFY(!std::empty(project_parts.parts));
+
+            elapsed = std::min(elapsed, timer.nsecsElapsed() / 1000);
+
+            files  = fileCount(result.targets);
+            memory = MemoryReport::estimate(result.targets, root_node.get(), project_parts.parts);
+        }
+
+        future.reportFinished();
+
+        const auto time_budget   = budget(TIME_BUDGET_VARIABLE, TIME_BUDGET) * files;
+        const auto memory_budget = budget(MEMORY_BUDGET_VARIABLE, MEMORY_BUDGET) * files;
+
+        qDebug().noquote() << files << "files replayed in" << elapsed << "us, holding"
+                           << memory.toString();
+
+        QVERIFY2(elapsed <= time_budget,
+                 qPrintable(QString { "%1 us spent, the budget is %2 us" }
+                                .arg(elapsed)
+                                .arg(time_budget)));
+        QVERIFY2(memory.total() <= memory_budget,
+                 qPrintable(QString { "%1 bytes held, the budget is %2 bytes" }
+                                .arg(memory.total())
+                                .arg(memory_budget)));
+    }
+} // namespace XMakeProjectManager::Internal
@@ -0,0 +1,21 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <QObject>
+
+namespace XMakeProjectManager::Internal {
+    // replays the recorded introspection documents, and a synthetic one, through the decoding,
+    // the project tree and the project parts, a replay fails past the time or memory budget
+    // given per file, XMAKE_REPLAY_TIME_BUDGET (microseconds) and XMAKE_REPLAY_MEMORY_BUDGET
+    // (bytes) override them
+    class XMakeFixtureReplayTest final: public QObject {
+        Q_OBJECT
+
+      private Q_SLOTS:
+        void replay_data();
+        void replay();
+    };
+} // namespace XMakeProjectManager::Internal
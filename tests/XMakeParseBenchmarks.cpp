@@ -0,0 +1,157 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeParseBenchmarks.hpp"
+#include "XMakeSyntheticProject.hpp"
+
+#include <project/XMakeProjectParser.hpp>
+#include <project/parsers/XMakeBuildParser.hpp>
+#include <project/projecttree/ProjectTree.hpp>
+
+#include <xmakeinfoparser/XMakeInfoParser.hpp>
+
+#include <projectexplorer/kitmanager.h>
+
+#include <qtsupport/qtcppkitinfo.h>
+
+#include <QDir>
+#include <QTest>
+
+#include <array>
+#include <utility>
+
+namespace XMakeProjectManager::Internal {
+    // targets x files, from a small project to one of 100 000 files
+    static constexpr auto SIZES = std::array { std::pair { 10, 100 },
+                                               std::pair { 100, 100 },
+                                               std::pair { 500, 200 } };
+
+    static constexpr auto SIZE_VARIABLE = "XMAKE_BENCHMARK_SIZE";
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto projectDir() -> Utils::FilePath {
+        return Utils::FilePath::fromString(QDir::tempPath()).pathAppended("xmake-benchmark");
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeParseBenchmarks::addSizes() -> void {
+        QTest::addColumn<int>("target_count");
+        QTest::addColumn<int>("file_count");
+
+        const auto add_size = [](int target_count, int file_count) {
+            QTest::addRow("%dx%d", target_count, file_count) << target_count << file_count;
+        };
+
+        for (const auto &[target_count, file_count] : SIZES) add_size(target_count, file_count);
+
+        const auto size = qEnvironmentVariable(SIZE_VARIABLE).split('x');
+        if (std::size(size) != 2) return;
+
+        auto target_ok   = false;
+        auto file_ok     = false;
+        const auto count = size[0].toInt(&target_ok);
+        const auto files = size[1].toInt(&file_ok);
+        if (target_ok && file_ok && count > 0 && files > 0) add_size(count, files);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeParseBenchmarks::infoParser_data() -> void { addSizes(); }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeParseBenchmarks::infoParser() -> void {
+        QFETCH(int, target_count);
+        QFETCH(int, file_count);
+
+        const auto data =
+            XMakeSyntheticProject::introspection(projectDir(), target_count, file_count);
+
+        QBENCHMARK {
+            const auto result = XMakeInfoParser::parse(data);
+            QCOMPARE(std::size(result.targets), static_cast<std::size_t>(target_count));
+        }
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeParseBenchmarks::projectTree_data() -> void { addSizes(); }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeParseBenchmarks::projectTree() -> void {
+        QFETCH(int, target_count);
+        QFETCH(int, file_count);
+
+        const auto project_dir = projectDir();
+        const auto result      = XMakeInfoParser::parse(
+            XMakeSyntheticProject::introspection(project_dir, target_count, file_count));
+
+        QBENCHMARK {
+            const auto root_node = ProjectTree::buildTree(project_dir,
+                                                          result.project_dir,
+                                                          result.targets,
+                                                          result.build_system_files,
+                                                          result.paths);
+            QVERIFY(root_node);
+        }
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeParseBenchmarks::projectParts_data() -> void { addSizes(); }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeParseBenchmarks::projectParts() -> void {
+        QFETCH(int, target_count);
+        QFETCH(int, file_count);
+
+        const auto project_dir = projectDir();
+        const auto result      = XMakeInfoParser::parse(
+            XMakeSyntheticProject::introspection(project_dir, target_count, file_count));
+
+        // without a kit the parts are still built, only the Qt and toolchain details are missing
+        const auto kit_info = QtSupport::CppKitInfo { ProjectExplorer::KitManager::defaultKit() };
+
+        auto future = QFutureInterface<XMakeProjectParser::ParserDataPtr> {};
+        future.reportStarted();
+
+        QBENCHMARK {
+            const auto project_parts = XMakeProjectParser::buildProjectParts(project_dir,
+                                                                             result.targets,
+                                                                             kit_info,
+                                                                             {},
+                                                                             future);
+            QCOMPARE(static_cast<int>(std::size(project_parts.by_target)), target_count);
+        }
+
+        future.reportFinished();
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeParseBenchmarks::buildParser_data() -> void { addSizes(); }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeParseBenchmarks::buildParser() -> void {
+        QFETCH(int, target_count);
+        QFETCH(int, file_count);
+
+        const auto project_dir = projectDir();
+        const auto lines       = XMakeSyntheticProject::buildOutput(target_count, file_count);
+
+        QBENCHMARK {
+            auto parser = XMakeBuildParser { XMakeBuildParser::Type::GCC_Clang };
+            parser.setSourceDirectory(project_dir);
+
+            for (const auto &line : lines)
+                parser.handleLine(line, Utils::OutputFormat::StdOutFormat);
+            parser.flush();
+        }
+    }
+} // namespace XMakeProjectManager::Internal
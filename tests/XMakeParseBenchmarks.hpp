@@ -0,0 +1,32 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <QObject>
+
+namespace XMakeProjectManager::Internal {
+    // times each step of a parse and of a build on synthetic projects, run with
+    // qtcreator -test XMakeProjectManager, XMAKE_BENCHMARK_SIZE=<targets>x<files> adds a
+    // project of that size to the default ones
+    class XMakeParseBenchmarks final: public QObject {
+        Q_OBJECT
+
+      private Q_SLOTS:
+        void infoParser_data();
+        void infoParser();
+
+        void projectTree_data();
+        void projectTree();
+
+        void projectParts_data();
+        void projectParts();
+
+        void buildParser_data();
+        void buildParser();
+
+      private:
+        static void addSizes();
+    };
+} // namespace XMakeProjectManager::Internal
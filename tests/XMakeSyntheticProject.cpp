@@ -0,0 +1,150 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#include "XMakeSyntheticProject.hpp"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+
+namespace XMakeProjectManager::Internal {
+    // about one header for two sources, a warning every 20 files and an error every 200
+    static constexpr auto HEADERS_RATIO  = 2;
+    static constexpr auto WARNING_PERIOD = 20;
+    static constexpr auto ERROR_PERIOD   = 200;
+
+    // a target depends on the previous one every DEPENDENCY_PERIOD targets
+    static constexpr auto DEPENDENCY_PERIOD = 10;
+    static constexpr auto GROUP_SIZE        = 25;
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto targetName(int index) -> QString { return QString { "target_%1" }.arg(index); }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    static auto sourceFile(int target, int file) -> QString {
+        return QString { "%1/src/file_%2.cpp" }.arg(targetName(target)).arg(file);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeSyntheticProject::introspection(const Utils::FilePath &project_dir,
+                                              int target_count,
+                                              int file_count) -> QByteArray {
+        const auto root = project_dir.toString();
+
+        auto targets       = QJsonArray {};
+        auto project_files = QJsonArray { root + "/xmake.lua" };
+
+        for (auto i = 0; i < target_count; ++i) {
+            const auto name       = targetName(i);
+            const auto target_dir = root + '/' + name;
+
+            auto sources = QJsonArray {};
+            auto headers = QJsonArray {};
+            for (auto j = 0; j < file_count; ++j) {
+                sources.append(root + '/' + sourceFile(i, j));
+                if (j % HEADERS_RATIO == 0)
+                    headers.append(QString { "%1/include/file_%2.hpp" }.arg(target_dir).arg(j));
+            }
+
+            // the flags of a release build with a couple of packages
+            const auto arguments = QJsonArray { "-m64",
+                                                "-fvisibility=hidden",
+                                                "-O3",
+                                                "-std=c++17",
+                                                "-I" + target_dir + "/include",
+                                                "-I" + root + "/common/include",
+                                                "-isystem",
+                                                "/usr/include/qt6",
+                                                "-isystem",
+                                                "/usr/include/qt6/QtCore",
+                                                "-DNDEBUG",
+                                                "-DQT_CORE_LIB",
+                                                "-D" + name.toUpper() + "_EXPORT" };
+
+            auto deps = QJsonArray {};
+            if (i > 0 && i % DEPENDENCY_PERIOD == 0) deps.append(targetName(i - 1));
+
+            const auto binary = i % DEPENDENCY_PERIOD == DEPENDENCY_PERIOD - 1;
+
+            targets.append(QJsonObject {
+                { "name", name },
+                { "kind", binary ? "binary" : "static" },
+                { "defined_in", target_dir + "/xmake.lua" },
+                { "source_batches",
+                  QJsonArray { QJsonObject { { "kind", "cxx" },
+                                             { "source_files", sources },
+                                             { "arguments", arguments },
+                                             { "file_flags", QJsonObject {} },
+                                             { "lazy_files", QJsonArray {} } } } },
+                { "header_files", headers },
+                { "module_files", QJsonArray {} },
+                { "target_file",
+                  root + "/build/linux/x86_64/release/" + (binary ? name : "lib" + name + ".a") },
+                { "object_dir", root + "/build/.objs/" + name },
+                { "group", QString { "group_%1" }.arg(i / GROUP_SIZE) },
+                { "deps", deps },
+                { "packages", QJsonArray {} },
+                { "frameworks", QJsonArray {} },
+                { "run_envs",
+                  QJsonObject { { "add", QJsonObject {} }, { "set", QJsonObject {} } } },
+            });
+
+            project_files.append(target_dir + "/xmake.lua");
+        }
+
+        const auto document = QJsonObject {
+            { "version", "2.7.5" },
+            { "project_dir", root },
+            { "project_files", project_files },
+            { "targets", targets },
+            { "options", QJsonArray {} },
+            { "packages", QJsonArray {} },
+            { "qml_import_path", QJsonArray {} },
+            { "profile", QJsonArray {} },
+        };
+
+        return QJsonDocument { document }.toJson(QJsonDocument::Compact);
+    }
+
+    ////////////////////////////////////////////////////
+    ////////////////////////////////////////////////////
+    auto XMakeSyntheticProject::buildOutput(int target_count, int file_count) -> QStringList {
+        const auto total = std::max(target_count * (file_count + 1), 1);
+
+        auto lines = QStringList {};
+        lines.reserve(total + total / WARNING_PERIOD + total / ERROR_PERIOD + 1);
+
+        auto done = 0;
+        for (auto i = 0; i < target_count; ++i) {
+            for (auto j = 0; j < file_count; ++j) {
+                const auto file = sourceFile(i, j);
+
+                lines.append(QString { "[%1%]: cache compiling.release %2" }
+                                 .arg(++done * 100 / total, 3)
+                                 .arg(file));
+
+                if (j % WARNING_PERIOD == WARNING_PERIOD - 1)
+                    lines.append(QString { "%1:12:5: warning: unused variable 'value' "
+                                           "[-Wunused-variable]" }
+                                     .arg(file));
+                if (j % ERROR_PERIOD == ERROR_PERIOD - 1)
+                    lines.append(QString { "error: %1:42:1: error: expected ';' after class" }
+                                     .arg(file));
+            }
+
+            lines.append(QString { "[%1%]: linking.release %2" }
+                             .arg(++done * 100 / total, 3)
+                             .arg(targetName(i)));
+        }
+
+        lines.append(QStringLiteral("[100%]: build ok, spent 42.0s"));
+
+        return lines;
+    }
+} // namespace XMakeProjectManager::Internal
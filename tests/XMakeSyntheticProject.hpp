@@ -0,0 +1,27 @@
+// Copyright (C) 2022 Arthur LAURENT <arthur.laurent4@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level of this distribution
+
+#pragma once
+
+#include <utils/filepath.h>
+
+#include <QByteArray>
+#include <QStringList>
+
+namespace XMakeProjectManager::Internal {
+    // the documents xmake gives for a project of target_count targets of file_count sources
+    // each, the files are never opened so they don't have to exist
+    class XMakeSyntheticProject {
+      public:
+        XMakeSyntheticProject() = delete;
+
+        // the JSON introspection document introspect.lua prints
+        static QByteArray introspection(const Utils::FilePath &project_dir,
+                                        int target_count,
+                                        int file_count);
+
+        // the lines of a build of every target, with a warning every few files
+        static QStringList buildOutput(int target_count, int file_count);
+    };
+} // namespace XMakeProjectManager::Internal
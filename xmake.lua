@@ -11,6 +11,20 @@ package_end()
 
 add_requires("QtCreator")
 
+option("trace_nodes")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Log every node and project part built by a parse")
+    add_defines("XMAKE_TRACE_NODES")
+option_end()
+
+option("tests")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Build the tests and the benchmarks of the plugin")
+    add_defines("WITH_TESTS")
+option_end()
+
 target("xmakeprojectmanager")
     set_kind("shared")
     add_rules("qt.shared")
@@ -23,3 +37,9 @@ target("xmakeprojectmanager")
     end
     add_frameworks("QtCore", "QtWidgets")
     add_packages("QtCreator")
+    add_options("trace_nodes", "tests")
+    if has_config("tests") then
+        add_files("tests/*.cpp")
+        add_includedirs("tests")
+        add_frameworks("QtTest")
+    end